@@ -16,121 +16,76 @@
 
 #include <string.h>
 #include "ceed-blocked.h"
-#include "../ref/ceed-ref.h"
 
 static int CeedOperatorDestroy_Blocked(CeedOperator op) {
   int ierr;
   CeedOperator_Blocked *impl;
   ierr = CeedOperatorGetData(op, (void*)&impl); CeedChk(ierr);
 
-  for (CeedInt i=0; i<impl->numein+impl->numeout; i++) {
-    ierr = CeedElemRestrictionDestroy(&impl->blkrestr[i]); CeedChk(ierr);
-    ierr = CeedVectorDestroy(&impl->evecs[i]); CeedChk(ierr);
-  }
-  ierr = CeedFree(&impl->blkrestr); CeedChk(ierr);
-  ierr = CeedFree(&impl->evecs); CeedChk(ierr);
-  ierr = CeedFree(&impl->edata); CeedChk(ierr);
-
-  for (CeedInt i=0; i<impl->numein; i++) {
-    ierr = CeedVectorDestroy(&impl->qvecsin[i]); CeedChk(ierr);
-  }
-  ierr = CeedFree(&impl->qvecsin); CeedChk(ierr);
-
-  for (CeedInt i=0; i<impl->numeout; i++) {
-    ierr = CeedVectorDestroy(&impl->qvecsout[i]); CeedChk(ierr);
-  }
-  ierr = CeedFree(&impl->qvecsout); CeedChk(ierr);
-
+  ierr = CeedOperatorPlanDestroy_Ref(&impl->plan); CeedChk(ierr);
   ierr = CeedFree(&impl); CeedChk(ierr);
   return 0;
 }
 
 /*
-  Setup infields or outfields
+  Default block size of an operator, wide enough for the matrix product
+  kernels if any of its bases is non-tensor
  */
-static int CeedOperatorSetupFields_Blocked(CeedQFunction qf, CeedOperator op,
-                                       bool inOrOut,
-                                       CeedElemRestriction *blkrestr,
-                                       CeedVector *evecs,
-                                       CeedVector *qvecs, CeedInt starte,
-                                       CeedInt numfields, CeedInt Q) {
-  CeedInt dim, ierr, ncomp;
-  Ceed ceed;
-  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
-  CeedBasis basis;
-  CeedElemRestriction r;
-  CeedOperatorField *opfields;
-  CeedQFunctionField *qffields;
-  if (inOrOut) {
-    ierr = CeedOperatorGetFields(op, NULL, &opfields);
-    CeedChk(ierr);
-    ierr = CeedQFunctionGetFields(qf, NULL, &qffields);
-    CeedChk(ierr);
-  } else {
-    ierr = CeedOperatorGetFields(op, &opfields, NULL);
-    CeedChk(ierr);
-    ierr = CeedQFunctionGetFields(qf, &qffields, NULL);
-    CeedChk(ierr);
-  }
-  const CeedInt blksize = 8;
-
-  // Loop over fields
-  for (CeedInt i=0; i<numfields; i++) {
-    CeedEvalMode emode;
-    ierr = CeedQFunctionFieldGetEvalMode(qffields[i], &emode); CeedChk(ierr);
+static int CeedOperatorDefaultBlockSize_Blocked(CeedOperator op,
+    CeedInt *blksize) {
+  int ierr;
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  CeedInt numinputfields, numoutputfields;
+  ierr = CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
+  CeedChk(ierr);
+  CeedOperatorField *opinputfields, *opoutputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, &opoutputfields);
+  CeedChk(ierr);
 
-    if (emode != CEED_EVAL_WEIGHT) {
-      ierr = CeedOperatorFieldGetElemRestriction(opfields[i], &r);
-      CeedChk(ierr);
-      CeedElemRestriction_Ref *data;
-      ierr = CeedElemRestrictionGetData(r, (void *)&data);
-      Ceed ceed;
-      ierr = CeedElemRestrictionGetCeed(r, &ceed); CeedChk(ierr);
-      CeedInt nelem, elemsize, ndof, ncomp;
-      ierr = CeedElemRestrictionGetNumElements(r, &nelem); CeedChk(ierr);
-      ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
-      ierr = CeedElemRestrictionGetNumDoF(r, &ndof); CeedChk(ierr);
-      ierr = CeedElemRestrictionGetNumComponents(r, &ncomp); CeedChk(ierr);
-      ierr = CeedElemRestrictionCreateBlocked(ceed, nelem, elemsize,
-                                              blksize, ndof, ncomp,
-                                              CEED_MEM_HOST, CEED_COPY_VALUES,
-                                              data->indices, &blkrestr[i+starte]);
-      CeedChk(ierr);
-      ierr = CeedElemRestrictionCreateVector(blkrestr[i+starte], NULL,
-                                             &evecs[i+starte]);
-      CeedChk(ierr);
-    }
+  *blksize = CEED_BLOCKED_BLKSIZE;
+  for (CeedInt i=0; i<numinputfields+numoutputfields; i++) {
+    CeedBasis basis;
+    ierr = CeedOperatorFieldGetBasis(i < numinputfields ? opinputfields[i]
+                                     : opoutputfields[i-numinputfields],
+                                     &basis); CeedChk(ierr);
+    if (basis == CEED_BASIS_COLLOCATED)
+      continue;
+    bool tensorbasis;
+    ierr = CeedBasisGetTensorStatus(basis, &tensorbasis); CeedChk(ierr);
+    if (!tensorbasis)
+      *blksize = CEED_BLOCKED_GEMM_BLKSIZE;
+  }
+  return 0;
+}
 
-    switch(emode) {
-    case CEED_EVAL_NONE:
-      ierr = CeedQFunctionFieldGetNumComponents(qffields[i], &ncomp);
-      CeedChk(ierr);
-      ierr = CeedVectorCreate(ceed, Q*ncomp, &qvecs[i]); CeedChk(ierr);
-      break;
-    case CEED_EVAL_INTERP:
-      ierr = CeedQFunctionFieldGetNumComponents(qffields[i], &ncomp);
-      CeedChk(ierr);
-      ierr = CeedVectorCreate(ceed, Q*ncomp*blksize, &qvecs[i]); CeedChk(ierr);
-      break;
-    case CEED_EVAL_GRAD:
-      ierr = CeedOperatorFieldGetBasis(opfields[i], &basis); CeedChk(ierr);
-      ierr = CeedQFunctionFieldGetNumComponents(qffields[i], &ncomp);
-      ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
-      ierr = CeedVectorCreate(ceed, Q*ncomp*dim*blksize, &qvecs[i]); CeedChk(ierr);
-      break;
-    case CEED_EVAL_WEIGHT: // Only on input fields
-      ierr = CeedOperatorFieldGetBasis(opfields[i], &basis); CeedChk(ierr);
-      ierr = CeedVectorCreate(ceed, Q*blksize, &qvecs[i]); CeedChk(ierr);
-      ierr = CeedBasisApply(basis, blksize, CEED_NOTRANSPOSE,
-                            CEED_EVAL_WEIGHT, NULL, qvecs[i]); CeedChk(ierr);
+/*
+  Block size of an operator, from the resource options of the blocked Ceed
+  ceed, the bases, or the autotuner; 1 if the QFunction vector length does
+  not divide the quadrature points of a block.  Also used by the backends
+  delegating to blocked.
+ */
+int CeedOperatorGetBlockSize_Blocked(Ceed ceed, CeedOperator op,
+                                     CeedInt *blksize) {
+  int ierr;
+  Ceed_Blocked *data;
+  ierr = CeedGetData(ceed, (void *)&data); CeedChk(ierr);
 
-      break;
-    case CEED_EVAL_DIV:
-      break; // Not implimented
-    case CEED_EVAL_CURL:
-      break; // Not implimented
-    }
+  *blksize = data->blksize;
+  if (!*blksize) {
+    ierr = CeedOperatorDefaultBlockSize_Blocked(op, blksize); CeedChk(ierr);
   }
+  if (data->autotune) {
+    ierr = CeedOperatorAutotune_Blocked(op, data, blksize); CeedChk(ierr);
+  }
+
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  CeedInt Q, vlength;
+  ierr = CeedOperatorGetNumQuadraturePoints(op, &Q); CeedChk(ierr);
+  ierr = CeedQFunctionGetVectorLength(qf, &vlength); CeedChk(ierr);
+  if ((Q * *blksize) % vlength)
+    *blksize = 1;
   return 0;
 }
 
@@ -143,266 +98,56 @@ static int CeedOperatorSetup_Blocked(CeedOperator op) {
   bool setupdone;
   ierr = CeedOperatorGetSetupStatus(op, &setupdone); CeedChk(ierr);
   if (setupdone) return 0;
-  Ceed ceed;
-  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
   CeedOperator_Blocked *impl;
   ierr = CeedOperatorGetData(op, (void*)&impl); CeedChk(ierr);
-  CeedQFunction qf;
-  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
-  CeedInt Q, numinputfields, numoutputfields;
-  ierr = CeedOperatorGetNumQuadraturePoints(op, &Q); CeedChk(ierr);
-  ierr= CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
-  CeedChk(ierr);
-  CeedOperatorField *opinputfields, *opoutputfields;
-  ierr = CeedOperatorGetFields(op, &opinputfields, &opoutputfields);
-  CeedChk(ierr);
-  CeedQFunctionField *qfinputfields, *qfoutputfields;
-  ierr = CeedQFunctionGetFields(qf, &qfinputfields, &qfoutputfields);
-  CeedChk(ierr);
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
 
-  // Allocate
-  ierr = CeedCalloc(numinputfields + numoutputfields, &impl->blkrestr);
-  CeedChk(ierr);
-  ierr = CeedCalloc(numinputfields + numoutputfields, &impl->evecs);
+  ierr = CeedOperatorGetBlockSize_Blocked(ceed, op, &impl->blksize);
   CeedChk(ierr);
-  ierr = CeedCalloc(numinputfields + numoutputfields, &impl->edata);
-  CeedChk(ierr);
-
-  ierr = CeedCalloc(16, &impl->qvecsin); CeedChk(ierr);
-  ierr = CeedCalloc(16, &impl->qvecsout); CeedChk(ierr);
 
-  impl->numein = numinputfields; impl->numeout = numoutputfields;
-
-  // Set up infield and outfield pointer arrays
-  // Infields
-  ierr = CeedOperatorSetupFields_Blocked(qf, op, 0, impl->blkrestr,
-                                     impl->evecs, impl->qvecsin, 0,
-                                     numinputfields, Q);
-  CeedChk(ierr);
-  // Outfields
-  ierr = CeedOperatorSetupFields_Blocked(qf, op, 1, impl->blkrestr,
-                                     impl->evecs, impl->qvecsout,
-                                     numinputfields, numoutputfields, Q);
+  // Blocked restrictions and block sized E-vectors and Q-vectors
+  ierr = CeedOperatorPlanCreate_Ref(op, impl->blksize, &impl->plan);
   CeedChk(ierr);
 
-  // Temporary Vector
-  ierr = CeedVectorCreate(ceed, 0, &impl->tempvec); CeedChk(ierr);
-
   ierr = CeedOperatorSetSetupDone(op); CeedChk(ierr);
 
   return 0;
 }
 
 static int CeedOperatorApply_Blocked(CeedOperator op, CeedVector invec,
-                                 CeedVector outvec, CeedRequest *request) {
+                                     CeedVector outvec, CeedRequest *request) {
   int ierr;
   CeedOperator_Blocked *impl;
   ierr = CeedOperatorGetData(op, (void*)&impl); CeedChk(ierr);
-  const CeedInt blksize = 8;
-  CeedInt Q, elemsize, numinputfields, numoutputfields, numelements, ncomp;
-  ierr = CeedOperatorGetNumElements(op, &numelements); CeedChk(ierr);
-  ierr = CeedOperatorGetNumQuadraturePoints(op, &Q); CeedChk(ierr);
-  CeedInt nblks = (numelements/blksize) + !!(numelements%blksize);
-  CeedQFunction qf;
-  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
-  ierr= CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
-  CeedChk(ierr);
-  CeedTransposeMode lmode;
-  CeedOperatorField *opinputfields, *opoutputfields;
-  ierr = CeedOperatorGetFields(op, &opinputfields, &opoutputfields);
-  CeedChk(ierr);
-  CeedQFunctionField *qfinputfields, *qfoutputfields;
-  ierr = CeedQFunctionGetFields(qf, &qfinputfields, &qfoutputfields);
-  CeedChk(ierr);
-  CeedEvalMode emode;
-  CeedVector vec;
-  CeedBasis basis;
-  CeedElemRestriction Erestrict;
 
   // Setup
   ierr = CeedOperatorSetup_Blocked(op); CeedChk(ierr);
 
-  // Input Evecs and Restriction
-  for (CeedInt i=0; i<numinputfields; i++) {
-    ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
-    CeedChk(ierr);
-    if (emode == CEED_EVAL_WEIGHT) { // Skip
-    } else {
-      // Get input vector
-      ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
-      if (vec == CEED_VECTOR_ACTIVE)
-        vec = invec;
-      // Restrict
-      ierr = CeedOperatorFieldGetLMode(opinputfields[i], &lmode); CeedChk(ierr);
-      ierr = CeedElemRestrictionApply(impl->blkrestr[i], CEED_NOTRANSPOSE,
-                                      lmode, vec, impl->evecs[i],
-                                      request); CeedChk(ierr); CeedChk(ierr);
-      // Get evec
-      ierr = CeedVectorGetArrayRead(impl->evecs[i], CEED_MEM_HOST,
-                                    (const CeedScalar **) &impl->edata[i]);
-      CeedChk(ierr);
-    }
-  }
-
-  // Output Evecs
-  for (CeedInt i=0; i<numoutputfields; i++) {
-    ierr = CeedVectorGetArray(impl->evecs[i+impl->numein], CEED_MEM_HOST,
-                              &impl->edata[i + numinputfields]); CeedChk(ierr);
-  }
-
-  // Loop through elements
-  for (CeedInt e=0; e<nblks*blksize; e+=blksize) {
-    // Input basis apply if needed
-    for (CeedInt i=0; i<numinputfields; i++) {
-      // Get elemsize, emode, ncomp
-      ierr = CeedOperatorFieldGetElemRestriction(opinputfields[i], &Erestrict);
-      CeedChk(ierr);
-      ierr = CeedElemRestrictionGetElementSize(Erestrict, &elemsize);
-      CeedChk(ierr);
-      ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
-      CeedChk(ierr);
-      ierr = CeedQFunctionFieldGetNumComponents(qfinputfields[i], &ncomp);
-      CeedChk(ierr);
-      // Basis action
-      switch(emode) {
-      case CEED_EVAL_NONE:
-        ierr = CeedVectorSetArray(impl->qvecsin[i], CEED_MEM_HOST, 
-                                  CEED_USE_POINTER,
-                                  &impl->edata[i][e*Q*ncomp]); CeedChk(ierr);
-        break;
-      case CEED_EVAL_INTERP:
-        ierr = CeedOperatorFieldGetBasis(opinputfields[i], &basis); CeedChk(ierr);
-        ierr = CeedVectorSetArray(impl->tempvec, CEED_MEM_HOST,
-                                  CEED_USE_POINTER,
-                                  &impl->edata[i][e*elemsize*ncomp]);
-        CeedChk(ierr);
-        ierr = CeedBasisApply(basis, blksize, CEED_NOTRANSPOSE,
-                              CEED_EVAL_INTERP, impl->tempvec,
-                              impl->qvecsin[i]); CeedChk(ierr);
-        break;
-      case CEED_EVAL_GRAD:
-        ierr = CeedOperatorFieldGetBasis(opinputfields[i], &basis); CeedChk(ierr);
-        ierr = CeedVectorSetArray(impl->tempvec, CEED_MEM_HOST,
-                                  CEED_USE_POINTER,
-                                  &impl->edata[i][e*elemsize*ncomp]);
-        CeedChk(ierr);
-        ierr = CeedBasisApply(basis, blksize, CEED_NOTRANSPOSE,
-                              CEED_EVAL_GRAD, impl->tempvec,
-                              impl->qvecsin[i]); CeedChk(ierr);
-        break;
-      case CEED_EVAL_WEIGHT:
-        break;  // No action
-      case CEED_EVAL_DIV:
-        break; // Not implimented
-      case CEED_EVAL_CURL:
-        break; // Not implimented
-      }
-    }
-
-    // Output pointers
-    for (CeedInt i=0; i<numoutputfields; i++) {
-      ierr = CeedQFunctionFieldGetEvalMode(qfoutputfields[i], &emode);
-      CeedChk(ierr);
-      if (emode == CEED_EVAL_NONE) {
-        ierr = CeedQFunctionFieldGetNumComponents(qfoutputfields[i], &ncomp);
-        CeedChk(ierr);
-        ierr = CeedVectorSetArray(impl->qvecsout[i], CEED_MEM_HOST,
-                                  CEED_USE_POINTER,
-                                  &impl->edata[i + numinputfields][e*Q*ncomp]);
-        CeedChk(ierr);
-      }
-    }
-    // Q function
-    ierr = CeedQFunctionApply(qf, Q*blksize, impl->qvecsin, impl->qvecsout);
-    CeedChk(ierr);
+  // Apply, one block of elements at a time
+  ierr = CeedOperatorPlanApply_Ref(op, impl->plan, 0, NULL, invec, outvec,
+                                   request); CeedChk(ierr);
 
-    // Output basis apply if needed
-    for (CeedInt i=0; i<numoutputfields; i++) {
-      // Get elemsize, emode, ncomp
-      ierr = CeedOperatorFieldGetElemRestriction(opoutputfields[i], &Erestrict);
-      CeedChk(ierr);
-      ierr = CeedElemRestrictionGetElementSize(Erestrict, &elemsize);
-      CeedChk(ierr);
-      ierr = CeedQFunctionFieldGetEvalMode(qfoutputfields[i], &emode);
-      CeedChk(ierr);
-      ierr = CeedQFunctionFieldGetNumComponents(qfoutputfields[i], &ncomp);
-      CeedChk(ierr);
-      // Basis action
-      switch(emode) {
-      case CEED_EVAL_NONE:
-        break; // No action
-      case CEED_EVAL_INTERP:
-        ierr = CeedOperatorFieldGetBasis(opoutputfields[i], &basis);
-        CeedChk(ierr);
-        ierr = CeedVectorSetArray(impl->tempvec, CEED_MEM_HOST,
-                                  CEED_USE_POINTER,
-                                  &impl->edata[i + numinputfields][e*elemsize*ncomp]);
-        ierr = CeedBasisApply(basis, blksize, CEED_TRANSPOSE,
-                              CEED_EVAL_INTERP, impl->qvecsout[i],
-                              impl->tempvec); CeedChk(ierr);
-        break;
-      case CEED_EVAL_GRAD:
-        ierr = CeedOperatorFieldGetBasis(opoutputfields[i], &basis);
-        CeedChk(ierr);
-        ierr = CeedVectorSetArray(impl->tempvec, CEED_MEM_HOST,
-                                  CEED_USE_POINTER,
-                                  &impl->edata[i + numinputfields][e*elemsize*ncomp]);
-        ierr = CeedBasisApply(basis, blksize, CEED_TRANSPOSE,
-                              CEED_EVAL_GRAD, impl->qvecsout[i],
-                              impl->tempvec); CeedChk(ierr);
-        break;
-      case CEED_EVAL_WEIGHT: {
-        Ceed ceed;
-        ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
-        return CeedError(ceed, 1,
-                         "CEED_EVAL_WEIGHT cannot be an output evaluation mode");
-        break; // Should not occur
-      }
-      case CEED_EVAL_DIV:
-        break; // Not implimented
-      case CEED_EVAL_CURL:
-        break; // Not implimented
-      }
-    }
-  }
-
-  // Zero lvecs
-  for (CeedInt i=0; i<numoutputfields; i++) {
-    ierr = CeedOperatorFieldGetVector(opoutputfields[i], &vec); CeedChk(ierr);
-    if (vec == CEED_VECTOR_ACTIVE)
-      vec = outvec;
-    ierr = CeedVectorSetValue(vec, 0.0); CeedChk(ierr);
-    }
+  return 0;
+}
 
-  // Output restriction
-  for (CeedInt i=0; i<numoutputfields; i++) {
-    // Restore evec
-    ierr = CeedVectorRestoreArray(impl->evecs[i+impl->numein],
-                                  &impl->edata[i + numinputfields]); CeedChk(ierr);
-    // Get output vector
-    ierr = CeedOperatorFieldGetVector(opoutputfields[i], &vec); CeedChk(ierr);
-    // Active
-    if (vec == CEED_VECTOR_ACTIVE)
-      vec = outvec;
-    // Restrict
-    ierr = CeedOperatorFieldGetLMode(opoutputfields[i], &lmode); CeedChk(ierr);
-    ierr = CeedElemRestrictionApply(impl->blkrestr[i+impl->numein], CEED_TRANSPOSE,
-                                      lmode, impl->evecs[i+impl->numein], vec,
-                                      request); CeedChk(ierr);
+static int CeedOperatorApplyElements_Blocked(CeedOperator op, CeedInt start,
+    CeedInt nelem, const CeedInt *elems, CeedVector invec, CeedVector outvec,
+    CeedRequest *request) {
+  int ierr;
+  CeedOperator_Blocked *impl;
+  ierr = CeedOperatorGetData(op, (void*)&impl); CeedChk(ierr);
 
-  }
+  // Setup
+  ierr = CeedOperatorSetup_Blocked(op); CeedChk(ierr);
 
-  // Restore input arrays
-  for (CeedInt i=0; i<numinputfields; i++) {
-    ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
-    CeedChk(ierr);
-    if (emode == CEED_EVAL_WEIGHT) { // Skip
-    } else {
-      ierr = CeedVectorRestoreArrayRead(impl->evecs[i],
-                                        (const CeedScalar **) &impl->edata[i]);
-      CeedChk(ierr);
-    }
-  }
+  // Apply the selected elements, packed into blocks, adding to the outputs
+  CeedInt nsel, *sel;
+  ierr = CeedOperatorSelectElements_Ref(start, nelem, elems, &nsel, &sel);
+  CeedChk(ierr);
+  ierr = CeedOperatorPlanApply_Ref(op, impl->plan, nsel, sel, invec, outvec,
+                                   request); CeedChk(ierr);
+  ierr = CeedFree(&sel); CeedChk(ierr);
 
   return 0;
 }
@@ -418,6 +163,9 @@ int CeedOperatorCreate_Blocked(CeedOperator op) {
 
   ierr = CeedSetBackendFunction(ceed, "Operator", op, "Apply",
                                 CeedOperatorApply_Blocked); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "ApplyElements",
+                                CeedOperatorApplyElements_Blocked);
+  CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "Operator", op, "Destroy",
                                 CeedOperatorDestroy_Blocked); CeedChk(ierr);
   return 0;
@@ -0,0 +1,587 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include "ceed-blocked.h"
+
+// The SIMD kernels vectorize over C, the blocked element index, and keep one
+// accumulator register per output row j, larger J is done in groups of rows
+#define CEED_CONTRACT_MAXJ 10
+// The even-odd SIMD kernels keep two accumulators per pair of output rows
+#define CEED_EVENODD_MAXNJ 5
+// The matrix product kernels for non-tensor bases keep an MR by NV register
+// tile of V and reuse each broadcast entry of T across NV registers of U
+#define CEED_GEMM_MR_AVX512 6
+#define CEED_GEMM_NV_AVX512 4
+#define CEED_GEMM_MR_AVX2 4
+#define CEED_GEMM_NV_AVX2 3
+// Size of the panel of U, by columns, that the matrix product keeps in cache
+#ifndef CEED_GEMM_PANEL_BYTES
+#define CEED_GEMM_PANEL_BYTES (16*1024)
+#endif
+
+// With CEED_BLAS, set by the Makefile when BLAS_LIB is given, contractions
+// that the SIMD kernels below do not take and that have at least this many
+// multiply-adds for each index a go to the system dgemm.  On x86 with AVX2 or
+// AVX-512 the SIMD kernels keep the contractions, they match or beat a tuned
+// dgemm at the small J and B of the bases.
+#ifndef CEED_BLAS_MIN_FLOPS
+#define CEED_BLAS_MIN_FLOPS (8*8*8)
+#endif
+
+#ifdef CEED_BLAS
+#include <cblas.h>
+
+// V_ajc (+)= T_jb U_abc as A products of T with the row-major B × C slabs of U
+static void CeedTensorContractBlas(CeedInt A, CeedInt B, CeedInt C, CeedInt J,
+                                   const CeedScalar *t,
+                                   CeedTransposeMode tmode, const CeedInt Add,
+                                   const CeedScalar *u, CeedScalar *v) {
+  const bool trans = tmode == CEED_TRANSPOSE;
+  for (CeedInt a=0; a<A; a++)
+    cblas_dgemm(CblasRowMajor, trans ? CblasTrans : CblasNoTrans,
+                CblasNoTrans, J, C, B, 1.0, t, trans ? J : B, u + a*B*C, C,
+                Add ? 1.0 : 0.0, v + a*J*C, C);
+}
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define CEED_CONTRACT_SIMD
+// Full unrolling of the register tile loops, which -O alone does not do
+#if defined(__clang__) || __GNUC__ >= 8
+#define CEED_PRAGMA(x) _Pragma(#x)
+#define CEED_UNROLL(n) CEED_PRAGMA(GCC unroll n)
+#else
+#define CEED_UNROLL(n)
+#endif
+
+// V_ajc (+)= T_jb U_abc for J <= CEED_CONTRACT_MAXJ rows of V, which has
+// Jstride rows, 8 doubles per register
+__attribute__((target("avx512f"), always_inline))
+static inline void CeedTensorContractKernel_Avx512(CeedInt A, CeedInt B,
+    CeedInt C, const CeedInt J, CeedInt Jstride, const CeedScalar *restrict t,
+    CeedInt tstride0, CeedInt tstride1, const CeedInt Add,
+    const CeedScalar *restrict u, CeedScalar *restrict v) {
+  const CeedInt Cv = C - C%8;
+  for (CeedInt a=0; a<A; a++) {
+    for (CeedInt c=0; c<Cv; c+=8) {
+      __m512d acc[CEED_CONTRACT_MAXJ];
+      for (CeedInt j=0; j<J; j++)
+        acc[j] = Add ? _mm512_loadu_pd(&v[(a*Jstride+j)*C+c])
+                 : _mm512_setzero_pd();
+      for (CeedInt b=0; b<B; b++) {
+        const __m512d ub = _mm512_loadu_pd(&u[(a*B+b)*C+c]);
+        for (CeedInt j=0; j<J; j++)
+          acc[j] = _mm512_fmadd_pd(_mm512_set1_pd(t[j*tstride0 + b*tstride1]),
+                                   ub, acc[j]);
+      }
+      for (CeedInt j=0; j<J; j++)
+        _mm512_storeu_pd(&v[(a*Jstride+j)*C+c], acc[j]);
+    }
+    for (CeedInt j=0; j<J; j++)
+      for (CeedInt c=Cv; c<C; c++) {
+        CeedScalar vq = Add ? v[(a*Jstride+j)*C+c] : 0.0;
+        for (CeedInt b=0; b<B; b++)
+          vq += t[j*tstride0 + b*tstride1] * u[(a*B+b)*C+c];
+        v[(a*Jstride+j)*C+c] = vq;
+      }
+  }
+}
+
+// V_ajc (+)= T_jb U_abc for J <= CEED_CONTRACT_MAXJ rows of V, which has
+// Jstride rows, 4 doubles per register
+__attribute__((target("avx2,fma"), always_inline))
+static inline void CeedTensorContractKernel_Avx2(CeedInt A, CeedInt B,
+    CeedInt C, const CeedInt J, CeedInt Jstride, const CeedScalar *restrict t,
+    CeedInt tstride0, CeedInt tstride1, const CeedInt Add,
+    const CeedScalar *restrict u, CeedScalar *restrict v) {
+  const CeedInt Cv = C - C%4;
+  for (CeedInt a=0; a<A; a++) {
+    for (CeedInt c=0; c<Cv; c+=4) {
+      __m256d acc[CEED_CONTRACT_MAXJ];
+      for (CeedInt j=0; j<J; j++)
+        acc[j] = Add ? _mm256_loadu_pd(&v[(a*Jstride+j)*C+c])
+                 : _mm256_setzero_pd();
+      for (CeedInt b=0; b<B; b++) {
+        const __m256d ub = _mm256_loadu_pd(&u[(a*B+b)*C+c]);
+        for (CeedInt j=0; j<J; j++)
+          acc[j] = _mm256_fmadd_pd(_mm256_set1_pd(t[j*tstride0 + b*tstride1]),
+                                   ub, acc[j]);
+      }
+      for (CeedInt j=0; j<J; j++)
+        _mm256_storeu_pd(&v[(a*Jstride+j)*C+c], acc[j]);
+    }
+    for (CeedInt j=0; j<J; j++)
+      for (CeedInt c=Cv; c<C; c++) {
+        CeedScalar vq = Add ? v[(a*Jstride+j)*C+c] : 0.0;
+        for (CeedInt b=0; b<B; b++)
+          vq += t[j*tstride0 + b*tstride1] * u[(a*B+b)*C+c];
+        v[(a*Jstride+j)*C+c] = vq;
+      }
+  }
+}
+
+// Instantiate the kernels for each J so the accumulators live in registers
+#define CEED_CONTRACT_CASE(kernel, n) \
+  case n: kernel(A, B, C, n, Jstride, t, tstride0, tstride1, Add, u, v); break;
+#define CEED_CONTRACT_CASES(kernel) \
+  switch (J) { \
+  CEED_CONTRACT_CASE(kernel, 1) CEED_CONTRACT_CASE(kernel, 2) \
+  CEED_CONTRACT_CASE(kernel, 3) CEED_CONTRACT_CASE(kernel, 4) \
+  CEED_CONTRACT_CASE(kernel, 5) CEED_CONTRACT_CASE(kernel, 6) \
+  CEED_CONTRACT_CASE(kernel, 7) CEED_CONTRACT_CASE(kernel, 8) \
+  CEED_CONTRACT_CASE(kernel, 9) CEED_CONTRACT_CASE(kernel, 10) \
+  }
+
+__attribute__((target("avx512f")))
+static void CeedTensorContract_Avx512(CeedInt A, CeedInt B, CeedInt C,
+                                      CeedInt J, CeedInt Jstride,
+                                      const CeedScalar *restrict t,
+                                      CeedInt tstride0, CeedInt tstride1,
+                                      const CeedInt Add,
+                                      const CeedScalar *restrict u,
+                                      CeedScalar *restrict v) {
+  CEED_CONTRACT_CASES(CeedTensorContractKernel_Avx512)
+}
+
+__attribute__((target("avx2,fma")))
+static void CeedTensorContract_Avx2(CeedInt A, CeedInt B, CeedInt C,
+                                    CeedInt J, CeedInt Jstride,
+                                    const CeedScalar *restrict t,
+                                    CeedInt tstride0, CeedInt tstride1,
+                                    const CeedInt Add,
+                                    const CeedScalar *restrict u,
+                                    CeedScalar *restrict v) {
+  CEED_CONTRACT_CASES(CeedTensorContractKernel_Avx2)
+}
+
+// Even-odd V_ajc (+)= T_jb U_abc with folded matrices E and O, see
+// CeedTensorContractEvenOdd_Blocked(), for the row pairs j0,...,j0+nj-1 with
+// nj <= CEED_EVENODD_MAXNJ, 8 doubles per register
+__attribute__((target("avx512f"), always_inline))
+static inline void CeedTensorContractEvenOddKernel_Avx512(CeedInt A,
+    CeedInt B, CeedInt C, CeedInt J, CeedInt j0, const CeedInt nj,
+    const CeedScalar *restrict E, const CeedScalar *restrict O, CeedInt sym,
+    const CeedInt Add, const CeedScalar *restrict u, CeedScalar *restrict v) {
+  const CeedInt hB = B/2, hJ = J/2, Be = B-hB, Cv = C - C%8;
+  const __m512d s = _mm512_set1_pd(sym);
+  for (CeedInt a=0; a<A; a++)
+    for (CeedInt c=0; c<Cv; c+=8) {
+      __m512d pe[CEED_EVENODD_MAXNJ], po[CEED_EVENODD_MAXNJ];
+      for (CeedInt j=0; j<nj; j++)
+        pe[j] = po[j] = _mm512_setzero_pd();
+      for (CeedInt b=0; b<hB; b++) {
+        const __m512d ub = _mm512_loadu_pd(&u[(a*B+b)*C+c]),
+                      ur = _mm512_loadu_pd(&u[(a*B+B-1-b)*C+c]),
+                      e = _mm512_add_pd(ub, ur), o = _mm512_sub_pd(ub, ur);
+        for (CeedInt j=0; j<nj; j++) {
+          pe[j] = _mm512_fmadd_pd(_mm512_set1_pd(E[(j0+j)*Be+b]), e, pe[j]);
+          po[j] = _mm512_fmadd_pd(_mm512_set1_pd(O[(j0+j)*hB+b]), o, po[j]);
+        }
+      }
+      if (Be > hB) {
+        const __m512d um = _mm512_loadu_pd(&u[(a*B+hB)*C+c]);
+        for (CeedInt j=0; j<nj; j++)
+          pe[j] = _mm512_fmadd_pd(_mm512_set1_pd(E[(j0+j)*Be+hB]), um, pe[j]);
+      }
+      for (CeedInt j=0; j<nj; j++) {
+        CeedScalar *vj = &v[(a*J+j0+j)*C+c], *vr = &v[(a*J+J-1-j0-j)*C+c];
+        __m512d sum = _mm512_add_pd(pe[j], po[j]);
+        if (Add) sum = _mm512_add_pd(sum, _mm512_loadu_pd(vj));
+        _mm512_storeu_pd(vj, sum);
+        if (j0+j < hJ) {
+          __m512d dif = _mm512_mul_pd(s, _mm512_sub_pd(pe[j], po[j]));
+          if (Add) dif = _mm512_add_pd(dif, _mm512_loadu_pd(vr));
+          _mm512_storeu_pd(vr, dif);
+        }
+      }
+    }
+}
+
+// Even-odd V_ajc (+)= T_jb U_abc with folded matrices E and O, see
+// CeedTensorContractEvenOdd_Blocked(), for the row pairs j0,...,j0+nj-1 with
+// nj <= CEED_EVENODD_MAXNJ, 4 doubles per register
+__attribute__((target("avx2,fma"), always_inline))
+static inline void CeedTensorContractEvenOddKernel_Avx2(CeedInt A,
+    CeedInt B, CeedInt C, CeedInt J, CeedInt j0, const CeedInt nj,
+    const CeedScalar *restrict E, const CeedScalar *restrict O, CeedInt sym,
+    const CeedInt Add, const CeedScalar *restrict u, CeedScalar *restrict v) {
+  const CeedInt hB = B/2, hJ = J/2, Be = B-hB, Cv = C - C%4;
+  const __m256d s = _mm256_set1_pd(sym);
+  for (CeedInt a=0; a<A; a++)
+    for (CeedInt c=0; c<Cv; c+=4) {
+      __m256d pe[CEED_EVENODD_MAXNJ], po[CEED_EVENODD_MAXNJ];
+      for (CeedInt j=0; j<nj; j++)
+        pe[j] = po[j] = _mm256_setzero_pd();
+      for (CeedInt b=0; b<hB; b++) {
+        const __m256d ub = _mm256_loadu_pd(&u[(a*B+b)*C+c]),
+                      ur = _mm256_loadu_pd(&u[(a*B+B-1-b)*C+c]),
+                      e = _mm256_add_pd(ub, ur), o = _mm256_sub_pd(ub, ur);
+        for (CeedInt j=0; j<nj; j++) {
+          pe[j] = _mm256_fmadd_pd(_mm256_set1_pd(E[(j0+j)*Be+b]), e, pe[j]);
+          po[j] = _mm256_fmadd_pd(_mm256_set1_pd(O[(j0+j)*hB+b]), o, po[j]);
+        }
+      }
+      if (Be > hB) {
+        const __m256d um = _mm256_loadu_pd(&u[(a*B+hB)*C+c]);
+        for (CeedInt j=0; j<nj; j++)
+          pe[j] = _mm256_fmadd_pd(_mm256_set1_pd(E[(j0+j)*Be+hB]), um, pe[j]);
+      }
+      for (CeedInt j=0; j<nj; j++) {
+        CeedScalar *vj = &v[(a*J+j0+j)*C+c], *vr = &v[(a*J+J-1-j0-j)*C+c];
+        __m256d sum = _mm256_add_pd(pe[j], po[j]);
+        if (Add) sum = _mm256_add_pd(sum, _mm256_loadu_pd(vj));
+        _mm256_storeu_pd(vj, sum);
+        if (j0+j < hJ) {
+          __m256d dif = _mm256_mul_pd(s, _mm256_sub_pd(pe[j], po[j]));
+          if (Add) dif = _mm256_add_pd(dif, _mm256_loadu_pd(vr));
+          _mm256_storeu_pd(vr, dif);
+        }
+      }
+    }
+}
+
+#define CEED_EVENODD_CASE(kernel, n) \
+  case n: kernel(A, B, C, J, j0, n, E, O, sym, Add, u, v); break;
+#define CEED_EVENODD_CASES(kernel) \
+  switch (nj) { \
+  CEED_EVENODD_CASE(kernel, 1) CEED_EVENODD_CASE(kernel, 2) \
+  CEED_EVENODD_CASE(kernel, 3) CEED_EVENODD_CASE(kernel, 4) \
+  CEED_EVENODD_CASE(kernel, 5) \
+  }
+
+__attribute__((target("avx512f")))
+static void CeedTensorContractEvenOdd_Avx512(CeedInt A, CeedInt B, CeedInt C,
+    CeedInt J, CeedInt j0, CeedInt nj, const CeedScalar *restrict E,
+    const CeedScalar *restrict O, CeedInt sym, const CeedInt Add,
+    const CeedScalar *restrict u, CeedScalar *restrict v) {
+  CEED_EVENODD_CASES(CeedTensorContractEvenOddKernel_Avx512)
+}
+
+__attribute__((target("avx2,fma")))
+static void CeedTensorContractEvenOdd_Avx2(CeedInt A, CeedInt B, CeedInt C,
+    CeedInt J, CeedInt j0, CeedInt nj, const CeedScalar *restrict E,
+    const CeedScalar *restrict O, CeedInt sym, const CeedInt Add,
+    const CeedScalar *restrict u, CeedScalar *restrict v) {
+  CEED_EVENODD_CASES(CeedTensorContractEvenOddKernel_Avx2)
+}
+
+// V_jc (+)= T_jb U_bc for MR <= CEED_GEMM_MR_AVX512 rows of V and the Cp
+// columns of a panel, U and V with row stride C, 8 doubles per register
+__attribute__((target("avx512f"), always_inline))
+static inline void CeedMatrixMultiplyKernel_Avx512(CeedInt B, CeedInt Cp,
+    CeedInt C, const CeedInt MR, const CeedScalar *restrict t,
+    CeedInt tstride0, CeedInt tstride1, const CeedInt Add,
+    const CeedScalar *restrict u, CeedScalar *restrict v) {
+  const CeedInt NV = CEED_GEMM_NV_AVX512;
+  CeedInt c = 0;
+  for (; c+8*NV<=Cp; c+=8*NV) {
+    __m512d acc[CEED_GEMM_MR_AVX512][CEED_GEMM_NV_AVX512];
+    CEED_UNROLL(6)
+    for (CeedInt j=0; j<MR; j++) {
+      CEED_UNROLL(4)
+      for (CeedInt k=0; k<NV; k++)
+        acc[j][k] = Add ? _mm512_loadu_pd(&v[j*C+c+8*k]) : _mm512_setzero_pd();
+    }
+    for (CeedInt b=0; b<B; b++) {
+      __m512d ub[CEED_GEMM_NV_AVX512];
+      CEED_UNROLL(4)
+      for (CeedInt k=0; k<NV; k++)
+        ub[k] = _mm512_loadu_pd(&u[b*C+c+8*k]);
+      CEED_UNROLL(6)
+      for (CeedInt j=0; j<MR; j++) {
+        const __m512d tjb = _mm512_set1_pd(t[j*tstride0 + b*tstride1]);
+        CEED_UNROLL(4)
+        for (CeedInt k=0; k<NV; k++)
+          acc[j][k] = _mm512_fmadd_pd(tjb, ub[k], acc[j][k]);
+      }
+    }
+    CEED_UNROLL(6)
+    for (CeedInt j=0; j<MR; j++) {
+      CEED_UNROLL(4)
+      for (CeedInt k=0; k<NV; k++)
+        _mm512_storeu_pd(&v[j*C+c+8*k], acc[j][k]);
+    }
+  }
+  for (; c+8<=Cp; c+=8) {
+    __m512d acc[CEED_GEMM_MR_AVX512];
+    CEED_UNROLL(6)
+    for (CeedInt j=0; j<MR; j++)
+      acc[j] = Add ? _mm512_loadu_pd(&v[j*C+c]) : _mm512_setzero_pd();
+    for (CeedInt b=0; b<B; b++) {
+      const __m512d ub = _mm512_loadu_pd(&u[b*C+c]);
+      CEED_UNROLL(6)
+      for (CeedInt j=0; j<MR; j++)
+        acc[j] = _mm512_fmadd_pd(_mm512_set1_pd(t[j*tstride0 + b*tstride1]),
+                                 ub, acc[j]);
+    }
+    CEED_UNROLL(6)
+    for (CeedInt j=0; j<MR; j++)
+      _mm512_storeu_pd(&v[j*C+c], acc[j]);
+  }
+  for (CeedInt j=0; j<MR; j++)
+    for (CeedInt cc=c; cc<Cp; cc++) {
+      CeedScalar vq = Add ? v[j*C+cc] : 0.0;
+      for (CeedInt b=0; b<B; b++)
+        vq += t[j*tstride0 + b*tstride1] * u[b*C+cc];
+      v[j*C+cc] = vq;
+    }
+}
+
+// V_jc (+)= T_jb U_bc for MR <= CEED_GEMM_MR_AVX2 rows of V and the Cp
+// columns of a panel, U and V with row stride C, 4 doubles per register
+__attribute__((target("avx2,fma"), always_inline))
+static inline void CeedMatrixMultiplyKernel_Avx2(CeedInt B, CeedInt Cp,
+    CeedInt C, const CeedInt MR, const CeedScalar *restrict t,
+    CeedInt tstride0, CeedInt tstride1, const CeedInt Add,
+    const CeedScalar *restrict u, CeedScalar *restrict v) {
+  const CeedInt NV = CEED_GEMM_NV_AVX2;
+  CeedInt c = 0;
+  for (; c+4*NV<=Cp; c+=4*NV) {
+    __m256d acc[CEED_GEMM_MR_AVX2][CEED_GEMM_NV_AVX2];
+    CEED_UNROLL(4)
+    for (CeedInt j=0; j<MR; j++) {
+      CEED_UNROLL(3)
+      for (CeedInt k=0; k<NV; k++)
+        acc[j][k] = Add ? _mm256_loadu_pd(&v[j*C+c+4*k]) : _mm256_setzero_pd();
+    }
+    for (CeedInt b=0; b<B; b++) {
+      __m256d ub[CEED_GEMM_NV_AVX2];
+      CEED_UNROLL(3)
+      for (CeedInt k=0; k<NV; k++)
+        ub[k] = _mm256_loadu_pd(&u[b*C+c+4*k]);
+      CEED_UNROLL(4)
+      for (CeedInt j=0; j<MR; j++) {
+        const __m256d tjb = _mm256_set1_pd(t[j*tstride0 + b*tstride1]);
+        CEED_UNROLL(3)
+        for (CeedInt k=0; k<NV; k++)
+          acc[j][k] = _mm256_fmadd_pd(tjb, ub[k], acc[j][k]);
+      }
+    }
+    CEED_UNROLL(4)
+    for (CeedInt j=0; j<MR; j++) {
+      CEED_UNROLL(3)
+      for (CeedInt k=0; k<NV; k++)
+        _mm256_storeu_pd(&v[j*C+c+4*k], acc[j][k]);
+    }
+  }
+  for (; c+4<=Cp; c+=4) {
+    __m256d acc[CEED_GEMM_MR_AVX2];
+    CEED_UNROLL(4)
+    for (CeedInt j=0; j<MR; j++)
+      acc[j] = Add ? _mm256_loadu_pd(&v[j*C+c]) : _mm256_setzero_pd();
+    for (CeedInt b=0; b<B; b++) {
+      const __m256d ub = _mm256_loadu_pd(&u[b*C+c]);
+      CEED_UNROLL(4)
+      for (CeedInt j=0; j<MR; j++)
+        acc[j] = _mm256_fmadd_pd(_mm256_set1_pd(t[j*tstride0 + b*tstride1]),
+                                 ub, acc[j]);
+    }
+    CEED_UNROLL(4)
+    for (CeedInt j=0; j<MR; j++)
+      _mm256_storeu_pd(&v[j*C+c], acc[j]);
+  }
+  for (CeedInt j=0; j<MR; j++)
+    for (CeedInt cc=c; cc<Cp; cc++) {
+      CeedScalar vq = Add ? v[j*C+cc] : 0.0;
+      for (CeedInt b=0; b<B; b++)
+        vq += t[j*tstride0 + b*tstride1] * u[b*C+cc];
+      v[j*C+cc] = vq;
+    }
+}
+
+#define CEED_GEMM_CASE(kernel, n) \
+  case n: kernel(B, Cp, C, n, t, tstride0, tstride1, Add, u, v); break;
+
+__attribute__((target("avx512f")))
+static void CeedMatrixMultiply_Avx512(CeedInt B, CeedInt Cp, CeedInt C,
+                                      CeedInt MR, const CeedScalar *restrict t,
+                                      CeedInt tstride0, CeedInt tstride1,
+                                      const CeedInt Add,
+                                      const CeedScalar *restrict u,
+                                      CeedScalar *restrict v) {
+  switch (MR) {
+  CEED_GEMM_CASE(CeedMatrixMultiplyKernel_Avx512, 1)
+  CEED_GEMM_CASE(CeedMatrixMultiplyKernel_Avx512, 2)
+  CEED_GEMM_CASE(CeedMatrixMultiplyKernel_Avx512, 3)
+  CEED_GEMM_CASE(CeedMatrixMultiplyKernel_Avx512, 4)
+  CEED_GEMM_CASE(CeedMatrixMultiplyKernel_Avx512, 5)
+  CEED_GEMM_CASE(CeedMatrixMultiplyKernel_Avx512, 6)
+  }
+}
+
+__attribute__((target("avx2,fma")))
+static void CeedMatrixMultiply_Avx2(CeedInt B, CeedInt Cp, CeedInt C,
+                                    CeedInt MR, const CeedScalar *restrict t,
+                                    CeedInt tstride0, CeedInt tstride1,
+                                    const CeedInt Add,
+                                    const CeedScalar *restrict u,
+                                    CeedScalar *restrict v) {
+  switch (MR) {
+  CEED_GEMM_CASE(CeedMatrixMultiplyKernel_Avx2, 1)
+  CEED_GEMM_CASE(CeedMatrixMultiplyKernel_Avx2, 2)
+  CEED_GEMM_CASE(CeedMatrixMultiplyKernel_Avx2, 3)
+  CEED_GEMM_CASE(CeedMatrixMultiplyKernel_Avx2, 4)
+  }
+}
+
+// Instruction set for the kernels, detected by CeedInit_Blocked(): 0 - none,
+//   2 - AVX2, 3 - AVX-512
+static int CeedContractISA(Ceed ceed) {
+  Ceed_Blocked *data;
+  CeedGetData(ceed, (void *)&data);
+  return sizeof(CeedScalar) == sizeof(double) && data ? data->isa : 0;
+}
+#endif
+
+// Contracts on the middle index
+// NOTRANSPOSE: V_ajc = T_jb U_abc
+// TRANSPOSE:   V_ajc = T_bj U_abc
+// If Add != 0, "=" is replaced by "+="
+int CeedTensorContract_Blocked(Ceed ceed, CeedInt A, CeedInt B, CeedInt C,
+                               CeedInt J, const CeedScalar *restrict t,
+                               CeedTransposeMode tmode, const CeedInt Add,
+                               const CeedScalar *restrict u,
+                               CeedScalar *restrict v) {
+  CeedInt tstride0 = B, tstride1 = 1;
+  if (tmode == CEED_TRANSPOSE) {
+    tstride0 = 1; tstride1 = J;
+  }
+
+#ifdef CEED_CONTRACT_SIMD
+  const int isa = CeedContractISA(ceed);
+  if ((isa == 3 && C >= 8) || (isa == 2 && C >= 4)) {
+    // Rows in groups of equal size
+    const CeedInt ngroups = (J + CEED_CONTRACT_MAXJ - 1)/CEED_CONTRACT_MAXJ,
+                  Jg = (J + ngroups - 1)/ngroups;
+    for (CeedInt j=0; j<J; j+=Jg) {
+      const CeedInt Jb = CeedIntMin(J-j, Jg);
+      if (isa == 3)
+        CeedTensorContract_Avx512(A, B, C, Jb, J, t + j*tstride0, tstride0,
+                                  tstride1, Add, u, v + j*C);
+      else
+        CeedTensorContract_Avx2(A, B, C, Jb, J, t + j*tstride0, tstride0,
+                                tstride1, Add, u, v + j*C);
+    }
+    return 0;
+  }
+#endif
+#ifdef CEED_BLAS
+  if (J*B*C >= CEED_BLAS_MIN_FLOPS) {
+    CeedTensorContractBlas(A, B, C, J, t, tmode, Add, u, v);
+    return 0;
+  }
+#endif
+
+  if (!Add)
+    for (CeedInt q=0; q<A*J*C; q++)
+      v[q] = (CeedScalar) 0.0;
+
+  for (CeedInt a=0; a<A; a++)
+    for (CeedInt b=0; b<B; b++)
+      for (CeedInt j=0; j<J; j++) {
+        CeedScalar tq = t[j*tstride0 + b*tstride1];
+        for (CeedInt c=0; c<C; c++)
+          v[(a*J+j)*C+c] += tq * u[(a*B+b)*C+c];
+      }
+  return 0;
+}
+
+// Applies a non-tensor basis to C elements at once as the matrix product
+// V_ajc = T_jb U_abc, with tmode and Add as for CeedTensorContract_Blocked().
+// The element index c is the wide operand: U is taken in column panels of
+// CEED_GEMM_PANEL_BYTES that stay in cache while all rows of T are applied to
+// them, in register tiles that reuse each entry of T across several vectors.
+int CeedMatrixMultiply_Blocked(Ceed ceed, CeedInt A, CeedInt B, CeedInt C,
+                               CeedInt J, const CeedScalar *restrict t,
+                               CeedTransposeMode tmode, const CeedInt Add,
+                               const CeedScalar *restrict u,
+                               CeedScalar *restrict v) {
+#ifdef CEED_CONTRACT_SIMD
+  CeedInt tstride0 = B, tstride1 = 1;
+  if (tmode == CEED_TRANSPOSE) {
+    tstride0 = 1; tstride1 = J;
+  }
+
+  // Narrower blocks are done by the contraction kernels, which keep more rows
+  const int isa = CeedContractISA(ceed);
+  const CeedInt W = isa == 3 ? 8*CEED_GEMM_NV_AVX512 : 4*CEED_GEMM_NV_AVX2;
+  if (isa && C >= W) {
+    const CeedInt MRmax = isa == 3 ? CEED_GEMM_MR_AVX512 : CEED_GEMM_MR_AVX2,
+                  ngroups = (J + MRmax - 1)/MRmax,
+                  MR = (J + ngroups - 1)/ngroups;
+    CeedInt panel = CEED_GEMM_PANEL_BYTES/(B*sizeof(CeedScalar));
+    panel = panel < W ? W : panel - panel%W;
+    for (CeedInt a=0; a<A; a++)
+      for (CeedInt c=0; c<C; c+=panel) {
+        const CeedInt Cp = CeedIntMin(C-c, panel);
+        for (CeedInt j=0; j<J; j+=MR) {
+          const CeedScalar *tj = t + j*tstride0, *ua = u + a*B*C + c;
+          CeedScalar *vj = v + (a*J+j)*C + c;
+          if (isa == 3)
+            CeedMatrixMultiply_Avx512(B, Cp, C, CeedIntMin(J-j, MR), tj,
+                                      tstride0, tstride1, Add, ua, vj);
+          else
+            CeedMatrixMultiply_Avx2(B, Cp, C, CeedIntMin(J-j, MR), tj,
+                                    tstride0, tstride1, Add, ua, vj);
+        }
+      }
+    return 0;
+  }
+#endif
+
+  return CeedTensorContract_Blocked(ceed, A, B, C, J, t, tmode, Add, u, v);
+}
+
+// Contracts on the middle index as CeedTensorContract_Blocked() with a matrix
+// from CeedTensorMatrixCreate_Ref(), by its even-odd decomposition if it has
+// folded matrices.  The columns that fill whole registers go to the SIMD
+// kernels and the rest to CeedTensorContractFolded_Ref().
+int CeedTensorContractEvenOdd_Blocked(Ceed ceed, CeedInt A, CeedInt B,
+                                      CeedInt C, CeedInt J,
+                                      const CeedTensorMatrix_Ref *t,
+                                      CeedTransposeMode tmode,
+                                      const CeedInt Add,
+                                      const CeedScalar *restrict u,
+                                      CeedScalar *restrict v) {
+  const CeedScalar *E = t->E[tmode], *O = t->O[tmode];
+  const CeedInt sym = t->sym;
+  if (!E)
+    return CeedTensorContract_Blocked(ceed, A, B, C, J, t->t, tmode, Add, u,
+                                      v);
+
+  CeedInt Cs = 0;
+#ifdef CEED_CONTRACT_SIMD
+  const int isa = CeedContractISA(ceed);
+  if ((isa == 3 && C >= 8) || (isa == 2 && C >= 4)) {
+    const CeedInt Je = J - J/2,
+                  ngroups = (Je + CEED_EVENODD_MAXNJ - 1)/CEED_EVENODD_MAXNJ,
+                  njg = (Je + ngroups - 1)/ngroups;
+    Cs = C - C%(isa == 3 ? 8 : 4);
+    for (CeedInt j=0; j<Je; j+=njg) {
+      const CeedInt nj = CeedIntMin(Je-j, njg);
+      if (isa == 3)
+        CeedTensorContractEvenOdd_Avx512(A, B, C, J, j, nj, E, O, sym, Add, u,
+                                         v);
+      else
+        CeedTensorContractEvenOdd_Avx2(A, B, C, J, j, nj, E, O, sym, Add, u, v);
+    }
+  }
+#endif
+
+  CeedTensorContractFolded_Ref(A, B, C, J, Cs, E, O, sym, Add, u, v);
+  return 0;
+}
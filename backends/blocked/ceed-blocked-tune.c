@@ -0,0 +1,247 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "ceed-blocked.h"
+
+// Candidate block sizes tried by the autotuner
+static const CeedInt blksizes[] = {1, 2, 4, 8, 16, 32};
+
+// Operator shape used as the autotuner cache key
+typedef struct {
+  CeedInt dim, P, Q, ncomp, nfields;
+} CeedTuneKey_Blocked;
+
+static int CeedTuneGetKey_Blocked(CeedOperator op, CeedTuneKey_Blocked *key) {
+  int ierr;
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  CeedInt numinputfields, numoutputfields;
+  ierr = CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
+  CeedChk(ierr);
+  CeedOperatorField *opinputfields, *opoutputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, &opoutputfields);
+  CeedChk(ierr);
+  CeedQFunctionField *qfinputfields, *qfoutputfields;
+  ierr = CeedQFunctionGetFields(qf, &qfinputfields, &qfoutputfields);
+  CeedChk(ierr);
+
+  memset(key, 0, sizeof(*key));
+  ierr = CeedOperatorGetNumQuadraturePoints(op, &key->Q); CeedChk(ierr);
+  for (CeedInt i=0; i<numinputfields+numoutputfields; i++) {
+    const bool isin = i < numinputfields;
+    CeedEvalMode emode;
+    ierr = CeedQFunctionFieldGetEvalMode(isin ? qfinputfields[i]
+                                         : qfoutputfields[i-numinputfields],
+                                         &emode); CeedChk(ierr);
+    if (!(emode & (CEED_EVAL_INTERP|CEED_EVAL_GRAD)))
+      continue;
+    CeedBasis basis;
+    ierr = CeedOperatorFieldGetBasis(isin ? opinputfields[i]
+                                     : opoutputfields[i-numinputfields],
+                                     &basis); CeedChk(ierr);
+    CeedInt dim, P, ncomp;
+    ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
+    ierr = CeedBasisGetNumNodes(basis, &P); CeedChk(ierr);
+    ierr = CeedBasisGetNumComponents(basis, &ncomp); CeedChk(ierr);
+    if (dim > key->dim) key->dim = dim;
+    if (P > key->P) key->P = P;
+    key->ncomp += ncomp;
+    key->nfields++;
+  }
+  return 0;
+}
+
+// Look up a tuned block size, later entries take precedence
+static bool CeedTuneCacheLookup_Blocked(const char *tunefile,
+                                        const CeedTuneKey_Blocked *key,
+                                        CeedInt *blksize) {
+  bool found = false;
+  FILE *fp = tunefile[0] ? fopen(tunefile, "r") : NULL;
+  if (!fp) return false;
+  int dim, P, Q, ncomp, nfields, blk;
+  while (fscanf(fp, "%d %d %d %d %d %d", &dim, &P, &Q, &ncomp, &nfields,
+                &blk) == 6) {
+    if (dim == key->dim && P == key->P && Q == key->Q && ncomp == key->ncomp
+        && nfields == key->nfields && blk > 0
+        && blk <= CEED_BLOCKED_MAX_BLKSIZE) {
+      *blksize = blk;
+      found = true;
+    }
+  }
+  fclose(fp);
+  return found;
+}
+
+/*
+  Record a tuned block size in the cache unless its key is already there, by
+  writing the previous entries and the new one to a temporary file renamed
+  over the cache, so that concurrent processes never read or append to a
+  partially written file.  Failure to write is not an error.
+ */
+static void CeedTuneCacheStore_Blocked(const char *tunefile,
+                                       const CeedTuneKey_Blocked *key,
+                                       CeedInt blksize) {
+  CeedInt cached;
+  if (!tunefile[0] || CeedTuneCacheLookup_Blocked(tunefile, key, &cached))
+    return;
+  char tmpname[CEED_MAX_RESOURCE_LEN + 8];
+  snprintf(tmpname, sizeof tmpname, "%s.XXXXXX", tunefile);
+  int fd = mkstemp(tmpname);
+  if (fd < 0) return;
+  FILE *fp = fdopen(fd, "w");
+  if (!fp) {
+    close(fd);
+    remove(tmpname);
+    return;
+  }
+  FILE *prev = fopen(tunefile, "r");
+  if (prev) {
+    int v[6];
+    while (fscanf(prev, "%d %d %d %d %d %d", &v[0], &v[1], &v[2], &v[3],
+                  &v[4], &v[5]) == 6)
+      fprintf(fp, "%d %d %d %d %d %d\n", v[0], v[1], v[2], v[3], v[4], v[5]);
+    fclose(prev);
+  }
+  fprintf(fp, "%d %d %d %d %d %d\n", key->dim, key->P, key->Q, key->ncomp,
+          key->nfields, blksize);
+  if (fclose(fp) || rename(tmpname, tunefile))
+    remove(tmpname);
+}
+
+/*
+  Time the basis actions of an operator for one block size, reported as
+  seconds per element.  Inputs are interpolated to quadrature points and
+  outputs are projected back, as in CeedOperatorApply().
+ */
+static int CeedTuneTime_Blocked(CeedOperator op, CeedInt blksize,
+                                double *time) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  CeedInt Q, numinputfields, numoutputfields;
+  ierr = CeedOperatorGetNumQuadraturePoints(op, &Q); CeedChk(ierr);
+  ierr = CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
+  CeedChk(ierr);
+  const CeedInt numfields = numinputfields + numoutputfields;
+  CeedOperatorField *opinputfields, *opoutputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, &opoutputfields);
+  CeedChk(ierr);
+  CeedQFunctionField *qfinputfields, *qfoutputfields;
+  ierr = CeedQFunctionGetFields(qf, &qfinputfields, &qfoutputfields);
+  CeedChk(ierr);
+  CeedBasis bases[numfields];
+  CeedEvalMode emodes[numfields];
+  CeedVector evecs[numfields], qvecs[numfields];
+
+  // Block sized work vectors
+  for (CeedInt i=0; i<numfields; i++) {
+    const bool isin = i < numinputfields;
+    evecs[i] = qvecs[i] = NULL;
+    ierr = CeedQFunctionFieldGetEvalMode(isin ? qfinputfields[i]
+                                         : qfoutputfields[i-numinputfields],
+                                         &emodes[i]); CeedChk(ierr);
+    if (!(emodes[i] & (CEED_EVAL_INTERP|CEED_EVAL_GRAD)))
+      continue;
+    ierr = CeedOperatorFieldGetBasis(isin ? opinputfields[i]
+                                     : opoutputfields[i-numinputfields],
+                                     &bases[i]); CeedChk(ierr);
+    CeedInt dim, P, ncomp;
+    ierr = CeedBasisGetDimension(bases[i], &dim); CeedChk(ierr);
+    ierr = CeedBasisGetNumNodes(bases[i], &P); CeedChk(ierr);
+    ierr = CeedBasisGetNumComponents(bases[i], &ncomp); CeedChk(ierr);
+    ierr = CeedVectorCreate(ceed, blksize*P*ncomp, &evecs[i]); CeedChk(ierr);
+    ierr = CeedVectorSetValue(evecs[i], 1.0); CeedChk(ierr);
+    ierr = CeedVectorCreate(ceed, blksize*Q*ncomp
+                            *(!!(emodes[i] & CEED_EVAL_INTERP)
+                              + !!(emodes[i] & CEED_EVAL_GRAD)*dim),
+                            &qvecs[i]); CeedChk(ierr);
+    ierr = CeedVectorSetValue(qvecs[i], 1.0); CeedChk(ierr);
+  }
+
+  // Repeat until the measurement is long enough to be meaningful
+  *time = 0;
+  for (CeedInt reps = 1; ; reps *= 2) {
+    clock_t start = clock();
+    for (CeedInt r=0; r<reps; r++)
+      for (CeedInt i=0; i<numfields; i++) {
+        if (!evecs[i]) continue;
+        if (i < numinputfields) {
+          ierr = CeedBasisApply(bases[i], blksize, CEED_NOTRANSPOSE, emodes[i],
+                                evecs[i], qvecs[i]); CeedChk(ierr);
+        } else {
+          ierr = CeedBasisApply(bases[i], blksize, CEED_TRANSPOSE, emodes[i],
+                                qvecs[i], evecs[i]); CeedChk(ierr);
+        }
+      }
+    clock_t elapsed = clock() - start;
+    if (elapsed > CLOCKS_PER_SEC/200 || reps >= (1 << 20)) {
+      *time = (double)elapsed / CLOCKS_PER_SEC / (reps*blksize);
+      break;
+    }
+  }
+
+  for (CeedInt i=0; i<numfields; i++) {
+    ierr = CeedVectorDestroy(&evecs[i]); CeedChk(ierr);
+    ierr = CeedVectorDestroy(&qvecs[i]); CeedChk(ierr);
+  }
+  return 0;
+}
+
+/*
+  Choose the block size for an operator, from the autotuner cache if this
+  operator shape was tuned before, otherwise by timing each candidate block
+  size and recording the fastest, in the cache named by the options data of
+  the blocked Ceed.
+ */
+int CeedOperatorAutotune_Blocked(CeedOperator op, const Ceed_Blocked *data,
+                                 CeedInt *blksize) {
+  int ierr;
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  CeedInt vlength;
+  ierr = CeedQFunctionGetVectorLength(qf, &vlength); CeedChk(ierr);
+
+  CeedTuneKey_Blocked key;
+  ierr = CeedTuneGetKey_Blocked(op, &key); CeedChk(ierr);
+  if (!key.nfields) // Nothing to tune
+    return 0;
+  if (CeedTuneCacheLookup_Blocked(data->tunefile, &key, blksize)
+      && !((key.Q * *blksize) % vlength))
+    return 0;
+
+  double best = -1.;
+  for (size_t b=0; b<sizeof(blksizes)/sizeof(blksizes[0]); b++) {
+    double t = 0.;
+    if ((key.Q*blksizes[b]) % vlength)
+      continue;
+    ierr = CeedTuneTime_Blocked(op, blksizes[b], &t); CeedChk(ierr);
+    if (best < 0 || t < best) {
+      best = t;
+      *blksize = blksizes[b];
+    }
+  }
+  CeedTuneCacheStore_Blocked(data->tunefile, &key, *blksize);
+
+  return 0;
+}
@@ -14,13 +14,63 @@
 // software, applications, hardware, advanced system engineering and early
 // testbed platforms, in support of the nation's exascale computing imperative.
 
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "ceed-blocked.h"
 
+static int CeedDestroy_Blocked(Ceed ceed) {
+  int ierr;
+  Ceed_Blocked *data;
+  ierr = CeedGetData(ceed, (void *)&data); CeedChk(ierr);
+  ierr = CeedFree(&data); CeedChk(ierr);
+  return 0;
+}
+
+/*
+  Parse the options following '?' in the resource, separated by '&':
+    blksize=N      number of elements processed together, by default
+                   CEED_BLOCKED_BLKSIZE or CEED_BLOCKED_GEMM_BLKSIZE for
+                   operators with non-tensor bases
+    autotune       time candidate block sizes when operators are set up
+    tunefile=PATH  autotuner cache file, default $CEED_TUNE_FILE or
+                   $HOME/.ceed-blocked-tune
+ */
+static int CeedParseOptions_Blocked(Ceed ceed, const char *options,
+                                    Ceed_Blocked *data) {
+  char opts[CEED_MAX_RESOURCE_LEN];
+  strncpy(opts, options, CEED_MAX_RESOURCE_LEN-1);
+  opts[CEED_MAX_RESOURCE_LEN-1] = 0;
+
+  // Split at '&' in place, strtok() is not reentrant
+  for (char *opt = opts, *next; opt; opt = next) {
+    next = strchr(opt, '&');
+    if (next)
+      *next++ = 0;
+    if (!*opt) {
+      continue;
+    } else if (!strncmp(opt, "blksize=", 8)) {
+      data->blksize = atoi(opt + 8);
+      if (data->blksize < 1 || data->blksize > CEED_BLOCKED_MAX_BLKSIZE)
+        return CeedError(ceed, 1, "Invalid block size: %s", opt + 8);
+    } else if (!strcmp(opt, "autotune")) {
+      data->autotune = true;
+    } else if (!strncmp(opt, "tunefile=", 9)) {
+      strncpy(data->tunefile, opt + 9, CEED_MAX_RESOURCE_LEN-1);
+    } else {
+      return CeedError(ceed, 1, "Blocked backend unknown option: %s", opt);
+    }
+  }
+  return 0;
+}
+
 static int CeedInit_Blocked(const char *resource, Ceed ceed) {
   int ierr;
-  if (strcmp(resource, "/cpu/self")
-      && strcmp(resource, "/cpu/self/blocked"))
+  const size_t nrc = strcspn(resource, "?"); // length without options
+  char base[CEED_MAX_RESOURCE_LEN];
+  snprintf(base, sizeof base, "%.*s", (int)nrc, resource);
+  if (strcmp(base, "/cpu/self")
+      && strcmp(base, "/cpu/self/blocked"))
     return CeedError(ceed, 1, "Blocked backend cannot use resource: %s", resource);
 
   Ceed ceedref;
@@ -30,6 +80,24 @@ static int CeedInit_Blocked(const char *resource, Ceed ceed) {
   CeedInit("/cpu/self/ref", &ceedref);
   ierr = CeedSetDelegate(ceed, &ceedref); CeedChk(ierr);
 
+  // Options
+  Ceed_Blocked *data;
+  ierr = CeedCalloc(1, &data); CeedChk(ierr);
+  ierr = CeedGetISA_Ref(ceedref, &data->isa); CeedChk(ierr);
+  const char *tunefile = getenv("CEED_TUNE_FILE"), *home = getenv("HOME");
+  if (tunefile)
+    strncpy(data->tunefile, tunefile, CEED_MAX_RESOURCE_LEN-1);
+  else if (home)
+    snprintf(data->tunefile, CEED_MAX_RESOURCE_LEN, "%s/.ceed-blocked-tune",
+             home);
+  ierr = CeedSetData(ceed, (void *)&data); CeedChk(ierr);
+  if (resource[nrc]) {
+    ierr = CeedParseOptions_Blocked(ceed, resource + nrc + 1, data);
+    CeedChk(ierr);
+  }
+
+  ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "Destroy",
+                                CeedDestroy_Blocked); CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "BasisCreateTensorH1",
                                 CeedBasisCreateTensorH1_Blocked); CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "BasisCreateH1",
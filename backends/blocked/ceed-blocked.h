@@ -16,27 +16,39 @@
 
 #include <ceed-backend.h>
 #include <string.h>
+#include "../ref/ceed-ref.h"
 
-typedef struct {
-  Ceed ceedref;
-} Ceed_Blocked;
+#define CEED_BLOCKED_MAX_BLKSIZE 64
+// Default elements per block, and for operators with non-tensor bases, which
+// are applied as matrix products that need wide blocks to reuse the basis
+#define CEED_BLOCKED_BLKSIZE 8
+#define CEED_BLOCKED_GEMM_BLKSIZE 32
 
 typedef struct {
-  CeedScalar *colograd1d;
-} CeedBasis_Blocked;
+  CeedInt blksize;   /// Elements per block, 0 for the default
+  bool autotune;   /// Time candidate block sizes when setting up operators
+  char tunefile[CEED_MAX_RESOURCE_LEN];   /// Autotuner cache, empty for none
+  int isa;   /// SIMD instruction set of the ref delegate, see CeedGetISA_Ref()
+} Ceed_Blocked;
 
 typedef struct {
-  CeedElemRestriction *blkrestr; /// Blocked versions of restrictions
-  CeedVector
-  *evecs;   /// E-vectors needed to apply operator (input followed by outputs)
-  CeedScalar ** edata;
-  CeedVector *qvecsin;   /// Input Q-vectors needed to apply operator
-  CeedVector *qvecsout;   /// Output Q-vectors needed to apply operator
-  CeedInt    numein;
-  CeedInt    numeout;
-  CeedVector tempvec;
+  CeedInt blksize;
+  CeedOperatorPlan_Ref *plan;   /// Execution plan, shared with ref
 } CeedOperator_Blocked;
 
+CEED_INTERN int CeedTensorContract_Blocked(Ceed ceed, CeedInt A, CeedInt B,
+    CeedInt C, CeedInt J, const CeedScalar *restrict t, CeedTransposeMode tmode,
+    const CeedInt Add, const CeedScalar *restrict u, CeedScalar *restrict v);
+
+CEED_INTERN int CeedMatrixMultiply_Blocked(Ceed ceed, CeedInt A, CeedInt B,
+    CeedInt C, CeedInt J, const CeedScalar *restrict t, CeedTransposeMode tmode,
+    const CeedInt Add, const CeedScalar *restrict u, CeedScalar *restrict v);
+
+CEED_INTERN int CeedTensorContractEvenOdd_Blocked(Ceed ceed, CeedInt A,
+    CeedInt B, CeedInt C, CeedInt J, const CeedTensorMatrix_Ref *t,
+    CeedTransposeMode tmode, const CeedInt Add, const CeedScalar *restrict u,
+    CeedScalar *restrict v);
+
 CEED_INTERN int CeedBasisCreateTensorH1_Blocked(CeedInt dim, CeedInt P1d,
     CeedInt Q1d, const CeedScalar *interp1d,
     const CeedScalar *grad1d,
@@ -53,3 +65,9 @@ CEED_INTERN int CeedBasisCreateH1_Blocked(CeedElemTopology topo, CeedInt dim,
                                       CeedBasis basis);
 
 CEED_INTERN int CeedOperatorCreate_Blocked(CeedOperator op);
+
+CEED_INTERN int CeedOperatorGetBlockSize_Blocked(Ceed ceed, CeedOperator op,
+    CeedInt *blksize);
+
+CEED_INTERN int CeedOperatorAutotune_Blocked(CeedOperator op,
+    const Ceed_Blocked *data, CeedInt *blksize);
@@ -474,6 +474,15 @@ static int CeedElemRestrictionCreate_Magma(CeedMemType mtype,
   int ierr, size = r->nelem*r->elemsize;
   CeedElemRestriction_Magma *impl;
 
+  if (r->cartesian)
+    return CeedError(r->ceed, 1,
+                     "Backend does not implement Cartesian restrictions");
+  // Strided restrictions come without indices, only the identity is handled
+  if (r->strides && (r->strides[0] != 1 || r->strides[1] != r->elemsize ||
+                     r->strides[2] != r->elemsize*r->ncomp))
+    return CeedError(r->ceed, 1,
+                     "Backend does not implement strided restrictions");
+
   // Allocate memory for the MAGMA Restricton and initializa pointers to NULL
   ierr = CeedCalloc(1,&impl); CeedChk(ierr);
   impl->dindices = NULL;
@@ -698,6 +707,9 @@ static int CeedBasisCreateTensorH1_Magma(CeedInt dim, CeedInt P1d,
     const CeedScalar *qref1d,
     const CeedScalar *qweight1d,
     CeedBasis basis) {
+  if (basis->sizes1d)
+    return CeedError(basis->ceed, 1,
+                     "Backend does not implement anisotropic bases");
   basis->Apply = CeedBasisApply_Magma;
   basis->Destroy = CeedBasisDestroy_Magma;
   return 0;
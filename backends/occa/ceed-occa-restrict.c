@@ -155,11 +155,21 @@ int CeedElemRestrictionCreate_Occa(const CeedMemType mtype,
   int ierr;
   Ceed ceed;
   ierr = CeedElemRestrictionGetCeed(r, &ceed); CeedChk(ierr);
-  CeedInt ndof, nelem, elemsize;
+  CeedInt ndof, nelem, elemsize, ncomp, *strides, *cartesian;
   ierr = CeedElemRestrictionGetNumDoF(r, &ndof); CeedChk(ierr);
   ierr = CeedElemRestrictionGetNumElements(r, &nelem); CeedChk(ierr);
   ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumComponents(r, &ncomp); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetStrides(r, &strides); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetCartesian(r, &cartesian); CeedChk(ierr);
   dbg("[CeedElemRestriction][Create]");
+  if (cartesian)
+    return CeedError(ceed, 1,
+                     "Backend does not implement Cartesian restrictions");
+  // Strided restrictions come without indices, only the identity is handled
+  if (strides && (strides[0] != 1 || strides[1] != elemsize ||
+                  strides[2] != elemsize*ncomp))
+    return CeedError(ceed, 1, "Backend does not implement strided restrictions");
   CeedElemRestriction_Occa *data;
   Ceed_Occa *ceed_data;
   ierr = CeedGetData(ceed, (void*)&ceed_data); CeedChk(ierr);
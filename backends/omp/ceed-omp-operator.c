@@ -0,0 +1,744 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <string.h>
+#include "ceed-omp.h"
+
+static int CeedOperatorDestroy_Omp(CeedOperator op) {
+  int ierr;
+  CeedOperator_Omp *impl;
+  ierr = CeedOperatorGetData(op, (void*)&impl); CeedChk(ierr);
+
+  for (CeedInt i=0; i<impl->numein+impl->numeout; i++) {
+    ierr = CeedElemRestrictionDestroy(&impl->blkrestr[i]); CeedChk(ierr);
+  }
+  ierr = CeedFree(&impl->blkrestr); CeedChk(ierr);
+
+  for (CeedInt i=0; i<impl->numeout; i++) {
+    ierr = CeedVectorDestroy(&impl->evecsout[i]); CeedChk(ierr);
+  }
+  ierr = CeedFree(&impl->evecsout); CeedChk(ierr);
+  ierr = CeedFree(&impl->edataout); CeedChk(ierr);
+  ierr = CeedFree(&impl->toffsets); CeedChk(ierr);
+  ierr = CeedFree(&impl->tindices); CeedChk(ierr);
+  for (CeedInt i=0; i<impl->numeout; i++) {
+    ierr = CeedElemTransposeDestroy_Ref(&impl->seltr[i]); CeedChk(ierr);
+  }
+  ierr = CeedFree(&impl->seltr); CeedChk(ierr);
+  ierr = CeedFree(&impl->selt); CeedChk(ierr);
+  ierr = CeedFree(&impl->ldatain); CeedChk(ierr);
+
+  for (CeedInt t=0; t<impl->nthreads; t++) {
+    for (CeedInt i=0; i<impl->numein; i++) {
+      ierr = CeedVectorDestroy(&impl->evecsin[t*impl->numein+i]); CeedChk(ierr);
+      ierr = CeedVectorDestroy(&impl->qvecsin[t*impl->numein+i]); CeedChk(ierr);
+    }
+    for (CeedInt i=0; i<impl->numeout; i++) {
+      ierr = CeedVectorDestroy(&impl->qvecsout[t*impl->numeout+i]);
+      CeedChk(ierr);
+    }
+    ierr = CeedVectorDestroy(&impl->tempvec[t]); CeedChk(ierr);
+    ierr = CeedFree(&impl->work[t]); CeedChk(ierr);
+  }
+  ierr = CeedFree(&impl->evecsin); CeedChk(ierr);
+  ierr = CeedFree(&impl->qvecsin); CeedChk(ierr);
+  ierr = CeedFree(&impl->qvecsout); CeedChk(ierr);
+  ierr = CeedFree(&impl->tempvec); CeedChk(ierr);
+  ierr = CeedFree(&impl->work); CeedChk(ierr);
+  ierr = CeedFree(&impl->edatain); CeedChk(ierr);
+  ierr = CeedFree(&impl->qdatain); CeedChk(ierr);
+  ierr = CeedFree(&impl->qdataout); CeedChk(ierr);
+
+  ierr = CeedFree(&impl); CeedChk(ierr);
+  return 0;
+}
+
+/*
+  Whether the nodes of all the elements of a strided restriction are distinct
+  entries of the L-vector: sorted by stride, each index must step over the
+  span of the smaller ones
+ */
+static bool CeedStridesDisjoint_Omp(CeedInt elemsize, CeedInt ncomp,
+                                    CeedInt nelem, const CeedInt *strides) {
+  CeedInt n[3] = {elemsize, ncomp, nelem}, s[3], m[3], span = 0;
+  for (CeedInt k=0; k<3; k++) {
+    s[k] = strides[k];
+    m[k] = n[k];
+  }
+  for (CeedInt k=1; k<3; k++)
+    for (CeedInt l=k; l>0 && s[l] < s[l-1]; l--) {
+      CeedInt t = s[l]; s[l] = s[l-1]; s[l-1] = t;
+      t = m[l]; m[l] = m[l-1]; m[l-1] = t;
+    }
+  for (CeedInt k=0; k<3; k++) {
+    if (m[k] == 1) continue;
+    if (s[k] <= span) return false;
+    span += s[k]*(m[k]-1);
+  }
+  return true;
+}
+
+/*
+  Setup infields or outfields
+ */
+static int CeedOperatorSetupFields_Omp(CeedQFunction qf, CeedOperator op,
+                                       bool inOrOut, CeedInt starte,
+                                       CeedInt numfields, CeedInt Q,
+                                       CeedInt *esize, CeedInt *qsize) {
+  CeedInt dim, ierr, ncomp;
+  CeedOperator_Omp *impl;
+  ierr = CeedOperatorGetData(op, (void*)&impl); CeedChk(ierr);
+  const CeedInt blksize = impl->blksize;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  CeedBasis basis;
+  CeedElemRestriction r;
+  CeedOperatorField *opfields;
+  CeedQFunctionField *qffields;
+  if (inOrOut) {
+    ierr = CeedOperatorGetFields(op, NULL, &opfields);
+    CeedChk(ierr);
+    ierr = CeedQFunctionGetFields(qf, NULL, &qffields);
+    CeedChk(ierr);
+  } else {
+    ierr = CeedOperatorGetFields(op, &opfields, NULL);
+    CeedChk(ierr);
+    ierr = CeedQFunctionGetFields(qf, &qffields, NULL);
+    CeedChk(ierr);
+  }
+
+  // Loop over fields
+  for (CeedInt i=0; i<numfields; i++) {
+    CeedEvalMode emode;
+    ierr = CeedQFunctionFieldGetEvalMode(qffields[i], &emode); CeedChk(ierr);
+    esize[i] = 0;
+
+    if (emode != CEED_EVAL_WEIGHT) {
+      ierr = CeedOperatorFieldGetElemRestriction(opfields[i], &r);
+      CeedChk(ierr);
+      CeedInt elemsize;
+      ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+      ierr = CeedElemRestrictionGetNumComponents(r, &ncomp); CeedChk(ierr);
+      ierr = CeedElemRestrictionGetBlocked_Ref(r, blksize,
+             &impl->blkrestr[i+starte]); CeedChk(ierr);
+      if (inOrOut) {
+        ierr = CeedElemRestrictionCreateVector(impl->blkrestr[i+starte], NULL,
+                                               &impl->evecsout[i]);
+        CeedChk(ierr);
+        // The restriction owns the transpose, NULL unless it has indices
+        ierr = CeedElemRestrictionGetTranspose_Ref(impl->blkrestr[i+starte],
+               &impl->toffsets[i], &impl->tindices[i]); CeedChk(ierr);
+      } else if (emode != CEED_EVAL_NONE) {
+        esize[i] = blksize*elemsize*ncomp;
+      }
+    }
+
+    ierr = CeedQFunctionFieldGetNumComponents(qffields[i], &ncomp);
+    CeedChk(ierr);
+    if (emode == (CEED_EVAL_INTERP|CEED_EVAL_GRAD)) {
+      // Values followed by gradients
+      ierr = CeedOperatorFieldGetBasis(opfields[i], &basis); CeedChk(ierr);
+      ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
+      qsize[i] = Q*ncomp*(1+dim)*blksize;
+    } else switch(emode) {
+    case CEED_EVAL_NONE:
+      // Inputs are gathered directly into the Q-vector, outputs are written
+      //   directly into the output E-vector
+      qsize[i] = inOrOut ? 0 : Q*ncomp*blksize;
+      break;
+    case CEED_EVAL_INTERP:
+      qsize[i] = Q*ncomp*blksize;
+      break;
+    case CEED_EVAL_GRAD:
+      ierr = CeedOperatorFieldGetBasis(opfields[i], &basis); CeedChk(ierr);
+      ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
+      qsize[i] = Q*ncomp*dim*blksize;
+      break;
+    case CEED_EVAL_WEIGHT: // Only on input fields
+      if (inOrOut)
+        return CeedError(ceed, 1,
+                         "CEED_EVAL_WEIGHT cannot be an output evaluation mode");
+      qsize[i] = Q*blksize;
+      break;
+    case CEED_EVAL_DIV:
+      qsize[i] = 0;
+      break; // Not implimented
+    case CEED_EVAL_CURL:
+      qsize[i] = 0;
+      break; // Not implimented
+    }
+  }
+  return 0;
+}
+
+/*
+  Set up per-thread workspace: each thread owns an E-vector block and a
+  Q-vector block for every field, so no two threads share scratch storage.
+ */
+static int CeedOperatorSetupThreads_Omp(CeedOperator op, const CeedInt *esize,
+                                        const CeedInt *qsize) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  CeedOperator_Omp *impl;
+  ierr = CeedOperatorGetData(op, (void*)&impl); CeedChk(ierr);
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  CeedOperatorField *opinputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, NULL); CeedChk(ierr);
+  CeedQFunctionField *qfinputfields;
+  ierr = CeedQFunctionGetFields(qf, &qfinputfields, NULL); CeedChk(ierr);
+  const CeedInt nthreads = impl->nthreads, numin = impl->numein,
+                numout = impl->numeout;
+  CeedEvalMode emode;
+  CeedBasis basis;
+
+  CeedInt worksize = 0;
+  for (CeedInt i=0; i<numin+numout; i++)
+    worksize += (i < numin ? esize[i] : 0) + qsize[i];
+
+  ierr = CeedCalloc(nthreads, &impl->work); CeedChk(ierr);
+  ierr = CeedCalloc(nthreads*numin, &impl->edatain); CeedChk(ierr);
+  ierr = CeedCalloc(nthreads*16, &impl->qdatain); CeedChk(ierr);
+  ierr = CeedCalloc(nthreads*16, &impl->qdataout); CeedChk(ierr);
+  ierr = CeedCalloc(nthreads*numin, &impl->evecsin); CeedChk(ierr);
+  ierr = CeedCalloc(nthreads*numin, &impl->qvecsin); CeedChk(ierr);
+  ierr = CeedCalloc(nthreads*numout, &impl->qvecsout); CeedChk(ierr);
+  ierr = CeedCalloc(nthreads, &impl->tempvec); CeedChk(ierr);
+
+  for (CeedInt t=0; t<nthreads; t++) {
+    ierr = CeedMalloc(worksize, &impl->work[t]); CeedChk(ierr);
+    CeedScalar *w = impl->work[t];
+    // Inputs
+    for (CeedInt i=0; i<numin; i++) {
+      const CeedInt ti = t*numin + i;
+      if (esize[i]) {
+        impl->edatain[ti] = w;
+        ierr = CeedVectorCreate(ceed, esize[i], &impl->evecsin[ti]);
+        CeedChk(ierr);
+        ierr = CeedVectorSetArray(impl->evecsin[ti], CEED_MEM_HOST,
+                                  CEED_USE_POINTER, w); CeedChk(ierr);
+        w += esize[i];
+      }
+      impl->qdatain[t*16 + i] = w;
+      ierr = CeedVectorCreate(ceed, qsize[i], &impl->qvecsin[ti]);
+      CeedChk(ierr);
+      ierr = CeedVectorSetArray(impl->qvecsin[ti], CEED_MEM_HOST,
+                                CEED_USE_POINTER, w); CeedChk(ierr);
+      w += qsize[i];
+      // Quadrature weights are computed once per thread
+      ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
+      CeedChk(ierr);
+      if (emode == CEED_EVAL_WEIGHT) {
+        ierr = CeedOperatorFieldGetBasis(opinputfields[i], &basis);
+        CeedChk(ierr);
+        ierr = CeedBasisApply(basis, impl->blksize, CEED_NOTRANSPOSE,
+                              CEED_EVAL_WEIGHT, NULL, impl->qvecsin[ti]);
+        CeedChk(ierr);
+      }
+    }
+    // Outputs
+    for (CeedInt i=0; i<numout; i++) {
+      const CeedInt ti = t*numout + i;
+      impl->qdataout[t*16 + i] = w;
+      ierr = CeedVectorCreate(ceed, qsize[numin+i], &impl->qvecsout[ti]);
+      CeedChk(ierr);
+      ierr = CeedVectorSetArray(impl->qvecsout[ti], CEED_MEM_HOST,
+                                CEED_USE_POINTER, w); CeedChk(ierr);
+      w += qsize[numin+i];
+    }
+    ierr = CeedVectorCreate(ceed, 0, &impl->tempvec[t]); CeedChk(ierr);
+  }
+  return 0;
+}
+
+/*
+  CeedOperator needs to connect all the named fields (be they active or passive)
+  to the named inputs and outputs of its CeedQFunction.
+ */
+static int CeedOperatorSetup_Omp(CeedOperator op) {
+  int ierr;
+  bool setupdone;
+  ierr = CeedOperatorGetSetupStatus(op, &setupdone); CeedChk(ierr);
+  if (setupdone) return 0;
+  CeedOperator_Omp *impl;
+  ierr = CeedOperatorGetData(op, (void*)&impl); CeedChk(ierr);
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  CeedInt Q, numinputfields, numoutputfields;
+  ierr = CeedOperatorGetNumQuadraturePoints(op, &Q); CeedChk(ierr);
+  ierr= CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
+  CeedChk(ierr);
+
+  // Allocate
+  ierr = CeedCalloc(numinputfields + numoutputfields, &impl->blkrestr);
+  CeedChk(ierr);
+  ierr = CeedCalloc(numoutputfields, &impl->evecsout); CeedChk(ierr);
+  ierr = CeedCalloc(numoutputfields, &impl->edataout); CeedChk(ierr);
+  ierr = CeedCalloc(numoutputfields, &impl->toffsets); CeedChk(ierr);
+  ierr = CeedCalloc(numoutputfields, &impl->tindices); CeedChk(ierr);
+  ierr = CeedCalloc(numoutputfields, &impl->seltr); CeedChk(ierr);
+  ierr = CeedCalloc(numinputfields, &impl->ldatain); CeedChk(ierr);
+
+  impl->numein = numinputfields; impl->numeout = numoutputfields;
+
+  // Block size chosen by the blocked delegate
+  Ceed ceed, ceedblocked;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  ierr = CeedGetDelegate(ceed, &ceedblocked); CeedChk(ierr);
+  ierr = CeedOperatorGetBlockSize_Blocked(ceedblocked, op, &impl->blksize);
+  CeedChk(ierr);
+#ifdef _OPENMP
+  impl->nthreads = omp_get_max_threads();
+#else
+  impl->nthreads = 1;
+#endif
+
+  // Set up infield and outfield pointer arrays
+  CeedInt esize[numinputfields + numoutputfields],
+          qsize[numinputfields + numoutputfields];
+  // Infields
+  ierr = CeedOperatorSetupFields_Omp(qf, op, 0, 0, numinputfields, Q,
+                                     esize, qsize); CeedChk(ierr);
+  // Outfields
+  ierr = CeedOperatorSetupFields_Omp(qf, op, 1, numinputfields,
+                                     numoutputfields, Q, esize + numinputfields,
+                                     qsize + numinputfields); CeedChk(ierr);
+
+  // Per-thread workspace
+  ierr = CeedOperatorSetupThreads_Omp(op, esize, qsize); CeedChk(ierr);
+
+  ierr = CeedOperatorSetSetupDone(op); CeedChk(ierr);
+
+  return 0;
+}
+
+/*
+  Apply the operator to a single block of elements, or to the nsel elements
+  elems packed into block blk if elems is not NULL, using the workspace of
+  thread tid.  Inputs are read from the L-vectors, outputs are written to the
+  block's (disjoint) slice of the output E-vectors.
+ */
+static int CeedOperatorApplyBlock_Omp(CeedOperator op, CeedInt tid,
+                                      CeedInt blk, CeedInt nsel,
+                                      const CeedInt *elems) {
+  int ierr;
+  CeedOperator_Omp *impl;
+  ierr = CeedOperatorGetData(op, (void*)&impl); CeedChk(ierr);
+  const CeedInt blksize = impl->blksize, numin = impl->numein,
+                numout = impl->numeout;
+  CeedInt Q, elemsize, ncomp;
+  ierr = CeedOperatorGetNumQuadraturePoints(op, &Q); CeedChk(ierr);
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  CeedOperatorField *opinputfields, *opoutputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, &opoutputfields);
+  CeedChk(ierr);
+  CeedQFunctionField *qfinputfields, *qfoutputfields;
+  ierr = CeedQFunctionGetFields(qf, &qfinputfields, &qfoutputfields);
+  CeedChk(ierr);
+  CeedTransposeMode lmode;
+  CeedEvalMode emode;
+  CeedBasis basis;
+
+  // Input restriction and basis apply
+  for (CeedInt i=0; i<numin; i++) {
+    ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
+    CeedChk(ierr);
+    if (emode == CEED_EVAL_WEIGHT)
+      continue;
+    ierr = CeedOperatorFieldGetLMode(opinputfields[i], &lmode); CeedChk(ierr);
+    // Restrict
+    CeedScalar *vv = emode == CEED_EVAL_NONE ? impl->qdatain[tid*16 + i]
+                     : impl->edatain[tid*numin + i];
+    if (elems) {
+      ierr = CeedElemRestrictionApplyElements_Ref(impl->blkrestr[i], nsel,
+             elems, CEED_NOTRANSPOSE, lmode, impl->ldatain[i], vv);
+      CeedChk(ierr);
+    } else {
+      ierr = CeedElemRestrictionApplyRange_Ref(impl->blkrestr[i], blk*blksize,
+             (blk+1)*blksize, CEED_NOTRANSPOSE, lmode, impl->ldatain[i], vv);
+      CeedChk(ierr);
+    }
+    // Basis action
+    if (emode & (CEED_EVAL_INTERP|CEED_EVAL_GRAD)) {
+      ierr = CeedOperatorFieldGetBasis(opinputfields[i], &basis); CeedChk(ierr);
+      ierr = CeedBasisApply(basis, blksize, CEED_NOTRANSPOSE, emode,
+                            impl->evecsin[tid*numin + i],
+                            impl->qvecsin[tid*numin + i]); CeedChk(ierr);
+    }
+  }
+
+  // Output pointers
+  for (CeedInt i=0; i<numout; i++) {
+    ierr = CeedQFunctionFieldGetEvalMode(qfoutputfields[i], &emode);
+    CeedChk(ierr);
+    if (emode == CEED_EVAL_NONE) {
+      ierr = CeedQFunctionFieldGetNumComponents(qfoutputfields[i], &ncomp);
+      CeedChk(ierr);
+      impl->qdataout[tid*16 + i] = &impl->edataout[i][blk*blksize*Q*ncomp];
+    }
+  }
+
+  // Q function, called directly so that threads do not share the
+  //   QFunction backend data
+  void *ctx;
+  ierr = CeedQFunctionGetContext(qf, &ctx); CeedChk(ierr);
+  int (*f)() = NULL;
+  ierr = CeedQFunctionGetUserFunction(qf, (int (**)())&f); CeedChk(ierr);
+  ierr = f(ctx, Q*blksize, (const CeedScalar *const *)&impl->qdatain[tid*16],
+           &impl->qdataout[tid*16]); CeedChk(ierr);
+
+  // Output basis apply if needed
+  for (CeedInt i=0; i<numout; i++) {
+    ierr = CeedQFunctionFieldGetEvalMode(qfoutputfields[i], &emode);
+    CeedChk(ierr);
+    if (emode & (CEED_EVAL_INTERP|CEED_EVAL_GRAD)) {
+      ierr = CeedElemRestrictionGetElementSize(impl->blkrestr[numin+i],
+             &elemsize); CeedChk(ierr);
+      ierr = CeedElemRestrictionGetNumComponents(impl->blkrestr[numin+i],
+             &ncomp); CeedChk(ierr);
+      ierr = CeedOperatorFieldGetBasis(opoutputfields[i], &basis);
+      CeedChk(ierr);
+      ierr = CeedVectorSetArray(impl->tempvec[tid], CEED_MEM_HOST,
+                                CEED_USE_POINTER,
+                                &impl->edataout[i][blk*blksize*elemsize*ncomp]);
+      CeedChk(ierr);
+      ierr = CeedBasisApply(basis, blksize, CEED_TRANSPOSE, emode,
+                            impl->qvecsout[tid*numout + i],
+                            impl->tempvec[tid]); CeedChk(ierr);
+    }
+  }
+  return 0;
+}
+
+/*
+  Transpose restriction of an output E-vector, computed by gathering over the
+  L-vector dofs so that each entry of the output is written by one thread
+ */
+static int CeedOperatorRestrictTranspose_Omp(CeedOperator op, CeedInt i,
+    CeedTransposeMode lmode, bool add, CeedVector vec) {
+  int ierr;
+  CeedOperator_Omp *impl;
+  ierr = CeedOperatorGetData(op, (void*)&impl); CeedChk(ierr);
+  CeedElemRestriction r = impl->blkrestr[impl->numein+i];
+  CeedInt nelem, elemsize, ndof, ncomp;
+  ierr = CeedElemRestrictionGetNumElements(r, &nelem); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumDoF(r, &ndof); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumComponents(r, &ncomp); CeedChk(ierr);
+  const CeedInt blksize = impl->blksize;
+  const CeedInt *toffsets = impl->toffsets[i], *tindices = impl->tindices[i];
+  const CeedScalar *uu = impl->edataout[i];
+  CeedScalar *vv;
+
+  CeedInt *cartesian;
+  ierr = CeedElemRestrictionGetCartesian(r, &cartesian); CeedChk(ierr);
+
+  ierr = CeedVectorGetArray(vec, CEED_MEM_HOST, &vv); CeedChk(ierr);
+  if (cartesian) {
+    // Cartesian restriction, the elements sharing each dof are those whose
+    // first node in every direction is at or just one element before it
+    const CeedInt dim = cartesian[0], P = cartesian[1];
+    CeedInt es[3];
+    CeedCartesianNodeStrides_Ref(cartesian, es);
+    #pragma omp parallel for num_threads(impl->nthreads) schedule(static)
+    for (CeedInt n=0; n<ndof; n++) {
+      CeedInt el[3][2], nd[3][2], ne[3];
+      for (CeedInt d=0, rem=n; d<3; d++) {
+        const CeedInt nd1 = d < dim ? cartesian[2+d]*(P-1) + 1 : 1,
+                      c = rem%nd1;
+        rem /= nd1;
+        el[d][0] = d < dim ? CeedIntMin(c/(P-1), cartesian[2+d]-1) : 0;
+        nd[d][0] = c - el[d][0]*(P-1);
+        ne[d] = 1;
+        if (nd[d][0] == 0 && el[d][0] > 0) {
+          el[d][1] = el[d][0]-1;
+          nd[d][1] = P-1;
+          ne[d] = 2;
+        }
+      }
+      for (CeedInt d=0; d<ncomp; d++) {
+        const CeedInt ind = lmode == CEED_NOTRANSPOSE ? n+ndof*d : d+ncomp*n;
+        CeedScalar vsum = add ? vv[ind] : 0.0;
+        for (CeedInt a=0; a<ne[0]; a++)
+          for (CeedInt b=0; b<ne[1]; b++)
+            for (CeedInt c=0; c<ne[2]; c++) {
+              const CeedInt e = el[0][a] + cartesian[2]*(el[1][b]
+                                + cartesian[3]*el[2][c]),
+                            k = nd[0][a]*es[0] + nd[1][b]*es[1]
+                                + nd[2][c]*es[2];
+              vsum += uu[(e/blksize)*blksize*elemsize*ncomp
+                         + (d*elemsize+k)*blksize + e%blksize];
+            }
+        vv[ind] = vsum;
+      }
+    }
+  } else if (!tindices) {
+    // Strided restriction, in parallel over the elements if no two of their
+    // nodes share an entry of the L-vector
+    CeedInt *strides;
+    ierr = CeedElemRestrictionGetStrides(r, &strides); CeedChk(ierr);
+    const bool disjoint = CeedStridesDisjoint_Omp(elemsize, ncomp, nelem,
+                          strides);
+    if (!add) {
+      #pragma omp parallel for num_threads(impl->nthreads) schedule(static)
+      for (CeedInt n=0; n<ndof*ncomp; n++)
+        vv[n] = 0.0;
+    }
+    #pragma omp parallel for num_threads(impl->nthreads) schedule(static) \
+            if(disjoint)
+    for (CeedInt e=0; e<nelem; e++) {
+      CeedScalar *ve = vv + e*strides[2];
+      const CeedScalar *ue = uu + (e/blksize)*blksize*elemsize*ncomp
+                             + e%blksize;
+      for (CeedInt d=0; d<ncomp; d++)
+        for (CeedInt k=0; k<elemsize; k++)
+          ve[k*strides[0] + d*strides[1]] += ue[(d*elemsize+k)*blksize];
+    }
+  } else {
+    #pragma omp parallel for num_threads(impl->nthreads) schedule(static)
+    for (CeedInt n=0; n<ndof; n++)
+      for (CeedInt d=0; d<ncomp; d++) {
+        const CeedInt ind = lmode == CEED_NOTRANSPOSE ? n+ndof*d : d+ncomp*n;
+        CeedScalar vsum = add ? vv[ind] : 0.0;
+        for (CeedInt j=toffsets[n]; j<toffsets[n+1]; j++)
+          vsum += uu[tindices[j] + d*elemsize*blksize];
+        vv[ind] = vsum;
+      }
+  }
+  ierr = CeedVectorRestoreArray(vec, &vv); CeedChk(ierr);
+  return 0;
+}
+
+/*
+  Add the output E-vector of output field i, holding the nsel elements sel
+  packed into blocks, to vec.  The transpose of the restriction to these
+  elements lists the distinct nodes they reference, which the threads add to
+  independently; it is kept for as long as the same elements are selected.
+ */
+static int CeedOperatorRestrictSelected_Omp(CeedOperator op, CeedInt i,
+    CeedInt nsel, const CeedInt *sel, CeedTransposeMode lmode,
+    CeedVector vec) {
+  int ierr;
+  CeedOperator_Omp *impl;
+  ierr = CeedOperatorGetData(op, (void*)&impl); CeedChk(ierr);
+  CeedElemRestriction r = impl->blkrestr[impl->numein+i];
+  CeedInt elemsize, ncomp;
+  ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumComponents(r, &ncomp); CeedChk(ierr);
+  const CeedInt blksize = impl->blksize;
+  CeedElemTranspose_Ref *t = &impl->seltr[i];
+  if (!t->toffsets) {
+    ierr = CeedElemRestrictionBuildElementsTranspose_Ref(r, nsel, sel, lmode,
+           t); CeedChk(ierr);
+  }
+  const CeedInt *lnodes = t->lnodes, *toffsets = t->toffsets,
+                 *tindices = t->tindices, dstride = t->dstride;
+  const CeedScalar *uu = impl->edataout[i];
+  CeedScalar *vv;
+
+  ierr = CeedVectorGetArray(vec, CEED_MEM_HOST, &vv); CeedChk(ierr);
+  #pragma omp parallel for num_threads(impl->nthreads) schedule(static)
+  for (CeedInt n=0; n<t->nnodes; n++)
+    for (CeedInt d=0; d<ncomp; d++) {
+      CeedScalar vsum = 0.0;
+      for (CeedInt j=toffsets[n]; j<toffsets[n+1]; j++)
+        vsum += uu[tindices[j] + d*elemsize*blksize];
+      vv[lnodes[n] + d*dstride] += vsum;
+    }
+  ierr = CeedVectorRestoreArray(vec, &vv); CeedChk(ierr);
+  return 0;
+}
+
+/*
+  Apply the operator to all elements, overwriting the output L-vectors, or
+  with sel, from CeedOperatorSelectElements_Ref(), to the nsel selected
+  elements, packed into blocks, adding to them.  Only the nodes of the
+  selected elements are then scattered.
+ */
+static int CeedOperatorApplySelected_Omp(CeedOperator op, CeedInt nsel,
+    const CeedInt *sel, CeedVector invec, CeedVector outvec,
+    CeedRequest *request) {
+  int ierr;
+  CeedOperator_Omp *impl;
+  ierr = CeedOperatorGetData(op, (void*)&impl); CeedChk(ierr);
+  CeedInt numinputfields, numoutputfields, numelements;
+  ierr = CeedOperatorGetNumElements(op, &numelements); CeedChk(ierr);
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  ierr= CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
+  CeedChk(ierr);
+  CeedTransposeMode lmode;
+  CeedOperatorField *opinputfields, *opoutputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, &opoutputfields);
+  CeedChk(ierr);
+  CeedQFunctionField *qfinputfields;
+  ierr = CeedQFunctionGetFields(qf, &qfinputfields, NULL);
+  CeedChk(ierr);
+  CeedEvalMode emode;
+  CeedVector vec;
+
+  // Setup
+  ierr = CeedOperatorSetup_Omp(op); CeedChk(ierr);
+  const CeedInt blksize = impl->blksize;
+  const CeedInt nblks = (numelements/blksize) + !!(numelements%blksize),
+                nselblks = (nsel/blksize) + !!(nsel%blksize);
+
+  // Input L-vectors
+  for (CeedInt i=0; i<numinputfields; i++) {
+    ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
+    CeedChk(ierr);
+    if (emode == CEED_EVAL_WEIGHT) { // Skip
+    } else {
+      ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+      if (vec == CEED_VECTOR_ACTIVE)
+        vec = invec;
+      ierr = CeedVectorGetArrayRead(vec, CEED_MEM_HOST, &impl->ldatain[i]);
+      CeedChk(ierr);
+    }
+  }
+
+  // Output Evecs
+  for (CeedInt i=0; i<numoutputfields; i++) {
+    ierr = CeedVectorGetArray(impl->evecsout[i], CEED_MEM_HOST,
+                              &impl->edataout[i]); CeedChk(ierr);
+  }
+
+  // Loop through element blocks, each thread owning its workspace
+  int blkierr = 0;
+  #pragma omp parallel num_threads(impl->nthreads)
+  {
+#ifdef _OPENMP
+    const CeedInt tid = omp_get_thread_num();
+#else
+    const CeedInt tid = 0;
+#endif
+    #pragma omp for schedule(static)
+    for (CeedInt b=0; b<(sel ? nselblks : nblks); b++) {
+      int berr = CeedOperatorApplyBlock_Omp(op, tid, b,
+                                            CeedIntMin(blksize, nsel-b*blksize),
+                                            sel ? &sel[b*blksize] : NULL);
+      if (berr) {
+        #pragma omp critical
+        blkierr = berr;
+      }
+    }
+  }
+  CeedChk(blkierr);
+
+  // Restore input arrays
+  for (CeedInt i=0; i<numinputfields; i++) {
+    ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
+    CeedChk(ierr);
+    if (emode == CEED_EVAL_WEIGHT) { // Skip
+    } else {
+      ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
+      if (vec == CEED_VECTOR_ACTIVE)
+        vec = invec;
+      ierr = CeedVectorRestoreArrayRead(vec, &impl->ldatain[i]); CeedChk(ierr);
+    }
+  }
+
+  // Transposes of the output restrictions are rebuilt for a new selection
+  if (sel && (nsel != impl->nselt ||
+              memcmp(sel, impl->selt, nsel*sizeof(sel[0])))) {
+    for (CeedInt i=0; i<numoutputfields; i++) {
+      ierr = CeedElemTransposeDestroy_Ref(&impl->seltr[i]); CeedChk(ierr);
+    }
+    ierr = CeedFree(&impl->selt); CeedChk(ierr);
+    ierr = CeedMalloc(nsel, &impl->selt); CeedChk(ierr);
+    memcpy(impl->selt, sel, nsel*sizeof(sel[0]));
+    impl->nselt = nsel;
+  }
+
+  // Output restriction, overwriting the output L-vectors unless adding the
+  //   contribution of selected elements
+  for (CeedInt i=0; i<numoutputfields; i++) {
+    // Get output vector
+    ierr = CeedOperatorFieldGetVector(opoutputfields[i], &vec); CeedChk(ierr);
+    // Active
+    if (vec == CEED_VECTOR_ACTIVE)
+      vec = outvec;
+    // Accumulate if an earlier output field shares this vector
+    bool add = !!sel;
+    for (CeedInt j=0; j<i; j++) {
+      CeedVector prev;
+      ierr = CeedOperatorFieldGetVector(opoutputfields[j], &prev);
+      CeedChk(ierr);
+      if (prev == CEED_VECTOR_ACTIVE)
+        prev = outvec;
+      add = add || prev == vec;
+    }
+    // Restrict
+    ierr = CeedOperatorFieldGetLMode(opoutputfields[i], &lmode); CeedChk(ierr);
+    if (sel) {
+      ierr = CeedOperatorRestrictSelected_Omp(op, i, nsel, sel, lmode, vec);
+      CeedChk(ierr);
+    } else {
+      ierr = CeedOperatorRestrictTranspose_Omp(op, i, lmode, add, vec);
+      CeedChk(ierr);
+    }
+    // Restore evec
+    ierr = CeedVectorRestoreArray(impl->evecsout[i], &impl->edataout[i]);
+    CeedChk(ierr);
+  }
+
+  if (request != CEED_REQUEST_IMMEDIATE && request != CEED_REQUEST_ORDERED)
+    *request = NULL;
+  return 0;
+}
+
+static int CeedOperatorApply_Omp(CeedOperator op, CeedVector invec,
+                                 CeedVector outvec, CeedRequest *request) {
+  return CeedOperatorApplySelected_Omp(op, 0, NULL, invec, outvec, request);
+}
+
+static int CeedOperatorApplyElements_Omp(CeedOperator op, CeedInt start,
+    CeedInt nelem, const CeedInt *elems, CeedVector invec, CeedVector outvec,
+    CeedRequest *request) {
+  int ierr;
+
+  // Setup
+  ierr = CeedOperatorSetup_Omp(op); CeedChk(ierr);
+
+  // Apply the selected elements, packed into blocks, adding to the outputs
+  CeedInt nsel, *sel;
+  ierr = CeedOperatorSelectElements_Ref(start, nelem, elems, &nsel, &sel);
+  CeedChk(ierr);
+  ierr = CeedOperatorApplySelected_Omp(op, nsel, sel, invec, outvec, request);
+  CeedChk(ierr);
+  ierr = CeedFree(&sel); CeedChk(ierr);
+  return 0;
+}
+
+int CeedOperatorCreate_Omp(CeedOperator op) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
+  CeedOperator_Omp *impl;
+
+  ierr = CeedCalloc(1, &impl); CeedChk(ierr);
+  ierr = CeedOperatorSetData(op, (void*)&impl); CeedChk(ierr);
+
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "Apply",
+                                CeedOperatorApply_Omp); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "ApplyElements",
+                                CeedOperatorApplyElements_Omp); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "Destroy",
+                                CeedOperatorDestroy_Omp); CeedChk(ierr);
+  return 0;
+}
@@ -0,0 +1,93 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <string.h>
+#include "ceed-omp.h"
+
+// The transpose of a restriction with indices gathers the element nodes of
+//   each L-vector node in parallel, adding to v or overwriting it; every other
+//   case is applied by the ref backend
+static int CeedElemRestrictionApplyAll_Omp(CeedElemRestriction r,
+    CeedTransposeMode tmode, CeedTransposeMode lmode, bool overwrite,
+    CeedVector u, CeedVector v, CeedRequest *request) {
+  int ierr;
+  const CeedInt *toffsets = NULL, *tindices = NULL;
+  if (tmode == CEED_TRANSPOSE) {
+    ierr = CeedElemRestrictionGetTranspose_Ref(r, &toffsets, &tindices);
+    CeedChk(ierr);
+  }
+  if (!tindices && overwrite)
+    return CeedElemRestrictionApplyOverwrite_Ref(r, tmode, lmode, u, v,
+           request);
+  if (!tindices)
+    return CeedElemRestrictionApply_Ref(r, tmode, lmode, u, v, request);
+
+  CeedInt elemsize, ndof, ncomp, blksize;
+  ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumDoF(r, &ndof); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumComponents(r, &ncomp); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetBlockSize(r, &blksize); CeedChk(ierr);
+  const CeedScalar *uu;
+  CeedScalar *vv;
+  ierr = CeedVectorGetArrayRead(u, CEED_MEM_HOST, &uu); CeedChk(ierr);
+  ierr = CeedVectorGetArray(v, CEED_MEM_HOST, &vv); CeedChk(ierr);
+  #pragma omp parallel for schedule(static)
+  for (CeedInt n=0; n<ndof; n++)
+    for (CeedInt d=0; d<ncomp; d++) {
+      const CeedScalar *ud = uu + d*elemsize*blksize;
+      CeedScalar *vn = vv + (lmode == CEED_NOTRANSPOSE ? n+ndof*d : d+ncomp*n);
+      CeedScalar vsum = overwrite ? 0.0 : *vn;
+      for (CeedInt j=toffsets[n]; j<toffsets[n+1]; j++)
+        vsum += ud[tindices[j]];
+      *vn = vsum;
+    }
+  ierr = CeedVectorRestoreArrayRead(u, &uu); CeedChk(ierr);
+  ierr = CeedVectorRestoreArray(v, &vv); CeedChk(ierr);
+  if (request != CEED_REQUEST_IMMEDIATE && request != CEED_REQUEST_ORDERED)
+    *request = NULL;
+  return 0;
+}
+
+static int CeedElemRestrictionApply_Omp(CeedElemRestriction r,
+                                        CeedTransposeMode tmode,
+                                        CeedTransposeMode lmode, CeedVector u,
+                                        CeedVector v, CeedRequest *request) {
+  return CeedElemRestrictionApplyAll_Omp(r, tmode, lmode, false, u, v,
+                                         request);
+}
+
+static int CeedElemRestrictionApplyOverwrite_Omp(CeedElemRestriction r,
+    CeedTransposeMode tmode, CeedTransposeMode lmode, CeedVector u,
+    CeedVector v, CeedRequest *request) {
+  return CeedElemRestrictionApplyAll_Omp(r, tmode, lmode, true, u, v,
+                                         request);
+}
+
+int CeedElemRestrictionCreate_Omp(CeedMemType mtype, CeedCopyMode cmode,
+                                  const CeedInt *indices,
+                                  CeedElemRestriction r) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedElemRestrictionGetCeed(r, &ceed); CeedChk(ierr);
+  ierr = CeedElemRestrictionCreate_Ref(mtype, cmode, indices, r);
+  CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "ElemRestriction", r, "Apply",
+                                CeedElemRestrictionApply_Omp); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "ElemRestriction", r, "ApplyOverwrite",
+                                CeedElemRestrictionApplyOverwrite_Omp);
+  CeedChk(ierr);
+  return 0;
+}
@@ -0,0 +1,53 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <stdio.h>
+#include <string.h>
+#include "ceed-omp.h"
+
+static int CeedInit_Omp(const char *resource, Ceed ceed) {
+  int ierr;
+  const size_t nrc = strcspn(resource, "?"); // length without options
+  char base[CEED_MAX_RESOURCE_LEN];
+  snprintf(base, sizeof base, "%.*s", (int)nrc, resource);
+  if (strcmp(base, "/cpu/self")
+      && strcmp(base, "/cpu/self/omp"))
+    return CeedError(ceed, 1, "OpenMP backend cannot use resource: %s", resource);
+
+  Ceed ceedblocked;
+
+  // Create blocked CEED that implementation will be dispatched
+  //   through unless overridden, with the options of the resource
+  char blocked[CEED_MAX_RESOURCE_LEN];
+  snprintf(blocked, sizeof blocked, "/cpu/self/blocked%s", resource + nrc);
+  ierr = CeedInit(blocked, &ceedblocked); CeedChk(ierr);
+  ierr = CeedSetDelegate(ceed, &ceedblocked); CeedChk(ierr);
+
+  ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "ElemRestrictionCreate",
+                                CeedElemRestrictionCreate_Omp); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Ceed", ceed,
+                                "ElemRestrictionCreateBlocked",
+                                CeedElemRestrictionCreate_Omp); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "OperatorCreate",
+                                CeedOperatorCreate_Omp); CeedChk(ierr);
+
+  return 0;
+}
+
+__attribute__((constructor))
+static void Register(void) {
+  CeedRegister("/cpu/self/omp", CeedInit_Omp, 15);
+}
@@ -0,0 +1,53 @@
+// Copyright (c) 2017-2018, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory. LLNL-CODE-734707.
+// All Rights reserved. See files LICENSE and NOTICE for details.
+//
+// This file is part of CEED, a collection of benchmarks, miniapps, software
+// libraries and APIs for efficient high-order finite element and spectral
+// element discretizations for exascale applications. For more information and
+// source code availability see http://github.com/ceed.
+//
+// The CEED research is supported by the Exascale Computing Project 17-SC-20-SC,
+// a collaborative effort of two U.S. Department of Energy organizations (Office
+// of Science and the National Nuclear Security Administration) responsible for
+// the planning and preparation of a capable exascale ecosystem, including
+// software, applications, hardware, advanced system engineering and early
+// testbed platforms, in support of the nation's exascale computing imperative.
+
+#include <ceed-backend.h>
+#include <string.h>
+#include "../blocked/ceed-blocked.h"
+#ifdef _OPENMP
+#  include <omp.h>
+#endif
+
+typedef struct {
+  CeedElemRestriction *blkrestr; /// Blocked versions of restrictions
+  const CeedInt **toffsets;   /// Transpose offsets of the output restrictions
+  const CeedInt **tindices;   /// Transpose E-vector indices, owned by the
+                              ///   restrictions
+  CeedInt nselt;   /// Number of elements of the selection seltr is built for
+  CeedInt *selt;   /// Selected elements seltr is built for
+  CeedElemTranspose_Ref *seltr;   /// [numeout] transposes of the output
+                                  ///   restrictions to the selection
+  CeedVector *evecsout;   /// Output E-vectors, shared by all threads
+  CeedScalar **edataout;
+  const CeedScalar **ldatain;   /// Input L-vector arrays
+  CeedInt    numein;
+  CeedInt    numeout;
+  CeedInt    blksize;
+  CeedInt    nthreads;
+  CeedScalar **work;   /// Per-thread E-vector and Q-vector workspace
+  CeedScalar **edatain;   /// [nthreads][numein] input E-vector blocks
+  CeedScalar **qdatain;   /// [nthreads][16] QFunction input arrays
+  CeedScalar **qdataout;   /// [nthreads][16] QFunction output arrays
+  CeedVector *evecsin;   /// [nthreads][numein] wrappers for edatain
+  CeedVector *qvecsin;   /// [nthreads][numein] wrappers for qdatain
+  CeedVector *qvecsout;   /// [nthreads][numeout] wrappers for qdataout
+  CeedVector *tempvec;   /// [nthreads] wrappers for output E-vector blocks
+} CeedOperator_Omp;
+
+CEED_INTERN int CeedElemRestrictionCreate_Omp(CeedMemType mtype,
+    CeedCopyMode cmode, const CeedInt *indices, CeedElemRestriction r);
+
+CEED_INTERN int CeedOperatorCreate_Omp(CeedOperator op);
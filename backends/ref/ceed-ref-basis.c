@@ -44,8 +44,627 @@ static int CeedTensorContract_Ref(Ceed ceed, CeedInt A, CeedInt B, CeedInt C, Ce
   return 0;
 }
 
-static int CeedBasisApply_Ref(CeedBasis basis, CeedInt nelem,
+// Even-odd V_ajc (+)= T_jb U_abc for the columns c0 <= c < C, with the folded
+// matrices E and O of a matrix T with T_(J-1-j)(B-1-b) = sym T_jb in the
+// transpose mode of the contraction, see CeedTensorMatrixCreate_Ref().  The
+// even and odd parts of each column of U are contracted with the half size
+// matrices and unfolded into V, halving the flops.
+void CeedTensorContractFolded_Ref(CeedInt A, CeedInt B, CeedInt C, CeedInt J,
+                                  CeedInt c0, const CeedScalar *restrict E,
+                                  const CeedScalar *restrict O, CeedInt sym,
+                                  const CeedInt Add,
+                                  const CeedScalar *restrict u,
+                                  CeedScalar *restrict v) {
+  const CeedInt hB = B/2, hJ = J/2, Be = B-hB, Je = J-hJ;
+  for (CeedInt a=0; a<A; a++)
+    for (CeedInt c=c0; c<C; c++) {
+      CeedScalar e[Be], o[hB];
+      for (CeedInt b=0; b<hB; b++) {
+        const CeedScalar ub = u[(a*B+b)*C+c], ur = u[(a*B+B-1-b)*C+c];
+        e[b] = ub + ur;
+        o[b] = ub - ur;
+      }
+      if (Be > hB)
+        e[hB] = u[(a*B+hB)*C+c];
+      for (CeedInt j=0; j<Je; j++) {
+        CeedScalar pe = 0.0, po = 0.0;
+        for (CeedInt b=0; b<Be; b++)
+          pe += E[j*Be+b] * e[b];
+        for (CeedInt b=0; b<hB; b++)
+          po += O[j*hB+b] * o[b];
+        CeedScalar *vj = &v[(a*J+j)*C+c], *vr = &v[(a*J+J-1-j)*C+c];
+        *vj = (Add ? *vj : 0.0) + pe + po;
+        if (j < hJ)
+          *vr = (Add ? *vr : 0.0) + sym*(pe - po);
+      }
+    }
+}
+
+// Contracts on the middle index as CeedTensorContract_Ref() with a matrix
+// from CeedTensorMatrixCreate_Ref(), by its even-odd decomposition if it has
+// folded matrices and as a plain contraction otherwise
+static int CeedTensorContractEvenOdd_Ref(Ceed ceed, CeedInt A, CeedInt B,
+                                         CeedInt C, CeedInt J,
+                                         const CeedTensorMatrix_Ref *t,
+                                         CeedTransposeMode tmode,
+                                         const CeedInt Add,
+                                         const CeedScalar *restrict u,
+                                         CeedScalar *restrict v) {
+  if (!t->E[tmode])
+    return CeedTensorContract_Ref(ceed, A, B, C, J, t->t, tmode, Add, u, v);
+  CeedTensorContractFolded_Ref(A, B, C, J, 0, t->E[tmode], t->O[tmode],
+                               t->sym, Add, u, v);
+  return 0;
+}
+
+// Sets up the J × B matrix t of a tensor basis for the even-odd contractions,
+// with T_(J-1-j)(B-1-b) = sym T_jb, sym = 1 for a centrosymmetric matrix and
+// -1 for a skew-centrosymmetric one.  The matrices E and O folding the even
+// and odd parts are formed once for each transpose mode, the middle row and
+// column kept when J or B is odd.  sym = 0, or a matrix too small for the
+// decomposition to pay off, is contracted as is.  t is not copied.
+int CeedTensorMatrixCreate_Ref(const CeedScalar *t, CeedInt J, CeedInt B,
+                               CeedInt sym, CeedTensorMatrix_Ref *m) {
+  int ierr;
+  m->t = t;
+  m->sym = sym;
+  m->E[0] = m->E[1] = m->O[0] = m->O[1] = NULL;
+  if (!sym || B < CEED_EVENODD_MIN || J < CEED_EVENODD_MIN)
+    return 0;
+
+  for (CeedInt tmode=0; tmode<2; tmode++) {
+    // Rows, columns and strides of T in this mode
+    const CeedInt Jm = tmode ? B : J, Bm = tmode ? J : B,
+                  tstride0 = tmode ? 1 : B, tstride1 = tmode ? B : 1,
+                  hB = Bm/2, hJ = Jm/2, Be = Bm-hB, Je = Jm-hJ;
+    CeedScalar *E, *O;
+    ierr = CeedMalloc(Je*Be, &E); CeedChk(ierr);
+    ierr = CeedMalloc(Je*hB, &O); CeedChk(ierr);
+    for (CeedInt j=0; j<Je; j++)
+      for (CeedInt b=0; b<Be; b++) {
+        const CeedScalar tjb = t[j*tstride0 + b*tstride1],
+                         tjr = t[j*tstride0 + (Bm-1-b)*tstride1];
+        if (j < hJ) {
+          E[j*Be+b] = b < hB ? (tjb + tjr)/2 : tjb;
+          if (b < hB) O[j*hB+b] = (tjb - tjr)/2;
+        } else { // Middle row acts on the even part if sym = 1, odd if -1
+          E[j*Be+b] = sym > 0 ? tjb : 0.0;
+          if (b < hB) O[j*hB+b] = sym < 0 ? tjb : 0.0;
+        }
+      }
+    m->E[tmode] = E;
+    m->O[tmode] = O;
+  }
+  return 0;
+}
+
+int CeedTensorMatrixDestroy_Ref(CeedTensorMatrix_Ref *m) {
+  int ierr;
+  for (CeedInt tmode=0; tmode<2; tmode++) {
+    ierr = CeedFree(&m->E[tmode]); CeedChk(ierr);
+    ierr = CeedFree(&m->O[tmode]); CeedChk(ierr);
+  }
+  return 0;
+}
+
+// Scalars in the fixed size scratch of the tensor contractions
+#define CEED_CONTRACT_STACK (CEED_CONTRACT_TILE_BYTES/sizeof(CeedScalar))
+
+// Scratch of n scalars for the tensor contractions, the buffer stack of
+// CEED_CONTRACT_STACK scalars if it is large enough and from the heap
+// otherwise, released with CeedContractScratchFree_Ref()
+static int CeedContractScratch_Ref(CeedInt n, CeedScalar *stack,
+                                   CeedScalar **tmp) {
+  int ierr;
+  *tmp = stack;
+  if ((size_t)n > CEED_CONTRACT_STACK) {
+    ierr = CeedMalloc(n, tmp); CeedChk(ierr);
+  }
+  return 0;
+}
+
+static int CeedContractScratchFree_Ref(const CeedScalar *stack,
+                                       CeedScalar **tmp) {
+  int ierr;
+  if (*tmp != stack) {
+    ierr = CeedFree(tmp); CeedChk(ierr);
+  }
+  *tmp = NULL;
+  return 0;
+}
+
+// Applies the tensor product of the 1D matrices t[d] to one component slab,
+// u has shape [P^dim, C] and v has shape [Q^dim, C], t[0] acting on the
+// innermost index.  The last dim-1 directions are applied to each slab of the
+// outermost index before contracting it, so that the intermediates are
+// P*Q^(dim-1)*C instead of growing with ncomp.  The intermediates of all
+// levels of the recursion are taken from the workspace w.
+static int CeedTensorContractSlab_Ref(Ceed ceed, CeedInt dim, CeedInt P,
+                                      CeedInt C, CeedInt Q,
+                                      const CeedTensorMatrix_Ref *const *t,
+                                      CeedTransposeMode tmode,
+                                      const CeedInt Add,
+                                      CeedTensorContractEvenOddFunction_Ref
+                                      contract,
+                                      const CeedScalar *restrict u,
+                                      CeedScalar *restrict v,
+                                      CeedScalar *restrict w) {
+  int ierr;
+  if (dim == 1)
+    return contract(ceed, 1, P, C, Q, t[0], tmode, Add, u, v);
+
+  const CeedInt slabin = CeedIntPow(P, dim-1)*C,
+                slabout = CeedIntPow(Q, dim-1)*C;
+  for (CeedInt z=0; z<P; z++) {
+    ierr = CeedTensorContractSlab_Ref(ceed, dim-1, P, C, Q, t, tmode, 0,
+                                      contract, u + z*slabin, w + z*slabout,
+                                      w + P*slabout); CeedChk(ierr);
+  }
+  ierr = contract(ceed, 1, P, slabout, Q, t[dim-1], tmode, Add, w, v);
+  CeedChk(ierr);
+  return 0;
+}
+
+// Applies the tensor product of the 1D matrices t[d], d=0,...,dim-1, from
+// CeedTensorMatrixCreate_Ref(), mapping u of shape [ncomp, P^dim, C] to v of
+// shape [ncomp, Q^dim, C], with the even-odd contraction kernel contract.
+// High order bases whose full size intermediates would not stay in cache are
+// processed slab by slab.
+// If Add != 0, "=" is replaced by "+="
+int CeedTensorContractChain_Ref(Ceed ceed, CeedInt dim, CeedInt ncomp,
+                                CeedInt P, CeedInt C, CeedInt Q,
+                                const CeedTensorMatrix_Ref *const *t,
+                                CeedTransposeMode tmode, const CeedInt Add,
+                                CeedTensorContractEvenOddFunction_Ref contract,
+                                const CeedScalar *restrict u,
+                                CeedScalar *restrict v) {
+  int ierr;
+  if (dim == 1)
+    return contract(ceed, ncomp, P, C, Q, t[0], tmode, Add, u, v);
+
+  const CeedInt tmpsize = ncomp*C*Q*CeedIntPow(P>Q?P:Q, dim-1);
+  CeedScalar stack[CEED_CONTRACT_STACK], *tmp;
+  if (tmpsize*sizeof(CeedScalar) > CEED_CONTRACT_TILE_BYTES) {
+    // Workspace for the slabs of every level of the recursion
+    CeedInt wsize = 0;
+    for (CeedInt d=1; d<dim; d++)
+      wsize += P*CeedIntPow(Q, d)*C;
+    ierr = CeedContractScratch_Ref(wsize, stack, &tmp); CeedChk(ierr);
+    for (CeedInt c=0; c<ncomp; c++) {
+      ierr = CeedTensorContractSlab_Ref(ceed, dim, P, C, Q, t, tmode, Add,
+                                        contract, u + c*CeedIntPow(P, dim)*C,
+                                        v + c*CeedIntPow(Q, dim)*C, tmp);
+      CeedChk(ierr);
+    }
+    ierr = CeedContractScratchFree_Ref(stack, &tmp); CeedChk(ierr);
+    return 0;
+  }
+
+  CeedInt pre = ncomp*CeedIntPow(P, dim-1), post = C;
+  ierr = CeedContractScratch_Ref(2*tmpsize, stack, &tmp); CeedChk(ierr);
+  CeedScalar *w[2] = {tmp, tmp + tmpsize};
+  for (CeedInt d=0; d<dim; d++) {
+    ierr = contract(ceed, pre, P, post, Q, t[d], tmode, Add&&(d==dim-1),
+                    d==0?u:w[d%2], d==dim-1?v:w[(d+1)%2]);
+    CeedChk(ierr);
+    pre /= P;
+    post *= Q;
+  }
+  ierr = CeedContractScratchFree_Ref(stack, &tmp); CeedChk(ierr);
+  return 0;
+}
+
+// Evaluates values and gradients of a tensor basis together, mapping u of
+// shape [ncomp, P^dim, C] to v of shape [1+dim, ncomp, Q^dim, C], values
+// first.  The derivative in direction d branches off the chain of
+// interpolations after d contractions, so that the contractions in the
+// first directions are shared.  The transpose accumulates the branches back
+// into the interpolation chain in the same order.
+// If Add != 0, "=" is replaced by "+="
+static int CeedTensorContractInterpGrad_Ref(Ceed ceed, CeedInt dim,
+    CeedInt ncomp, CeedInt P, CeedInt C, CeedInt Q,
+    const CeedTensorMatrix_Ref *interp1d, const CeedTensorMatrix_Ref *grad1d,
+    CeedTransposeMode tmode, const CeedInt Add,
+    CeedTensorContractEvenOddFunction_Ref contract,
+    const CeedScalar *restrict u, CeedScalar *restrict v) {
+  int ierr;
+  const bool notrans = tmode == CEED_NOTRANSPOSE;
+  const CeedInt tmpsize = ncomp*C*Q*CeedIntPow(P>Q?P:Q, dim-1),
+                blk = ncomp*CeedIntPow(notrans ? Q : P, dim)*C;
+  const CeedTensorMatrix_Ref *t[dim];
+
+  if (dim == 1 || tmpsize*sizeof(CeedScalar) > CEED_CONTRACT_TILE_BYTES) {
+    // Separate chains, each processed slab by slab
+    for (CeedInt p=-1; p<dim; p++) {
+      for (CeedInt d=0; d<dim; d++)
+        t[d] = d == p ? grad1d : interp1d;
+      ierr = CeedTensorContractChain_Ref(ceed, dim, ncomp, P, C, Q, t, tmode,
+                                         notrans ? Add : Add || p >= 0,
+                                         contract, notrans ? u : u + (1+p)*blk,
+                                         notrans ? v + (1+p)*blk : v);
+      CeedChk(ierr);
+    }
+    return 0;
+  }
+
+  CeedScalar stack[CEED_CONTRACT_STACK], *tmp;
+  ierr = CeedContractScratch_Ref(4*tmpsize, stack, &tmp); CeedChk(ierr);
+  CeedScalar *w[2] = {tmp, tmp + tmpsize},
+             *g[2] = {tmp + 2*tmpsize, tmp + 3*tmpsize};
+  const CeedScalar *s = u;
+  CeedInt pre = ncomp*CeedIntPow(P, dim-1), post = C;
+  for (CeedInt d=0; d<dim; d++) {
+    const bool last = d == dim-1;
+    CeedScalar *out = last ? v : w[d%2];
+    if (notrans) {
+      // Derivative in direction d, then interpolation in the others
+      const CeedScalar *x = s;
+      for (CeedInt e=d, gpre=pre, gpost=post; e<dim; e++) {
+        CeedScalar *gout = e == dim-1 ? v + (1+d)*blk : g[(e-d)%2];
+        ierr = contract(ceed, gpre, P, gpost, Q, e == d ? grad1d : interp1d,
+                        tmode, Add && e == dim-1, x, gout); CeedChk(ierr);
+        x = gout;
+        gpre /= P;
+        gpost *= Q;
+      }
+      ierr = contract(ceed, pre, P, post, Q, interp1d, tmode, Add && last, s,
+                      out); CeedChk(ierr);
+    } else {
+      // Gradient in direction d interpolated in the previous directions
+      const CeedScalar *x = u + (1+d)*blk;
+      for (CeedInt e=0, gpre=ncomp*CeedIntPow(P, dim-1), gpost=C; e<d; e++) {
+        ierr = contract(ceed, gpre, P, gpost, Q, interp1d, tmode, 0, x,
+                        g[e%2]); CeedChk(ierr);
+        x = g[e%2];
+        gpre /= P;
+        gpost *= Q;
+      }
+      ierr = contract(ceed, pre, P, post, Q, interp1d, tmode, Add && last, s,
+                      out); CeedChk(ierr);
+      ierr = contract(ceed, pre, P, post, Q, grad1d, tmode, 1, x, out);
+      CeedChk(ierr);
+    }
+    s = out;
+    pre /= P;
+    post *= Q;
+  }
+  ierr = CeedContractScratchFree_Ref(stack, &tmp); CeedChk(ierr);
+  return 0;
+}
+
+// Evaluates gradients of a tensor basis by interpolating to the quadrature
+// points and applying the Q1d × Q1d collocated derivative colograd1d in each
+// direction, u of shape [ncomp, P1d^dim, C] and v of shape [dim, ncomp,
+// Q1d^dim, C] in CEED_NOTRANSPOSE mode.  If fused, the values are kept in
+// front of the gradients as for CEED_EVAL_INTERP|CEED_EVAL_GRAD.
+// If Add != 0, "=" is replaced by "+="
+static int CeedTensorContractColoGrad_Ref(Ceed ceed, CeedInt dim,
+    CeedInt ncomp, CeedInt P1d, CeedInt C, CeedInt Q1d,
+    const CeedTensorMatrix_Ref *interp1d,
+    const CeedTensorMatrix_Ref *colograd1d, CeedTransposeMode tmode,
+    bool fused, const CeedInt Add,
+    CeedTensorContractEvenOddFunction_Ref contract,
+    const CeedScalar *restrict u, CeedScalar *restrict v) {
+  int ierr;
+  const CeedInt qblk = ncomp*CeedIntPow(Q1d, dim)*C;
+  const CeedTensorMatrix_Ref *t[dim];
+  for (CeedInt d=0; d<dim; d++)
+    t[d] = interp1d;
+  CeedScalar stack[CEED_CONTRACT_STACK], *w = NULL;
+  if (!fused || tmode == CEED_TRANSPOSE) {
+    ierr = CeedContractScratch_Ref(qblk, stack, &w); CeedChk(ierr);
+  }
+
+  CeedInt pre = ncomp*CeedIntPow(Q1d, dim-1), post = C;
+  if (tmode == CEED_NOTRANSPOSE) {
+    CeedScalar *interp = fused ? v : w;
+    ierr = CeedTensorContractChain_Ref(ceed, dim, ncomp, P1d, C, Q1d, t,
+                                       tmode, Add && fused, contract, u,
+                                       interp); CeedChk(ierr);
+    for (CeedInt d=0; d<dim; d++) {
+      ierr = contract(ceed, pre, Q1d, post, Q1d, colograd1d, tmode, Add,
+                      interp, v + (fused+d)*qblk); CeedChk(ierr);
+      pre /= Q1d;
+      post *= Q1d;
+    }
+  } else {
+    if (fused)
+      memcpy(w, u, qblk*sizeof(w[0]));
+    for (CeedInt d=0; d<dim; d++) {
+      ierr = contract(ceed, pre, Q1d, post, Q1d, colograd1d, tmode,
+                      fused || d>0, u + (fused+d)*qblk, w); CeedChk(ierr);
+      pre /= Q1d;
+      post *= Q1d;
+    }
+    ierr = CeedTensorContractChain_Ref(ceed, dim, ncomp, Q1d, C, P1d, t,
+                                       tmode, Add, contract, w, v);
+    CeedChk(ierr);
+  }
+  ierr = CeedContractScratchFree_Ref(stack, &w); CeedChk(ierr);
+  return 0;
+}
+
+// Applies a tensor basis with the even-odd contraction kernel contract and
+// the 1D matrices set up in CeedBasisCreateTensorH1_Ref().  Gradients go
+// through the collocated derivative if there is one.  In CEED_TRANSPOSE mode,
+// v is added to.
+int CeedBasisApplyTensor_Ref(CeedBasis basis, CeedInt nelem,
+                             CeedTransposeMode tmode, CeedEvalMode emode,
+                             CeedTensorContractEvenOddFunction_Ref contract,
+                             const CeedScalar *u, CeedScalar *v) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedBasisGetCeed(basis, &ceed); CeedChk(ierr);
+  CeedInt dim, ncomp, nqpt, P1d, Q1d;
+  ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
+  ierr = CeedBasisGetNumComponents(basis, &ncomp); CeedChk(ierr);
+  ierr = CeedBasisGetNumQuadraturePoints(basis, &nqpt); CeedChk(ierr);
+  ierr = CeedBasisGetNumNodes1D(basis, &P1d); CeedChk(ierr);
+  ierr = CeedBasisGetNumQuadraturePoints1D(basis, &Q1d); CeedChk(ierr);
+  CeedBasis_Ref *impl;
+  ierr = CeedBasisGetData(basis, (void*)&impl); CeedChk(ierr);
+  const CeedInt add = (tmode == CEED_TRANSPOSE);
+  CeedInt P = P1d, Q = Q1d;
+  if (tmode == CEED_TRANSPOSE) {
+    P = Q1d; Q = P1d;
+  }
+
+  if (emode == (CEED_EVAL_INTERP|CEED_EVAL_GRAD)) {
+    // Values and gradients from one interpolation, or sharing the first
+    // contractions if Q1d < P1d
+    if (impl->colograd1d) {
+      ierr = CeedTensorContractColoGrad_Ref(ceed, dim, ncomp, P1d, nelem, Q1d,
+                                            &impl->interp, &impl->colograd,
+                                            tmode, true, add, contract, u, v);
+      CeedChk(ierr);
+    } else {
+      ierr = CeedTensorContractInterpGrad_Ref(ceed, dim, ncomp, P, nelem, Q,
+                                              &impl->interp, &impl->grad,
+                                              tmode, add, contract, u, v);
+      CeedChk(ierr);
+    }
+    return 0;
+  }
+
+  switch (emode) {
+  // Interpolate to/from quadrature points
+  case CEED_EVAL_INTERP: {
+    const CeedTensorMatrix_Ref *t[dim];
+    for (CeedInt d=0; d<dim; d++)
+      t[d] = &impl->interp;
+    ierr = CeedTensorContractChain_Ref(ceed, dim, ncomp, P, nelem, Q, t, tmode,
+                                       add, contract, u, v); CeedChk(ierr);
+  } break;
+  // Evaluate the gradient to/from quadrature points
+  case CEED_EVAL_GRAD: {
+    // In CEED_NOTRANSPOSE mode:
+    // u has shape [dim, ncomp, P^dim, nelem], row-major layout
+    // v has shape [dim, ncomp, Q^dim, nelem], row-major layout
+    // In CEED_TRANSPOSE mode, the sizes of u and v are switched.
+    if (impl->colograd1d) {
+      // Interpolate once, then differentiate at the quadrature points
+      ierr = CeedTensorContractColoGrad_Ref(ceed, dim, ncomp, P1d, nelem, Q1d,
+                                            &impl->interp, &impl->colograd,
+                                            tmode, false, add, contract, u, v);
+      CeedChk(ierr);
+      break;
+    }
+    for (CeedInt p = 0; p < dim; p++) {
+      const CeedTensorMatrix_Ref *t[dim];
+      for (CeedInt d=0; d<dim; d++)
+        t[d] = (p==d) ? &impl->grad : &impl->interp;
+      ierr = CeedTensorContractChain_Ref(ceed, dim, ncomp, P, nelem, Q, t,
+                                         tmode, add, contract,
+                                         tmode == CEED_NOTRANSPOSE
+                                         ? u : u+p*ncomp*nqpt*nelem,
+                                         tmode == CEED_TRANSPOSE
+                                         ? v : v+p*ncomp*nqpt*nelem);
+      CeedChk(ierr);
+    }
+  } break;
+  // Retrieve interpolation weights
+  case CEED_EVAL_WEIGHT: {
+    if (tmode == CEED_TRANSPOSE)
+      return CeedError(ceed, 1,
+                       "CEED_EVAL_WEIGHT incompatible with CEED_TRANSPOSE");
+    CeedInt Q = Q1d;
+    const CeedScalar *qweight1d;
+    ierr = CeedBasisGetQWeights(basis, &qweight1d); CeedChk(ierr);
+    for (CeedInt d=0; d<dim; d++) {
+      CeedInt pre = CeedIntPow(Q, dim-d-1), post = CeedIntPow(Q, d);
+      for (CeedInt i=0; i<pre; i++)
+        for (CeedInt j=0; j<Q; j++)
+          for (CeedInt k=0; k<post; k++) {
+            CeedScalar w = qweight1d[j]
+                           * (d == 0 ? 1 : v[((i*Q + j)*post + k)*nelem]);
+            for (CeedInt e=0; e<nelem; e++)
+              v[((i*Q + j)*post + k)*nelem + e] = w;
+          }
+    }
+  } break;
+  // Evaluate the divergence to/from the quadrature points
+  case CEED_EVAL_DIV:
+    return CeedError(ceed, 1, "CEED_EVAL_DIV not supported");
+  // Evaluate the curl to/from the quadrature points
+  case CEED_EVAL_CURL:
+    return CeedError(ceed, 1, "CEED_EVAL_CURL not supported");
+  // Take no action, BasisApply should not have been called
+  case CEED_EVAL_NONE:
+    return CeedError(ceed, 1,
+                     "CEED_EVAL_NONE does not make sense in this context");
+  }
+  return 0;
+}
+
+// One stage of the sum factorization of a simplex basis in collapsed
+// coordinates, with the factor table t of coordinate a (stage 0), b (stage 1)
+// or c (stage 2) and the contraction kernel contract.  In CEED_NOTRANSPOSE
+// mode, stage 2 maps modes to [ij][qc], stage 1 maps [ij][rest] to
+// [qb][rest] and stage 0 maps [i][rest] to [qa][rest], with the element index
+// innermost.  Each stage is a sum of contractions with the ragged blocks of t.
+static int CeedCollapsedStage_Ref(Ceed ceed, CeedInt stage, CeedInt dim,
+                                  CeedInt P, CeedInt Q, CeedInt C,
+                                  const CeedScalar *t, CeedTransposeMode tmode,
+                                  const CeedInt Add,
+                                  CeedTensorContractFunction_Ref contract,
+                                  const CeedScalar *u, CeedScalar *v) {
+  int ierr;
+  const bool notrans = tmode == CEED_NOTRANSPOSE;
+  const CeedInt inner = CeedIntPow(Q, dim-2)*C;
+
+  switch (stage) {
+  case 0:
+    ierr = contract(ceed, 1, notrans ? P : Q, Q*inner, notrans ? Q : P, t,
+                    tmode, Add, u, v); CeedChk(ierr);
+    break;
+  case 1:
+    for (CeedInt i=0, offB=0; i<P; offB+=Q*(P-i), i++) {
+      const CeedInt n = P-i, ij = offB/Q*inner, iq = i*Q*inner;
+      ierr = contract(ceed, 1, notrans ? n : Q, inner, notrans ? Q : n,
+                      t + offB, tmode, Add, u + (notrans ? ij : iq),
+                      v + (notrans ? iq : ij)); CeedChk(ierr);
+    }
+    break;
+  case 2:
+    for (CeedInt ij=0, i=0, m=0, offC=0; i<P; i++)
+      for (CeedInt j=0; j<P-i; offC+=Q*(P-i-j), m+=P-i-j, ij++, j++) {
+        const CeedInt n = P-i-j;
+        ierr = contract(ceed, 1, notrans ? n : Q, C, notrans ? Q : n,
+                        t + offC, tmode, Add,
+                        u + (notrans ? m*C : ij*Q*C),
+                        v + (notrans ? ij*Q*C : m*C)); CeedChk(ierr);
+      }
+    break;
+  }
+  return 0;
+}
+
+// Applies a simplex basis from CeedBasisCreateSimplexDubiner() by sum
+// factorization in collapsed coordinates, with the contraction kernel
+// contract.  u and v are laid out as for a dense non-tensor basis.  The chain
+// rule to the unit simplex is folded into the factor tables, see
+// CeedBasisGetCollapsedTables(), and the partial sums shared by the gradient
+// components are formed once.  In CEED_TRANSPOSE mode, v is added to.
+int CeedBasisApplyCollapsed_Ref(CeedBasis basis, CeedInt nelem,
+                                CeedTransposeMode tmode, CeedEvalMode emode,
+                                CeedTensorContractFunction_Ref contract,
+                                const CeedScalar *u, CeedScalar *v) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedBasisGetCeed(basis, &ceed); CeedChk(ierr);
+  CeedInt dim, ncomp, ndof, nqpt, P, Q;
+  ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
+  ierr = CeedBasisGetNumComponents(basis, &ncomp); CeedChk(ierr);
+  ierr = CeedBasisGetNumNodes(basis, &ndof); CeedChk(ierr);
+  ierr = CeedBasisGetNumQuadraturePoints(basis, &nqpt); CeedChk(ierr);
+  ierr = CeedBasisGetNumNodes1D(basis, &P); CeedChk(ierr);
+  ierr = CeedBasisGetNumQuadraturePoints1D(basis, &Q); CeedChk(ierr);
+  CeedScalar *tables;
+  ierr = CeedBasisGetCollapsedTables(basis, &tables); CeedChk(ierr);
+  const CeedInt nB = P*(P+1)/2, nd = emode == CEED_EVAL_GRAD ? dim : 1,
+                nf = P*CeedIntPow(Q, dim-1)*nelem, ng = nB*Q*nelem,
+                nq = nqpt*nelem;
+  const CeedScalar *A = tables, *DA = A + Q*P, *AA = DA + Q*P, *B = AA + Q*P,
+                    *DB = B + Q*nB, *BB = DB + Q*nB, *DBB = BB + Q*nB,
+                    *Cf = dim == 3 ? DBB + Q*nB : NULL,
+                    *DC = dim == 3 ? Cf + Q*ndof : NULL,
+                    *CC = dim == 3 ? DC + Q*ndof : NULL;
+  const CeedTransposeMode T = CEED_TRANSPOSE;
+  if (emode != CEED_EVAL_INTERP && emode != CEED_EVAL_GRAD)
+    return CeedError(ceed, 1, "Collapsed bases only apply INTERP and GRAD");
+
+  // Buffers, f holds up to three [i][qb][qc] and g two [ij][qc] partial sums
+  CeedScalar *f, *g = NULL, *w = NULL;
+  ierr = CeedMalloc(nd*nf, &f); CeedChk(ierr);
+  if (dim == 3) {
+    ierr = CeedMalloc((nd > 1 ? 2 : 1)*ng, &g); CeedChk(ierr);
+  }
+  if (dim == 3 && nd > 1 && tmode == CEED_TRANSPOSE) {
+    ierr = CeedMalloc(nq, &w); CeedChk(ierr);
+  }
+  CeedScalar *f1 = f, *f2 = nd > 1 ? f + nf : NULL,
+              *f3 = nd > 2 ? f + 2*nf : NULL,
+              *g1 = g, *g2 = g && nd > 1 ? g + ng : NULL;
+
+  for (CeedInt comp=0; comp<ncomp; comp++) {
+    const CeedScalar *uc = u + comp*(tmode == CEED_NOTRANSPOSE ? ndof
+                                     : nd*nqpt)*nelem;
+    CeedScalar *vc = v + comp*(tmode == CEED_NOTRANSPOSE ? nd*nqpt
+                               : ndof)*nelem;
+#define STAGE(s, t, mode, add, in, out) \
+    ierr = CeedCollapsedStage_Ref(ceed, s, dim, P, Q, nelem, t, mode, add, \
+                                  contract, in, out); CeedChk(ierr)
+    if (emode == CEED_EVAL_INTERP && tmode == CEED_NOTRANSPOSE) {
+      if (dim == 3) {
+        STAGE(2, Cf, tmode, 0, uc, g1);
+      }
+      STAGE(1, B, tmode, 0, dim == 3 ? g1 : uc, f1);
+      STAGE(0, A, tmode, 0, f1, vc);
+    } else if (emode == CEED_EVAL_INTERP) {
+      STAGE(0, A, T, 0, uc, f1);
+      STAGE(1, B, T, dim == 2, f1, dim == 3 ? g1 : vc);
+      if (dim == 3) {
+        STAGE(2, Cf, T, 1, g1, vc);
+      }
+    } else if (tmode == CEED_NOTRANSPOSE) {
+      // d/dx = DA BB CC, d/dy = AA BB CC + A DB CC,
+      // d/dz = AA BB CC + A DBB CC + A B DC
+      const CeedScalar *ub = uc;
+      if (dim == 3) {
+        STAGE(2, CC, tmode, 0, uc, g1);
+        STAGE(2, DC, tmode, 0, uc, g2);
+        STAGE(1, DBB, tmode, 0, g1, f3);
+        STAGE(1, B, tmode, 1, g2, f3);
+        ub = g1;
+      }
+      STAGE(1, BB, tmode, 0, ub, f1);
+      STAGE(1, DB, tmode, 0, ub, f2);
+      STAGE(0, DA, tmode, 0, f1, vc);
+      STAGE(0, AA, tmode, 0, f1, vc + nq);
+      if (dim == 3) {
+        memcpy(vc + 2*nq, vc + nq, nq*sizeof(vc[0]));
+        STAGE(0, A, tmode, 1, f3, vc + 2*nq);
+      }
+      STAGE(0, A, tmode, 1, f2, vc + nq);
+    } else {
+      const CeedScalar *gy = uc + nq, *gaa = gy;
+      if (dim == 3) {
+        const CeedScalar *gz = uc + 2*nq;
+        for (CeedInt i=0; i<nq; i++)
+          w[i] = gy[i] + gz[i];
+        gaa = w;
+        STAGE(0, A, T, 0, gz, f3);
+      }
+      STAGE(0, DA, T, 0, uc, f1);
+      STAGE(0, AA, T, 1, gaa, f1);
+      STAGE(0, A, T, 0, gy, f2);
+      STAGE(1, BB, T, dim == 2, f1, dim == 3 ? g1 : vc);
+      STAGE(1, DB, T, 1, f2, dim == 3 ? g1 : vc);
+      if (dim == 3) {
+        STAGE(1, DBB, T, 1, f3, g1);
+        STAGE(1, B, T, 0, f3, g2);
+        STAGE(2, CC, T, 1, g1, vc);
+        STAGE(2, DC, T, 1, g2, vc);
+      }
+    }
+#undef STAGE
+  }
+
+  ierr = CeedFree(&f); CeedChk(ierr);
+  ierr = CeedFree(&g); CeedChk(ierr);
+  ierr = CeedFree(&w); CeedChk(ierr);
+  return 0;
+}
+
+// Applies a basis with the kernels of a backend: the contraction contract
+// of the anisotropic and collapsed simplex bases, its even-odd form evenodd
+// for the other tensor bases and the matrix product multiply of the
+// non-tensor bases, all with the CeedTensorContract_Ref() semantics
+int CeedBasisApplyKernels_Ref(CeedBasis basis, CeedInt nelem,
                               CeedTransposeMode tmode, CeedEvalMode emode,
+                              CeedTensorContractFunction_Ref contract,
+                              CeedTensorContractEvenOddFunction_Ref evenodd,
+                              CeedTensorContractFunction_Ref multiply,
                               CeedVector U, CeedVector V) {
   int ierr;
   Ceed ceed;
@@ -66,127 +685,85 @@ static int CeedBasisApply_Ref(CeedBasis basis, CeedInt nelem,
   }
   ierr = CeedVectorGetArray(V, CEED_MEM_HOST, &v); CeedChk(ierr);
 
-  if (nelem != 1)
-    return CeedError(ceed, 1,
-                     "This backend does not support BasisApply for multiple elements");
-
   // Clear v if operating in transpose
   if (tmode == CEED_TRANSPOSE) {
-    const CeedInt vsize = ncomp*ndof;
+    const CeedInt vsize = nelem*ncomp*ndof;
     for (CeedInt i = 0; i < vsize; i++)
       v[i] = (CeedScalar) 0;
   }
-  // Tensor basis
   bool tensorbasis;
   ierr = CeedBasisGetTensorStatus(basis, &tensorbasis); CeedChk(ierr);
-  if (tensorbasis) {
-    CeedInt P1d, Q1d;
-    ierr = CeedBasisGetNumNodes1D(basis, &P1d); CeedChk(ierr);
-    ierr = CeedBasisGetNumQuadraturePoints1D(basis, &Q1d); CeedChk(ierr);
-    switch (emode) {
-    // Interpolate to/from quadrature points
-    case CEED_EVAL_INTERP: {
-      CeedInt P = P1d, Q = Q1d;
-      if (tmode == CEED_TRANSPOSE) {
-        P = Q1d; Q = P1d;
-      }
-      CeedInt pre = ncomp*CeedIntPow(P, dim-1), post = 1;
-      CeedScalar tmp[2][ncomp*Q*CeedIntPow(P>Q?P:Q, dim-1)];
-      CeedScalar *interp1d;
-      ierr = CeedBasisGetInterp(basis, &interp1d); CeedChk(ierr);
-      for (CeedInt d=0; d<dim; d++) {
-        ierr = CeedTensorContract_Ref(ceed, pre, P, post, Q, interp1d,
-                                      tmode, add&&(d==dim-1),
-                                      d==0?u:tmp[d%2], d==dim-1?v:tmp[(d+1)%2]);
-        CeedChk(ierr);
-        pre /= P;
-        post *= Q;
-      }
-    } break;
-    // Evaluate the gradient to/from quadrature points
-    case CEED_EVAL_GRAD: {
-      CeedInt P = P1d, Q = Q1d;
-      // In CEED_NOTRANSPOSE mode:
-      // u has shape [dim, ncomp, P^dim, nelem], row-major layout
-      // v has shape [dim, ncomp, Q^dim, nelem], row-major layout
-      // In CEED_TRANSPOSE mode, the sizes of u and v are switched.
-      if (tmode == CEED_TRANSPOSE) {
-        P = Q1d, Q = P1d;
-      }
-      CeedScalar tmp[2][ncomp*Q*CeedIntPow(P>Q?P:Q, dim-1)];
-      CeedScalar *interp1d, *grad1d;
-      ierr = CeedBasisGetInterp(basis, &interp1d); CeedChk(ierr);
-      ierr = CeedBasisGetGrad(basis, &grad1d); CeedChk(ierr);
-      for (CeedInt p = 0; p < dim; p++) {
-        CeedInt pre = ncomp*CeedIntPow(P, dim-1), post = 1;
-        for (CeedInt d=0; d<dim; d++) {
-          ierr = CeedTensorContract_Ref(ceed, pre, P, post, Q,
-                                        (p==d)?grad1d:interp1d,
-                                        tmode, add&&(d==dim-1),
-                                        (d == 0
-                                         ? (tmode==CEED_NOTRANSPOSE?u:u+p*ncomp*nqpt)
-                                         : tmp[d%2]),
-                                        (d == dim-1
-                                         ? (tmode==CEED_TRANSPOSE?v:v+p*ncomp*nqpt)
-                                         : tmp[(d+1)%2]));
-          CeedChk(ierr);
-          pre /= P;
-          post *= Q;
-        }
-      }
-    } break;
-    // Retrieve interpolation weights
-    case CEED_EVAL_WEIGHT: {
-      if (tmode == CEED_TRANSPOSE)
-        return CeedError(ceed, 1,
-                         "CEED_EVAL_WEIGHT incompatible with CEED_TRANSPOSE");
-      CeedInt Q = Q1d;
-      CeedScalar *qweight1d;
-      ierr = CeedBasisGetQWeights(basis, &qweight1d); CeedChk(ierr);
-      for (CeedInt d=0; d<dim; d++) {
-        CeedInt pre = CeedIntPow(Q, dim-d-1), post = CeedIntPow(Q, d);
-        for (CeedInt i=0; i<pre; i++)
-          for (CeedInt j=0; j<Q; j++)
-            for (CeedInt k=0; k<post; k++)
-              v[(i*Q + j)*post + k] = qweight1d[j]
-                                      * (d == 0 ? 1 : v[(i*Q + j)*post + k]);
-      }
-    } break;
-    // Evaluate the divergence to/from the quadrature points
-    case CEED_EVAL_DIV:
-      return CeedError(ceed, 1, "CEED_EVAL_DIV not supported");
-    // Evaluate the curl to/from the quadrature points
-    case CEED_EVAL_CURL:
-      return CeedError(ceed, 1, "CEED_EVAL_CURL not supported");
-    // Take no action, BasisApply should not have been called
-    case CEED_EVAL_NONE:
-      return CeedError(ceed, 1,
-                       "CEED_EVAL_NONE does not make sense in this context");
+  CeedScalar *collapsed;
+  ierr = CeedBasisGetCollapsedTables(basis, &collapsed); CeedChk(ierr);
+  CeedInt *sizes1d;
+  ierr = CeedBasisGetAnisotropicSizes(basis, &sizes1d); CeedChk(ierr);
+  // Values followed by gradients, the gradient block starts at offset qoff
+  const bool fused = emode == (CEED_EVAL_INTERP|CEED_EVAL_GRAD);
+  const CeedInt qoff = ncomp*nqpt*nelem;
+  if (sizes1d) {
+    // Tensor basis with the sizes of each direction
+    ierr = CeedBasisApplyAnisotropic_Ref(basis, nelem, tmode, emode,
+                                         contract, u, v);
+    CeedChk(ierr);
+  } else if (collapsed && fused) {
+    ierr = CeedBasisApplyCollapsed_Ref(basis, nelem, tmode, CEED_EVAL_INTERP,
+                                       contract, u, v);
+    CeedChk(ierr);
+    ierr = CeedBasisApplyCollapsed_Ref(basis, nelem, tmode, CEED_EVAL_GRAD,
+                                       contract,
+                                       tmode == CEED_TRANSPOSE ? u + qoff : u,
+                                       tmode == CEED_TRANSPOSE ? v : v + qoff);
+    CeedChk(ierr);
+  } else if (collapsed && (emode == CEED_EVAL_INTERP ||
+                           emode == CEED_EVAL_GRAD)) {
+    // Simplex basis in collapsed coordinates, by sum factorization
+    ierr = CeedBasisApplyCollapsed_Ref(basis, nelem, tmode, emode,
+                                       contract, u, v);
+    CeedChk(ierr);
+  } else if (tensorbasis) {
+    ierr = CeedBasisApplyTensor_Ref(basis, nelem, tmode, emode, evenodd, u,
+                                    v);
+    CeedChk(ierr);
+  } else if (fused) {
+    // Non-tensor basis, values and gradients
+    const CeedScalar *interp, *grad;
+    ierr = CeedBasisGetInterp(basis, &interp); CeedChk(ierr);
+    ierr = CeedBasisGetGrad(basis, &grad); CeedChk(ierr);
+    if (tmode == CEED_NOTRANSPOSE) {
+      ierr = multiply(ceed, ncomp, ndof, nelem, nqpt, interp,
+                      tmode, add, u, v); CeedChk(ierr);
+      ierr = multiply(ceed, ncomp, ndof, nelem, dim*nqpt, grad,
+                      tmode, add, u, v + qoff); CeedChk(ierr);
+    } else {
+      ierr = multiply(ceed, ncomp, nqpt, nelem, ndof, interp,
+                      tmode, add, u, v); CeedChk(ierr);
+      ierr = multiply(ceed, ncomp, dim*nqpt, nelem, ndof, grad,
+                      tmode, add, u + qoff, v); CeedChk(ierr);
     }
   } else {
     // Non-tensor basis
     switch (emode) {
     case CEED_EVAL_INTERP: {
       CeedInt P = ndof, Q = nqpt;
-      CeedScalar *interp;
+      const CeedScalar *interp;
       ierr = CeedBasisGetInterp(basis, &interp); CeedChk(ierr);
       if (tmode == CEED_TRANSPOSE) {
         P = nqpt; Q = ndof;
       }
-      ierr = CeedTensorContract_Ref(ceed, ncomp, P, 1, Q, interp,
-                                    tmode, add, u, v);
+      ierr = multiply(ceed, ncomp, P, nelem, Q, interp,
+                      tmode, add, u, v);
       CeedChk(ierr);
     }
     break;
     case CEED_EVAL_GRAD: {
       CeedInt P = ndof, Q = dim*nqpt;
-      CeedScalar *grad;
+      const CeedScalar *grad;
       ierr = CeedBasisGetGrad(basis, &grad); CeedChk(ierr);
       if (tmode == CEED_TRANSPOSE) {
         P = dim*nqpt; Q = ndof;
       }
-      ierr = CeedTensorContract_Ref(ceed, ncomp, P, 1, Q, grad,
-                                    tmode, add, u, v);
+      ierr = multiply(ceed, ncomp, P, nelem, Q, grad,
+                      tmode, add, u, v);
       CeedChk(ierr);
     }
     break;
@@ -194,10 +771,11 @@ static int CeedBasisApply_Ref(CeedBasis basis, CeedInt nelem,
       if (tmode == CEED_TRANSPOSE)
         return CeedError(ceed, 1,
                          "CEED_EVAL_WEIGHT incompatible with CEED_TRANSPOSE");
-      CeedScalar *qweight;
+      const CeedScalar *qweight;
       ierr = CeedBasisGetQWeights(basis, &qweight); CeedChk(ierr);
       for (CeedInt i=0; i<nqpt; i++)
-        v[i] = qweight[i];
+        for (CeedInt e=0; e<nelem; e++)
+          v[i*nelem + e] = qweight[i];
     } break;
     case CEED_EVAL_DIV:
       return CeedError(ceed, 1, "CEED_EVAL_DIV not supported");
@@ -215,7 +793,289 @@ static int CeedBasisApply_Ref(CeedBasis basis, CeedInt nelem,
   return 0;
 }
 
-static int CeedBasisDestroy_Ref(CeedBasis basis) {
+static int CeedBasisApply_Ref(CeedBasis basis, CeedInt nelem,
+                              CeedTransposeMode tmode, CeedEvalMode emode,
+                              CeedVector U, CeedVector V) {
+  return CeedBasisApplyKernels_Ref(basis, nelem, tmode, emode,
+                                   CeedTensorContract_Ref,
+                                   CeedTensorContractEvenOdd_Ref,
+                                   CeedTensorContract_Ref, U, V);
+}
+
+// Applies an anisotropic tensor basis from
+// CeedBasisCreateTensorH1Anisotropic() with the contraction kernel contract,
+// the table of direction d contracting the d-th fastest varying index of the
+// nodes or quadrature points as in CeedTensorContractChain_Ref().  The values
+// and the derivative in each direction of CEED_EVAL_INTERP|CEED_EVAL_GRAD are
+// separate chains.  In CEED_TRANSPOSE mode, v is added to.
+int CeedBasisApplyAnisotropic_Ref(CeedBasis basis, CeedInt nelem,
+                                  CeedTransposeMode tmode, CeedEvalMode emode,
+                                  CeedTensorContractFunction_Ref contract,
+                                  const CeedScalar *u, CeedScalar *v) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedBasisGetCeed(basis, &ceed); CeedChk(ierr);
+  CeedInt dim, ncomp, ndof, nqpt, *sizes1d;
+  ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
+  ierr = CeedBasisGetNumComponents(basis, &ncomp); CeedChk(ierr);
+  ierr = CeedBasisGetNumNodes(basis, &ndof); CeedChk(ierr);
+  ierr = CeedBasisGetNumQuadraturePoints(basis, &nqpt); CeedChk(ierr);
+  ierr = CeedBasisGetAnisotropicSizes(basis, &sizes1d); CeedChk(ierr);
+  const CeedInt *P1d = sizes1d, *Q1d = sizes1d + dim;
+  const bool notrans = tmode == CEED_NOTRANSPOSE;
+
+  if (emode == CEED_EVAL_WEIGHT) {
+    if (!notrans)
+      return CeedError(ceed, 1,
+                       "CEED_EVAL_WEIGHT incompatible with CEED_TRANSPOSE");
+    const CeedScalar *qweight1d;
+    ierr = CeedBasisGetQWeights(basis, &qweight1d); CeedChk(ierr);
+    for (CeedInt q=0; q<nqpt; q++) {
+      CeedScalar w = 1;
+      for (CeedInt d=0, k=q, qoff=0; d<dim; qoff+=Q1d[d], k/=Q1d[d], d++)
+        w *= qweight1d[qoff + k%Q1d[d]];
+      for (CeedInt e=0; e<nelem; e++)
+        v[q*nelem + e] = w;
+    }
+    return 0;
+  }
+  if (emode != CEED_EVAL_INTERP && emode != CEED_EVAL_GRAD &&
+      emode != (CEED_EVAL_INTERP|CEED_EVAL_GRAD))
+    return CeedError(ceed, 1,
+                     "Anisotropic bases only apply INTERP, GRAD and WEIGHT");
+
+  // The 1D tables of each direction
+  const CeedScalar *interp1d, *grad1d;
+  ierr = CeedBasisGetInterp(basis, &interp1d); CeedChk(ierr);
+  ierr = CeedBasisGetGrad(basis, &grad1d); CeedChk(ierr);
+  const CeedScalar *interp[dim], *grad[dim];
+  CeedInt tmpsize = ncomp*nelem;
+  for (CeedInt d=0, off=0; d<dim; off+=Q1d[d]*P1d[d], d++) {
+    interp[d] = interp1d + off;
+    grad[d] = grad1d + off;
+    tmpsize *= P1d[d] > Q1d[d] ? P1d[d] : Q1d[d];
+  }
+  CeedScalar *tmp[2] = {NULL, NULL};
+  if (dim > 1) {
+    ierr = CeedMalloc(tmpsize, &tmp[0]); CeedChk(ierr);
+    ierr = CeedMalloc(tmpsize, &tmp[1]); CeedChk(ierr);
+  }
+
+  // Chain o applies the derivative in direction o-1 if the values come first
+  const bool values = emode & CEED_EVAL_INTERP;
+  const CeedInt nout = values + (emode & CEED_EVAL_GRAD ? dim : 0),
+                qblk = ncomp*nqpt*nelem;
+  for (CeedInt o=0; o<nout; o++) {
+    const CeedInt p = values ? o-1 : o;
+    CeedInt pre = ncomp*(notrans ? ndof : nqpt), post = nelem;
+    for (CeedInt d=0; d<dim; d++) {
+      const CeedInt B = notrans ? P1d[d] : Q1d[d],
+                    J = notrans ? Q1d[d] : P1d[d];
+      const bool last = d == dim-1;
+      pre /= B;
+      ierr = contract(ceed, pre, B, post, J, d == p ? grad[d] : interp[d],
+                      tmode, last && !notrans,
+                      d == 0 ? u + (notrans ? 0 : o*qblk) : tmp[d%2],
+                      last ? v + (notrans ? o*qblk : 0) : tmp[(d+1)%2]);
+      CeedChk(ierr);
+      post *= J;
+    }
+  }
+  ierr = CeedFree(&tmp[0]); CeedChk(ierr);
+  ierr = CeedFree(&tmp[1]); CeedChk(ierr);
+  return 0;
+}
+
+// Applies a tensor basis at npoints arbitrary points in each of nelem
+// elements, with the contraction kernel contract, see
+// CeedBasisApplyAtPoints().  Element by element, the first coordinate is
+// contracted for all points at once as a product with the npoints columns of
+// the transposed 1D tables, with the points innermost, and the remaining
+// coordinates are contracted point by point with their own table rows.  In
+// CEED_TRANSPOSE mode, the chain is reversed and v is added to.
+int CeedBasisEvalAtPoints_Ref(CeedBasis basis, CeedInt nelem,
+                              CeedInt npoints, CeedTransposeMode tmode,
+                              CeedEvalMode emode,
+                              CeedTensorContractFunction_Ref contract,
+                              const CeedScalar *x, const CeedScalar *u,
+                              CeedScalar *v) {
+  int ierr;
+  Ceed ceed;
+  ierr = CeedBasisGetCeed(basis, &ceed); CeedChk(ierr);
+  CeedInt dim, ncomp, P, Q;
+  ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
+  ierr = CeedBasisGetNumComponents(basis, &ncomp); CeedChk(ierr);
+  ierr = CeedBasisGetNumNodes1D(basis, &P); CeedChk(ierr);
+  ierr = CeedBasisGetNumQuadraturePoints1D(basis, &Q); CeedChk(ierr);
+  const CeedInt n = npoints, ndof = CeedIntPow(P, dim),
+                A0 = ncomp*CeedIntPow(P, dim-1),
+                interp = !!(emode & CEED_EVAL_INTERP),
+                grad = !!(emode & CEED_EVAL_GRAD),
+                nout = interp + (grad ? dim : 0);
+  const bool notrans = tmode == CEED_NOTRANSPOSE;
+
+  // Element nodes, 1D tables B and D of each coordinate at the points and the
+  // workspace computing them, the first stage partial sums w0 for B and D, and
+  // the later stages
+  CeedScalar *ue, *xe, *w1d, *B, *D, *BT, *w0, *wa, *wb;
+  ierr = CeedMalloc(ncomp*ndof, &ue); CeedChk(ierr);
+  ierr = CeedMalloc(n, &xe); CeedChk(ierr);
+  ierr = CeedMalloc(2*n*Q, &w1d); CeedChk(ierr);
+  ierr = CeedMalloc(dim*n*P, &B); CeedChk(ierr);
+  ierr = CeedMalloc(dim*n*P, &D); CeedChk(ierr);
+  ierr = CeedMalloc(2*P*n, &BT); CeedChk(ierr);
+  ierr = CeedMalloc(2*A0*n, &w0); CeedChk(ierr);
+  ierr = CeedMalloc(A0*n, &wa); CeedChk(ierr);
+  ierr = CeedMalloc(A0*n, &wb); CeedChk(ierr);
+  CeedScalar *DT = BT + P*n, *w0D = w0 + A0*n;
+
+  for (CeedInt e=0; e<nelem; e++) {
+    for (CeedInt d=0; d<dim; d++) {
+      for (CeedInt p=0; p<n; p++)
+        xe[p] = x[(d*n+p)*nelem+e];
+      ierr = CeedBasisEvaluate1D(basis, n, xe, B + d*n*P, D + d*n*P, w1d);
+      CeedChk(ierr);
+    }
+
+    if (notrans) {
+      for (CeedInt i=0; i<ncomp*ndof; i++)
+        ue[i] = u[i*nelem+e];
+      for (CeedInt p=0; p<n; p++)
+        for (CeedInt j=0; j<P; j++) {
+          BT[j*n+p] = B[p*P+j];
+          DT[j*n+p] = D[p*P+j];
+        }
+      ierr = contract(ceed, 1, P, n, A0, ue, CEED_NOTRANSPOSE, 0, BT, w0);
+      CeedChk(ierr);
+      if (grad) {
+        ierr = contract(ceed, 1, P, n, A0, ue, CEED_NOTRANSPOSE, 0, DT, w0D);
+        CeedChk(ierr);
+      }
+    } else {
+      for (CeedInt i=0; i<2*A0*n; i++)
+        w0[i] = 0;
+    }
+
+    // Outputs o, the values if requested and then the derivative in each
+    // coordinate dout
+    for (CeedInt o=0; o<nout; o++) {
+      const CeedInt dout = o - interp;
+      const CeedScalar *wi = notrans ? (dout == 0 ? w0D : w0) : NULL;
+      CeedScalar *wo = wa, *vo = v + o*ncomp*n*nelem;
+      const CeedScalar *uo = u + o*ncomp*n*nelem;
+      if (notrans) {
+        // W_s[r][p] = sum_j W_(s-1)[r][j][p] T_s[p][j]
+        for (CeedInt s=1; s<dim; s++) {
+          const CeedScalar *T = (dout == s ? D : B) + s*n*P;
+          const CeedInt rows = A0/CeedIntPow(P, s);
+          for (CeedInt r=0; r<rows; r++)
+            for (CeedInt p=0; p<n; p++) {
+              CeedScalar sum = 0;
+              for (CeedInt j=0; j<P; j++)
+                sum += wi[(r*P+j)*n+p] * T[p*P+j];
+              wo[r*n+p] = sum;
+            }
+          wi = wo;
+          wo = wo == wa ? wb : wa;
+        }
+        for (CeedInt i=0; i<ncomp*n; i++)
+          vo[i*nelem+e] = wi[i];
+      } else {
+        // W_(s-1)[r][j][p] = W_s[r][p] T_s[p][j]
+        for (CeedInt i=0; i<ncomp*n; i++)
+          wb[i] = uo[i*nelem+e];
+        wi = wb;
+        for (CeedInt s=dim-1; s>0; s--) {
+          const CeedScalar *T = (dout == s ? D : B) + s*n*P;
+          const CeedInt rows = A0/CeedIntPow(P, s);
+          wo = wi == wa ? wb : wa;
+          for (CeedInt r=0; r<rows; r++)
+            for (CeedInt j=0; j<P; j++)
+              for (CeedInt p=0; p<n; p++)
+                wo[(r*P+j)*n+p] = wi[r*n+p] * T[p*P+j];
+          wi = wo;
+        }
+        CeedScalar *w = dout == 0 ? w0D : w0;
+        for (CeedInt i=0; i<A0*n; i++)
+          w[i] += wi[i];
+      }
+    }
+
+    if (!notrans) {
+      ierr = contract(ceed, 1, n, P, A0, w0, CEED_NOTRANSPOSE, 0, B, ue);
+      CeedChk(ierr);
+      if (grad) {
+        ierr = contract(ceed, 1, n, P, A0, w0D, CEED_NOTRANSPOSE, 1, D, ue);
+        CeedChk(ierr);
+      }
+      for (CeedInt i=0; i<ncomp*ndof; i++)
+        v[i*nelem+e] += ue[i];
+    }
+  }
+
+  ierr = CeedFree(&ue); CeedChk(ierr);
+  ierr = CeedFree(&xe); CeedChk(ierr);
+  ierr = CeedFree(&w1d); CeedChk(ierr);
+  ierr = CeedFree(&B); CeedChk(ierr);
+  ierr = CeedFree(&D); CeedChk(ierr);
+  ierr = CeedFree(&BT); CeedChk(ierr);
+  ierr = CeedFree(&w0); CeedChk(ierr);
+  ierr = CeedFree(&wa); CeedChk(ierr);
+  ierr = CeedFree(&wb); CeedChk(ierr);
+  return 0;
+}
+
+// Evaluates a basis at points, as CeedBasisEvalAtPoints_Ref(), with the
+// contraction contract of a backend
+int CeedBasisApplyAtPointsKernels_Ref(CeedBasis basis, CeedInt nelem,
+                                      CeedInt npoints, CeedTransposeMode tmode,
+                                      CeedEvalMode emode,
+                                      CeedTensorContractFunction_Ref contract,
+                                      CeedVector X, CeedVector U,
+                                      CeedVector V) {
+  int ierr;
+  CeedInt ncomp, ndof;
+  ierr = CeedBasisGetNumComponents(basis, &ncomp); CeedChk(ierr);
+  ierr = CeedBasisGetNumNodes(basis, &ndof); CeedChk(ierr);
+  const CeedScalar *x, *u;
+  CeedScalar *v;
+  ierr = CeedVectorGetArrayRead(X, CEED_MEM_HOST, &x); CeedChk(ierr);
+  ierr = CeedVectorGetArrayRead(U, CEED_MEM_HOST, &u); CeedChk(ierr);
+  ierr = CeedVectorGetArray(V, CEED_MEM_HOST, &v); CeedChk(ierr);
+  if (tmode == CEED_TRANSPOSE)
+    for (CeedInt i=0; i<nelem*ncomp*ndof; i++)
+      v[i] = (CeedScalar) 0.0;
+  ierr = CeedBasisEvalAtPoints_Ref(basis, nelem, npoints, tmode, emode,
+                                   contract, x, u, v); CeedChk(ierr);
+  ierr = CeedVectorRestoreArrayRead(X, &x); CeedChk(ierr);
+  ierr = CeedVectorRestoreArrayRead(U, &u); CeedChk(ierr);
+  ierr = CeedVectorRestoreArray(V, &v); CeedChk(ierr);
+  return 0;
+}
+
+static int CeedBasisApplyAtPoints_Ref(CeedBasis basis, CeedInt nelem,
+                                      CeedInt npoints, CeedTransposeMode tmode,
+                                      CeedEvalMode emode, CeedVector X,
+                                      CeedVector U, CeedVector V) {
+  return CeedBasisApplyAtPointsKernels_Ref(basis, nelem, npoints, tmode,
+         emode, CeedTensorContract_Ref, X, U, V);
+}
+
+static int CeedBasisDestroyNonTensor_Ref(CeedBasis basis) {
+  return 0;
+}
+
+int CeedBasisDestroyTensor_Ref(CeedBasis basis) {
+  int ierr;
+  CeedBasis_Ref *impl;
+  ierr = CeedBasisGetData(basis, (void*)&impl); CeedChk(ierr);
+
+  ierr = CeedTensorMatrixDestroy_Ref(&impl->interp); CeedChk(ierr);
+  ierr = CeedTensorMatrixDestroy_Ref(&impl->grad); CeedChk(ierr);
+  ierr = CeedTensorMatrixDestroy_Ref(&impl->colograd); CeedChk(ierr);
+  ierr = CeedFree(&impl->colograd1d); CeedChk(ierr);
+  ierr = CeedFree(&impl); CeedChk(ierr);
+
   return 0;
 }
 
@@ -228,11 +1088,36 @@ int CeedBasisCreateTensorH1_Ref(CeedInt dim, CeedInt P1d,
   int ierr;
   Ceed ceed;
   ierr = CeedBasisGetCeed(basis, &ceed); CeedChk(ierr);
+  CeedInt *sizes1d;
+  ierr = CeedBasisGetAnisotropicSizes(basis, &sizes1d); CeedChk(ierr);
+  CeedBasis_Ref *impl;
+  ierr = CeedCalloc(1, &impl); CeedChk(ierr);
+  // The collocated derivative needs interp1d to have full column rank
+  if (Q1d >= P1d && !sizes1d) {
+    ierr = CeedMalloc(Q1d*Q1d, &impl->colograd1d); CeedChk(ierr);
+    ierr = CeedBasisGetCollocatedGrad(basis, impl->colograd1d); CeedChk(ierr);
+  }
+  // The even-odd folding of the 1D matrices of isotropic symmetric bases
+  bool symmetric;
+  ierr = CeedBasisGetSymmetryStatus(basis, &symmetric); CeedChk(ierr);
+  const CeedInt sym = symmetric && !sizes1d;
+  ierr = CeedTensorMatrixCreate_Ref(interp1d, Q1d, P1d, sym, &impl->interp);
+  CeedChk(ierr);
+  ierr = CeedTensorMatrixCreate_Ref(grad1d, Q1d, P1d, -sym, &impl->grad);
+  CeedChk(ierr);
+  ierr = CeedTensorMatrixCreate_Ref(impl->colograd1d, Q1d, Q1d,
+                                    impl->colograd1d ? -sym : 0,
+                                    &impl->colograd); CeedChk(ierr);
+  ierr = CeedBasisSetData(basis, (void*)&impl); CeedChk(ierr);
 
   ierr = CeedSetBackendFunction(ceed, "Basis", basis, "Apply",
                                 CeedBasisApply_Ref); CeedChk(ierr);
+  if (!sizes1d) {
+    ierr = CeedSetBackendFunction(ceed, "Basis", basis, "ApplyAtPoints",
+                                  CeedBasisApplyAtPoints_Ref); CeedChk(ierr);
+  }
   ierr = CeedSetBackendFunction(ceed, "Basis", basis, "Destroy",
-                                CeedBasisDestroy_Ref); CeedChk(ierr);
+                                CeedBasisDestroyTensor_Ref); CeedChk(ierr);
   return 0;
 }
 
@@ -250,6 +1135,6 @@ int CeedBasisCreateH1_Ref(CeedElemTopology topo, CeedInt dim,
   ierr = CeedSetBackendFunction(ceed, "Basis", basis, "Apply",
                                 CeedBasisApply_Ref); CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "Basis", basis, "Destroy",
-                                CeedBasisDestroy_Ref); CeedChk(ierr);
+                                CeedBasisDestroyNonTensor_Ref); CeedChk(ierr);
   return 0;
 }
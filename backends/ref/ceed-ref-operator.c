@@ -14,102 +14,416 @@
 // software, applications, hardware, advanced system engineering and early
 // testbed platforms, in support of the nation's exascale computing imperative.
 
+#include <stdlib.h>
 #include <string.h>
 #include "ceed-ref.h"
 
-static int CeedOperatorDestroy_Ref(CeedOperator op) {
+/*
+  Destroy an operator execution plan
+ */
+int CeedOperatorPlanDestroy_Ref(CeedOperatorPlan_Ref **plan) {
   int ierr;
-  CeedOperator_Ref *impl;
-  ierr = CeedOperatorGetData(op, (void*)&impl); CeedChk(ierr);
-
-  for (CeedInt i=0; i<impl->numein+impl->numeout; i++) {
-    ierr = CeedVectorDestroy(&impl->evecs[i]); CeedChk(ierr);
-  }
-  ierr = CeedFree(&impl->evecs); CeedChk(ierr);
-  ierr = CeedFree(&impl->edata); CeedChk(ierr);
-
-  for (CeedInt i=0; i<impl->numein; i++) {
-    ierr = CeedVectorDestroy(&impl->qvecsin[i]); CeedChk(ierr);
-  }
-  ierr = CeedFree(&impl->qvecsin); CeedChk(ierr);
+  CeedOperatorPlan_Ref *p = *plan;
+  if (!p) return 0;
 
-  for (CeedInt i=0; i<impl->numeout; i++) {
-    ierr = CeedVectorDestroy(&impl->qvecsout[i]); CeedChk(ierr);
+  for (CeedInt i=0; i<p->numin+p->numout; i++) {
+    if (p->fields[i].blkrestr) {
+      ierr = CeedElemRestrictionDestroy(&p->fields[i].rstr); CeedChk(ierr);
+    }
+    ierr = CeedVectorDestroy(&p->fields[i].evec); CeedChk(ierr);
+    ierr = CeedVectorDestroy(&p->fields[i].qvec); CeedChk(ierr);
+    if (p->fields[i].nbatch) {
+      ierr = CeedFree(&p->fields[i].qdata); CeedChk(ierr);
+    }
+    ierr = CeedBasisDestroy(&p->fields[i].bbasis); CeedChk(ierr);
+    ierr = CeedVectorDestroy(&p->fields[i].bevec); CeedChk(ierr);
+    ierr = CeedVectorDestroy(&p->fields[i].bqvec); CeedChk(ierr);
+    ierr = CeedFree(&p->fields[i].edata); CeedChk(ierr);
   }
-  ierr = CeedFree(&impl->qvecsout); CeedChk(ierr);
-
-  ierr = CeedFree(&impl); CeedChk(ierr);
+  ierr = CeedFree(&p->fields); CeedChk(ierr);
+  ierr = CeedFree(&p->indata); CeedChk(ierr);
+  ierr = CeedFree(&p->outdata); CeedChk(ierr);
+  ierr = CeedFree(plan); CeedChk(ierr);
   return 0;
 }
 
 /*
-  Setup infields or outfields
+  Build the execution plan for an operator, processing blksize elements at a
+  time.  Everything the apply loop needs is resolved here once: restrictions
+  (blocked copies when blksize > 1), bases, eval modes, L-vectors and the
+  E-vector and Q-vector storage handed to the QFunction.
  */
-static int CeedOperatorSetupFields_Ref(CeedQFunction qf, CeedOperator op,
-                                       bool inOrOut, CeedVector *evecs,
-                                       CeedVector *qvecs, CeedInt starte,
-                                       CeedInt numfields, CeedInt Q) {
-  CeedInt dim, ierr, ncomp;
+int CeedOperatorPlanCreate_Ref(CeedOperator op, CeedInt blksize,
+                               CeedOperatorPlan_Ref **plan) {
+  int ierr;
   Ceed ceed;
   ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
-  CeedBasis basis;
-  CeedElemRestriction Erestrict;
-  CeedOperatorField *opfields;
-  CeedQFunctionField *qffields;
-  if (inOrOut) {
-    ierr = CeedOperatorGetFields(op, NULL, &opfields);
-    CeedChk(ierr);
-    ierr = CeedQFunctionGetFields(qf, NULL, &qffields);
-    CeedChk(ierr);
-  } else {
-    ierr = CeedOperatorGetFields(op, &opfields, NULL);
-    CeedChk(ierr);
-    ierr = CeedQFunctionGetFields(qf, &qffields, NULL);
-    CeedChk(ierr);
-  }
-
-  // Loop over fields
-  for (CeedInt i=0; i<numfields; i++) {
-    CeedEvalMode emode;
-    ierr = CeedQFunctionFieldGetEvalMode(qffields[i], &emode); CeedChk(ierr);
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  CeedInt Q, numelements, numinputfields, numoutputfields, vlength;
+  ierr = CeedOperatorGetNumQuadraturePoints(op, &Q); CeedChk(ierr);
+  ierr = CeedOperatorGetNumElements(op, &numelements); CeedChk(ierr);
+  ierr = CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
+  CeedChk(ierr);
+  ierr = CeedQFunctionGetVectorLength(qf, &vlength); CeedChk(ierr);
+  if ((Q*blksize) % vlength)
+    return CeedError(ceed, 2,
+                     "Number of quadrature points %d must be a multiple of %d",
+                     Q*blksize, vlength);
+  CeedOperatorField *opinputfields, *opoutputfields;
+  ierr = CeedOperatorGetFields(op, &opinputfields, &opoutputfields);
+  CeedChk(ierr);
+  CeedQFunctionField *qfinputfields, *qfoutputfields;
+  ierr = CeedQFunctionGetFields(qf, &qfinputfields, &qfoutputfields);
+  CeedChk(ierr);
 
-    if (emode != CEED_EVAL_WEIGHT) {
-      ierr = CeedOperatorFieldGetElemRestriction(opfields[i], &Erestrict);
-      CeedChk(ierr);
-      ierr = CeedElemRestrictionCreateVector(Erestrict, NULL,
-                                             &evecs[i+starte]);
-      CeedChk(ierr);
+  CeedOperatorPlan_Ref *p;
+  ierr = CeedCalloc(1, &p); CeedChk(ierr);
+  p->numin = numinputfields; p->numout = numoutputfields;
+  p->blksize = blksize;
+  p->nblk = (numelements/blksize) + !!(numelements%blksize);
+  p->Q = Q;
+  ierr = CeedCalloc(numinputfields + numoutputfields, &p->fields);
+  CeedChk(ierr);
+  ierr = CeedCalloc(16, &p->indata); CeedChk(ierr);
+  ierr = CeedCalloc(16, &p->outdata); CeedChk(ierr);
+
+  // Loop over fields, inputs followed by outputs
+  for (CeedInt i=0; i<numinputfields+numoutputfields; i++) {
+    const bool isin = i < numinputfields;
+    CeedOperatorField opfield = isin ? opinputfields[i]
+                                : opoutputfields[i-numinputfields];
+    CeedQFunctionField qffield = isin ? qfinputfields[i]
+                                 : qfoutputfields[i-numinputfields];
+    CeedOperatorPlanField_Ref *fi = &p->fields[i];
+    CeedInt ncomp, dim, qsize = 0;
+    ierr = CeedQFunctionFieldGetEvalMode(qffield, &fi->emode); CeedChk(ierr);
+    ierr = CeedQFunctionFieldGetNumComponents(qffield, &ncomp); CeedChk(ierr);
+    ierr = CeedOperatorFieldGetBasis(opfield, &fi->basis); CeedChk(ierr);
+    ierr = CeedOperatorFieldGetVector(opfield, &fi->vec); CeedChk(ierr);
+    ierr = CeedOperatorFieldGetLMode(opfield, &fi->lmode); CeedChk(ierr);
+    fi->nbatch = 1;
+
+    if (fi->emode != CEED_EVAL_WEIGHT) {
+      CeedElemRestriction r;
+      ierr = CeedOperatorFieldGetElemRestriction(opfield, &r); CeedChk(ierr);
+      CeedInt elemsize, rcomp;
+      ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+      ierr = CeedElemRestrictionGetNumComponents(r, &rcomp); CeedChk(ierr);
+      if (blksize > 1) {
+        ierr = CeedElemRestrictionGetBlocked_Ref(r, blksize, &fi->rstr);
+        CeedChk(ierr);
+        fi->blkrestr = true;
+      } else {
+        fi->rstr = r;
+      }
+      // CEED_EVAL_NONE restricts directly to and from the Q-vector
+      if (fi->emode != CEED_EVAL_NONE) {
+        ierr = CeedMalloc(blksize*elemsize*rcomp, &fi->edata); CeedChk(ierr);
+        ierr = CeedVectorCreate(ceed, blksize*elemsize*rcomp, &fi->evec);
+        CeedChk(ierr);
+        ierr = CeedVectorSetArray(fi->evec, CEED_MEM_HOST, CEED_USE_POINTER,
+                                  fi->edata); CeedChk(ierr);
+        fi->earray = fi->edata;
+      }
     }
 
-    switch(emode) {
+    if (fi->emode == (CEED_EVAL_INTERP|CEED_EVAL_GRAD)) {
+      // Values followed by gradients
+      ierr = CeedBasisGetDimension(fi->basis, &dim); CeedChk(ierr);
+      qsize = Q*ncomp*(1+dim)*blksize;
+    } else switch(fi->emode) {
     case CEED_EVAL_NONE:
-      ierr = CeedQFunctionFieldGetNumComponents(qffields[i], &ncomp);
-      CeedChk(ierr);
-      ierr = CeedVectorCreate(ceed, Q*ncomp, &qvecs[i]); CeedChk(ierr);
-      break;
     case CEED_EVAL_INTERP:
-      ierr = CeedQFunctionFieldGetNumComponents(qffields[i], &ncomp);
-      CeedChk(ierr);
-      ierr = CeedVectorCreate(ceed, Q*ncomp, &qvecs[i]); CeedChk(ierr);
+      qsize = Q*ncomp*blksize;
       break;
     case CEED_EVAL_GRAD:
-      ierr = CeedOperatorFieldGetBasis(opfields[i], &basis); CeedChk(ierr);
-      ierr = CeedQFunctionFieldGetNumComponents(qffields[i], &ncomp);
-      ierr = CeedBasisGetDimension(basis, &dim); CeedChk(ierr);
-      ierr = CeedVectorCreate(ceed, Q*ncomp*dim, &qvecs[i]); CeedChk(ierr);
+      ierr = CeedBasisGetDimension(fi->basis, &dim); CeedChk(ierr);
+      qsize = Q*ncomp*dim*blksize;
       break;
     case CEED_EVAL_WEIGHT: // Only on input fields
-      ierr = CeedOperatorFieldGetBasis(opfields[i], &basis); CeedChk(ierr);
-      ierr = CeedVectorCreate(ceed, Q, &qvecs[i]); CeedChk(ierr);
-      ierr = CeedBasisApply(basis, 1, CEED_NOTRANSPOSE, CEED_EVAL_WEIGHT,
-                            NULL, qvecs[i]); CeedChk(ierr);
+      if (!isin)
+        return CeedError(ceed, 1,
+                         "CEED_EVAL_WEIGHT cannot be an output evaluation mode");
+      qsize = Q*blksize;
       break;
     case CEED_EVAL_DIV:
       break; // Not implimented
     case CEED_EVAL_CURL:
       break; // Not implimented
     }
+    ierr = CeedMalloc(qsize, &fi->qdata); CeedChk(ierr);
+    ierr = CeedVectorCreate(ceed, qsize, &fi->qvec); CeedChk(ierr);
+    ierr = CeedVectorSetArray(fi->qvec, CEED_MEM_HOST, CEED_USE_POINTER,
+                              fi->qdata); CeedChk(ierr);
+    if (fi->emode == CEED_EVAL_NONE)
+      fi->earray = fi->qdata;
+    if (fi->emode == CEED_EVAL_WEIGHT) {
+      ierr = CeedBasisApply(fi->basis, blksize, CEED_NOTRANSPOSE,
+                            CEED_EVAL_WEIGHT, NULL, fi->qvec); CeedChk(ierr);
+    }
+    if (isin)
+      p->indata[i] = fi->qdata;
+    else
+      p->outdata[i-numinputfields] = fi->qdata;
   }
+
+  // Fields of one direction interpolating values with the same tensor basis
+  // are batched: their E-vectors and Q-vectors become consecutive slices of
+  // one batch, to which a basis over all their components is applied in one
+  // call that streams the 1D matrices once
+  for (CeedInt i=0; i<numinputfields+numoutputfields; i++) {
+    CeedOperatorPlanField_Ref *fi = &p->fields[i];
+    const CeedInt end = i < numinputfields ? numinputfields
+                        : numinputfields + numoutputfields;
+    bool tensor;
+    if (fi->nbatch != 1 || fi->emode != CEED_EVAL_INTERP) continue;
+    ierr = CeedBasisGetTensorStatus(fi->basis, &tensor); CeedChk(ierr);
+    if (!tensor) continue;
+    for (CeedInt j=i+1; j<end; j++)
+      if (p->fields[j].emode == CEED_EVAL_INTERP &&
+          p->fields[j].basis == fi->basis)
+        fi->nbatch++;
+    if (fi->nbatch == 1) continue;
+
+    Ceed bceed;
+    CeedInt dim, ncomp, esize, *sizes1d;
+    const CeedScalar *interp1d, *grad1d, *qref1d, *qweight1d;
+    CeedScalar *qdata;
+    ierr = CeedBasisGetCeed(fi->basis, &bceed); CeedChk(ierr);
+    ierr = CeedBasisGetDimension(fi->basis, &dim); CeedChk(ierr);
+    ierr = CeedBasisGetNumComponents(fi->basis, &ncomp); CeedChk(ierr);
+    ierr = CeedBasisGetAnisotropicSizes(fi->basis, &sizes1d); CeedChk(ierr);
+    ierr = CeedBasisGetInterp(fi->basis, &interp1d); CeedChk(ierr);
+    ierr = CeedBasisGetGrad(fi->basis, &grad1d); CeedChk(ierr);
+    ierr = CeedBasisGetQRef(fi->basis, &qref1d); CeedChk(ierr);
+    ierr = CeedBasisGetQWeights(fi->basis, &qweight1d); CeedChk(ierr);
+    ierr = CeedVectorGetLength(fi->evec, &esize); CeedChk(ierr);
+    const CeedInt nbatch = fi->nbatch, qsize = Q*ncomp*blksize;
+    if (sizes1d) {
+      ierr = CeedBasisCreateTensorH1Anisotropic(bceed, dim, nbatch*ncomp,
+                                                sizes1d, sizes1d + dim,
+                                                interp1d, grad1d, qref1d,
+                                                qweight1d, &fi->bbasis);
+      CeedChk(ierr);
+    } else {
+      CeedInt P1d, Q1d;
+      ierr = CeedBasisGetNumNodes1D(fi->basis, &P1d); CeedChk(ierr);
+      ierr = CeedBasisGetNumQuadraturePoints1D(fi->basis, &Q1d);
+      CeedChk(ierr);
+      ierr = CeedBasisCreateTensorH1(bceed, dim, nbatch*ncomp, P1d, Q1d,
+                                     interp1d, grad1d, qref1d, qweight1d,
+                                     &fi->bbasis); CeedChk(ierr);
+    }
+    ierr = CeedFree(&fi->edata); CeedChk(ierr);
+    ierr = CeedMalloc(nbatch*esize, &fi->edata); CeedChk(ierr);
+    ierr = CeedMalloc(nbatch*qsize, &qdata); CeedChk(ierr);
+    ierr = CeedVectorCreate(ceed, nbatch*esize, &fi->bevec); CeedChk(ierr);
+    ierr = CeedVectorSetArray(fi->bevec, CEED_MEM_HOST, CEED_USE_POINTER,
+                              fi->edata); CeedChk(ierr);
+    ierr = CeedVectorCreate(ceed, nbatch*qsize, &fi->bqvec); CeedChk(ierr);
+    ierr = CeedVectorSetArray(fi->bqvec, CEED_MEM_HOST, CEED_USE_POINTER,
+                              qdata); CeedChk(ierr);
+
+    // The first field owns the batch E-vector and Q-vector storage
+    for (CeedInt j=i, k=0; j<end; j++) {
+      CeedOperatorPlanField_Ref *fj = &p->fields[j];
+      if (j > i && (fj->emode != CEED_EVAL_INTERP || fj->basis != fi->basis))
+        continue;
+      ierr = CeedFree(&fj->qdata); CeedChk(ierr);
+      fj->qdata = qdata + k*qsize;
+      ierr = CeedVectorSetArray(fj->qvec, CEED_MEM_HOST, CEED_USE_POINTER,
+                                fj->qdata); CeedChk(ierr);
+      if (j > i) {
+        ierr = CeedFree(&fj->edata); CeedChk(ierr);
+      }
+      fj->earray = fi->edata + k*esize;
+      ierr = CeedVectorSetArray(fj->evec, CEED_MEM_HOST, CEED_USE_POINTER,
+                                fj->earray); CeedChk(ierr);
+      if (j < numinputfields)
+        p->indata[j] = fj->qdata;
+      else
+        p->outdata[j-numinputfields] = fj->qdata;
+      if (j > i)
+        fj->nbatch = 0;
+      k++;
+    }
+  }
+
+  *plan = p;
+  return 0;
+}
+
+// Order element indices
+static int CeedIntCompare_Ref(const void *a, const void *b) {
+  const CeedInt x = *(const CeedInt *)a, y = *(const CeedInt *)b;
+  return (x > y) - (x < y);
+}
+
+/*
+  List the elements [start, start+nelem), or elems[0..nelem) if elems is not
+  NULL, sorted and each once, see CeedOperatorApplyElements(); *sel holds
+  *nsel elements and is freed by the caller.
+ */
+int CeedOperatorSelectElements_Ref(CeedInt start, CeedInt nelem,
+                                   const CeedInt *elems, CeedInt *nsel,
+                                   CeedInt **sel) {
+  int ierr;
+  ierr = CeedMalloc(nelem, sel); CeedChk(ierr);
+  for (CeedInt i=0; i<nelem; i++)
+    (*sel)[i] = elems ? elems[i] : start+i;
+  *nsel = nelem;
+  if (!elems) return 0;
+
+  qsort(*sel, nelem, sizeof((*sel)[0]), CeedIntCompare_Ref);
+  *nsel = 0;
+  for (CeedInt i=0; i<nelem; i++)
+    if (!i || (*sel)[i] != (*sel)[i-1])
+      (*sel)[(*nsel)++] = (*sel)[i];
+  return 0;
+}
+
+// Restrict the L-vector array u of field fi to its storage v for block b, or
+//   for the elements sel[b*blksize..) packed into the block if sel is not
+//   NULL, or add its storage u to v for the transpose
+static int CeedOperatorRestrict_Ref(const CeedOperatorPlanField_Ref *fi,
+                                    CeedInt b, CeedInt blksize, CeedInt nsel,
+                                    const CeedInt *sel, CeedTransposeMode tmode,
+                                    const CeedScalar *u, CeedScalar *v) {
+  if (sel)
+    return CeedElemRestrictionApplyElements_Ref(fi->rstr,
+           CeedIntMin(blksize, nsel-b*blksize), &sel[b*blksize], tmode,
+           fi->lmode, u, v);
+  return CeedElemRestrictionApplyRange_Ref(fi->rstr, b*blksize,
+         (b+1)*blksize, tmode, fi->lmode, u, v);
+}
+
+/*
+  Execute an operator plan: for each block of elements, gather, interpolate,
+  call the QFunction, apply the transpose basis and scatter-add, so that
+  only block sized E-vectors and Q-vectors are needed.  The restriction
+  kernels work on the arrays of the L-vectors, accessed once per apply, and
+  on the storage of the plan.  With sel, from CeedOperatorSelectElements_Ref(),
+  the nsel selected elements are packed into blocks instead, whatever blocks
+  of the restrictions they belong to, only their nodes are scattered, and the
+  outputs are added to rather than overwritten.
+ */
+int CeedOperatorPlanApply_Ref(CeedOperator op, CeedOperatorPlan_Ref *plan,
+                              CeedInt nsel, const CeedInt *sel,
+                              CeedVector invec, CeedVector outvec,
+                              CeedRequest *request) {
+  int ierr;
+  CeedQFunction qf;
+  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
+  void *ctx;
+  ierr = CeedQFunctionGetContext(qf, &ctx); CeedChk(ierr);
+  int (*f)() = NULL;
+  ierr = CeedQFunctionGetUserFunction(qf, (int (**)())&f); CeedChk(ierr);
+  const CeedInt numin = plan->numin, numout = plan->numout,
+                blksize = plan->blksize;
+  const CeedInt nblk = sel ? (nsel/blksize) + !!(nsel%blksize) : plan->nblk;
+  CeedOperatorPlanField_Ref *fields = plan->fields;
+
+  // Resolve active vectors
+  CeedVector lvecs[numin+numout];
+  for (CeedInt i=0; i<numin+numout; i++)
+    lvecs[i] = fields[i].vec == CEED_VECTOR_ACTIVE
+               ? (i < numin ? invec : outvec) : fields[i].vec;
+
+  // Zero lvecs, unless adding the contribution of selected elements
+  for (CeedInt i=numin; i<numin+numout && !sel; i++) {
+    ierr = CeedVectorSetValue(lvecs[i], 0.0); CeedChk(ierr);
+  }
+
+  // L-vector arrays, an output vector shared by several fields accessed once
+  const CeedScalar *lin[numin];
+  CeedScalar *lout[numout];
+  for (CeedInt i=0; i<numin; i++) {
+    lin[i] = NULL;
+    if (fields[i].emode == CEED_EVAL_WEIGHT) continue;
+    ierr = CeedVectorGetArrayRead(lvecs[i], CEED_MEM_HOST, &lin[i]);
+    CeedChk(ierr);
+  }
+  for (CeedInt i=0; i<numout; i++) {
+    lout[i] = NULL;
+    for (CeedInt j=0; j<i && !lout[i]; j++)
+      if (lvecs[numin+j] == lvecs[numin+i])
+        lout[i] = lout[j];
+    if (lout[i]) continue;
+    ierr = CeedVectorGetArray(lvecs[numin+i], CEED_MEM_HOST, &lout[i]);
+    CeedChk(ierr);
+  }
+
+  // Loop through element blocks
+  for (CeedInt b=0; b<nblk; b++) {
+    // Input restriction, to the E-vector or the Q-vector
+    for (CeedInt i=0; i<numin; i++) {
+      const CeedOperatorPlanField_Ref *fi = &fields[i];
+      if (fi->emode == CEED_EVAL_WEIGHT) continue; // No action
+      ierr = CeedOperatorRestrict_Ref(fi, b, blksize, nsel, sel,
+                                      CEED_NOTRANSPOSE, lin[i], fi->earray);
+      CeedChk(ierr);
+    }
+
+    // Input basis apply if needed, once per batch
+    for (CeedInt i=0; i<numin; i++) {
+      const CeedOperatorPlanField_Ref *fi = &fields[i];
+      if (!fi->evec || !fi->nbatch) continue;
+      if (fi->nbatch > 1) {
+        ierr = CeedBasisApply(fi->bbasis, blksize, CEED_NOTRANSPOSE, fi->emode,
+                              fi->bevec, fi->bqvec); CeedChk(ierr);
+      } else {
+        ierr = CeedBasisApply(fi->basis, blksize, CEED_NOTRANSPOSE, fi->emode,
+                              fi->evec, fi->qvec); CeedChk(ierr);
+      }
+    }
+
+    // Q function
+    ierr = f(ctx, plan->Q*blksize, (const CeedScalar *const *)plan->indata,
+             plan->outdata); CeedChk(ierr);
+
+    // Output basis apply if needed and transpose restriction
+    for (CeedInt i=numin; i<numin+numout; i++) {
+      const CeedOperatorPlanField_Ref *fi = &fields[i];
+      // A batch is applied with its first field
+      if (fi->nbatch > 1) {
+        ierr = CeedBasisApply(fi->bbasis, blksize, CEED_TRANSPOSE, fi->emode,
+                              fi->bqvec, fi->bevec); CeedChk(ierr);
+      } else if (fi->evec && fi->nbatch) {
+        ierr = CeedBasisApply(fi->basis, blksize, CEED_TRANSPOSE, fi->emode,
+                              fi->qvec, fi->evec); CeedChk(ierr);
+      }
+      ierr = CeedOperatorRestrict_Ref(fi, b, blksize, nsel, sel,
+                                      CEED_TRANSPOSE, fi->earray,
+                                      lout[i-numin]); CeedChk(ierr);
+    }
+  }
+
+  // Restore the L-vector arrays
+  for (CeedInt i=0; i<numin; i++) {
+    if (!lin[i]) continue;
+    ierr = CeedVectorRestoreArrayRead(lvecs[i], &lin[i]); CeedChk(ierr);
+  }
+  for (CeedInt i=0; i<numout; i++) {
+    bool first = true;
+    for (CeedInt j=0; j<i; j++)
+      first = first && lvecs[numin+j] != lvecs[numin+i];
+    if (!first) continue;
+    ierr = CeedVectorRestoreArray(lvecs[numin+i], &lout[i]); CeedChk(ierr);
+  }
+  if (request != CEED_REQUEST_IMMEDIATE && request != CEED_REQUEST_ORDERED)
+    *request = NULL;
+
+  return 0;
+}
+
+static int CeedOperatorDestroy_Ref(CeedOperator op) {
+  int ierr;
+  CeedOperator_Ref *impl;
+  ierr = CeedOperatorGetData(op, (void*)&impl); CeedChk(ierr);
+
+  ierr = CeedOperatorPlanDestroy_Ref(&impl->plan); CeedChk(ierr);
+  ierr = CeedFree(&impl); CeedChk(ierr);
   return 0;
 }
 
@@ -122,49 +436,18 @@ static int CeedOperatorSetup_Ref(CeedOperator op) {
   bool setupdone;
   ierr = CeedOperatorGetSetupStatus(op, &setupdone); CeedChk(ierr);
   if (setupdone) return 0;
-  Ceed ceed;
-  ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
   CeedOperator_Ref *impl;
   ierr = CeedOperatorGetData(op, (void*)&impl); CeedChk(ierr);
+
+  // Batch elements through the basis when the QFunction vector length allows
   CeedQFunction qf;
   ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
-  CeedInt Q, numinputfields, numoutputfields;
+  CeedInt Q, vlength;
   ierr = CeedOperatorGetNumQuadraturePoints(op, &Q); CeedChk(ierr);
-  ierr = CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
-  CeedChk(ierr);
-  CeedOperatorField *opinputfields, *opoutputfields;
-  ierr = CeedOperatorGetFields(op, &opinputfields, &opoutputfields);
-  CeedChk(ierr);
-  CeedQFunctionField *qfinputfields, *qfoutputfields;
-  ierr = CeedQFunctionGetFields(qf, &qfinputfields, &qfoutputfields);
-  CeedChk(ierr);
-
-  // Allocate
-  ierr = CeedCalloc(numinputfields + numoutputfields, &impl->evecs);
-  CeedChk(ierr);
-  ierr = CeedCalloc(numinputfields + numoutputfields, &impl->edata);
-  CeedChk(ierr);
+  ierr = CeedQFunctionGetVectorLength(qf, &vlength); CeedChk(ierr);
+  const CeedInt blksize = (Q*CEED_REF_BLKSIZE) % vlength ? 1 : CEED_REF_BLKSIZE;
 
-  ierr = CeedCalloc(16, &impl->qvecsin); CeedChk(ierr);
-  ierr = CeedCalloc(16, &impl->qvecsout); CeedChk(ierr);
-
-  impl->numein = numinputfields; impl->numeout = numoutputfields;
-
-  // Set up infield and outfield evecs and qvecs
-  // Infields
-  ierr = CeedOperatorSetupFields_Ref(qf, op, 0,
-                                     impl->evecs, impl->qvecsin, 0,
-                                     numinputfields, Q);
-  CeedChk(ierr);
-
-  // Outfields
-  ierr = CeedOperatorSetupFields_Ref(qf, op, 1,
-                                     impl->evecs, impl->qvecsout,
-                                     numinputfields, numoutputfields, Q);
-  CeedChk(ierr);
-
-  // Temporary Vector
-  ierr = CeedVectorCreate(ceed, 0, &impl->tempvec); CeedChk(ierr);
+  ierr = CeedOperatorPlanCreate_Ref(op, blksize, &impl->plan); CeedChk(ierr);
 
   ierr = CeedOperatorSetSetupDone(op); CeedChk(ierr);
 
@@ -176,211 +459,34 @@ static int CeedOperatorApply_Ref(CeedOperator op, CeedVector invec,
   int ierr;
   CeedOperator_Ref *impl;
   ierr = CeedOperatorGetData(op, (void*)&impl); CeedChk(ierr);
-  CeedQFunction qf;
-  ierr = CeedOperatorGetQFunction(op, &qf); CeedChk(ierr);
-  CeedInt Q, numelements, elemsize, numinputfields, numoutputfields, ncomp;
-  ierr = CeedOperatorGetNumQuadraturePoints(op, &Q); CeedChk(ierr);
-  ierr = CeedOperatorGetNumElements(op, &numelements); CeedChk(ierr);
-  ierr= CeedQFunctionGetNumArgs(qf, &numinputfields, &numoutputfields);
-  CeedChk(ierr);
-  CeedTransposeMode lmode;
-  CeedOperatorField *opinputfields, *opoutputfields;
-  ierr = CeedOperatorGetFields(op, &opinputfields, &opoutputfields);
-  CeedChk(ierr);
-  CeedQFunctionField *qfinputfields, *qfoutputfields;
-  ierr = CeedQFunctionGetFields(qf, &qfinputfields, &qfoutputfields);
-  CeedChk(ierr);
-  CeedEvalMode emode;
-  CeedVector vec;
-  CeedBasis basis;
-  CeedElemRestriction Erestrict;
 
   // Setup
   ierr = CeedOperatorSetup_Ref(op); CeedChk(ierr);
 
-  // Input Evecs and Restriction
-  for (CeedInt i=0; i<numinputfields; i++) {
-    ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
-    CeedChk(ierr);
-    if (emode == CEED_EVAL_WEIGHT) { // Skip
-    } else {
-      // Get input vector
-      ierr = CeedOperatorFieldGetVector(opinputfields[i], &vec); CeedChk(ierr);
-      if (vec == CEED_VECTOR_ACTIVE)
-        vec = invec;
-      // Restrict
-      ierr = CeedOperatorFieldGetElemRestriction(opinputfields[i], &Erestrict);
-      CeedChk(ierr);
-      ierr = CeedOperatorFieldGetLMode(opinputfields[i], &lmode); CeedChk(ierr);
-      ierr = CeedElemRestrictionApply(Erestrict, CEED_NOTRANSPOSE,
-                                      lmode, vec, impl->evecs[i],
-                                      request); CeedChk(ierr);
-      // Get evec
-      ierr = CeedVectorGetArrayRead(impl->evecs[i], CEED_MEM_HOST,
-                                    (const CeedScalar **) &impl->edata[i]);
-      CeedChk(ierr);
-    }
-  }
-
-  // Output Evecs
-  for (CeedInt i=0; i<numoutputfields; i++) {
-    ierr = CeedVectorGetArray(impl->evecs[i+impl->numein], CEED_MEM_HOST,
-                              &impl->edata[i + numinputfields]); CeedChk(ierr);
-  }
+  // Apply, one block of elements at a time
+  ierr = CeedOperatorPlanApply_Ref(op, impl->plan, 0, NULL, invec, outvec,
+                                   request); CeedChk(ierr);
 
-  // Loop through elements
-  for (CeedInt e=0; e<numelements; e++) {
-    // Input basis apply if needed
-    for (CeedInt i=0; i<numinputfields; i++) {
-      // Get elemsize, emode, ncomp
-      ierr = CeedOperatorFieldGetElemRestriction(opinputfields[i], &Erestrict);
-      CeedChk(ierr);
-      ierr = CeedElemRestrictionGetElementSize(Erestrict, &elemsize);
-      CeedChk(ierr);
-      ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
-      CeedChk(ierr);
-      ierr = CeedQFunctionFieldGetNumComponents(qfinputfields[i], &ncomp);
-      CeedChk(ierr);
-      // Basis action
-      switch(emode) {
-      case CEED_EVAL_NONE:
-        ierr = CeedVectorSetArray(impl->qvecsin[i], CEED_MEM_HOST, 
-                                  CEED_USE_POINTER,
-                                  &impl->edata[i][e*Q*ncomp]); CeedChk(ierr);
-        break;
-      case CEED_EVAL_INTERP:
-        ierr = CeedOperatorFieldGetBasis(opinputfields[i], &basis); CeedChk(ierr);
-        ierr = CeedVectorSetArray(impl->tempvec, CEED_MEM_HOST,
-                                  CEED_USE_POINTER,
-                                  &impl->edata[i][e*elemsize*ncomp]);
-        CeedChk(ierr);
-        ierr = CeedBasisApply(basis, 1, CEED_NOTRANSPOSE,
-                              CEED_EVAL_INTERP, impl->tempvec,
-                              impl->qvecsin[i]); CeedChk(ierr);
-        break;
-      case CEED_EVAL_GRAD:
-        ierr = CeedOperatorFieldGetBasis(opinputfields[i], &basis); CeedChk(ierr);
-        ierr = CeedVectorSetArray(impl->tempvec, CEED_MEM_HOST,
-                                  CEED_USE_POINTER,
-                                  &impl->edata[i][e*elemsize*ncomp]);
-        CeedChk(ierr);
-        ierr = CeedBasisApply(basis, 1, CEED_NOTRANSPOSE,
-                              CEED_EVAL_GRAD, impl->tempvec,
-                              impl->qvecsin[i]); CeedChk(ierr);
-        break;
-      case CEED_EVAL_WEIGHT:
-        break;  // No action
-      case CEED_EVAL_DIV:
-        break; // Not implimented
-      case CEED_EVAL_CURL:
-        break; // Not implimented
-      }
-    }
-    // Output pointers
-    for (CeedInt i=0; i<numoutputfields; i++) {
-      ierr = CeedQFunctionFieldGetEvalMode(qfoutputfields[i], &emode);
-      CeedChk(ierr);
-      if (emode == CEED_EVAL_NONE) {
-        ierr = CeedQFunctionFieldGetNumComponents(qfoutputfields[i], &ncomp);
-        CeedChk(ierr);
-        ierr = CeedVectorSetArray(impl->qvecsout[i], CEED_MEM_HOST,
-                                  CEED_USE_POINTER,
-                                  &impl->edata[i + numinputfields][e*Q*ncomp]);
-        CeedChk(ierr);
-      }
-    }
-    // Q function
-    ierr = CeedQFunctionApply(qf, Q, impl->qvecsin, impl->qvecsout); CeedChk(ierr);
-
-    // Output basis apply if needed
-    for (CeedInt i=0; i<numoutputfields; i++) {
-      // Get elemsize, emode, ncomp
-      ierr = CeedOperatorFieldGetElemRestriction(opoutputfields[i], &Erestrict);
-      CeedChk(ierr);
-      ierr = CeedElemRestrictionGetElementSize(Erestrict, &elemsize);
-      CeedChk(ierr);
-      ierr = CeedQFunctionFieldGetEvalMode(qfoutputfields[i], &emode);
-      CeedChk(ierr);
-      ierr = CeedQFunctionFieldGetNumComponents(qfoutputfields[i], &ncomp);
-      CeedChk(ierr);
-      // Basis action
-      switch(emode) {
-      case CEED_EVAL_NONE:
-        break; // No action
-      case CEED_EVAL_INTERP:
-        ierr = CeedOperatorFieldGetBasis(opoutputfields[i], &basis);
-        CeedChk(ierr);
-        ierr = CeedVectorSetArray(impl->tempvec, CEED_MEM_HOST,
-                                  CEED_USE_POINTER,
-                                  &impl->edata[i + numinputfields][e*elemsize*ncomp]);
-        ierr = CeedBasisApply(basis, 1, CEED_TRANSPOSE,
-                              CEED_EVAL_INTERP, impl->qvecsout[i],
-                              impl->tempvec); CeedChk(ierr);
-        break;
-      case CEED_EVAL_GRAD:
-        ierr = CeedOperatorFieldGetBasis(opoutputfields[i], &basis);
-        CeedChk(ierr);
-        ierr = CeedVectorSetArray(impl->tempvec, CEED_MEM_HOST,
-                                  CEED_USE_POINTER,
-                                  &impl->edata[i + numinputfields][e*elemsize*ncomp]);
-        ierr = CeedBasisApply(basis, 1, CEED_TRANSPOSE,
-                              CEED_EVAL_GRAD, impl->qvecsout[i],
-                              impl->tempvec); CeedChk(ierr);
-        break;
-      case CEED_EVAL_WEIGHT: {
-        Ceed ceed;
-        ierr = CeedOperatorGetCeed(op, &ceed); CeedChk(ierr);
-        return CeedError(ceed, 1,
-                         "CEED_EVAL_WEIGHT cannot be an output evaluation mode");
-        break; // Should not occur
-      }
-      case CEED_EVAL_DIV:
-        break; // Not implimented
-      case CEED_EVAL_CURL:
-        break; // Not implimented
-      }
-    }
-  }
+  return 0;
+}
 
-  // Zero lvecs
-  for (CeedInt i=0; i<numoutputfields; i++) {
-    ierr = CeedOperatorFieldGetVector(opoutputfields[i], &vec); CeedChk(ierr);
-    if (vec == CEED_VECTOR_ACTIVE)
-      vec = outvec;
-    ierr = CeedVectorSetValue(vec, 0.0); CeedChk(ierr);
-    }
+static int CeedOperatorApplyElements_Ref(CeedOperator op, CeedInt start,
+    CeedInt nelem, const CeedInt *elems, CeedVector invec, CeedVector outvec,
+    CeedRequest *request) {
+  int ierr;
+  CeedOperator_Ref *impl;
+  ierr = CeedOperatorGetData(op, (void*)&impl); CeedChk(ierr);
 
-  // Output restriction
-  for (CeedInt i=0; i<numoutputfields; i++) {
-    // Restore evec
-    ierr = CeedVectorRestoreArray(impl->evecs[i+impl->numein],
-                                  &impl->edata[i + numinputfields]);
-    CeedChk(ierr);
-    // Get output vector
-    ierr = CeedOperatorFieldGetVector(opoutputfields[i], &vec); CeedChk(ierr);
-    // Active
-    if (vec == CEED_VECTOR_ACTIVE)
-      vec = outvec;
-    // Restrict
-    ierr = CeedOperatorFieldGetElemRestriction(opoutputfields[i], &Erestrict);
-    CeedChk(ierr);
-    ierr = CeedOperatorFieldGetLMode(opoutputfields[i], &lmode); CeedChk(ierr);
-    ierr = CeedElemRestrictionApply(Erestrict, CEED_TRANSPOSE,
-                                    lmode, impl->evecs[i+impl->numein], vec,
-                                    request); CeedChk(ierr);
-  }
+  // Setup
+  ierr = CeedOperatorSetup_Ref(op); CeedChk(ierr);
 
-  // Restore input arrays
-  for (CeedInt i=0; i<numinputfields; i++) {
-    ierr = CeedQFunctionFieldGetEvalMode(qfinputfields[i], &emode);
-    CeedChk(ierr);
-    if (emode == CEED_EVAL_WEIGHT) { // Skip
-    } else {
-      ierr = CeedVectorRestoreArrayRead(impl->evecs[i],
-                                        (const CeedScalar **) &impl->edata[i]);
-      CeedChk(ierr);
-    }
-  }
+  // Apply the selected elements, packed into blocks, adding to the outputs
+  CeedInt nsel, *sel;
+  ierr = CeedOperatorSelectElements_Ref(start, nelem, elems, &nsel, &sel);
+  CeedChk(ierr);
+  ierr = CeedOperatorPlanApply_Ref(op, impl->plan, nsel, sel, invec, outvec,
+                                   request); CeedChk(ierr);
+  ierr = CeedFree(&sel); CeedChk(ierr);
 
   return 0;
 }
@@ -396,6 +502,8 @@ int CeedOperatorCreate_Ref(CeedOperator op) {
 
   ierr = CeedSetBackendFunction(ceed, "Operator", op, "Apply",
                                 CeedOperatorApply_Ref); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "Operator", op, "ApplyElements",
+                                CeedOperatorApplyElements_Ref); CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "Operator", op, "Destroy",
                                 CeedOperatorDestroy_Ref); CeedChk(ierr);
   return 0;
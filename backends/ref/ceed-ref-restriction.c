@@ -14,46 +14,408 @@
 // software, applications, hardware, advanced system engineering and early
 // testbed platforms, in support of the nation's exascale computing imperative.
 
+#include <stdlib.h>
 #include <string.h>
 #include "ceed-ref.h"
 
-static int CeedElemRestrictionApply_Ref(CeedElemRestriction r,
-                                        CeedTransposeMode tmode,
-                                        CeedTransposeMode lmode, CeedVector u,
-                                        CeedVector v, CeedRequest *request) {
+// Gather kernel: vv has shape [nblk, ncomp, elemsize, blksize] and the L-vector
+//   uu has node stride ls and component stride cs; ncomp, lmode and blksize are
+//   constants in every instantiation below, so the layout select leaves the
+//   loop and the component loop unrolls
+static inline void CeedElemRestrictionGatherKernel_Ref(const CeedInt ncomp,
+    const CeedTransposeMode lmode, const CeedInt blksize, CeedInt start,
+    CeedInt stop, CeedInt nelem, CeedInt elemsize, CeedInt ndof,
+    const CeedInt *restrict indices, const CeedScalar *restrict uu,
+    CeedScalar *restrict vv) {
+  const CeedInt ls = lmode == CEED_NOTRANSPOSE ? 1 : ncomp,
+                cs = lmode == CEED_NOTRANSPOSE ? ndof : 1,
+                esize = elemsize*blksize;
+  for (CeedInt e = start; e < stop; e+=blksize) {
+    const CeedInt *ind = indices + e*elemsize;
+    CeedScalar *ve = vv + (e-start)*elemsize*ncomp;
+    for (CeedInt i = 0; i < esize; i++)
+      for (CeedInt d = 0; d < ncomp; d++)
+        ve[d*esize + i] = uu[ind[i]*ls + d*cs];
+  }
+}
+
+// Scatter-add kernel, the transpose of the gather; padding elements of the
+//   last block are skipped
+static inline void CeedElemRestrictionScatterKernel_Ref(const CeedInt ncomp,
+    const CeedTransposeMode lmode, const CeedInt blksize, CeedInt start,
+    CeedInt stop, CeedInt nelem, CeedInt elemsize, CeedInt ndof,
+    const CeedInt *restrict indices, const CeedScalar *restrict uu,
+    CeedScalar *restrict vv) {
+  const CeedInt ls = lmode == CEED_NOTRANSPOSE ? 1 : ncomp,
+                cs = lmode == CEED_NOTRANSPOSE ? ndof : 1,
+                esize = elemsize*blksize;
+  for (CeedInt e = start; e < stop; e+=blksize) {
+    const CeedInt *ind = indices + e*elemsize,
+                   nb = CeedIntMin(blksize, nelem-e);
+    const CeedScalar *ue = uu + (e-start)*elemsize*ncomp;
+    for (CeedInt i = 0; i < esize; i+=blksize)
+      for (CeedInt j = i; j < i+nb; j++)
+        for (CeedInt d = 0; d < ncomp; d++)
+          vv[ind[j]*ls + d*cs] += ue[d*esize + j];
+  }
+}
+
+// Gather kernel of an unblocked restriction that reads the indices of its
+//   blocked copy, blocked by ib, see CeedElemRestrictionShareIndices_Ref();
+//   vv has shape [nelem, ncomp, elemsize]
+static inline void CeedElemRestrictionGatherSharedKernel_Ref(
+    const CeedInt ncomp, const CeedTransposeMode lmode, const CeedInt ib,
+    CeedInt start, CeedInt stop, CeedInt nelem, CeedInt elemsize, CeedInt ndof,
+    const CeedInt *restrict indices, const CeedScalar *restrict uu,
+    CeedScalar *restrict vv) {
+  const CeedInt ls = lmode == CEED_NOTRANSPOSE ? 1 : ncomp,
+                cs = lmode == CEED_NOTRANSPOSE ? ndof : 1;
+  for (CeedInt e = start; e < stop; e++) {
+    const CeedInt *ind = indices + (e/ib)*ib*elemsize + e%ib;
+    CeedScalar *ve = vv + (e-start)*ncomp*elemsize;
+    for (CeedInt k = 0; k < elemsize; k++)
+      for (CeedInt d = 0; d < ncomp; d++)
+        ve[d*elemsize + k] = uu[ind[k*ib]*ls + d*cs];
+  }
+}
+
+// Scatter-add kernel, the transpose of the shared gather
+static inline void CeedElemRestrictionScatterSharedKernel_Ref(
+    const CeedInt ncomp, const CeedTransposeMode lmode, const CeedInt ib,
+    CeedInt start, CeedInt stop, CeedInt nelem, CeedInt elemsize, CeedInt ndof,
+    const CeedInt *restrict indices, const CeedScalar *restrict uu,
+    CeedScalar *restrict vv) {
+  const CeedInt ls = lmode == CEED_NOTRANSPOSE ? 1 : ncomp,
+                cs = lmode == CEED_NOTRANSPOSE ? ndof : 1;
+  for (CeedInt e = start; e < CeedIntMin(stop, nelem); e++) {
+    const CeedInt *ind = indices + (e/ib)*ib*elemsize + e%ib;
+    const CeedScalar *ue = uu + (e-start)*ncomp*elemsize;
+    for (CeedInt k = 0; k < elemsize; k++)
+      for (CeedInt d = 0; d < ncomp; d++)
+        vv[ind[k*ib]*ls + d*cs] += ue[d*elemsize + k];
+  }
+}
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define CEED_RESTRICTION_SIMD
+
+// Gather kernel with one AVX2 gather of 4 doubles per component, for
+//   elemsize*blksize a multiple of 4
+__attribute__((target("avx2"), always_inline))
+static inline void CeedElemRestrictionGatherKernel_Avx2(const CeedInt ncomp,
+    const CeedTransposeMode lmode, const CeedInt blksize, CeedInt start,
+    CeedInt stop, CeedInt nelem, CeedInt elemsize, CeedInt ndof,
+    const CeedInt *restrict indices, const CeedScalar *restrict uu,
+    CeedScalar *restrict vv) {
+  const CeedInt ls = lmode == CEED_NOTRANSPOSE ? 1 : ncomp,
+                cs = lmode == CEED_NOTRANSPOSE ? ndof : 1,
+                esize = elemsize*blksize;
+  for (CeedInt e = start; e < stop; e+=blksize) {
+    const CeedInt *ind = indices + e*elemsize;
+    CeedScalar *ve = vv + (e-start)*elemsize*ncomp;
+    for (CeedInt i = 0; i < esize; i+=4) {
+      __m128i idx = _mm_loadu_si128((const __m128i *)(ind + i));
+      if (ls != 1)
+        idx = _mm_mullo_epi32(idx, _mm_set1_epi32(ls));
+      for (CeedInt d = 0; d < ncomp; d++)
+        _mm256_storeu_pd(ve + d*esize + i, _mm256_i32gather_pd(uu + d*cs, idx,
+                         8));
+    }
+  }
+}
+
+// Gather kernel with one AVX-512 gather of 8 doubles, a block of 8 elements,
+//   per component and element node
+__attribute__((target("avx512f"), always_inline))
+static inline void CeedElemRestrictionGatherKernel_Avx512(const CeedInt ncomp,
+    const CeedTransposeMode lmode, const CeedInt blksize, CeedInt start,
+    CeedInt stop, CeedInt nelem, CeedInt elemsize, CeedInt ndof,
+    const CeedInt *restrict indices, const CeedScalar *restrict uu,
+    CeedScalar *restrict vv) {
+  const CeedInt ls = lmode == CEED_NOTRANSPOSE ? 1 : ncomp,
+                cs = lmode == CEED_NOTRANSPOSE ? ndof : 1,
+                esize = elemsize*blksize;
+  for (CeedInt e = start; e < stop; e+=blksize) {
+    const CeedInt *ind = indices + e*elemsize;
+    CeedScalar *ve = vv + (e-start)*elemsize*ncomp;
+    for (CeedInt i = 0; i < esize; i+=8) {
+      __m256i idx = _mm256_loadu_si256((const __m256i *)(ind + i));
+      if (ls != 1)
+        idx = _mm256_mullo_epi32(idx, _mm256_set1_epi32(ls));
+      for (CeedInt d = 0; d < ncomp; d++)
+        _mm512_storeu_pd(ve + d*esize + i, _mm512_i32gather_pd(idx, uu + d*cs,
+                         8));
+    }
+  }
+}
+
+// Scatter-add kernel with AVX-512 gather, add and scatter of a block of 8
+//   elements; only taken when the elements of every full block reference
+//   distinct nodes at each element node, see
+//   CeedElemRestrictionConflictFree_Ref(), so the lanes of a scatter never
+//   collide. The padded last block is added lane by lane.
+__attribute__((target("avx512f"), always_inline))
+static inline void CeedElemRestrictionScatterKernel_Avx512(const CeedInt ncomp,
+    const CeedTransposeMode lmode, const CeedInt blksize, CeedInt start,
+    CeedInt stop, CeedInt nelem, CeedInt elemsize, CeedInt ndof,
+    const CeedInt *restrict indices, const CeedScalar *restrict uu,
+    CeedScalar *restrict vv) {
+  const CeedInt ls = lmode == CEED_NOTRANSPOSE ? 1 : ncomp,
+                cs = lmode == CEED_NOTRANSPOSE ? ndof : 1,
+                esize = elemsize*blksize;
+  for (CeedInt e = start; e < stop; e+=blksize) {
+    const CeedInt *ind = indices + e*elemsize;
+    const CeedScalar *ue = uu + (e-start)*elemsize*ncomp;
+    if (nelem-e < blksize) {
+      CeedElemRestrictionScatterKernel_Ref(ncomp, lmode, blksize, e, e+blksize,
+                                           nelem, elemsize, ndof, indices, ue,
+                                           vv);
+      continue;
+    }
+    for (CeedInt i = 0; i < esize; i+=8) {
+      __m256i idx = _mm256_loadu_si256((const __m256i *)(ind + i));
+      if (ls != 1)
+        idx = _mm256_mullo_epi32(idx, _mm256_set1_epi32(ls));
+      for (CeedInt d = 0; d < ncomp; d++) {
+        CeedScalar *vd = vv + d*cs;
+        const __m512d s = _mm512_add_pd(_mm512_i32gather_pd(idx, vd, 8),
+                                        _mm512_loadu_pd(ue + d*esize + i));
+        _mm512_i32scatter_pd(vd, idx, s, 8);
+      }
+    }
+  }
+}
+#endif
+
+// One kernel with NCOMP components, L-vector layout LMODE (suffix L) and
+//   blocks of BLKSIZE elements, e.g. CeedElemRestrictionGather_Ref_3T8
+#define CEED_RESTRICTION_KERNEL(KIND, ISA, ATTR, NCOMP, LMODE, L, BLKSIZE)   \
+  ATTR static void CeedElemRestriction##KIND##ISA##_##NCOMP##L##BLKSIZE(    \
+      CeedInt start, CeedInt stop, CeedInt nelem, CeedInt elemsize,         \
+      CeedInt ndof, const CeedInt *indices, const CeedScalar *u,            \
+      CeedScalar *v) {                                                      \
+    CeedElemRestriction##KIND##Kernel##ISA(NCOMP, LMODE, BLKSIZE, start,    \
+        stop, nelem, elemsize, ndof, indices, u, v);                        \
+  }
+// Both L-vector layouts
+#define CEED_RESTRICTION_KERNELS(KIND, ISA, ATTR, NCOMP, BLKSIZE)           \
+  CEED_RESTRICTION_KERNEL(KIND, ISA, ATTR, NCOMP, CEED_NOTRANSPOSE, N,      \
+                          BLKSIZE)                                          \
+  CEED_RESTRICTION_KERNEL(KIND, ISA, ATTR, NCOMP, CEED_TRANSPOSE, T,        \
+                          BLKSIZE)
+
+CEED_RESTRICTION_KERNELS(Gather, _Ref, , 1, 1)
+CEED_RESTRICTION_KERNELS(Gather, _Ref, , 1, 4)
+CEED_RESTRICTION_KERNELS(Gather, _Ref, , 1, 8)
+CEED_RESTRICTION_KERNELS(Gather, _Ref, , 3, 1)
+CEED_RESTRICTION_KERNELS(Gather, _Ref, , 3, 4)
+CEED_RESTRICTION_KERNELS(Gather, _Ref, , 3, 8)
+CEED_RESTRICTION_KERNELS(Scatter, _Ref, , 1, 1)
+CEED_RESTRICTION_KERNELS(Scatter, _Ref, , 1, 4)
+CEED_RESTRICTION_KERNELS(Scatter, _Ref, , 1, 8)
+CEED_RESTRICTION_KERNELS(Scatter, _Ref, , 3, 1)
+CEED_RESTRICTION_KERNELS(Scatter, _Ref, , 3, 4)
+CEED_RESTRICTION_KERNELS(Scatter, _Ref, , 3, 8)
+CEED_RESTRICTION_KERNELS(GatherShared, _Ref, , 1, 4)
+CEED_RESTRICTION_KERNELS(GatherShared, _Ref, , 1, 8)
+CEED_RESTRICTION_KERNELS(GatherShared, _Ref, , 3, 4)
+CEED_RESTRICTION_KERNELS(GatherShared, _Ref, , 3, 8)
+CEED_RESTRICTION_KERNELS(ScatterShared, _Ref, , 1, 4)
+CEED_RESTRICTION_KERNELS(ScatterShared, _Ref, , 1, 8)
+CEED_RESTRICTION_KERNELS(ScatterShared, _Ref, , 3, 4)
+CEED_RESTRICTION_KERNELS(ScatterShared, _Ref, , 3, 8)
+
+// Kernels by number of components (1 or 3), block size (1, 4 or 8) and
+//   L-vector layout
+static const CeedElemRestrictionKernel_Ref gather_ref[2][3][2] = {
+  { { CeedElemRestrictionGather_Ref_1N1,
+      CeedElemRestrictionGather_Ref_1T1 },
+    { CeedElemRestrictionGather_Ref_1N4,
+      CeedElemRestrictionGather_Ref_1T4 },
+    { CeedElemRestrictionGather_Ref_1N8,
+      CeedElemRestrictionGather_Ref_1T8 } },
+  { { CeedElemRestrictionGather_Ref_3N1,
+      CeedElemRestrictionGather_Ref_3T1 },
+    { CeedElemRestrictionGather_Ref_3N4,
+      CeedElemRestrictionGather_Ref_3T4 },
+    { CeedElemRestrictionGather_Ref_3N8,
+      CeedElemRestrictionGather_Ref_3T8 } }
+};
+static const CeedElemRestrictionKernel_Ref scatter_ref[2][3][2] = {
+  { { CeedElemRestrictionScatter_Ref_1N1,
+      CeedElemRestrictionScatter_Ref_1T1 },
+    { CeedElemRestrictionScatter_Ref_1N4,
+      CeedElemRestrictionScatter_Ref_1T4 },
+    { CeedElemRestrictionScatter_Ref_1N8,
+      CeedElemRestrictionScatter_Ref_1T8 } },
+  { { CeedElemRestrictionScatter_Ref_3N1,
+      CeedElemRestrictionScatter_Ref_3T1 },
+    { CeedElemRestrictionScatter_Ref_3N4,
+      CeedElemRestrictionScatter_Ref_3T4 },
+    { CeedElemRestrictionScatter_Ref_3N8,
+      CeedElemRestrictionScatter_Ref_3T8 } }
+};
+// Kernels of an unblocked restriction sharing the indices of its blocked
+//   copy, by number of components, block size of the indices (4 or 8) and
+//   L-vector layout
+static const CeedElemRestrictionKernel_Ref gather_shared_ref[2][2][2] = {
+  { { CeedElemRestrictionGatherShared_Ref_1N4,
+      CeedElemRestrictionGatherShared_Ref_1T4 },
+    { CeedElemRestrictionGatherShared_Ref_1N8,
+      CeedElemRestrictionGatherShared_Ref_1T8 } },
+  { { CeedElemRestrictionGatherShared_Ref_3N4,
+      CeedElemRestrictionGatherShared_Ref_3T4 },
+    { CeedElemRestrictionGatherShared_Ref_3N8,
+      CeedElemRestrictionGatherShared_Ref_3T8 } }
+};
+static const CeedElemRestrictionKernel_Ref scatter_shared_ref[2][2][2] = {
+  { { CeedElemRestrictionScatterShared_Ref_1N4,
+      CeedElemRestrictionScatterShared_Ref_1T4 },
+    { CeedElemRestrictionScatterShared_Ref_1N8,
+      CeedElemRestrictionScatterShared_Ref_1T8 } },
+  { { CeedElemRestrictionScatterShared_Ref_3N4,
+      CeedElemRestrictionScatterShared_Ref_3T4 },
+    { CeedElemRestrictionScatterShared_Ref_3N8,
+      CeedElemRestrictionScatterShared_Ref_3T8 } }
+};
+
+#ifdef CEED_RESTRICTION_SIMD
+#define CEED_AVX2 __attribute__((target("avx2")))
+#define CEED_AVX512 __attribute__((target("avx512f")))
+CEED_RESTRICTION_KERNELS(Gather, _Avx2, CEED_AVX2, 1, 4)
+CEED_RESTRICTION_KERNELS(Gather, _Avx2, CEED_AVX2, 1, 8)
+CEED_RESTRICTION_KERNELS(Gather, _Avx2, CEED_AVX2, 3, 4)
+CEED_RESTRICTION_KERNELS(Gather, _Avx2, CEED_AVX2, 3, 8)
+CEED_RESTRICTION_KERNELS(Gather, _Avx512, CEED_AVX512, 1, 8)
+CEED_RESTRICTION_KERNELS(Gather, _Avx512, CEED_AVX512, 3, 8)
+CEED_RESTRICTION_KERNELS(Scatter, _Avx512, CEED_AVX512, 1, 8)
+CEED_RESTRICTION_KERNELS(Scatter, _Avx512, CEED_AVX512, 3, 8)
+
+// AVX2 kernels by number of components, block size (4 or 8) and layout; AVX2
+//   has no scatter, so the transpose keeps the scalar kernels
+static const CeedElemRestrictionKernel_Ref gather_avx2[2][2][2] = {
+  { { CeedElemRestrictionGather_Avx2_1N4,
+      CeedElemRestrictionGather_Avx2_1T4 },
+    { CeedElemRestrictionGather_Avx2_1N8,
+      CeedElemRestrictionGather_Avx2_1T8 } },
+  { { CeedElemRestrictionGather_Avx2_3N4,
+      CeedElemRestrictionGather_Avx2_3T4 },
+    { CeedElemRestrictionGather_Avx2_3N8,
+      CeedElemRestrictionGather_Avx2_3T8 } }
+};
+// AVX-512 kernels by number of components and layout, for blocks of 8
+static const CeedElemRestrictionKernel_Ref gather_avx512[2][2] = {
+  { CeedElemRestrictionGather_Avx512_1N8,
+    CeedElemRestrictionGather_Avx512_1T8 },
+  { CeedElemRestrictionGather_Avx512_3N8,
+    CeedElemRestrictionGather_Avx512_3T8 }
+};
+static const CeedElemRestrictionKernel_Ref scatter_avx512[2][2] = {
+  { CeedElemRestrictionScatter_Avx512_1N8,
+    CeedElemRestrictionScatter_Avx512_1T8 },
+  { CeedElemRestrictionScatter_Avx512_3N8,
+    CeedElemRestrictionScatter_Avx512_3T8 }
+};
+#endif
+
+// Apply the restriction to elements [start, stop) of the arrays uu and vv;
+//   the E-vector vv (or uu for the transpose) holds only those elements
+int CeedElemRestrictionApplyRange_Ref(CeedElemRestriction r,
+                                      CeedInt start, CeedInt stop,
+                                      CeedTransposeMode tmode,
+                                      CeedTransposeMode lmode,
+                                      const CeedScalar *uu, CeedScalar *vv) {
   int ierr;
   CeedElemRestriction_Ref *impl;
-  ierr = CeedElemRestrictionGetData(r, (void*)&impl); CeedChk(ierr);;
-  const CeedScalar *uu;
-  CeedScalar *vv;
-  CeedInt nblk, blksize, nelem, elemsize, ndof, ncomp;
-  ierr = CeedElemRestrictionGetNumBlocks(r, &nblk); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetData(r, (void*)&impl); CeedChk(ierr);
+  CeedInt blksize, nelem, elemsize, ndof, ncomp;
   ierr = CeedElemRestrictionGetBlockSize(r, &blksize); CeedChk(ierr);
   ierr = CeedElemRestrictionGetNumElements(r, &nelem); CeedChk(ierr);
   ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
   ierr = CeedElemRestrictionGetNumDoF(r, &ndof); CeedChk(ierr);
   ierr = CeedElemRestrictionGetNumComponents(r, &ncomp); CeedChk(ierr);
+  CeedInt *strides;
+  ierr = CeedElemRestrictionGetStrides(r, &strides); CeedChk(ierr);
+  CeedInt *cartesian;
+  ierr = CeedElemRestrictionGetCartesian(r, &cartesian); CeedChk(ierr);
+  // Offsets of the nodes and components of the L-vector
+  const CeedInt ls = lmode == CEED_NOTRANSPOSE ? 1 : ncomp,
+                cs = lmode == CEED_NOTRANSPOSE ? ndof : 1;
 
-  ierr = CeedVectorGetArrayRead(u, CEED_MEM_HOST, &uu); CeedChk(ierr);
-  ierr = CeedVectorGetArray(v, CEED_MEM_HOST, &vv); CeedChk(ierr);
   // Restriction from lvector to evector
   // Perform: v = r * u
   if (tmode == CEED_NOTRANSPOSE) {
-    // No indicies provided, Identity Restriction
-    if (!impl->indices) {
-      for (CeedInt e = 0; e < nblk*blksize; e+=blksize)
-        for (CeedInt j = 0; j < blksize; j++)
-          for (CeedInt k = 0; k < ncomp*elemsize; k++)
-            vv[e*elemsize*ncomp + k*blksize + j]
-              = uu[CeedIntMin(e+j,nelem-1)*ncomp*elemsize + k];
+    // Cartesian restriction, indices computed from the box
+    if (cartesian) {
+      for (CeedInt e = start; e < stop; e+=blksize)
+        for (CeedInt j = 0; j < blksize; j++) {
+          CeedInt n[3], ns[3], es[3];
+          const CeedInt off = CeedCartesianElement_Ref(cartesian,
+                              CeedIntMin(e+j,nelem-1), n, ns, es);
+          for (CeedInt d = 0; d < ncomp; d++) {
+            const CeedScalar *ud = uu + d*cs;
+            CeedScalar *vd = vv + (e-start)*elemsize*ncomp + d*elemsize*blksize
+                             + j;
+            for (CeedInt k = 0; k < n[2]; k++)
+              for (CeedInt l = 0; l < n[1]; l++) {
+                const CeedInt o = off + k*ns[2] + l*ns[1],
+                              eo = k*es[2] + l*es[1];
+                for (CeedInt m = 0; m < n[0]; m++)
+                  vd[(eo+m*es[0])*blksize] = ud[(o+m)*ls];
+              }
+          }
+        }
+    } else if (impl->runoffsets) {
+      // Indices stored as runs of consecutive L-vector nodes
+      for (CeedInt e = start; e < stop; e+=blksize)
+        for (CeedInt j = 0; j < blksize; j++) {
+          const CeedInt el = CeedIntMin(e+j,nelem-1);
+          for (CeedInt d = 0; d < ncomp; d++) {
+            const CeedScalar *ud = uu + d*cs;
+            CeedScalar *vd = vv + (e-start)*elemsize*ncomp + d*elemsize*blksize
+                             + j;
+            for (CeedInt r = impl->runoffsets[el]; r < impl->runoffsets[el+1];
+                 r++) {
+              const CeedInt o = impl->runs[2*r], len = impl->runs[2*r+1];
+              for (CeedInt m = 0; m < len; m++)
+                vd[m*blksize] = ud[(o+m)*ls];
+              vd += len*blksize;
+            }
+          }
+        }
+    } else if (!impl->indices) {
+      // No indicies provided, strided restriction, node i of component d of
+      // element e at i*strides[0] + d*strides[1] + e*strides[2]
+      for (CeedInt e = start; e < stop; e+=blksize)
+        for (CeedInt j = 0; j < blksize; j++) {
+          const CeedScalar *ue = uu + CeedIntMin(e+j,nelem-1)*strides[2];
+          for (CeedInt d = 0; d < ncomp; d++)
+            for (CeedInt i = 0; i < elemsize; i++)
+              vv[(e-start)*elemsize*ncomp + (d*elemsize+i)*blksize + j]
+                = ue[i*strides[0] + d*strides[1]];
+        }
+    } else if (impl->gather[lmode]) {
+      // Kernel specialized at creation
+      impl->gather[lmode](start, stop, nelem, elemsize, ndof, impl->indices, uu,
+                          vv);
+    } else if (impl->indblksize != blksize) {
+      // Indices of the blocked copy, see CeedElemRestrictionGetBlocked_Ref()
+      const CeedInt ib = impl->indblksize;
+      for (CeedInt e = start; e < stop; e++)
+        for (CeedInt k = 0; k < elemsize; k++) {
+          const CeedInt n = impl->indices[(e/ib)*ib*elemsize + k*ib + e%ib];
+          for (CeedInt d = 0; d < ncomp; d++)
+            vv[((e-start)*ncomp+d)*elemsize + k] = uu[n*ls + d*cs];
+        }
     } else {
       // Indicies provided, standard or blocked restriction
       // vv has shape [elemsize, ncomp, nelem], row-major
       // uu has shape [ndof, ncomp]
-      for (CeedInt e = 0; e < nblk*blksize; e+=blksize)
+      for (CeedInt e = start; e < stop; e+=blksize)
         for (CeedInt d = 0; d < ncomp; d++)
           for (CeedInt i = 0; i < elemsize*blksize; i++)
-            vv[i+elemsize*(d*blksize+ncomp*e)]
+            vv[i+elemsize*(d*blksize+ncomp*(e-start))]
               = uu[lmode == CEED_NOTRANSPOSE
                          ? impl->indices[i+elemsize*e]+ndof*d
                          : d+ncomp*impl->indices[i+elemsize*e]];
@@ -61,17 +423,70 @@ static int CeedElemRestrictionApply_Ref(CeedElemRestriction r,
   } else {
     // Restriction from evector to lvector
     // Performing v += r^T * u
-    // No indicies provided, Identity Restriction
-    if (!impl->indices) {
-      for (CeedInt e = 0; e < nblk*blksize; e+=blksize)
+    // Cartesian restriction, indices computed from the box
+    if (cartesian) {
+      for (CeedInt e = start; e < stop; e+=blksize)
+        for (CeedInt j = 0; j < CeedIntMin(blksize, nelem-e); j++) {
+          CeedInt n[3], ns[3], es[3];
+          const CeedInt off = CeedCartesianElement_Ref(cartesian, e+j, n, ns,
+                              es);
+          for (CeedInt d = 0; d < ncomp; d++) {
+            CeedScalar *vd = vv + d*cs;
+            const CeedScalar *ud = uu + (e-start)*elemsize*ncomp
+                                   + d*elemsize*blksize + j;
+            for (CeedInt k = 0; k < n[2]; k++)
+              for (CeedInt l = 0; l < n[1]; l++) {
+                const CeedInt o = off + k*ns[2] + l*ns[1],
+                              eo = k*es[2] + l*es[1];
+                for (CeedInt m = 0; m < n[0]; m++)
+                  vd[(o+m)*ls] += ud[(eo+m*es[0])*blksize];
+              }
+          }
+        }
+    } else if (impl->runoffsets) {
+      // Indices stored as runs of consecutive L-vector nodes
+      for (CeedInt e = start; e < stop; e+=blksize)
         for (CeedInt j = 0; j < CeedIntMin(blksize, nelem-e); j++)
-          for (CeedInt k = 0; k < ncomp*elemsize; k++)
-            vv[(e+j)*ncomp*elemsize + k] += uu[e*elemsize*ncomp + k*blksize + j];
+          for (CeedInt d = 0; d < ncomp; d++) {
+            CeedScalar *vd = vv + d*cs;
+            const CeedScalar *ud = uu + (e-start)*elemsize*ncomp
+                                   + d*elemsize*blksize + j;
+            for (CeedInt r = impl->runoffsets[e+j];
+                 r < impl->runoffsets[e+j+1]; r++) {
+              const CeedInt o = impl->runs[2*r], len = impl->runs[2*r+1];
+              for (CeedInt m = 0; m < len; m++)
+                vd[(o+m)*ls] += ud[m*blksize];
+              ud += len*blksize;
+            }
+          }
+    } else if (!impl->indices) {
+      // No indicies provided, strided restriction
+      for (CeedInt e = start; e < stop; e+=blksize)
+        for (CeedInt j = 0; j < CeedIntMin(blksize, nelem-e); j++) {
+          CeedScalar *ve = vv + (e+j)*strides[2];
+          for (CeedInt d = 0; d < ncomp; d++)
+            for (CeedInt i = 0; i < elemsize; i++)
+              ve[i*strides[0] + d*strides[1]]
+                += uu[(e-start)*elemsize*ncomp + (d*elemsize+i)*blksize + j];
+        }
+    } else if (impl->scatter[lmode]) {
+      // Kernel specialized at creation
+      impl->scatter[lmode](start, stop, nelem, elemsize, ndof, impl->indices,
+                           uu, vv);
+    } else if (impl->indblksize != blksize) {
+      // Indices of the blocked copy, see CeedElemRestrictionGetBlocked_Ref()
+      const CeedInt ib = impl->indblksize;
+      for (CeedInt e = start; e < CeedIntMin(stop, nelem); e++)
+        for (CeedInt k = 0; k < elemsize; k++) {
+          const CeedInt n = impl->indices[(e/ib)*ib*elemsize + k*ib + e%ib];
+          for (CeedInt d = 0; d < ncomp; d++)
+            vv[n*ls + d*cs] += uu[((e-start)*ncomp+d)*elemsize + k];
+        }
     } else {
       // Indicies provided, standard or blocked restriction
       // uu has shape [elemsize, ncomp, nelem]
       // vv has shape [ndof, ncomp]
-      for (CeedInt e = 0; e < nblk*blksize; e+=blksize) {
+      for (CeedInt e = start; e < stop; e+=blksize) {
         for (CeedInt d = 0; d < ncomp; d++)
           for (CeedInt i = 0; i < elemsize*blksize; i+=blksize)
             // Iteration bound set to discard padding elements
@@ -79,10 +494,92 @@ static int CeedElemRestrictionApply_Ref(CeedElemRestriction r,
               vv[lmode == CEED_NOTRANSPOSE
                        ? impl->indices[j+e*elemsize]+ndof*d
                        : d+ncomp*impl->indices[j+e*elemsize]]
-              += uu[j+elemsize*(d*blksize+ncomp*e)];
+              += uu[j+elemsize*(d*blksize+ncomp*(e-start))];
       }
     }
   }
+  return 0;
+}
+
+// Apply the restriction to all its elements; the transpose adds to v, or
+//   overwrites it. With indices, each L-vector node of the transpose gathers
+//   the element nodes that reference it, see
+//   CeedElemRestrictionGetTranspose_Ref().
+static int CeedElemRestrictionApplyAll_Ref(CeedElemRestriction r,
+    CeedTransposeMode tmode, CeedTransposeMode lmode, bool overwrite,
+    CeedVector u, CeedVector v, CeedRequest *request) {
+  int ierr;
+  CeedInt nblk, blksize, elemsize, ndof, ncomp;
+  const CeedScalar *uu;
+  CeedScalar *vv;
+  ierr = CeedElemRestrictionGetNumBlocks(r, &nblk); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetBlockSize(r, &blksize); CeedChk(ierr);
+  const CeedInt *toffsets = NULL, *tindices = NULL;
+  if (tmode == CEED_TRANSPOSE) {
+    ierr = CeedElemRestrictionGetTranspose_Ref(r, &toffsets, &tindices);
+    CeedChk(ierr);
+  }
+  if (tindices) {
+    ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+    ierr = CeedElemRestrictionGetNumDoF(r, &ndof); CeedChk(ierr);
+    ierr = CeedElemRestrictionGetNumComponents(r, &ncomp); CeedChk(ierr);
+    ierr = CeedVectorGetArrayRead(u, CEED_MEM_HOST, &uu); CeedChk(ierr);
+    ierr = CeedVectorGetArray(v, CEED_MEM_HOST, &vv); CeedChk(ierr);
+    for (CeedInt n = 0; n < ndof; n++)
+      for (CeedInt d = 0; d < ncomp; d++) {
+        const CeedScalar *ud = uu + d*elemsize*blksize;
+        CeedScalar *vn = vv + (lmode == CEED_NOTRANSPOSE ? n+ndof*d
+                               : d+ncomp*n);
+        CeedScalar vsum = overwrite ? 0.0 : *vn;
+        for (CeedInt j = toffsets[n]; j < toffsets[n+1]; j++)
+          vsum += ud[tindices[j]];
+        *vn = vsum;
+      }
+    ierr = CeedVectorRestoreArrayRead(u, &uu); CeedChk(ierr);
+    ierr = CeedVectorRestoreArray(v, &vv); CeedChk(ierr);
+  } else {
+    if (tmode == CEED_TRANSPOSE && overwrite) {
+      ierr = CeedVectorSetValue(v, 0.0); CeedChk(ierr);
+    }
+    ierr = CeedVectorGetArrayRead(u, CEED_MEM_HOST, &uu); CeedChk(ierr);
+    ierr = CeedVectorGetArray(v, CEED_MEM_HOST, &vv); CeedChk(ierr);
+    ierr = CeedElemRestrictionApplyRange_Ref(r, 0, nblk*blksize, tmode, lmode,
+           uu, vv); CeedChk(ierr);
+    ierr = CeedVectorRestoreArrayRead(u, &uu); CeedChk(ierr);
+    ierr = CeedVectorRestoreArray(v, &vv); CeedChk(ierr);
+  }
+  if (request != CEED_REQUEST_IMMEDIATE && request != CEED_REQUEST_ORDERED)
+    *request = NULL;
+  return 0;
+}
+
+int CeedElemRestrictionApply_Ref(CeedElemRestriction r,
+                                 CeedTransposeMode tmode,
+                                 CeedTransposeMode lmode, CeedVector u,
+                                 CeedVector v, CeedRequest *request) {
+  return CeedElemRestrictionApplyAll_Ref(r, tmode, lmode, false, u, v,
+                                         request);
+}
+
+int CeedElemRestrictionApplyOverwrite_Ref(CeedElemRestriction r,
+    CeedTransposeMode tmode, CeedTransposeMode lmode, CeedVector u,
+    CeedVector v, CeedRequest *request) {
+  return CeedElemRestrictionApplyAll_Ref(r, tmode, lmode, true, u, v,
+                                         request);
+}
+
+static int CeedElemRestrictionApplyBlock_Ref(CeedElemRestriction r,
+    CeedInt block, CeedTransposeMode tmode, CeedTransposeMode lmode,
+    CeedVector u, CeedVector v, CeedRequest *request) {
+  int ierr;
+  CeedInt blksize;
+  const CeedScalar *uu;
+  CeedScalar *vv;
+  ierr = CeedElemRestrictionGetBlockSize(r, &blksize); CeedChk(ierr);
+  ierr = CeedVectorGetArrayRead(u, CEED_MEM_HOST, &uu); CeedChk(ierr);
+  ierr = CeedVectorGetArray(v, CEED_MEM_HOST, &vv); CeedChk(ierr);
+  ierr = CeedElemRestrictionApplyRange_Ref(r, block*blksize,
+         (block+1)*blksize, tmode, lmode, uu, vv); CeedChk(ierr);
   ierr = CeedVectorRestoreArrayRead(u, &uu); CeedChk(ierr);
   ierr = CeedVectorRestoreArray(v, &vv); CeedChk(ierr);
   if (request != CEED_REQUEST_IMMEDIATE && request != CEED_REQUEST_ORDERED)
@@ -90,16 +587,446 @@ static int CeedElemRestrictionApply_Ref(CeedElemRestriction r,
   return 0;
 }
 
+// L-vector offsets of component 0 of the nodes of element e of the
+//   restriction r, with ls the offset between consecutive nodes of an indexed
+//   or Cartesian restriction; returns the offset between components, cs
+//   unless r is strided
+static CeedInt CeedElemRestrictionElementNodes_Ref(
+    const CeedElemRestriction_Ref *impl, CeedInt e, CeedInt elemsize,
+    const CeedInt *cartesian, const CeedInt *strides, CeedInt ls, CeedInt cs,
+    CeedInt *nodes) {
+  const CeedInt ib = impl->indblksize;
+  if (cartesian) {
+    CeedInt n[3], ns[3], es[3];
+    const CeedInt off = CeedCartesianElement_Ref(cartesian, e, n, ns, es);
+    for (CeedInt k = 0; k < n[2]; k++)
+      for (CeedInt l = 0; l < n[1]; l++)
+        for (CeedInt m = 0; m < n[0]; m++)
+          nodes[k*es[2] + l*es[1] + m*es[0]] = (off + k*ns[2] + l*ns[1]
+                                                + m)*ls;
+  } else if (impl->runoffsets) {
+    CeedInt *nd = nodes;
+    for (CeedInt r = impl->runoffsets[e]; r < impl->runoffsets[e+1]; r++)
+      for (CeedInt m = 0; m < impl->runs[2*r+1]; m++)
+        *nd++ = (impl->runs[2*r] + m)*ls;
+  } else if (!impl->indices) {
+    for (CeedInt k = 0; k < elemsize; k++)
+      nodes[k] = e*strides[2] + k*strides[0];
+    return strides[1];
+  } else {
+    for (CeedInt k = 0; k < elemsize; k++)
+      nodes[k] = impl->indices[(e/ib)*ib*elemsize + k*ib + e%ib]*ls;
+  }
+  return cs;
+}
+
+// Apply the restriction to the elements elems[0..nsel), nsel <= blksize,
+//   packed into the lanes of a single block of the E-vector v (or u for the
+//   transpose), whatever the blocks they belong to. The gather pads the block
+//   with the last element, the transpose adds the nsel lanes only, so the
+//   cost is that of the listed elements, see CeedOperatorPlanApply_Ref().
+int CeedElemRestrictionApplyElements_Ref(CeedElemRestriction r, CeedInt nsel,
+    const CeedInt *elems, CeedTransposeMode tmode, CeedTransposeMode lmode,
+    const CeedScalar *u, CeedScalar *v) {
+  int ierr;
+  CeedElemRestriction_Ref *impl;
+  ierr = CeedElemRestrictionGetData(r, (void*)&impl); CeedChk(ierr);
+  CeedInt blksize, elemsize, ndof, ncomp;
+  ierr = CeedElemRestrictionGetBlockSize(r, &blksize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumDoF(r, &ndof); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumComponents(r, &ncomp); CeedChk(ierr);
+  CeedInt *strides;
+  ierr = CeedElemRestrictionGetStrides(r, &strides); CeedChk(ierr);
+  CeedInt *cartesian;
+  ierr = CeedElemRestrictionGetCartesian(r, &cartesian); CeedChk(ierr);
+  const CeedInt ls = lmode == CEED_NOTRANSPOSE ? 1 : ncomp,
+                cs = lmode == CEED_NOTRANSPOSE ? ndof : 1;
+  const CeedInt nlanes = tmode == CEED_NOTRANSPOSE ? blksize : nsel;
+
+  for (CeedInt j = 0; j < nlanes; j++) {
+    const CeedInt e = elems[CeedIntMin(j, nsel-1)];
+    CeedInt nodes[elemsize];
+    const CeedInt dstride = CeedElemRestrictionElementNodes_Ref(impl, e,
+                            elemsize, cartesian, strides, ls, cs, nodes);
+
+    if (tmode == CEED_NOTRANSPOSE) {
+      for (CeedInt d = 0; d < ncomp; d++)
+        for (CeedInt k = 0; k < elemsize; k++)
+          v[(d*elemsize+k)*blksize + j] = u[nodes[k] + d*dstride];
+    } else {
+      for (CeedInt d = 0; d < ncomp; d++)
+        for (CeedInt k = 0; k < elemsize; k++)
+          v[nodes[k] + d*dstride] += u[(d*elemsize+k)*blksize + j];
+    }
+  }
+  return 0;
+}
+
+// Order pairs of an L-vector offset and an E-vector offset
+static int CeedIntPairCompare_Ref(const void *a, const void *b) {
+  const CeedInt *x = (const CeedInt *)a, *y = (const CeedInt *)b;
+  return x[0] != y[0] ? (x[0] > y[0]) - (x[0] < y[0])
+         : (x[1] > y[1]) - (x[1] < y[1]);
+}
+
+// Build the transpose of the restriction to the elements elems[0..nsel)
+//   packed into consecutive blocks of an E-vector, block b holding
+//   elems[b*blksize..) as in CeedElemRestrictionApplyElements_Ref(): the
+//   distinct L-vector nodes of those elements, each with the E-vector offsets
+//   of the element nodes referencing it, so that the nodes can be added to
+//   independently.  Its cost is that of the listed elements.
+int CeedElemRestrictionBuildElementsTranspose_Ref(CeedElemRestriction r,
+    CeedInt nsel, const CeedInt *elems, CeedTransposeMode lmode,
+    CeedElemTranspose_Ref *t) {
+  int ierr;
+  CeedElemRestriction_Ref *impl;
+  ierr = CeedElemRestrictionGetData(r, (void*)&impl); CeedChk(ierr);
+  CeedInt blksize, elemsize, ndof, ncomp;
+  ierr = CeedElemRestrictionGetBlockSize(r, &blksize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumDoF(r, &ndof); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumComponents(r, &ncomp); CeedChk(ierr);
+  CeedInt *strides;
+  ierr = CeedElemRestrictionGetStrides(r, &strides); CeedChk(ierr);
+  CeedInt *cartesian;
+  ierr = CeedElemRestrictionGetCartesian(r, &cartesian); CeedChk(ierr);
+  const CeedInt ls = lmode == CEED_NOTRANSPOSE ? 1 : ncomp,
+                cs = lmode == CEED_NOTRANSPOSE ? ndof : 1,
+                nent = nsel*elemsize;
+
+  // Pairs of an L-vector node and the packed E-vector offset of an element
+  //   node referencing it, sorted by node
+  CeedInt *pairs;
+  ierr = CeedMalloc(2*nent, &pairs); CeedChk(ierr);
+  t->dstride = cs;
+  for (CeedInt j = 0; j < nsel; j++) {
+    CeedInt nodes[elemsize];
+    t->dstride = CeedElemRestrictionElementNodes_Ref(impl, elems[j],
+                 elemsize, cartesian, strides, ls, cs, nodes);
+    for (CeedInt k = 0; k < elemsize; k++) {
+      CeedInt *pr = &pairs[2*(j*elemsize + k)];
+      pr[0] = nodes[k];
+      pr[1] = (j/blksize)*blksize*elemsize*ncomp + k*blksize + j%blksize;
+    }
+  }
+  qsort(pairs, nent, 2*sizeof(pairs[0]), CeedIntPairCompare_Ref);
+
+  ierr = CeedMalloc(nent, &t->lnodes); CeedChk(ierr);
+  ierr = CeedMalloc(nent+1, &t->toffsets); CeedChk(ierr);
+  ierr = CeedMalloc(nent, &t->tindices); CeedChk(ierr);
+  t->nnodes = 0;
+  for (CeedInt j = 0; j < nent; j++) {
+    if (!j || pairs[2*j] != pairs[2*(j-1)]) {
+      t->lnodes[t->nnodes] = pairs[2*j];
+      t->toffsets[t->nnodes++] = j;
+    }
+    t->tindices[j] = pairs[2*j+1];
+  }
+  t->toffsets[t->nnodes] = nent;
+  ierr = CeedFree(&pairs); CeedChk(ierr);
+  return 0;
+}
+
+int CeedElemTransposeDestroy_Ref(CeedElemTranspose_Ref *t) {
+  int ierr;
+  ierr = CeedFree(&t->lnodes); CeedChk(ierr);
+  ierr = CeedFree(&t->toffsets); CeedChk(ierr);
+  ierr = CeedFree(&t->tindices); CeedChk(ierr);
+  t->nnodes = 0;
+  return 0;
+}
+
 static int CeedElemRestrictionDestroy_Ref(CeedElemRestriction r) {
   int ierr;
   CeedElemRestriction_Ref *impl;
   ierr = CeedElemRestrictionGetData(r, (void*)&impl); CeedChk(ierr);
 
   ierr = CeedFree(&impl->indices_allocated); CeedChk(ierr);
+  ierr = CeedFree(&impl->runoffsets); CeedChk(ierr);
+  ierr = CeedFree(&impl->runs); CeedChk(ierr);
+  ierr = CeedFree(&impl->toffsets); CeedChk(ierr);
+  ierr = CeedFree(&impl->tindices); CeedChk(ierr);
+  ierr = CeedElemRestrictionDestroy(&impl->blocked); CeedChk(ierr);
   ierr = CeedFree(&impl); CeedChk(ierr);
   return 0;
 }
 
+// Store the indices of each element as runs of consecutive L-vector nodes,
+//   if the runs are long enough on average for the apply to read much less;
+//   the runs then replace the indices, see CeedElemRestrictionCreate_Ref()
+static int CeedElemRestrictionCompress_Ref(CeedElemRestriction r,
+    CeedElemRestriction_Ref *impl) {
+  int ierr;
+  CeedInt nelem, elemsize, blksize;
+  ierr = CeedElemRestrictionGetNumElements(r, &nelem); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetBlockSize(r, &blksize); CeedChk(ierr);
+  const CeedInt *ind = impl->indices;
+
+  // Node k of element e, the indices may be blocked
+#define CEED_REF_IND(e, k) ind[((e)/blksize)*blksize*elemsize \
+                               + (k)*blksize + (e)%blksize]
+  CeedInt nruns = 0;
+  for (CeedInt e = 0; e < nelem; e++)
+    for (CeedInt k = 0; k < elemsize; k++)
+      nruns += !k || CEED_REF_IND(e, k) != CEED_REF_IND(e, k-1) + 1;
+  if (nruns*CEED_RUN_MIN > nelem*elemsize)
+    return 0;
+
+  ierr = CeedMalloc(nelem+1, &impl->runoffsets); CeedChk(ierr);
+  ierr = CeedMalloc(2*nruns, &impl->runs); CeedChk(ierr);
+  nruns = 0;
+  for (CeedInt e = 0; e < nelem; e++) {
+    impl->runoffsets[e] = nruns;
+    for (CeedInt k = 0; k < elemsize; k++) {
+      if (!k || CEED_REF_IND(e, k) != CEED_REF_IND(e, k-1) + 1) {
+        impl->runs[2*nruns] = CEED_REF_IND(e, k);
+        impl->runs[2*nruns+1] = 0;
+        nruns++;
+      }
+      impl->runs[2*nruns-1]++;
+    }
+  }
+  impl->runoffsets[nelem] = nruns;
+#undef CEED_REF_IND
+  return 0;
+}
+
+// Indices of each element in order, from the indices whatever their blocking
+//   or, once those are dropped, from the runs; *ind is freed by the caller
+static int CeedElemRestrictionGetElementIndices_Ref(CeedElemRestriction r,
+    CeedElemRestriction_Ref *impl, CeedInt **ind) {
+  int ierr;
+  CeedInt nelem, elemsize;
+  ierr = CeedElemRestrictionGetNumElements(r, &nelem); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+  ierr = CeedMalloc(nelem*elemsize, ind); CeedChk(ierr);
+  if (impl->indices) {
+    const CeedInt ib = impl->indblksize;
+    for (CeedInt e = 0; e < nelem; e++)
+      for (CeedInt k = 0; k < elemsize; k++)
+        (*ind)[e*elemsize+k] = impl->indices[(e/ib)*ib*elemsize + k*ib
+                                             + e%ib];
+  } else {
+    CeedInt *n = *ind;
+    for (CeedInt r = 0; r < impl->runoffsets[nelem]; r++)
+      for (CeedInt m = 0; m < impl->runs[2*r+1]; m++)
+        *n++ = impl->runs[2*r] + m;
+  }
+  return 0;
+}
+
+// Build the transpose of a restriction with indices: for each L-vector node,
+//   the offsets in the (component 0) E-vector of every element node that
+//   references it. Padding elements are skipped, so each node can be
+//   assembled by a single thread without atomics.
+static int CeedElemRestrictionBuildTranspose_Ref(CeedElemRestriction r,
+    CeedElemRestriction_Ref *impl) {
+  int ierr;
+  CeedInt nelem, elemsize, ndof, ncomp, blksize;
+  ierr = CeedElemRestrictionGetNumElements(r, &nelem); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumDoF(r, &ndof); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumComponents(r, &ncomp); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetBlockSize(r, &blksize); CeedChk(ierr);
+  CeedInt *ind, *count;
+  ierr = CeedElemRestrictionGetElementIndices_Ref(r, impl, &ind); CeedChk(ierr);
+
+  ierr = CeedCalloc(ndof+1, &impl->toffsets); CeedChk(ierr);
+  ierr = CeedMalloc(nelem*elemsize, &impl->tindices); CeedChk(ierr);
+  ierr = CeedCalloc(ndof, &count); CeedChk(ierr);
+  for (CeedInt i = 0; i < nelem*elemsize; i++)
+    impl->toffsets[ind[i] + 1]++;
+  for (CeedInt n = 0; n < ndof; n++)
+    impl->toffsets[n+1] += impl->toffsets[n];
+  for (CeedInt e = 0; e < nelem; e++)
+    for (CeedInt k = 0; k < elemsize; k++) {
+      const CeedInt n = ind[e*elemsize+k];
+      impl->tindices[impl->toffsets[n] + count[n]++]
+        = (e/blksize)*blksize*elemsize*ncomp + k*blksize + e%blksize;
+    }
+  ierr = CeedFree(&count); CeedChk(ierr);
+  ierr = CeedFree(&ind); CeedChk(ierr);
+  return 0;
+}
+
+// Transpose of a restriction with indices, built on first use and kept by
+//   the restriction; NULL for strided and Cartesian restrictions
+int CeedElemRestrictionGetTranspose_Ref(CeedElemRestriction r,
+                                        const CeedInt **toffsets,
+                                        const CeedInt **tindices) {
+  int ierr;
+  CeedElemRestriction_Ref *impl;
+  ierr = CeedElemRestrictionGetData(r, (void*)&impl); CeedChk(ierr);
+  if (!impl->tindices && (impl->indices || impl->runoffsets)) {
+    ierr = CeedElemRestrictionBuildTranspose_Ref(r, impl); CeedChk(ierr);
+  }
+  *toffsets = impl->toffsets;
+  *tindices = impl->tindices;
+  return 0;
+}
+
+// Whether the elements of each full block reference distinct L-vector nodes
+//   at every element node, so that the lanes of a scatter over a block never
+//   collide
+static bool CeedElemRestrictionConflictFree_Ref(CeedInt nelem,
+    CeedInt elemsize, CeedInt blksize, const CeedInt *ind) {
+  for (CeedInt e = 0; e+blksize <= nelem; e+=blksize)
+    for (CeedInt k = 0; k < elemsize; k++) {
+      const CeedInt *n = ind + e*elemsize + k*blksize;
+      for (CeedInt j = 1; j < blksize; j++)
+        for (CeedInt l = 0; l < j; l++)
+          if (n[j] == n[l])
+            return false;
+    }
+  return true;
+}
+
+// Pick the gather and scatter kernels of a restriction with uncompressed
+//   indices, for 1 or 3 components and blocks of 1, 4 or 8 elements, or
+//   indices shared with a blocked copy in blocks of 4 or 8; the SIMD kernels
+//   are chosen by the instruction set detected by CeedInit_Ref()
+static int CeedElemRestrictionSetKernels_Ref(CeedElemRestriction r,
+    CeedElemRestriction_Ref *impl) {
+  int ierr;
+  CeedInt nelem, elemsize, ncomp, blksize;
+  ierr = CeedElemRestrictionGetNumElements(r, &nelem); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumComponents(r, &ncomp); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetBlockSize(r, &blksize); CeedChk(ierr);
+  for (int lmode = 0; lmode < 2; lmode++)
+    impl->gather[lmode] = impl->scatter[lmode] = NULL;
+  const int c = ncomp == 1 ? 0 : ncomp == 3 ? 1 : -1,
+            b = blksize == 1 ? 0 : blksize == 4 ? 1 : blksize == 8 ? 2 : -1;
+  if (impl->indblksize != blksize) {
+    const CeedInt ib = impl->indblksize;
+    if (c < 0 || (ib != 4 && ib != 8))
+      return 0;
+    for (int lmode = 0; lmode < 2; lmode++) {
+      impl->gather[lmode] = gather_shared_ref[c][ib == 8][lmode];
+      impl->scatter[lmode] = scatter_shared_ref[c][ib == 8][lmode];
+    }
+    return 0;
+  }
+  if (c < 0 || b < 0)
+    return 0;
+
+  for (int lmode = 0; lmode < 2; lmode++) {
+    impl->gather[lmode] = gather_ref[c][b][lmode];
+    impl->scatter[lmode] = scatter_ref[c][b][lmode];
+  }
+#ifdef CEED_RESTRICTION_SIMD
+  if (sizeof(CeedScalar) != sizeof(double) || sizeof(CeedInt) != 4)
+    return 0;
+  Ceed ceed;
+  ierr = CeedElemRestrictionGetCeed(r, &ceed); CeedChk(ierr);
+  int isa;
+  ierr = CeedGetISA_Ref(ceed, &isa); CeedChk(ierr);
+  const bool conflictfree = isa == 3 && blksize == 8 &&
+                            CeedElemRestrictionConflictFree_Ref(nelem,
+                                elemsize, blksize, impl->indices);
+  for (int lmode = 0; lmode < 2; lmode++) {
+    if (isa == 3 && blksize == 8)
+      impl->gather[lmode] = gather_avx512[c][lmode];
+    else if (isa >= 2 && blksize > 1)
+      impl->gather[lmode] = gather_avx2[c][b-1][lmode];
+    if (conflictfree)
+      impl->scatter[lmode] = scatter_avx512[c][lmode];
+  }
+#endif
+  return 0;
+}
+
+// Replace the indices of an unblocked restriction that owns them by those of
+//   its blocked copy, if allowed by CeedElemRestrictionSetIndexSharing(); the
+//   kernels are rebound to the blocked indices
+static int CeedElemRestrictionShareIndices_Ref(CeedElemRestriction r,
+    CeedElemRestriction_Ref *impl) {
+  int ierr;
+  bool share;
+  ierr = CeedElemRestrictionGetIndexSharing(r, &share); CeedChk(ierr);
+  CeedInt rblksize, blksize;
+  ierr = CeedElemRestrictionGetBlockSize(r, &rblksize); CeedChk(ierr);
+  if (!share || !impl->indices_allocated || rblksize != 1)
+    return 0;
+  CeedElemRestriction_Ref *blkimpl;
+  ierr = CeedElemRestrictionGetData(impl->blocked, (void*)&blkimpl);
+  CeedChk(ierr);
+  if (!blkimpl->indices)
+    return 0;
+
+  ierr = CeedElemRestrictionGetBlockSize(impl->blocked, &blksize);
+  CeedChk(ierr);
+  ierr = CeedFree(&impl->indices_allocated); CeedChk(ierr);
+  impl->indices = blkimpl->indices;
+  impl->indblksize = blksize;
+  ierr = CeedElemRestrictionSetKernels_Ref(r, impl); CeedChk(ierr);
+  return 0;
+}
+
+// Blocked copy of r for operators that process blksize elements at a time,
+//   r itself if already blocked so. The first copy is built once, kept by r and
+//   shared through its reference count, so *blkr is destroyed by the caller.
+//   An unblocked r may then read the indices of the copy instead of its own,
+//   see CeedElemRestrictionShareIndices_Ref().
+int CeedElemRestrictionGetBlocked_Ref(CeedElemRestriction r, CeedInt blksize,
+                                      CeedElemRestriction *blkr) {
+  int ierr;
+  CeedElemRestriction_Ref *impl;
+  ierr = CeedElemRestrictionGetData(r, (void*)&impl); CeedChk(ierr);
+  CeedInt rblksize;
+  ierr = CeedElemRestrictionGetBlockSize(r, &rblksize); CeedChk(ierr);
+  if (rblksize == blksize) {
+    ierr = CeedElemRestrictionReference(r); CeedChk(ierr);
+    *blkr = r;
+    return 0;
+  }
+  if (impl->blocked) {
+    CeedInt cblksize;
+    ierr = CeedElemRestrictionGetBlockSize(impl->blocked, &cblksize);
+    CeedChk(ierr);
+    if (cblksize == blksize) {
+      ierr = CeedElemRestrictionReference(impl->blocked); CeedChk(ierr);
+      *blkr = impl->blocked;
+      return CeedElemRestrictionShareIndices_Ref(r, impl);
+    }
+  }
+
+  Ceed ceed;
+  ierr = CeedElemRestrictionGetCeed(r, &ceed); CeedChk(ierr);
+  CeedInt nelem, elemsize, ndof, ncomp, *strides, *cartesian;
+  ierr = CeedElemRestrictionGetNumElements(r, &nelem); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetElementSize(r, &elemsize); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumDoF(r, &ndof); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetNumComponents(r, &ncomp); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetStrides(r, &strides); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetCartesian(r, &cartesian); CeedChk(ierr);
+  if (cartesian) {
+    ierr = CeedElemRestrictionCreateBlockedCartesian(ceed, cartesian[0],
+           &cartesian[2], cartesian[1], (CeedNodeOrdering)cartesian[5],
+           blksize, ncomp, blkr); CeedChk(ierr);
+  } else if (strides) {
+    ierr = CeedElemRestrictionCreateBlockedStrided(ceed, nelem, elemsize,
+           blksize, ndof, ncomp, strides, blkr); CeedChk(ierr);
+  } else {
+    CeedInt *ind;
+    ierr = CeedElemRestrictionGetElementIndices_Ref(r, impl, &ind);
+    CeedChk(ierr);
+    ierr = CeedElemRestrictionCreateBlocked(ceed, nelem, elemsize, blksize,
+                                            ndof, ncomp, CEED_MEM_HOST,
+                                            CEED_OWN_POINTER, ind, blkr);
+    CeedChk(ierr);
+  }
+  if (impl->blocked)
+    return 0;
+
+  // Keep the first copy
+  ierr = CeedElemRestrictionReference(*blkr); CeedChk(ierr);
+  impl->blocked = *blkr;
+  return CeedElemRestrictionShareIndices_Ref(r, impl);
+}
+
 int CeedElemRestrictionCreate_Ref(CeedMemType mtype, CeedCopyMode cmode,
                                   const CeedInt *indices, CeedElemRestriction r) {
   int ierr;
@@ -113,6 +1040,7 @@ int CeedElemRestrictionCreate_Ref(CeedMemType mtype, CeedCopyMode cmode,
   if (mtype != CEED_MEM_HOST)
     return CeedError(ceed, 1, "Only MemType = HOST supported");
   ierr = CeedCalloc(1,&impl); CeedChk(ierr);
+  ierr = CeedElemRestrictionGetBlockSize(r, &impl->indblksize); CeedChk(ierr);
   switch (cmode) {
   case CEED_COPY_VALUES:
     ierr = CeedMalloc(nelem*elemsize, &impl->indices_allocated);
@@ -128,10 +1056,29 @@ int CeedElemRestrictionCreate_Ref(CeedMemType mtype, CeedCopyMode cmode,
   case CEED_USE_POINTER:
     impl->indices = indices;
   }
+  if (impl->indices) {
+    // Runs copied from indices the caller keeps could go stale
+    if (cmode != CEED_USE_POINTER) {
+      ierr = CeedElemRestrictionCompress_Ref(r, impl); CeedChk(ierr);
+    }
+    if (impl->runoffsets) {
+      // The runs replace the indices
+      ierr = CeedFree(&impl->indices_allocated); CeedChk(ierr);
+      impl->indices = NULL;
+    } else {
+      ierr = CeedElemRestrictionSetKernels_Ref(r, impl); CeedChk(ierr);
+    }
+  }
 
   ierr = CeedElemRestrictionSetData(r, (void*)&impl); CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "ElemRestriction", r, "Apply",
                                 CeedElemRestrictionApply_Ref); CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "ElemRestriction", r, "ApplyOverwrite",
+                                CeedElemRestrictionApplyOverwrite_Ref);
+  CeedChk(ierr);
+  ierr = CeedSetBackendFunction(ceed, "ElemRestriction", r, "ApplyBlock",
+                                CeedElemRestrictionApplyBlock_Ref);
+  CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "ElemRestriction", r, "Destroy",
                                 CeedElemRestrictionDestroy_Ref); CeedChk(ierr);
   return 0;
@@ -17,11 +17,56 @@
 #include <string.h>
 #include "ceed-ref.h"
 
+// Instruction set available at run time: 0 - none, 2 - AVX2 with FMA,
+//   3 - AVX-512
+static int CeedDetectISA_Ref(void) {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx512f") ? 3
+         : (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+         ? 2 : 0;
+#else
+  return 0;
+#endif
+}
+
+/*
+  Instruction set detected when the ref Ceed at the end of the delegate chain
+  of ceed was created, for the SIMD kernels of the backends built on ref
+ */
+int CeedGetISA_Ref(Ceed ceed, int *isa) {
+  int ierr;
+  for (Ceed delegate = ceed; delegate; ) {
+    ceed = delegate;
+    ierr = CeedGetDelegate(ceed, &delegate); CeedChk(ierr);
+  }
+  Ceed_Ref *data;
+  ierr = CeedGetData(ceed, (void *)&data); CeedChk(ierr);
+  *isa = data ? data->isa : 0;
+  return 0;
+}
+
+static int CeedDestroy_Ref(Ceed ceed) {
+  int ierr;
+  Ceed_Ref *data;
+  ierr = CeedGetData(ceed, (void *)&data); CeedChk(ierr);
+  ierr = CeedFree(&data); CeedChk(ierr);
+  return 0;
+}
+
 static int CeedInit_Ref(const char *resource, Ceed ceed) {
   int ierr;
   if (strcmp(resource, "/cpu/self")
       && strcmp(resource, "/cpu/self/ref"))
     return CeedError(ceed, 1, "Ref backend cannot use resource: %s", resource);
+
+  Ceed_Ref *data;
+  ierr = CeedCalloc(1, &data); CeedChk(ierr);
+  data->isa = CeedDetectISA_Ref();
+  ierr = CeedSetData(ceed, (void *)&data); CeedChk(ierr);
+
+  ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "Destroy",
+                                CeedDestroy_Ref); CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "VecCreate",
                                 CeedVectorCreate_Ref); CeedChk(ierr);
   ierr = CeedSetBackendFunction(ceed, "Ceed", ceed, "BasisCreateTensorH1",
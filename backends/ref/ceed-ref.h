@@ -17,16 +17,79 @@
 #include <ceed-backend.h>
 #include <string.h>
 
+// Elements per block in the ref operator
+#define CEED_REF_BLKSIZE 8
+// Intermediate size above which tensor contractions are applied slab by slab
+#ifndef CEED_CONTRACT_TILE_BYTES
+#define CEED_CONTRACT_TILE_BYTES (256*1024)
+#endif
+// Smallest 1D matrix dimension for which the even-odd decomposition is used
+#ifndef CEED_EVENODD_MIN
+#define CEED_EVENODD_MIN 2
+#endif
+// Shortest average run of consecutive indices for which a restriction that
+//   owns its indices stores them as runs instead
+#ifndef CEED_RUN_MIN
+#define CEED_RUN_MIN 4
+#endif
+
+typedef struct {
+  int isa;   /// SIMD instruction set, see CeedGetISA_Ref()
+} Ceed_Ref;
+
+// A 1D matrix T of a tensor basis, J × B in CEED_NOTRANSPOSE mode, with
+//   T_(J-1-j)(B-1-b) = sym T_jb and the half size matrices folding its even
+//   and odd parts in each transpose mode, see CeedTensorMatrixCreate_Ref()
+typedef struct {
+  const CeedScalar *t;
+  CeedInt sym;   /// 1 centrosymmetric, -1 skew-centrosymmetric, 0 neither
+  CeedScalar *E[2], *O[2];   /// By CeedTransposeMode, NULL if not folded
+} CeedTensorMatrix_Ref;
+
+typedef struct {
+  CeedScalar *colograd1d;   /// Collocated derivative, NULL if Q1d < P1d
+  CeedTensorMatrix_Ref interp, grad, colograd;   /// 1D matrices, folded once
+} CeedBasis_Ref;
+
 typedef struct {
   CeedScalar *array;
   CeedScalar *array_allocated;
 } CeedVector_Ref;
 
+// Gather from, or add into, the L-vector for elements [start, stop) of a
+//   restriction with indices, specialized for the number of components, the
+//   L-vector layout and the block size, see CeedElemRestrictionCreate_Ref()
+typedef void (*CeedElemRestrictionKernel_Ref)(CeedInt start, CeedInt stop,
+    CeedInt nelem, CeedInt elemsize, CeedInt ndof, const CeedInt *indices,
+    const CeedScalar *u, CeedScalar *v);
+
 typedef struct {
-  const CeedInt *indices;
+  const CeedInt *indices;   /// NULL if strided, Cartesian or stored as runs
   CeedInt *indices_allocated;
+  CeedInt indblksize;   /// Blocking of indices, the block size of the
+                        ///   restriction unless they belong to its blocked copy
+  CeedInt *runoffsets;   /// First run of each element, NULL if not compressed
+  CeedInt *runs;   /// First L-vector index and length of each run
+  CeedInt *toffsets;   /// First entry of tindices for each L-vector node
+  CeedInt *tindices;   /// E-vector offsets (component 0) of the element nodes
+                       ///   referencing each L-vector node, built on first
+                       ///   use, see CeedElemRestrictionGetTranspose_Ref()
+  CeedElemRestrictionKernel_Ref gather[2];   /// By lmode, NULL if generic
+  CeedElemRestrictionKernel_Ref scatter[2];   /// By lmode, NULL if generic
+  CeedElemRestriction blocked;   /// Blocked copy shared by the operators
 } CeedElemRestriction_Ref;
 
+// Transpose of a restriction to a list of elements packed into blocks, see
+//   CeedElemRestrictionBuildElementsTranspose_Ref()
+typedef struct {
+  CeedInt nnodes;   /// Distinct L-vector nodes of the elements
+  CeedInt dstride;   /// L-vector offset between components
+  CeedInt *lnodes;   /// L-vector offset (component 0) of each node
+  CeedInt *toffsets;   /// First entry of tindices for each node
+  CeedInt *tindices;   /// Packed E-vector offsets (component 0) of the element
+                       ///   nodes referencing each node
+} CeedElemTranspose_Ref;
+
 typedef struct {
   const CeedScalar **inputs;
   CeedScalar **outputs;
@@ -34,21 +97,120 @@ typedef struct {
 } CeedQFunction_Ref;
 
 typedef struct {
-  CeedVector
-  *evecs;   /// E-vectors needed to apply operator (input followed by outputs)
-  CeedScalar ** edata;
-  CeedVector *qvecsin;   /// Input Q-vectors needed to apply operator
-  CeedVector *qvecsout;   /// Output Q-vectors needed to apply operator
-  CeedInt    numein;
-  CeedInt    numeout;
-  CeedVector tempvec;
+  CeedEvalMode emode;
+  CeedTransposeMode lmode;
+  CeedElemRestriction rstr;   /// Restriction, blocked copy if blkrestr
+  bool blkrestr;   /// Whether the plan holds a reference to rstr
+  CeedBasis basis;
+  CeedVector vec;   /// L-vector, possibly CEED_VECTOR_ACTIVE
+  CeedVector evec;   /// Block E-vector, NULL if restricted to the Q-vector
+  CeedScalar *earray;   /// Storage restricted to and from, of evec or qdata
+  CeedVector qvec;   /// Block Q-vector wrapping qdata
+  CeedScalar *qdata;   /// Slice of the batch storage if batched
+  CeedInt nbatch;   /// Fields applied with this one, 0 if with an earlier one
+  CeedBasis bbasis;   /// Basis over the components of the batch if nbatch > 1
+  CeedVector bevec;   /// Batch E-vector, a slice of which is each evec
+  CeedVector bqvec;   /// Batch Q-vector, a slice of which is each qvec
+  CeedScalar *edata;   /// E-vector storage, of the whole batch if nbatch > 1
+} CeedOperatorPlanField_Ref;
+
+typedef struct {
+  CeedOperatorPlanField_Ref *fields;   /// Input fields followed by outputs
+  CeedInt numin;
+  CeedInt numout;
+  CeedInt blksize;
+  CeedInt nblk;
+  CeedInt Q;
+  const CeedScalar **indata;   /// QFunction input arrays
+  CeedScalar **outdata;   /// QFunction output arrays
+} CeedOperatorPlan_Ref;
+
+typedef struct {
+  CeedOperatorPlan_Ref *plan;
 } CeedOperator_Ref;
 
+// Contraction on the middle index, V_ajc = T_jb U_abc, see
+// CeedTensorContract_Ref()
+typedef int (*CeedTensorContractFunction_Ref)(Ceed ceed, CeedInt A, CeedInt B,
+    CeedInt C, CeedInt J, const CeedScalar *restrict t, CeedTransposeMode tmode,
+    const CeedInt Add, const CeedScalar *restrict u, CeedScalar *restrict v);
+
+// Contraction as CeedTensorContractFunction_Ref() with a matrix from
+// CeedTensorMatrixCreate_Ref(), see CeedTensorContractEvenOdd_Ref()
+typedef int (*CeedTensorContractEvenOddFunction_Ref)(Ceed ceed, CeedInt A,
+    CeedInt B, CeedInt C, CeedInt J, const CeedTensorMatrix_Ref *t,
+    CeedTransposeMode tmode, const CeedInt Add, const CeedScalar *restrict u,
+    CeedScalar *restrict v);
+
+// Stride between the element nodes of a Cartesian restriction, see
+//   CeedElemRestrictionGetCartesian(), in each of the 3 directions
+static inline void CeedCartesianNodeStrides_Ref(const CeedInt *cartesian,
+    CeedInt estride[3]) {
+  const CeedInt dim = cartesian[0], P = cartesian[1];
+  for (CeedInt d=0, s=1; d<3; d++) {
+    // Lexicographic, or reversed over the dim directions
+    const CeedInt dd = cartesian[5] == CEED_ORDER_REVERSED && d < dim ?
+                       dim-1-d : d;
+    estride[dd] = s;
+    s *= dd < dim ? P : 1;
+  }
+}
+
+// Offset in the L-vector of the first node of element e of a Cartesian
+//   restriction, see CeedElemRestrictionGetCartesian(), along with the number
+//   of element nodes, the L-vector stride and the element node stride in each
+//   of the 3 directions
+static inline CeedInt CeedCartesianElement_Ref(const CeedInt *cartesian,
+    CeedInt e, CeedInt nnodes[3], CeedInt nstride[3], CeedInt estride[3]) {
+  const CeedInt dim = cartesian[0], P = cartesian[1];
+  CeedInt offset = 0, stride = 1;
+  for (CeedInt d=0; d<3; d++) {
+    const CeedInt n = cartesian[2+d];
+    nnodes[d] = d < dim ? P : 1;
+    nstride[d] = stride;
+    offset += (e%n)*(P-1)*stride;
+    e /= n;
+    stride *= n*(P-1) + 1;
+  }
+  CeedCartesianNodeStrides_Ref(cartesian, estride);
+  return offset;
+}
+
+CEED_INTERN int CeedGetISA_Ref(Ceed ceed, int *isa);
+
 CEED_INTERN int CeedVectorCreate_Ref(CeedInt n, CeedVector vec);
 
 CEED_INTERN int CeedElemRestrictionCreate_Ref(CeedMemType mtype,
     CeedCopyMode cmode, const CeedInt *indices, CeedElemRestriction r);
 
+CEED_INTERN int CeedElemRestrictionApply_Ref(CeedElemRestriction r,
+    CeedTransposeMode tmode, CeedTransposeMode lmode, CeedVector u,
+    CeedVector v, CeedRequest *request);
+
+CEED_INTERN int CeedElemRestrictionApplyOverwrite_Ref(CeedElemRestriction r,
+    CeedTransposeMode tmode, CeedTransposeMode lmode, CeedVector u,
+    CeedVector v, CeedRequest *request);
+
+CEED_INTERN int CeedElemRestrictionApplyRange_Ref(CeedElemRestriction r,
+    CeedInt start, CeedInt stop, CeedTransposeMode tmode,
+    CeedTransposeMode lmode, const CeedScalar *uu, CeedScalar *vv);
+
+CEED_INTERN int CeedElemRestrictionApplyElements_Ref(CeedElemRestriction r,
+    CeedInt nsel, const CeedInt *elems, CeedTransposeMode tmode,
+    CeedTransposeMode lmode, const CeedScalar *u, CeedScalar *v);
+
+CEED_INTERN int CeedElemRestrictionBuildElementsTranspose_Ref(
+    CeedElemRestriction r, CeedInt nsel, const CeedInt *elems,
+    CeedTransposeMode lmode, CeedElemTranspose_Ref *t);
+
+CEED_INTERN int CeedElemTransposeDestroy_Ref(CeedElemTranspose_Ref *t);
+
+CEED_INTERN int CeedElemRestrictionGetTranspose_Ref(CeedElemRestriction r,
+    const CeedInt **toffsets, const CeedInt **tindices);
+
+CEED_INTERN int CeedElemRestrictionGetBlocked_Ref(CeedElemRestriction r,
+    CeedInt blksize, CeedElemRestriction *blkr);
+
 CEED_INTERN int CeedBasisCreateTensorH1_Ref(CeedInt dim, CeedInt P1d,
     CeedInt Q1d, const CeedScalar *interp1d,
     const CeedScalar *grad1d,
@@ -64,6 +226,67 @@ CEED_INTERN int CeedBasisCreateH1_Ref(CeedElemTopology topo,
     const CeedScalar *qweight,
     CeedBasis basis);
 
+CEED_INTERN int CeedTensorMatrixCreate_Ref(const CeedScalar *t, CeedInt J,
+    CeedInt B, CeedInt sym, CeedTensorMatrix_Ref *m);
+
+CEED_INTERN int CeedTensorMatrixDestroy_Ref(CeedTensorMatrix_Ref *m);
+
+CEED_INTERN void CeedTensorContractFolded_Ref(CeedInt A, CeedInt B, CeedInt C,
+    CeedInt J, CeedInt c0, const CeedScalar *restrict E,
+    const CeedScalar *restrict O, CeedInt sym, const CeedInt Add,
+    const CeedScalar *restrict u, CeedScalar *restrict v);
+
+CEED_INTERN int CeedTensorContractChain_Ref(Ceed ceed, CeedInt dim,
+    CeedInt ncomp, CeedInt P, CeedInt C, CeedInt Q,
+    const CeedTensorMatrix_Ref *const *t, CeedTransposeMode tmode,
+    const CeedInt Add, CeedTensorContractEvenOddFunction_Ref contract,
+    const CeedScalar *restrict u, CeedScalar *restrict v);
+
+CEED_INTERN int CeedBasisDestroyTensor_Ref(CeedBasis basis);
+
+CEED_INTERN int CeedBasisApplyTensor_Ref(CeedBasis basis, CeedInt nelem,
+    CeedTransposeMode tmode, CeedEvalMode emode,
+    CeedTensorContractEvenOddFunction_Ref contract, const CeedScalar *u,
+    CeedScalar *v);
+
+CEED_INTERN int CeedBasisApplyCollapsed_Ref(CeedBasis basis, CeedInt nelem,
+    CeedTransposeMode tmode, CeedEvalMode emode,
+    CeedTensorContractFunction_Ref contract, const CeedScalar *u,
+    CeedScalar *v);
+
+CEED_INTERN int CeedBasisApplyAnisotropic_Ref(CeedBasis basis, CeedInt nelem,
+    CeedTransposeMode tmode, CeedEvalMode emode,
+    CeedTensorContractFunction_Ref contract, const CeedScalar *u,
+    CeedScalar *v);
+
+CEED_INTERN int CeedBasisEvalAtPoints_Ref(CeedBasis basis, CeedInt nelem,
+    CeedInt npoints, CeedTransposeMode tmode, CeedEvalMode emode,
+    CeedTensorContractFunction_Ref contract, const CeedScalar *x,
+    const CeedScalar *u, CeedScalar *v);
+
+CEED_INTERN int CeedBasisApplyKernels_Ref(CeedBasis basis, CeedInt nelem,
+    CeedTransposeMode tmode, CeedEvalMode emode,
+    CeedTensorContractFunction_Ref contract,
+    CeedTensorContractEvenOddFunction_Ref evenodd,
+    CeedTensorContractFunction_Ref multiply, CeedVector U, CeedVector V);
+
+CEED_INTERN int CeedBasisApplyAtPointsKernels_Ref(CeedBasis basis,
+    CeedInt nelem, CeedInt npoints, CeedTransposeMode tmode,
+    CeedEvalMode emode, CeedTensorContractFunction_Ref contract, CeedVector X,
+    CeedVector U, CeedVector V);
+
 CEED_INTERN int CeedQFunctionCreate_Ref(CeedQFunction qf);
 
 CEED_INTERN int CeedOperatorCreate_Ref(CeedOperator op);
+
+CEED_INTERN int CeedOperatorPlanCreate_Ref(CeedOperator op, CeedInt blksize,
+    CeedOperatorPlan_Ref **plan);
+
+CEED_INTERN int CeedOperatorSelectElements_Ref(CeedInt start, CeedInt nelem,
+    const CeedInt *elems, CeedInt *nsel, CeedInt **sel);
+
+CEED_INTERN int CeedOperatorPlanApply_Ref(CeedOperator op,
+    CeedOperatorPlan_Ref *plan, CeedInt nsel, const CeedInt *sel,
+    CeedVector invec, CeedVector outvec, CeedRequest *request);
+
+CEED_INTERN int CeedOperatorPlanDestroy_Ref(CeedOperatorPlan_Ref **plan);
@@ -341,40 +341,24 @@ int BuildCartesianRestriction(Ceed ceed, int dim, int nxyz[3], int order,
                               CeedElemRestriction *restr,
                               CeedElemRestriction *restr_i) {
   CeedInt p = order, pp1 = p+1;
-  CeedInt ndof = CeedIntPow(pp1, dim); // number of scal. dofs per element
   CeedInt elem_qpts = CeedIntPow(num_qpts, dim); // number of qpts per element
-  CeedInt nd[3], num_elem = 1, scalar_size = 1;
+  CeedInt nelem[3], num_elem = 1, scalar_size = 1;
   for (int d = 0; d < dim; d++) {
+    nelem[d] = nxyz[d];
     num_elem *= nxyz[d];
-    nd[d] = nxyz[d]*p + 1;
-    scalar_size *= nd[d];
+    scalar_size *= nxyz[d]*p + 1;
   }
   *size = scalar_size*ncomp;
   // elem:         0             1                 n-1
   //        |---*-...-*---|---*-...-*---|- ... -|--...--|
   // dof:   0   1    p-1  p  p+1       2*p             n*p
-  CeedInt *el_dof = malloc(sizeof(CeedInt)*num_elem*ndof);
-  for (CeedInt e = 0; e < num_elem; e++) {
-    CeedInt exyz[3], re = e;
-    for (int d = 0; d < dim; d++) { exyz[d] = re%nxyz[d]; re /= nxyz[d]; }
-    CeedInt *loc_el_dof = el_dof + e*ndof;
-    for (int ldof = 0; ldof < ndof; ldof++) {
-      CeedInt gdof = 0, gdof_stride = 1, rdof = ldof;
-      for (int d = 0; d < dim; d++) {
-        gdof += (exyz[d]*p + rdof%pp1) * gdof_stride;
-        gdof_stride *= nd[d];
-        rdof /= pp1;
-      }
-      loc_el_dof[ldof] = gdof;
-    }
-  }
-  CeedElemRestrictionCreate(ceed, num_elem, ndof, scalar_size,
-                            ncomp, CEED_MEM_HOST,
-                            CEED_COPY_VALUES, el_dof, restr);
+  // The dofs are numbered lexicographically, x fastest, and computed by the
+  // restriction from the mesh size instead of being stored.
+  CeedElemRestrictionCreateCartesian(ceed, dim, nelem, pp1,
+                                     CEED_ORDER_LEXICOGRAPHIC, ncomp, restr);
   CeedElemRestrictionCreateIdentity(ceed, num_elem, elem_qpts,
                                     elem_qpts*num_elem,
                                     ncomp, restr_i);
-  free(el_dof);
   return 0;
 }
 
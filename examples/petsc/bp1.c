@@ -71,37 +71,16 @@ static PetscInt GlobalStart(const PetscInt p[3], const PetscInt irank[3],
   }
   return -1;
 }
+// The elements and the nodes of the L-vector are numbered with k fastest, and
+// the nodes of each element in the (k,j,i) ordering of the MFEM example, i
+// fastest.  In the directions of the Cartesian restriction, k is direction 0.
 static int CreateRestriction(Ceed ceed, const CeedInt melem[3],
                              CeedInt P, CeedInt ncomp,
                              CeedElemRestriction *Erestrict) {
-  const PetscInt Nelem = melem[0]*melem[1]*melem[2];
-  PetscInt mdof[3], *idx, *idxp;
-
-  for (int d=0; d<3; d++) mdof[d] = melem[d]*(P-1) + 1;
-  idxp = idx = malloc(Nelem*P*P*P*sizeof idx[0]);
-  for (CeedInt i=0; i<melem[0]; i++) {
-    for (CeedInt j=0; j<melem[1]; j++) {
-      for (CeedInt k=0; k<melem[2]; k++,idxp += P*P*P) {
-        for (CeedInt ii=0; ii<P; ii++) {
-          for (CeedInt jj=0; jj<P; jj++) {
-            for (CeedInt kk=0; kk<P; kk++) {
-              if (0) { // This is the C-style (i,j,k) ordering that I prefer
-                idxp[(ii*P+jj)*P+kk] = (((i*(P-1)+ii)*mdof[1]
-                                         + (j*(P-1)+jj))*mdof[2]
-                                        + (k*(P-1)+kk));
-              } else { // (k,j,i) ordering for consistency with MFEM example
-                idxp[ii+P*(jj+P*kk)] = (((i*(P-1)+ii)*mdof[1]
-                                         + (j*(P-1)+jj))*mdof[2]
-                                        + (k*(P-1)+kk));
-              }
-            }
-          }
-        }
-      }
-    }
-  }
-  CeedElemRestrictionCreate(ceed, Nelem, P*P*P, mdof[0]*mdof[1]*mdof[2], ncomp,
-                            CEED_MEM_HOST, CEED_OWN_POINTER, idx, Erestrict);
+  const CeedInt nelem[3] = {melem[2], melem[1], melem[0]};
+
+  CeedElemRestrictionCreateCartesian(ceed, 3, nelem, P, CEED_ORDER_REVERSED,
+                                     ncomp, Erestrict);
   PetscFunctionReturn(0);
 }
 
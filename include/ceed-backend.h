@@ -72,25 +72,44 @@ CEED_EXTERN int CeedElemRestrictionGetNumComponents(CeedElemRestriction rstr,
     CeedInt *numcomp);
 CEED_EXTERN int CeedElemRestrictionGetNumBlocks(CeedElemRestriction rstr,
     CeedInt *numblk);
+CEED_EXTERN int CeedElemRestrictionGetStrides(CeedElemRestriction rstr,
+    CeedInt* *strides);
+CEED_EXTERN int CeedElemRestrictionGetCartesian(CeedElemRestriction rstr,
+    CeedInt* *cartesian);
+CEED_EXTERN int CeedElemRestrictionGetIndexSharing(CeedElemRestriction rstr,
+    bool *share);
 CEED_EXTERN int CeedElemRestrictionGetBlockSize(CeedElemRestriction rstr,
     CeedInt *blksize);
 CEED_EXTERN int CeedElemRestrictionGetData(CeedElemRestriction rstr,
     void* *data);
 CEED_EXTERN int CeedElemRestrictionSetData(CeedElemRestriction rstr,
     void* *data);
+CEED_EXTERN int CeedElemRestrictionReference(CeedElemRestriction rstr);
 
 CEED_EXTERN int CeedBasisGetCollocatedGrad(CeedBasis basis,
     CeedScalar *colograd1d);
 CEED_EXTERN int CeedBasisGetCeed(CeedBasis basis, Ceed *ceed);
 CEED_EXTERN int CeedBasisGetTensorStatus(CeedBasis basis, bool *tensor);
+CEED_EXTERN int CeedBasisGetSymmetryStatus(CeedBasis basis, bool *symmetric);
 CEED_EXTERN int CeedBasisGetDimension(CeedBasis basis, CeedInt *dim);
 CEED_EXTERN int CeedBasisGetNumComponents(CeedBasis basis, CeedInt *numcomp);
 CEED_EXTERN int CeedBasisGetNumNodes1D(CeedBasis basis, CeedInt *P1d);
 CEED_EXTERN int CeedBasisGetNumQuadraturePoints1D(CeedBasis basis, CeedInt *Q1d);
-CEED_EXTERN int CeedBasisGetQRef(CeedBasis basis, CeedScalar* *qref);
-CEED_EXTERN int CeedBasisGetQWeights(CeedBasis basis, CeedScalar* *qweight);
-CEED_EXTERN int CeedBasisGetInterp(CeedBasis basis, CeedScalar* *interp);
-CEED_EXTERN int CeedBasisGetGrad(CeedBasis basis, CeedScalar* *grad);
+CEED_EXTERN int CeedBasisGetQRef(CeedBasis basis,
+    const CeedScalar **qref);
+CEED_EXTERN int CeedBasisGetQWeights(CeedBasis basis,
+    const CeedScalar **qweight);
+CEED_EXTERN int CeedBasisGetInterp(CeedBasis basis,
+    const CeedScalar **interp);
+CEED_EXTERN int CeedBasisGetGrad(CeedBasis basis,
+    const CeedScalar **grad);
+CEED_EXTERN int CeedBasisGetAnisotropicSizes(CeedBasis basis,
+    CeedInt* *sizes1d);
+CEED_EXTERN int CeedBasisGetCollapsedTables(CeedBasis basis,
+    CeedScalar* *tables);
+CEED_EXTERN int CeedBasisEvaluate1D(CeedBasis basis, CeedInt npts,
+                                    const CeedScalar *x, CeedScalar *interp,
+                                    CeedScalar *grad, CeedScalar *work);
 CEED_EXTERN int CeedBasisGetData(CeedBasis basis, void* *data);
 CEED_EXTERN int CeedBasisSetData(CeedBasis basis, void* *data);
 
@@ -26,7 +26,7 @@
 
 #define CEED_MAX_RESOURCE_LEN 1024
 #define CEED_ALIGN 64
-#define CEED_NUM_BACKEND_FUNCTIONS 25
+#define CEED_NUM_BACKEND_FUNCTIONS 29
 
 // Lookup table field for backend functions
 typedef struct {
@@ -52,6 +52,9 @@ struct Ceed_private {
   int (*OperatorCreate)(CeedOperator);
   int refcount;
   void *data;
+  struct CeedBasisTable_private
+  *basistables; /* 1D tables shared by the Lagrange bases created from this
+                   Ceed, see CeedBasisCreateTensorH1Lagrange() */
   foffset foffsets[CEED_NUM_BACKEND_FUNCTIONS];
 };
 
@@ -74,6 +77,11 @@ struct CeedElemRestriction_private {
   Ceed ceed;
   int (*Apply)(CeedElemRestriction, CeedTransposeMode, CeedTransposeMode,
                CeedVector, CeedVector, CeedRequest *);
+  int (*ApplyOverwrite)(CeedElemRestriction, CeedTransposeMode,
+                        CeedTransposeMode, CeedVector, CeedVector,
+                        CeedRequest *);
+  int (*ApplyBlock)(CeedElemRestriction, CeedInt, CeedTransposeMode,
+                    CeedTransposeMode, CeedVector, CeedVector, CeedRequest *);
   int (*Destroy)(CeedElemRestriction);
   int refcount;
   CeedInt nelem;    /* number of elements */
@@ -83,6 +91,14 @@ struct CeedElemRestriction_private {
   CeedInt ncomp;    /* number of components */
   CeedInt blksize;  /* number of elements in a batch */
   CeedInt nblk;     /* number of blocks of elements */
+  CeedInt *strides; /* node, component and element strides in the L-vector
+                       of a restriction without indices, NULL otherwise */
+  CeedInt *cartesian; /* dimension, nodes per direction, elements in each
+                         direction and node ordering of a Cartesian
+                         restriction, NULL otherwise */
+  bool shareindices; /* whether the backend may replace the indices by those
+                        of a blocked copy, see
+                        CeedElemRestrictionSetIndexSharing() */
   void *data;       /* place for the backend to store any data */
 };
 
@@ -90,9 +106,13 @@ struct CeedBasis_private {
   Ceed ceed;
   int (*Apply)(CeedBasis, CeedInt, CeedTransposeMode, CeedEvalMode,
                CeedVector, CeedVector);
+  int (*ApplyAtPoints)(CeedBasis, CeedInt, CeedInt, CeedTransposeMode,
+                       CeedEvalMode, CeedVector, CeedVector, CeedVector);
   int (*Destroy)(CeedBasis);
   int refcount;
   bool tensorbasis;      /* flag for tensor basis */
+  bool symmetric;        /* flag for centrosymmetric interp1d and
+                            skew-centrosymmetric grad1d */
   CeedInt dim;           /* topological dimension */
   CeedInt ncomp;         /* number of field components (1 for scalar fields) */
   CeedInt P1d;           /* number of nodes in one dimension */
@@ -109,6 +129,16 @@ struct CeedBasis_private {
   CeedScalar
   *grad1d;    /* row-major matrix of shape [Q1d, P1d] matrix expressing derivatives of
                             nodal basis functions at quadrature points */
+  CeedInt *sizes1d;      /* P1d and Q1d in each direction of an anisotropic
+                            tensor basis, NULL if they are the same */
+  CeedScalar *collapsed; /* factor tables of a simplex basis in collapsed
+                            coordinates, see CeedBasisGetCollapsedTables() */
+  struct CeedBasisTable_private
+  *table;     /* shared 1D tables holding interp1d, grad1d, qref1d and
+                            qweight1d, NULL if the basis owns them */
+  struct CeedBasisTable_private
+  **dirtables; /* shared 1D tables of each direction of an anisotropic
+                            Lagrange basis, copied in interp1d, ..., or NULL */
   void *data;            /* place for the backend to store any data */
 };
 
@@ -150,6 +180,8 @@ struct CeedOperator_private {
   int (*Apply)(CeedOperator, CeedVector, CeedVector, CeedRequest *);
   int (*ApplyJacobian)(CeedOperator, CeedVector, CeedVector, CeedVector,
                        CeedVector, CeedRequest *);
+  int (*ApplyElements)(CeedOperator, CeedInt, CeedInt, const CeedInt *,
+                       CeedVector, CeedVector, CeedRequest *);
   int (*Destroy)(CeedOperator);
   CeedOperatorField *inputfields;
   CeedOperatorField *outputfields;
@@ -194,19 +194,56 @@ typedef enum {
   CEED_TRANSPOSE
 } CeedTransposeMode;
 
+/// Ordering of the nodes of each element of a Cartesian restriction, see
+/// CeedElemRestrictionCreateCartesian()
+/// @ingroup CeedElemRestriction
+typedef enum {
+  /// Lexicographic, direction 0 fastest, as the elements and the L-vector
+  CEED_ORDER_LEXICOGRAPHIC = 0,
+  /// Reversed lexicographic, the last direction fastest, as the (k,j,i)
+  /// ordering of MFEM for an L-vector numbered with k fastest
+  CEED_ORDER_REVERSED = 1,
+} CeedNodeOrdering;
+
 CEED_EXTERN int CeedElemRestrictionCreate(Ceed ceed, CeedInt nelem,
     CeedInt elemsize, CeedInt ndof, CeedInt ncomp, CeedMemType mtype,
     CeedCopyMode cmode,
     const CeedInt *indices, CeedElemRestriction *rstr);
 CEED_EXTERN int CeedElemRestrictionCreateIdentity(Ceed ceed, CeedInt nelem,
     CeedInt elemsize, CeedInt ndof, CeedInt ncomp, CeedElemRestriction *rstr);
+CEED_EXTERN int CeedElemRestrictionCreateStrided(Ceed ceed, CeedInt nelem,
+    CeedInt elemsize, CeedInt ndof, CeedInt ncomp, const CeedInt strides[3],
+    CeedElemRestriction *rstr);
 CEED_EXTERN int CeedElemRestrictionCreateBlocked(Ceed ceed, CeedInt nelem,
     CeedInt elemsize, CeedInt blksize, CeedInt ndof, CeedInt ncomp,
     CeedMemType mtype,
     CeedCopyMode cmode, const CeedInt *indices, CeedElemRestriction *rstr);
+CEED_EXTERN int CeedElemRestrictionCreateBlockedStrided(Ceed ceed,
+    CeedInt nelem, CeedInt elemsize, CeedInt blksize, CeedInt ndof,
+    CeedInt ncomp, const CeedInt strides[3], CeedElemRestriction *rstr);
+CEED_EXTERN int CeedElemRestrictionCreateCartesian(Ceed ceed, CeedInt dim,
+    const CeedInt *nelem, CeedInt P, CeedNodeOrdering order, CeedInt ncomp,
+    CeedElemRestriction *rstr);
+CEED_EXTERN int CeedElemRestrictionCreateBlockedCartesian(Ceed ceed,
+    CeedInt dim, const CeedInt *nelem, CeedInt P, CeedNodeOrdering order,
+    CeedInt blksize, CeedInt ncomp, CeedElemRestriction *rstr);
+CEED_EXTERN int CeedElemRestrictionComputeOrdering(Ceed ceed, CeedInt nelem,
+    CeedInt elemsize, CeedInt ndof, const CeedInt *indices, CeedInt dim,
+    const CeedScalar *centroids, CeedInt *eperm, CeedInt *dofperm);
+CEED_EXTERN int CeedElemRestrictionCreatePermuted(Ceed ceed, CeedInt nelem,
+    CeedInt elemsize, CeedInt ndof, CeedInt ncomp, const CeedInt *indices,
+    const CeedInt *eperm, const CeedInt *dofperm, CeedElemRestriction *rstr);
+CEED_EXTERN int CeedElemRestrictionSetIndexSharing(CeedElemRestriction rstr,
+    bool share);
 CEED_EXTERN int CeedElemRestrictionApply(CeedElemRestriction rstr,
     CeedTransposeMode tmode, CeedTransposeMode lmode, CeedVector u,
     CeedVector ru, CeedRequest *request);
+CEED_EXTERN int CeedElemRestrictionApplyOverwrite(CeedElemRestriction rstr,
+    CeedTransposeMode tmode, CeedTransposeMode lmode, CeedVector u,
+    CeedVector ru, CeedRequest *request);
+CEED_EXTERN int CeedElemRestrictionApplyBlock(CeedElemRestriction rstr,
+    CeedInt block, CeedTransposeMode tmode, CeedTransposeMode lmode,
+    CeedVector u, CeedVector ru, CeedRequest *request);
 CEED_EXTERN int CeedElemRestrictionDestroy(CeedElemRestriction *rstr);
 
 // The formalism here is that we have the structure
@@ -215,7 +252,9 @@ CEED_EXTERN int CeedElemRestrictionDestroy(CeedElemRestriction *rstr);
 
 /// Basis evaluation mode
 ///
-/// Modes can be bitwise ORed when passing to most functions.
+/// Modes can be bitwise ORed when passing to most functions.  The combined
+/// mode CEED_EVAL_INTERP|CEED_EVAL_GRAD evaluates values and gradients in one
+/// pass, the values being followed by the gradients at the quadrature points.
 /// @ingroup CeedBasis
 typedef enum {
   /// Perform no evaluation (either because there is no data or it is already at
@@ -269,17 +308,30 @@ CEED_EXTERN int CeedBasisCreateTensorH1Lagrange(Ceed ceed, CeedInt dim,
 CEED_EXTERN int CeedBasisCreateTensorH1(Ceed ceed, CeedInt dim, CeedInt ncomp,
                                         CeedInt P1d, CeedInt Q1d, const CeedScalar *interp1d, const CeedScalar *grad1d,
                                         const CeedScalar *qref1d, const CeedScalar *qweight1d, CeedBasis *basis);
+CEED_EXTERN int CeedBasisCreateTensorH1LagrangeAnisotropic(Ceed ceed,
+    CeedInt dim, CeedInt ncomp, const CeedInt *P, const CeedInt *Q,
+    CeedQuadMode qmode, CeedBasis *basis);
+CEED_EXTERN int CeedBasisCreateTensorH1Anisotropic(Ceed ceed, CeedInt dim,
+    CeedInt ncomp, const CeedInt *P1d, const CeedInt *Q1d,
+    const CeedScalar *interp1d, const CeedScalar *grad1d,
+    const CeedScalar *qref1d, const CeedScalar *qweight1d, CeedBasis *basis);
 CEED_EXTERN int CeedBasisCreateH1(Ceed ceed, CeedElemTopology topo,
                                   CeedInt ncomp,
                                   CeedInt ndof, CeedInt nqpts,
                                   const CeedScalar *interp, const CeedScalar *grad,
                                   const CeedScalar *qref, const CeedScalar *qweight, CeedBasis *basis);
+CEED_EXTERN int CeedBasisCreateSimplexDubiner(Ceed ceed, CeedElemTopology topo,
+    CeedInt ncomp, CeedInt P, CeedInt Q, CeedBasis *basis);
 CEED_EXTERN int CeedBasisView(CeedBasis basis, FILE *stream);
 CEED_EXTERN int CeedBasisGetNumNodes(CeedBasis basis, CeedInt *P);
 CEED_EXTERN int CeedBasisGetNumQuadraturePoints(CeedBasis basis, CeedInt *Q);
 CEED_EXTERN int CeedBasisApply(CeedBasis basis, CeedInt nelem,
                                CeedTransposeMode tmode,
                                CeedEvalMode emode, CeedVector u, CeedVector v);
+CEED_EXTERN int CeedBasisApplyAtPoints(CeedBasis basis, CeedInt nelem,
+                                       CeedInt npoints, CeedTransposeMode tmode,
+                                       CeedEvalMode emode, CeedVector x,
+                                       CeedVector u, CeedVector v);
 CEED_EXTERN int CeedBasisDestroy(CeedBasis *basis);
 
 CEED_EXTERN int CeedGaussQuadrature(CeedInt Q, CeedScalar *qref1d,
@@ -311,6 +363,10 @@ CEED_EXTERN int CeedOperatorSetField(CeedOperator op, const char *fieldname,
                                      CeedVector v);
 CEED_EXTERN int CeedOperatorApply(CeedOperator op, CeedVector in,
                                   CeedVector out, CeedRequest *request);
+CEED_EXTERN int CeedOperatorApplyElements(CeedOperator op, CeedInt nelem,
+    const CeedInt *elems, CeedVector in, CeedVector out, CeedRequest *request);
+CEED_EXTERN int CeedOperatorApplyElementRange(CeedOperator op, CeedInt start,
+    CeedInt stop, CeedVector in, CeedVector out, CeedRequest *request);
 CEED_EXTERN int CeedOperatorDestroy(CeedOperator *op);
 
 /**
@@ -84,6 +84,16 @@ c
       integer ceed_gauss_lobatto
       parameter(ceed_gauss_lobatto = 1)
 
+c
+c CeedNodeOrdering
+c
+
+      integer ceed_order_lexicographic
+      parameter(ceed_order_lexicographic = 0)
+
+      integer ceed_order_reversed
+      parameter(ceed_order_reversed      = 1)
+
 c
 c CeedElemTopology
 c
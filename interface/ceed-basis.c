@@ -25,6 +25,285 @@
 static struct CeedBasis_private ceed_basis_collocated;
 /// @endcond
 
+// Check whether interp1d is centrosymmetric and grad1d skew-centrosymmetric,
+// as for nodes and quadrature points symmetric about the element center
+static bool CeedBasisCheckSymmetry(CeedInt P1d, CeedInt Q1d,
+                                   const CeedScalar *interp1d,
+                                   const CeedScalar *grad1d) {
+  CeedScalar maxinterp = 0, maxgrad = 0;
+  for (CeedInt i=0; i<Q1d*P1d; i++) {
+    maxinterp = fmax(maxinterp, fabs(interp1d[i]));
+    maxgrad = fmax(maxgrad, fabs(grad1d[i]));
+  }
+  for (CeedInt i=0; i<Q1d; i++)
+    for (CeedInt j=0; j<P1d; j++) {
+      const CeedInt ij = i*P1d + j, r = (Q1d-1-i)*P1d + (P1d-1-j);
+      if (fabs(interp1d[r] - interp1d[ij]) > 1e-12*maxinterp ||
+          fabs(grad1d[r] + grad1d[ij]) > 1e-12*maxgrad)
+        return false;
+    }
+  return true;
+}
+
+// Values and derivatives of the Lagrange polynomials through the n distinct
+// nodes at the m points x, as row-major m × n matrices
+static void CeedLagrangeEvaluate(CeedInt n, const CeedScalar *nodes,
+                                 CeedInt m, const CeedScalar *x,
+                                 CeedScalar *interp, CeedScalar *grad) {
+  CeedInt i, j, k;
+  CeedScalar c1, c2, c3, c4, dx;
+  // Fornberg, 1998
+  for (i = 0; i  < m; i++) {
+    c1 = 1.0;
+    c3 = nodes[0] - x[i];
+    interp[i*n+0] = 1.0;
+    grad[i*n+0] = 0.0;
+    for (j = 1; j < n; j++) {
+      c2 = 1.0;
+      c4 = c3;
+      c3 = nodes[j] - x[i];
+      for (k = 0; k < j; k++) {
+        dx = nodes[j] - nodes[k];
+        c2 *= dx;
+        if (k == j - 1) {
+          grad[i*n + j] = c1*(interp[i*n + k] - c4*grad[i*n + k]) / c2;
+          interp[i*n + j] = - c1*c4*interp[i*n + k] / c2;
+        }
+        grad[i*n + k] = (c3*grad[i*n + k] - interp[i*n + k]) / dx;
+        interp[i*n + k] = c3*interp[i*n + k] / dx;
+      }
+      c1 = c2;
+    }
+  }
+}
+
+static int CeedHouseholderApplyQ(CeedScalar *A, const CeedScalar *Q,
+                                 const CeedScalar *tau, CeedTransposeMode tmode,
+                                 CeedInt m, CeedInt n, CeedInt k,
+                                 CeedInt row, CeedInt col);
+
+// Collocated derivative of the Q1d × P1d tables interp1d and grad1d, see
+// CeedBasisGetCollocatedGrad()
+static int CeedBasisComputeCollocatedGrad(CeedInt P1d, CeedInt Q1d,
+    const CeedScalar *interp1d, const CeedScalar *grad1d,
+    CeedScalar *colograd1d) {
+  int i, j, k;
+  CeedInt ierr;
+  CeedScalar *qr, tau[Q1d];
+
+  ierr = CeedMalloc(Q1d*P1d, &qr); CeedChk(ierr);
+  memcpy(qr, interp1d, Q1d*P1d*sizeof(interp1d[0]));
+
+  // QR Factorization, interp1d = Q R
+  ierr = CeedQRFactorization(qr, tau, Q1d, P1d); CeedChk(ierr);
+
+  // Apply Rinv, colograd1d = grad1d Rinv
+  for (i=0; i<Q1d; i++) { // Row i
+    colograd1d[Q1d*i] = grad1d[P1d*i]/qr[0];
+    for (j=1; j<P1d; j++) { // Column j
+      colograd1d[j+Q1d*i] = grad1d[j+P1d*i];
+      for (k=0; k<j; k++) {
+        colograd1d[j+Q1d*i] -= qr[j+P1d*k]*colograd1d[k+Q1d*i];
+      }
+      colograd1d[j+Q1d*i] /= qr[j+P1d*j];
+    }
+    for (j=P1d; j<Q1d; j++) {
+      colograd1d[j+Q1d*i] = 0;
+    }
+  }
+
+  // Apply Qtranspose, colograd = colograd Qtranspose
+  CeedHouseholderApplyQ(colograd1d, qr, tau, CEED_NOTRANSPOSE,
+                        Q1d, Q1d, P1d, 1, Q1d);
+
+  ierr = CeedFree(&qr); CeedChk(ierr);
+  return 0;
+}
+
+/// @cond DOXYGEN_SKIP
+// 1D tables of a tensor product Lagrange basis.  Bases created from the same
+// Ceed with the same P1d, Q1d and qmode share one reference counted copy,
+// held in a list of the Ceed and freed with the last basis using it.  The
+// tables are complete when inserted and never written afterwards, and as for
+// the other objects of a Ceed, the list is used by one thread at a time.
+struct CeedBasisTable_private {
+  Ceed ceed;   // Holding the list, referenced until the tables are freed
+  CeedInt P1d, Q1d;
+  CeedQuadMode qmode;
+  int refcount;
+  bool symmetric;
+  CeedScalar *interp1d, *grad1d, *qref1d, *qweight1d;
+  CeedScalar *colograd1d; // NULL if Q1d < P1d
+  struct CeedBasisTable_private *next;
+};
+/// @endcond
+
+// Get a new reference to the tables of the Lagrange basis with P nodes and Q
+// quadrature points in the list of ceed, computing them if no basis uses them
+// yet
+static int CeedBasisTableGet(Ceed ceed, CeedInt P, CeedInt Q,
+                             CeedQuadMode qmode,
+                             struct CeedBasisTable_private **table) {
+  int ierr;
+  for (struct CeedBasisTable_private *t = ceed->basistables; t; t = t->next)
+    if (t->P1d == P && t->Q1d == Q && t->qmode == qmode) {
+      t->refcount++;
+      *table = t;
+      return 0;
+    }
+
+  // Allocate
+  CeedScalar *nodes, *interp1d, *grad1d, *qref1d, *qweight1d;
+  ierr = CeedCalloc(P*Q, &interp1d); CeedChk(ierr);
+  ierr = CeedCalloc(P*Q, &grad1d); CeedChk(ierr);
+  ierr = CeedCalloc(P, &nodes); CeedChk(ierr);
+  ierr = CeedCalloc(Q, &qref1d); CeedChk(ierr);
+  ierr = CeedCalloc(Q, &qweight1d); CeedChk(ierr);
+  // Get Nodes and Weights
+  ierr = CeedLobattoQuadrature(P, nodes, NULL); CeedChk(ierr);
+  switch (qmode) {
+  case CEED_GAUSS:
+    ierr = CeedGaussQuadrature(Q, qref1d, qweight1d); CeedChk(ierr);
+    break;
+  case CEED_GAUSS_LOBATTO:
+    ierr = CeedLobattoQuadrature(Q, qref1d, qweight1d); CeedChk(ierr);
+    break;
+  }
+  // Build B, D matrix
+  CeedLagrangeEvaluate(P, nodes, Q, qref1d, interp1d, grad1d);
+  ierr = CeedFree(&nodes); CeedChk(ierr);
+
+  struct CeedBasisTable_private *t;
+  ierr = CeedCalloc(1, &t); CeedChk(ierr);
+  // The collocated derivative needs interp1d to have full column rank
+  if (Q >= P) {
+    ierr = CeedMalloc(Q*Q, &t->colograd1d); CeedChk(ierr);
+    ierr = CeedBasisComputeCollocatedGrad(P, Q, interp1d, grad1d,
+                                          t->colograd1d); CeedChk(ierr);
+  }
+  t->ceed = ceed;
+  ceed->refcount++;
+  t->P1d = P;
+  t->Q1d = Q;
+  t->qmode = qmode;
+  t->refcount = 1;
+  t->symmetric = CeedBasisCheckSymmetry(P, Q, interp1d, grad1d);
+  t->interp1d = interp1d;
+  t->grad1d = grad1d;
+  t->qref1d = qref1d;
+  t->qweight1d = qweight1d;
+  t->next = ceed->basistables;
+  ceed->basistables = t;
+  *table = t;
+  return 0;
+}
+
+// Release a reference to shared tables, freeing them with the last one
+static int CeedBasisTableRestore(struct CeedBasisTable_private **table) {
+  int ierr;
+  if (!*table || --(*table)->refcount > 0) {
+    *table = NULL;
+    return 0;
+  }
+  for (struct CeedBasisTable_private **t = &(*table)->ceed->basistables; *t;
+       t = &(*t)->next)
+    if (*t == *table) {
+      *t = (*table)->next;
+      break;
+    }
+  ierr = CeedFree(&(*table)->interp1d); CeedChk(ierr);
+  ierr = CeedFree(&(*table)->grad1d); CeedChk(ierr);
+  ierr = CeedFree(&(*table)->qref1d); CeedChk(ierr);
+  ierr = CeedFree(&(*table)->qweight1d); CeedChk(ierr);
+  ierr = CeedFree(&(*table)->colograd1d); CeedChk(ierr);
+  ierr = CeedDestroy(&(*table)->ceed); CeedChk(ierr);
+  ierr = CeedFree(table); CeedChk(ierr);
+  return 0;
+}
+
+// Create a tensor product basis, as CeedBasisCreateTensorH1(), that takes
+// over the reference to the shared tables table if not NULL and copies the
+// 1D arrays otherwise.  If sizes1d is not NULL, it holds the P1d and then the
+// Q1d of each direction of an anisotropic basis, whose 1D arrays are those of
+// the directions one after the other, and P1d and Q1d are the largest ones.
+static int CeedBasisCreateTensorH1Table(Ceed ceed, CeedInt dim, CeedInt ncomp,
+                                        CeedInt P1d, CeedInt Q1d,
+                                        const CeedInt *sizes1d,
+                                        const CeedScalar *interp1d,
+                                        const CeedScalar *grad1d,
+                                        const CeedScalar *qref1d,
+                                        const CeedScalar *qweight1d,
+                                        struct CeedBasisTable_private *table,
+                                        CeedBasis *basis) {
+  int ierr;
+
+  if (!ceed->BasisCreateTensorH1) {
+    Ceed delegate;
+    ierr = CeedGetDelegate(ceed, &delegate); CeedChk(ierr);
+
+    if (!delegate)
+      return CeedError(ceed, 1, "Backend does not support BasisCreateTensorH1");
+
+    ierr = CeedBasisCreateTensorH1Table(delegate, dim, ncomp, P1d, Q1d,
+                                        sizes1d, interp1d, grad1d, qref1d,
+                                        qweight1d, table, basis);
+    CeedChk(ierr);
+    return 0;
+  }
+  ierr = CeedCalloc(1,basis); CeedChk(ierr);
+  (*basis)->ceed = ceed;
+  ceed->refcount++;
+  (*basis)->refcount = 1;
+  (*basis)->tensorbasis = 1;
+  (*basis)->dim = dim;
+  (*basis)->ncomp = ncomp;
+  (*basis)->P1d = P1d;
+  (*basis)->Q1d = Q1d;
+  (*basis)->P = CeedIntPow(P1d, dim);
+  (*basis)->Q = CeedIntPow(Q1d, dim);
+  if (sizes1d) {
+    CeedInt nq = 0, nt = 0;
+    (*basis)->P = (*basis)->Q = 1;
+    for (CeedInt d=0; d<dim; d++) {
+      (*basis)->P *= sizes1d[d];
+      (*basis)->Q *= sizes1d[dim+d];
+      nq += sizes1d[dim+d];
+      nt += sizes1d[dim+d]*sizes1d[d];
+    }
+    ierr = CeedMalloc(2*dim, &(*basis)->sizes1d); CeedChk(ierr);
+    memcpy((*basis)->sizes1d, sizes1d, 2*dim*sizeof(sizes1d[0]));
+    ierr = CeedMalloc(nq,&(*basis)->qref1d); CeedChk(ierr);
+    ierr = CeedMalloc(nq,&(*basis)->qweight1d); CeedChk(ierr);
+    memcpy((*basis)->qref1d, qref1d, nq*sizeof(qref1d[0]));
+    memcpy((*basis)->qweight1d, qweight1d, nq*sizeof(qweight1d[0]));
+    ierr = CeedMalloc(nt,&(*basis)->interp1d); CeedChk(ierr);
+    ierr = CeedMalloc(nt,&(*basis)->grad1d); CeedChk(ierr);
+    memcpy((*basis)->interp1d, interp1d, nt*sizeof(interp1d[0]));
+    memcpy((*basis)->grad1d, grad1d, nt*sizeof(grad1d[0]));
+    (*basis)->symmetric = false;
+  } else if (table) {
+    (*basis)->table = table;
+    (*basis)->qref1d = table->qref1d;
+    (*basis)->qweight1d = table->qweight1d;
+    (*basis)->interp1d = table->interp1d;
+    (*basis)->grad1d = table->grad1d;
+    (*basis)->symmetric = table->symmetric;
+  } else {
+    ierr = CeedMalloc(Q1d,&(*basis)->qref1d); CeedChk(ierr);
+    ierr = CeedMalloc(Q1d,&(*basis)->qweight1d); CeedChk(ierr);
+    memcpy((*basis)->qref1d, qref1d, Q1d*sizeof(qref1d[0]));
+    memcpy((*basis)->qweight1d, qweight1d, Q1d*sizeof(qweight1d[0]));
+    ierr = CeedMalloc(Q1d*P1d,&(*basis)->interp1d); CeedChk(ierr);
+    ierr = CeedMalloc(Q1d*P1d,&(*basis)->grad1d); CeedChk(ierr);
+    memcpy((*basis)->interp1d, interp1d, Q1d*P1d*sizeof(interp1d[0]));
+    memcpy((*basis)->grad1d, grad1d, Q1d*P1d*sizeof(grad1d[0]));
+    (*basis)->symmetric = CeedBasisCheckSymmetry(P1d, Q1d, interp1d, grad1d);
+  }
+  ierr = ceed->BasisCreateTensorH1(dim, P1d, Q1d, interp1d, grad1d, qref1d,
+                                   qweight1d, *basis); CeedChk(ierr);
+  return 0;
+}
+
 /// @file
 /// Implementation of public CeedBasis interfaces
 ///
@@ -58,41 +337,77 @@ int CeedBasisCreateTensorH1(Ceed ceed, CeedInt dim, CeedInt ncomp, CeedInt P1d,
                             CeedInt Q1d, const CeedScalar *interp1d,
                             const CeedScalar *grad1d, const CeedScalar *qref1d,
                             const CeedScalar *qweight1d, CeedBasis *basis) {
-  int ierr;
+  int ierr = CeedBasisCreateTensorH1Table(ceed, dim, ncomp, P1d, Q1d, NULL,
+                                          interp1d, grad1d, qref1d, qweight1d,
+                                          NULL, basis); CeedChk(ierr);
+  return 0;
+}
 
-  if (!ceed->BasisCreateTensorH1) {
-    Ceed delegate;
-    ierr = CeedGetDelegate(ceed, &delegate); CeedChk(ierr);
+/**
+  @brief Create a tensor product basis for H^1 discretizations with different
+         numbers of nodes and quadrature points in each direction
 
-    if (!delegate)
-      return CeedError(ceed, 1, "Backend does not support BasisCreateTensorH1");
+  Direction 0 is that of the fastest varying index of the nodes and
+  quadrature points.  The 1D arrays of the directions are given one after the
+  other, and the basis is applied by sum factorization with the table of each
+  direction, so that an element with high order normal to a wall and low
+  order along it costs what its nodes and quadrature points need.  If all the
+  directions are the same, this is CeedBasisCreateTensorH1().
 
-    ierr = CeedBasisCreateTensorH1(delegate, dim, ncomp, P1d,
-                            Q1d, interp1d, grad1d, qref1d,
-                            qweight1d, basis); CeedChk(ierr);
-    return 0;
+  @param ceed       A Ceed object where the CeedBasis will be created
+  @param dim        Topological dimension
+  @param ncomp      Number of field components (1 for scalar fields)
+  @param P1d        Array of length dim holding the number of nodes in each
+                      direction
+  @param Q1d        Array of length dim holding the number of quadrature
+                      points in each direction
+  @param interp1d   Row-major Q1d[d] × P1d[d] matrices expressing the values of
+                      nodal basis functions at quadrature points, for
+                      d=0,...,dim-1
+  @param grad1d     Row-major Q1d[d] × P1d[d] matrices expressing derivatives
+                      of nodal basis functions at quadrature points
+  @param qref1d     Arrays of length Q1d[d] holding the locations of
+                      quadrature points on the 1D reference element [-1, 1]
+  @param qweight1d  Arrays of length Q1d[d] holding the quadrature weights on
+                      the reference element
+  @param[out] basis Address of the variable where the newly created
+                      CeedBasis will be stored.
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Basic
+**/
+int CeedBasisCreateTensorH1Anisotropic(Ceed ceed, CeedInt dim, CeedInt ncomp,
+                                       const CeedInt *P1d, const CeedInt *Q1d,
+                                       const CeedScalar *interp1d,
+                                       const CeedScalar *grad1d,
+                                       const CeedScalar *qref1d,
+                                       const CeedScalar *qweight1d,
+                                       CeedBasis *basis) {
+  int ierr;
+  if (dim < 1)
+    return CeedError(ceed, 1, "Tensor bases need dim > 0");
+  bool same = true;
+  CeedInt sizes1d[2*dim], Pmax = 0, Qmax = 0;
+  for (CeedInt d=0, off=0, qoff=0; d<dim; d++) {
+    if (P1d[d] < 1 || Q1d[d] < 1)
+      return CeedError(ceed, 1, "Tensor bases need P1d > 0 and Q1d > 0");
+    sizes1d[d] = P1d[d];
+    sizes1d[dim+d] = Q1d[d];
+    Pmax = P1d[d] > Pmax ? P1d[d] : Pmax;
+    Qmax = Q1d[d] > Qmax ? Q1d[d] : Qmax;
+    same = same && P1d[d] == P1d[0] && Q1d[d] == Q1d[0]
+           && !memcmp(interp1d + off, interp1d, P1d[d]*Q1d[d]*sizeof(*interp1d))
+           && !memcmp(grad1d + off, grad1d, P1d[d]*Q1d[d]*sizeof(*grad1d))
+           && !memcmp(qref1d + qoff, qref1d, Q1d[d]*sizeof(*qref1d))
+           && !memcmp(qweight1d + qoff, qweight1d, Q1d[d]*sizeof(*qweight1d));
+    off += P1d[d]*Q1d[d];
+    qoff += Q1d[d];
   }
-  ierr = CeedCalloc(1,basis); CeedChk(ierr);
-  (*basis)->ceed = ceed;
-  ceed->refcount++;
-  (*basis)->refcount = 1;
-  (*basis)->tensorbasis = 1;
-  (*basis)->dim = dim;
-  (*basis)->ncomp = ncomp;
-  (*basis)->P1d = P1d;
-  (*basis)->Q1d = Q1d;
-  (*basis)->P = CeedIntPow(P1d, dim);
-  (*basis)->Q = CeedIntPow(Q1d, dim);
-  ierr = CeedMalloc(Q1d,&(*basis)->qref1d); CeedChk(ierr);
-  ierr = CeedMalloc(Q1d,&(*basis)->qweight1d); CeedChk(ierr);
-  memcpy((*basis)->qref1d, qref1d, Q1d*sizeof(qref1d[0]));
-  memcpy((*basis)->qweight1d, qweight1d, Q1d*sizeof(qweight1d[0]));
-  ierr = CeedMalloc(Q1d*P1d,&(*basis)->interp1d); CeedChk(ierr);
-  ierr = CeedMalloc(Q1d*P1d,&(*basis)->grad1d); CeedChk(ierr);
-  memcpy((*basis)->interp1d, interp1d, Q1d*P1d*sizeof(interp1d[0]));
-  memcpy((*basis)->grad1d, grad1d, Q1d*P1d*sizeof(grad1d[0]));
-  ierr = ceed->BasisCreateTensorH1(dim, P1d, Q1d, interp1d, grad1d, qref1d,
-                                   qweight1d, *basis); CeedChk(ierr);
+  ierr = CeedBasisCreateTensorH1Table(ceed, dim, ncomp, Pmax, Qmax,
+                                      same ? NULL : sizes1d, interp1d, grad1d,
+                                      qref1d, qweight1d, NULL, basis);
+  CeedChk(ierr);
   return 0;
 }
 
@@ -110,6 +425,10 @@ int CeedBasisCreateTensorH1(Ceed ceed, CeedInt dim, CeedInt ncomp, CeedInt P1d,
   @param[out] basis Address of the variable where the newly created
                       CeedBasis will be stored.
 
+  The 1D tables are computed by the first call for given P, Q and qmode on
+  ceed and shared, read-only, by all bases created with them from ceed, until
+  the last of these bases is destroyed.
+
   @return An error code: 0 - success, otherwise - failure
 
   @ref Basic
@@ -117,53 +436,95 @@ int CeedBasisCreateTensorH1(Ceed ceed, CeedInt dim, CeedInt ncomp, CeedInt P1d,
 int CeedBasisCreateTensorH1Lagrange(Ceed ceed, CeedInt dim, CeedInt ncomp,
                                     CeedInt P, CeedInt Q,
                                     CeedQuadMode qmode, CeedBasis *basis) {
-  // Allocate
-  int ierr, i, j, k;
-  CeedScalar c1, c2, c3, c4, dx, *nodes, *interp1d, *grad1d, *qref1d, *qweight1d;
-  ierr = CeedCalloc(P*Q, &interp1d); CeedChk(ierr);
-  ierr = CeedCalloc(P*Q, &grad1d); CeedChk(ierr);
-  ierr = CeedCalloc(P, &nodes); CeedChk(ierr);
-  ierr = CeedCalloc(Q, &qref1d); CeedChk(ierr);
-  ierr = CeedCalloc(Q, &qweight1d); CeedChk(ierr);
-  // Get Nodes and Weights
-  ierr = CeedLobattoQuadrature(P, nodes, NULL); CeedChk(ierr);
-  switch (qmode) {
-  case CEED_GAUSS:
-    ierr = CeedGaussQuadrature(Q, qref1d, qweight1d); CeedChk(ierr);
-    break;
-  case CEED_GAUSS_LOBATTO:
-    ierr = CeedLobattoQuadrature(Q, qref1d, qweight1d); CeedChk(ierr);
-    break;
+  int ierr;
+  struct CeedBasisTable_private *table;
+  ierr = CeedBasisTableGet(ceed, P, Q, qmode, &table); CeedChk(ierr);
+  ierr = CeedBasisCreateTensorH1Table(ceed, dim, ncomp, P, Q, NULL,
+                                      table->interp1d, table->grad1d,
+                                      table->qref1d, table->qweight1d, table,
+                                      basis);
+  if (ierr) {
+    // The basis did not take over the reference
+    CeedBasisTableRestore(&table);
+    return ierr;
   }
-  // Build B, D matrix
-  // Fornberg, 1998
-  for (i = 0; i  < Q; i++) {
-    c1 = 1.0;
-    c3 = nodes[0] - qref1d[i];
-    interp1d[i*P+0] = 1.0;
-    for (j = 1; j < P; j++) {
-      c2 = 1.0;
-      c4 = c3;
-      c3 = nodes[j] - qref1d[i];
-      for (k = 0; k < j; k++) {
-        dx = nodes[j] - nodes[k];
-        c2 *= dx;
-        if (k == j - 1) {
-          grad1d[i*P + j] = c1*(interp1d[i*P + k] - c4*grad1d[i*P + k]) / c2;
-          interp1d[i*P + j] = - c1*c4*interp1d[i*P + k] / c2;
-        }
-        grad1d[i*P + k] = (c3*grad1d[i*P + k] - interp1d[i*P + k]) / dx;
-        interp1d[i*P + k] = c3*interp1d[i*P + k] / dx;
-      }
-      c1 = c2;
-    }
+  return 0;
+}
+
+/**
+  @brief Create a tensor product Lagrange basis with different numbers of
+         nodes and quadrature points in each direction
+
+  @param ceed       A Ceed object where the CeedBasis will be created
+  @param dim        Topological dimension of element
+  @param ncomp      Number of field components
+  @param P          Array of length dim holding the number of Gauss-Lobatto
+                      nodes in each direction, of polynomial degree P[d]-1
+  @param Q          Array of length dim holding the number of quadrature
+                      points in each direction
+  @param qmode      Distribution of the quadrature points (affects order of
+                      accuracy for the quadrature)
+  @param[out] basis Address of the variable where the newly created
+                      CeedBasis will be stored.
+
+  See CeedBasisCreateTensorH1Anisotropic().  If all the directions are the
+  same, this is CeedBasisCreateTensorH1Lagrange().
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Basic
+**/
+int CeedBasisCreateTensorH1LagrangeAnisotropic(Ceed ceed, CeedInt dim,
+    CeedInt ncomp, const CeedInt *P, const CeedInt *Q, CeedQuadMode qmode,
+    CeedBasis *basis) {
+  int ierr;
+  if (dim < 1)
+    return CeedError(ceed, 1, "Tensor bases need dim > 0");
+  bool same = true;
+  CeedInt nq = 0, nt = 0;
+  for (CeedInt d=0; d<dim; d++) {
+    same = same && P[d] == P[0] && Q[d] == Q[0];
+    nq += Q[d];
+    nt += Q[d]*P[d];
+  }
+  if (same) {
+    ierr = CeedBasisCreateTensorH1Lagrange(ceed, dim, ncomp, P[0], Q[0], qmode,
+                                           basis); CeedChk(ierr);
+    return 0;
   }
-  //  // Pass to CeedBasisCreateTensorH1
-  ierr = CeedBasisCreateTensorH1(ceed, dim, ncomp, P, Q, interp1d, grad1d, qref1d,
-                                 qweight1d, basis); CeedChk(ierr);
+
+  // The shared 1D tables of the directions, referenced by the basis until it
+  // is destroyed, and copied one after the other
+  struct CeedBasisTable_private **tables;
+  CeedScalar *interp1d, *grad1d, *qref1d, *qweight1d;
+  ierr = CeedCalloc(dim, &tables); CeedChk(ierr);
+  ierr = CeedMalloc(nt, &interp1d); CeedChk(ierr);
+  ierr = CeedMalloc(nt, &grad1d); CeedChk(ierr);
+  ierr = CeedMalloc(nq, &qref1d); CeedChk(ierr);
+  ierr = CeedMalloc(nq, &qweight1d); CeedChk(ierr);
+  for (CeedInt d=0, off=0, qoff=0; d<dim; d++) {
+    ierr = CeedBasisTableGet(ceed, P[d], Q[d], qmode, &tables[d]);
+    CeedChk(ierr);
+    memcpy(interp1d + off, tables[d]->interp1d,
+           Q[d]*P[d]*sizeof(interp1d[0]));
+    memcpy(grad1d + off, tables[d]->grad1d, Q[d]*P[d]*sizeof(grad1d[0]));
+    memcpy(qref1d + qoff, tables[d]->qref1d, Q[d]*sizeof(qref1d[0]));
+    memcpy(qweight1d + qoff, tables[d]->qweight1d, Q[d]*sizeof(qweight1d[0]));
+    off += Q[d]*P[d];
+    qoff += Q[d];
+  }
+  ierr = CeedBasisCreateTensorH1Anisotropic(ceed, dim, ncomp, P, Q, interp1d,
+                                            grad1d, qref1d, qweight1d, basis);
+  if (ierr) {
+    for (CeedInt d=0; d<dim; d++)
+      CeedBasisTableRestore(&tables[d]);
+    CeedFree(&tables);
+  } else {
+    (*basis)->dirtables = tables;
+  }
+  CeedChk(ierr);
   ierr = CeedFree(&interp1d); CeedChk(ierr);
   ierr = CeedFree(&grad1d); CeedChk(ierr);
-  ierr = CeedFree(&nodes); CeedChk(ierr);
   ierr = CeedFree(&qref1d); CeedChk(ierr);
   ierr = CeedFree(&qweight1d); CeedChk(ierr);
   return 0;
@@ -238,6 +599,222 @@ int CeedBasisCreateH1(Ceed ceed, CeedElemTopology topo, CeedInt ncomp,
   return 0;
 }
 
+/// @cond DOXYGEN_SKIP
+// Values of the Jacobi polynomials P_0^(alpha,beta),...,P_(n-1)^(alpha,beta)
+// at x
+static void CeedJacobiPolynomials(CeedInt n, CeedScalar alpha,
+                                  CeedScalar beta, CeedScalar x,
+                                  CeedScalar *p) {
+  if (n > 0) p[0] = 1.0;
+  if (n > 1) p[1] = ((alpha+beta+2.0)*x + alpha - beta)/2.0;
+  for (CeedInt k=1; k+1<n; k++) {
+    const CeedScalar s = 2*k + alpha + beta,
+                     c0 = 2*(k+1)*(k+alpha+beta+1)*s,
+                     c1 = (s+1)*((s+2)*s*x + alpha*alpha - beta*beta),
+                     c2 = 2*(k+alpha)*(k+beta)*(s+2);
+    p[k+1] = (c1*p[k] - c2*p[k-1])/c0;
+  }
+}
+
+// Derivatives of the Jacobi polynomials P_0^(alpha,beta),...,
+// P_(n-1)^(alpha,beta) at x
+static void CeedJacobiDerivatives(CeedInt n, CeedScalar alpha,
+                                  CeedScalar beta, CeedScalar x,
+                                  CeedScalar *dp) {
+  CeedScalar p[n];
+  CeedJacobiPolynomials(n, alpha+1, beta+1, x, p);
+  if (n > 0) dp[0] = 0.0;
+  for (CeedInt k=1; k<n; k++)
+    dp[k] = (k+alpha+beta+1)/2.0*p[k-1];
+}
+
+// Gauss-Jacobi quadrature for the weight (1-x)^alpha on [-1, 1], the roots
+// of P_Q^(alpha,0) found by Newton's method with deflation
+static void CeedGaussJacobiQuadrature(CeedInt Q, CeedScalar alpha,
+                                      CeedScalar *x, CeedScalar *w) {
+  const CeedScalar PI = 4.0*atan(1.0);
+  CeedScalar p[Q+1], dp[Q+1];
+  for (CeedInt i=0; i<Q; i++) {
+    CeedScalar xi = -cos(PI*(2*i+1)/(2*Q));
+    if (i > 0) xi = (xi + x[i-1])/2;
+    for (CeedInt k=0; k<100; k++) {
+      CeedJacobiPolynomials(Q+1, alpha, 0.0, xi, p);
+      CeedJacobiDerivatives(Q+1, alpha, 0.0, xi, dp);
+      CeedScalar s = 0.0;
+      for (CeedInt j=0; j<i; j++)
+        s += 1.0/(xi - x[j]);
+      const CeedScalar delta = -p[Q]/(dp[Q] - s*p[Q]);
+      xi += delta;
+      if (fabs(delta) < 1e-15) break;
+    }
+    CeedJacobiDerivatives(Q+1, alpha, 0.0, xi, dp);
+    x[i] = xi;
+    w[i] = pow(2.0, alpha+1)/((1.0 - xi*xi)*dp[Q]*dp[Q]);
+  }
+}
+/// @endcond
+
+/**
+  @brief Create an orthonormal (Dubiner) basis on a simplex, applied by sum
+    factorization in collapsed (Duffy) coordinates
+
+  The nodes of this basis are the coefficients of the P(P+1)/2 (triangle) or
+  P(P+1)(P+2)/6 (tetrahedron) modes spanning the polynomials of degree P-1,
+  which are orthonormal on the reference simplex with vertices at the origin
+  and the unit vectors.  The modes are products of Jacobi polynomials in the
+  collapsed coordinates, in which the simplex is a cube, so backends can apply
+  the basis with O(P^(dim+1)) operations per element instead of the
+  O(P^(2 dim)) of a dense CeedBasisCreateH1() basis.  The quadrature is the
+  tensor product of Q Gauss-Jacobi points in each collapsed coordinate.  As the
+  modes are not associated with vertices, edges or faces, this basis suits
+  discretizations in which each element has its own nodes.
+
+  @param ceed       A Ceed object where the CeedBasis will be created
+  @param topo       Topology of element, CEED_TRIANGLE or CEED_TET
+  @param ncomp      Number of field components (1 for scalar fields)
+  @param P          Number of modes in each collapsed coordinate, the
+                      polynomial degree is P-1
+  @param Q          Number of quadrature points in each collapsed coordinate,
+                      Q^dim in total (exact for degree 2*Q-1 in each)
+  @param[out] basis Address of the variable where the newly created
+                      CeedBasis will be stored.
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Basic
+**/
+int CeedBasisCreateSimplexDubiner(Ceed ceed, CeedElemTopology topo,
+                                  CeedInt ncomp, CeedInt P, CeedInt Q,
+                                  CeedBasis *basis) {
+  int ierr;
+  CeedInt dim;
+  ierr = CeedBasisGetTopologyDimension(topo, &dim); CeedChk(ierr);
+  if (topo != CEED_TRIANGLE && topo != CEED_TET)
+    return CeedError(ceed, 1, "Dubiner bases need a triangle or tetrahedron");
+  if (P < 1 || Q < 1)
+    return CeedError(ceed, 1, "Dubiner bases need P > 0 and Q > 0");
+
+  // Sizes, nB modes of the first two coordinates
+  const CeedInt nB = P*(P+1)/2, ndof = dim == 2 ? nB : P*(P+1)*(P+2)/6,
+                nqpt = CeedIntPow(Q, dim),
+                ntables = 3*Q*P + 4*Q*nB + (dim == 3 ? 3*Q*ndof : 0);
+  const CeedScalar scale = sqrt(CeedIntPow(2, dim));
+
+  // Collapsed coordinates a, b, c of the 1D quadrature points
+  CeedScalar *x1d, *w1d;
+  ierr = CeedCalloc(dim*Q, &x1d); CeedChk(ierr);
+  ierr = CeedCalloc(dim*Q, &w1d); CeedChk(ierr);
+  for (CeedInt d=0; d<dim; d++)
+    CeedGaussJacobiQuadrature(Q, d, x1d + d*Q, w1d + d*Q);
+
+  // Factor tables, see CeedBasisGetCollapsedTables()
+  CeedScalar *tables;
+  ierr = CeedCalloc(ntables, &tables); CeedChk(ierr);
+  CeedScalar *A = tables, *DA = A + Q*P, *AA = DA + Q*P, *B = AA + Q*P,
+              *DB = B + Q*nB, *BB = DB + Q*nB, *DBB = BB + Q*nB,
+              *C = dim == 3 ? DBB + Q*nB : NULL,
+              *DC = dim == 3 ? C + Q*ndof : NULL,
+              *CC = dim == 3 ? DC + Q*ndof : NULL;
+  for (CeedInt q=0; q<Q; q++) {
+    CeedScalar p[P], dp[P];
+    const CeedScalar a = x1d[q];
+    CeedJacobiPolynomials(P, 0.0, 0.0, a, p);
+    CeedJacobiDerivatives(P, 0.0, 0.0, a, dp);
+    for (CeedInt i=0; i<P; i++) {
+      const CeedScalar s = scale*sqrt((2*i+1)/2.0);
+      A[q*P+i] = s*p[i];
+      DA[q*P+i] = 2*s*dp[i];
+      AA[q*P+i] = (1+a)*s*dp[i];
+    }
+  }
+  for (CeedInt i=0, off=0; i<P; off+=Q*(P-i), i++)
+    for (CeedInt q=0; q<Q; q++) {
+      CeedScalar p[P], dp[P];
+      const CeedScalar b = x1d[Q+q], h = (1-b)/2, hi = pow(h, i),
+                       dhi = i ? -i/2.0*pow(h, i-1) : 0.0;
+      CeedJacobiPolynomials(P-i, 2*i+1, 0.0, b, p);
+      CeedJacobiDerivatives(P-i, 2*i+1, 0.0, b, dp);
+      for (CeedInt j=0; j<P-i; j++) {
+        const CeedScalar s = sqrt(i+j+1.0), db = s*(dhi*p[j] + hi*dp[j]);
+        B[off + q*(P-i)+j] = s*hi*p[j];
+        DB[off + q*(P-i)+j] = 2*db;
+        BB[off + q*(P-i)+j] = s*hi*p[j]/h;
+        DBB[off + q*(P-i)+j] = (1+b)*db;
+      }
+    }
+  if (dim == 3)
+    for (CeedInt i=0, off=0; i<P; i++)
+      for (CeedInt j=0; j<P-i; off+=Q*(P-i-j), j++)
+        for (CeedInt q=0; q<Q; q++) {
+          CeedScalar p[P], dp[P];
+          const CeedInt n = P-i-j;
+          const CeedScalar c = x1d[2*Q+q], h = (1-c)/2, hij = pow(h, i+j),
+                           dhij = i+j ? -(i+j)/2.0*pow(h, i+j-1) : 0.0;
+          CeedJacobiPolynomials(n, 2*(i+j)+2, 0.0, c, p);
+          CeedJacobiDerivatives(n, 2*(i+j)+2, 0.0, c, dp);
+          for (CeedInt k=0; k<n; k++) {
+            const CeedScalar s = sqrt((2*(i+j+k)+3)/2.0);
+            C[off + q*n+k] = s*hij*p[k];
+            DC[off + q*n+k] = 2*s*(dhij*p[k] + hij*dp[k]);
+            CC[off + q*n+k] = s*hij*p[k]/h;
+          }
+        }
+
+  // Dense tables, the quadrature point q = (qa*Q + qb)*Q + qc has collapsed
+  // coordinates (a, b, c) and the mode (i, j, k) is numbered lexicographically
+  CeedScalar *interp, *grad, *qref, *qweight;
+  ierr = CeedCalloc(nqpt*ndof, &interp); CeedChk(ierr);
+  ierr = CeedCalloc(dim*nqpt*ndof, &grad); CeedChk(ierr);
+  ierr = CeedCalloc(dim*nqpt, &qref); CeedChk(ierr);
+  ierr = CeedCalloc(nqpt, &qweight); CeedChk(ierr);
+  for (CeedInt q=0; q<nqpt; q++) {
+    const CeedInt qa = dim == 2 ? q/Q : q/(Q*Q), qb = dim == 2 ? q%Q : (q/Q)%Q,
+                  qc = q%Q;
+    const CeedScalar a = x1d[qa], b = x1d[Q+qb], c = dim == 3 ? x1d[2*Q+qc] : 0;
+    if (dim == 2) {
+      qref[q] = (1+a)*(1-b)/4;
+      qref[nqpt+q] = (1+b)/2;
+      qweight[q] = w1d[qa]*w1d[Q+qb]/8;
+    } else {
+      qref[q] = (1+a)*(1-b)*(1-c)/8;
+      qref[nqpt+q] = (1+b)*(1-c)/4;
+      qref[2*nqpt+q] = (1+c)/2;
+      qweight[q] = w1d[qa]*w1d[Q+qb]*w1d[2*Q+qc]/64;
+    }
+    for (CeedInt i=0, m=0, offB=0, offC=0; i<P; offB+=Q*(P-i), i++)
+      for (CeedInt j=0; j<P-i; j++) {
+        const CeedInt n = dim == 2 ? 1 : P-i-j, qij = offB + qb*(P-i)+j;
+        for (CeedInt k=0; k<n; k++, m++) {
+          const CeedInt qijk = offC + qc*n+k;
+          const CeedScalar c0 = dim == 3 ? C[qijk] : 1,
+                           cc = dim == 3 ? CC[qijk] : 1;
+          interp[q*ndof+m] = A[qa*P+i]*B[qij]*c0;
+          grad[q*ndof+m] = DA[qa*P+i]*BB[qij]*cc;
+          grad[(nqpt+q)*ndof+m] = AA[qa*P+i]*BB[qij]*cc
+                                  + A[qa*P+i]*DB[qij]*cc;
+          if (dim == 3)
+            grad[(2*nqpt+q)*ndof+m] = AA[qa*P+i]*BB[qij]*cc
+                                      + A[qa*P+i]*DBB[qij]*cc
+                                      + A[qa*P+i]*B[qij]*DC[qijk];
+        }
+        offC += Q*n;
+      }
+  }
+
+  ierr = CeedBasisCreateH1(ceed, topo, ncomp, ndof, nqpt, interp, grad, qref,
+                           qweight, basis); CeedChk(ierr);
+  (*basis)->P1d = P;
+  (*basis)->Q1d = Q;
+  (*basis)->collapsed = tables;
+  ierr = CeedFree(&x1d); CeedChk(ierr);
+  ierr = CeedFree(&w1d); CeedChk(ierr);
+  ierr = CeedFree(&interp); CeedChk(ierr);
+  ierr = CeedFree(&grad); CeedChk(ierr);
+  ierr = CeedFree(&qref); CeedChk(ierr);
+  ierr = CeedFree(&qweight); CeedChk(ierr);
+  return 0;
+}
+
 /**
   @brief Construct a Gauss-Legendre quadrature
 
@@ -398,7 +975,23 @@ static int CeedScalarView(const char *name, const char *fpformat, CeedInt m,
 int CeedBasisView(CeedBasis basis, FILE *stream) {
   int ierr;
 
-  if (basis->tensorbasis) {
+  if (basis->sizes1d) {
+    const CeedInt dim = basis->dim, *P1d = basis->sizes1d, *Q1d = P1d + dim;
+    fprintf(stream, "CeedBasis: dim=%d P=%d Q=%d\n", dim, basis->P, basis->Q);
+    for (CeedInt d=0, off=0, qoff=0; d<dim; d++) {
+      fprintf(stream, "  direction %d: P=%d Q=%d\n", d, P1d[d], Q1d[d]);
+      ierr = CeedScalarView("qref1d", "\t% 12.8f", 1, Q1d[d],
+                            basis->qref1d + qoff, stream); CeedChk(ierr);
+      ierr = CeedScalarView("qweight1d", "\t% 12.8f", 1, Q1d[d],
+                            basis->qweight1d + qoff, stream); CeedChk(ierr);
+      ierr = CeedScalarView("interp1d", "\t% 12.8f", Q1d[d], P1d[d],
+                            basis->interp1d + off, stream); CeedChk(ierr);
+      ierr = CeedScalarView("grad1d", "\t% 12.8f", Q1d[d], P1d[d],
+                            basis->grad1d + off, stream); CeedChk(ierr);
+      off += Q1d[d]*P1d[d];
+      qoff += Q1d[d];
+    }
+  } else if (basis->tensorbasis) {
     fprintf(stream, "CeedBasis: dim=%d P=%d Q=%d\n", basis->dim, basis->P1d,
             basis->Q1d);
     ierr = CeedScalarView("qref1d", "\t% 12.8f", 1, basis->Q1d, basis->qref1d,
@@ -548,40 +1141,74 @@ int CeedQRFactorization(CeedScalar *mat, CeedScalar *tau,
   @ref Advanced
 **/
 int CeedBasisGetCollocatedGrad(CeedBasis basis, CeedScalar *colograd1d) {
-  int i, j, k;
-  CeedInt ierr, P1d=(basis)->P1d, Q1d=(basis)->Q1d;
-  CeedScalar *interp1d, *grad1d, tau[Q1d];
+  int ierr;
+  CeedInt P1d = basis->P1d, Q1d = basis->Q1d;
+  if (basis->sizes1d)
+    return CeedError(basis->ceed, 1,
+                     "Anisotropic bases have no single collocated derivative");
+
+  // Shared tables come with it
+  if (basis->table && basis->table->colograd1d) {
+    memcpy(colograd1d, basis->table->colograd1d,
+           Q1d*Q1d*sizeof(colograd1d[0]));
+    return 0;
+  }
+  ierr = CeedBasisComputeCollocatedGrad(P1d, Q1d, basis->interp1d,
+                                        basis->grad1d, colograd1d);
+  CeedChk(ierr);
+  return 0;
+}
 
-  ierr = CeedMalloc(Q1d*P1d, &interp1d); CeedChk(ierr);
-  ierr = CeedMalloc(Q1d*P1d, &grad1d); CeedChk(ierr);
-  memcpy(interp1d, (basis)->interp1d, Q1d*P1d*sizeof(basis)->interp1d[0]);
-  memcpy(grad1d, (basis)->grad1d, Q1d*P1d*sizeof(basis)->interp1d[0]);
+/**
+  @brief Evaluate the 1D basis functions of a tensor basis at arbitrary points
 
-  // QR Factorization, interp1d = Q R
-  ierr = CeedQRFactorization(interp1d, tau, Q1d, P1d); CeedChk(ierr);
+  The nodal basis functions, polynomials of degree P1d-1, are recovered from
+  their values at the Q1d >= P1d quadrature points by Lagrange interpolation
+  through those points, so that any tensor basis can be evaluated, not only
+  those of CeedBasisCreateTensorH1Lagrange().
 
-  // Apply Rinv, colograd1d = grad1d Rinv
-  for (i=0; i<Q1d; i++) { // Row i
-    colograd1d[Q1d*i] = grad1d[P1d*i]/interp1d[0];
-    for (j=1; j<P1d; j++) { // Column j
-      colograd1d[j+Q1d*i] = grad1d[j+P1d*i];
-      for (k=0; k<j; k++) {
-        colograd1d[j+Q1d*i] -= interp1d[j+P1d*k]*colograd1d[k+Q1d*i];
-      }
-      colograd1d[j+Q1d*i] /= interp1d[j+P1d*j];
-    }
-    for (j=P1d; j<Q1d; j++) {
-      colograd1d[j+Q1d*i] = 0;
-    }
-  }
-
-  // Apply Qtranspose, colograd = colograd Qtranspose
-  CeedHouseholderApplyQ(colograd1d, interp1d, tau, CEED_NOTRANSPOSE,
-                        Q1d, Q1d, P1d, 1, Q1d);
+  @param basis        CeedBasis
+  @param npts         Number of points
+  @param x            Array of length npts holding the points on the reference
+                        element [-1, 1]
+  @param[out] interp  Row-major npts × P1d matrix of the values of the basis
+                        functions at the points, or NULL
+  @param[out] grad    Row-major npts × P1d matrix of their derivatives, or NULL
+  @param work         Workspace of length 2*npts*Q1d, so that callers
+                        evaluating many sets of points allocate it once
 
-  ierr = CeedFree(&interp1d); CeedChk(ierr);
-  ierr = CeedFree(&grad1d); CeedChk(ierr);
+  @return An error code: 0 - success, otherwise - failure
 
+  @ref Advanced
+**/
+int CeedBasisEvaluate1D(CeedBasis basis, CeedInt npts, const CeedScalar *x,
+                        CeedScalar *interp, CeedScalar *grad,
+                        CeedScalar *work) {
+  const CeedInt P1d = basis->P1d, Q1d = basis->Q1d;
+  if (!basis->tensorbasis || basis->collapsed)
+    return CeedError(basis->ceed, 1, "Only tensor bases have 1D functions");
+  if (basis->sizes1d)
+    return CeedError(basis->ceed, 1,
+                     "Anisotropic bases have different 1D functions");
+  if (Q1d < P1d)
+    return CeedError(basis->ceed, 1,
+                     "Evaluating a basis at points needs Q1d >= P1d");
+
+  // Lagrange polynomials through the quadrature points
+  CeedScalar *l = work, *dl = work + npts*Q1d;
+  CeedLagrangeEvaluate(Q1d, basis->qref1d, npts, x, l, dl);
+
+  // Applied to the values of the basis functions at the quadrature points
+  for (CeedInt i=0; i<npts; i++)
+    for (CeedInt j=0; j<P1d; j++) {
+      CeedScalar vij = 0, dij = 0;
+      for (CeedInt q=0; q<Q1d; q++) {
+        vij += l[i*Q1d+q] * basis->interp1d[q*P1d+j];
+        dij += dl[i*Q1d+q] * basis->interp1d[q*P1d+j];
+      }
+      if (interp) interp[i*P1d+j] = vij;
+      if (grad) grad[i*P1d+j] = dij;
+    }
   return 0;
 }
 
@@ -596,7 +1223,9 @@ int CeedBasisGetCollocatedGrad(CeedBasis basis, CeedScalar *colograd1d) {
                   points, \ref CEED_TRANSPOSE to apply the transpose, mapping
                   from quadrature points to nodes
   @param emode  \ref CEED_EVAL_INTERP to obtain interpolated values,
-                  \ref CEED_EVAL_GRAD to obtain gradients.
+                  \ref CEED_EVAL_GRAD to obtain gradients,
+                  \ref CEED_EVAL_INTERP | \ref CEED_EVAL_GRAD to obtain the
+                  interpolated values followed by the gradients.
   @param[in] u  Input array
   @param[out] v Output array
 
@@ -613,6 +1242,51 @@ int CeedBasisApply(CeedBasis basis, CeedInt nelem, CeedTransposeMode tmode,
   return 0;
 }
 
+/**
+  @brief Apply basis evaluation from nodes to arbitrary points in each element
+    or vice-versa
+
+  Each element holds the same number of points, given by their reference
+  coordinates.  Tensor bases are evaluated by sum factorization: the first
+  coordinate is contracted for all points of an element at once with the
+  backend's tensor contraction, the others point by point.  In
+  \ref CEED_TRANSPOSE mode, the contributions of all points of an element are
+  summed into its nodes.
+
+  @param basis    CeedBasis to evaluate
+  @param nelem    The number of elements to apply the basis evaluation to,
+                    with the element index fastest in x, u and v
+  @param npoints  The number of points in each element
+  @param tmode    \ref CEED_NOTRANSPOSE to evaluate from nodes to the points,
+                    \ref CEED_TRANSPOSE to apply the transpose, mapping from
+                    the points to nodes
+  @param emode    \ref CEED_EVAL_INTERP, \ref CEED_EVAL_GRAD or both, laid
+                    out at the points as for CeedBasisApply()
+  @param[in] x    Reference coordinates of the points, of size
+                    dim*npoints*nelem with the coordinate index slowest
+  @param[in] u    Input array
+  @param[out] v   Output array
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Advanced
+**/
+int CeedBasisApplyAtPoints(CeedBasis basis, CeedInt nelem, CeedInt npoints,
+                           CeedTransposeMode tmode, CeedEvalMode emode,
+                           CeedVector x, CeedVector u, CeedVector v) {
+  int ierr;
+  if (!basis->ApplyAtPoints)
+    return CeedError(basis->ceed, 1,
+                     "Backend does not support BasisApplyAtPoints");
+  if (!(emode & (CEED_EVAL_INTERP|CEED_EVAL_GRAD)) ||
+      (emode & ~(CEED_EVAL_INTERP|CEED_EVAL_GRAD)))
+    return CeedError(basis->ceed, 1,
+                     "Only INTERP and GRAD are evaluated at points");
+  ierr = basis->ApplyAtPoints(basis, nelem, npoints, tmode, emode, x, u, v);
+  CeedChk(ierr);
+  return 0;
+}
+
 /**
   @brief Get Ceed associated with a CeedBasis
 
@@ -661,6 +1335,27 @@ int CeedBasisGetTensorStatus(CeedBasis basis, bool *tensor) {
   return 0;
 };
 
+/**
+  @brief Get symmetry status for given CeedBasis
+
+  A tensor basis is symmetric if its 1D interpolation matrix is
+  centrosymmetric and its 1D gradient matrix is skew-centrosymmetric, as for
+  nodes and quadrature points symmetric about the element center.  Backends
+  may then use an even-odd decomposition of the 1D matrices.
+
+  @param basis           CeedBasis
+  @param[out] symmetric  Variable to store symmetry status
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Advanced
+**/
+int CeedBasisGetSymmetryStatus(CeedBasis basis, bool *symmetric) {
+  *symmetric = basis->symmetric;
+
+  return 0;
+};
+
 /**
   @brief Get number of components for given CeedBasis
 
@@ -680,6 +1375,10 @@ int CeedBasisGetNumComponents(CeedBasis basis, CeedInt *numcomp) {
 /**
   @brief Get total number of nodes (in 1 dimension) of a CeedBasis
 
+  For a simplex basis in collapsed coordinates, this is the number of modes
+  in each collapsed coordinate.  Anisotropic bases have no single P1d, see
+  CeedBasisGetAnisotropicSizes().
+
   @param basis     CeedBasis
   @param[out] P1d  Variable to store number of nodes
 
@@ -688,8 +1387,10 @@ int CeedBasisGetNumComponents(CeedBasis basis, CeedInt *numcomp) {
   @ref Advanced
 **/
 int CeedBasisGetNumNodes1D(CeedBasis basis, CeedInt *P1d) {
-  if (!basis->tensorbasis) return CeedError(basis->ceed, 1,
-                                      "Cannot supply P1d for non-tensor basis");
+  if (!basis->tensorbasis && !basis->collapsed)
+    return CeedError(basis->ceed, 1, "Cannot supply P1d for non-tensor basis");
+  if (basis->sizes1d)
+    return CeedError(basis->ceed, 1, "Cannot supply P1d for anisotropic basis");
   *P1d = basis->P1d;
   return 0;
 }
@@ -697,6 +1398,10 @@ int CeedBasisGetNumNodes1D(CeedBasis basis, CeedInt *P1d) {
 /**
   @brief Get total number of quadrature points (in 1 dimension) of a CeedBasis
 
+  For a simplex basis in collapsed coordinates, this is the number of
+  quadrature points in each collapsed coordinate.  Anisotropic bases have no
+  single Q1d, see CeedBasisGetAnisotropicSizes().
+
   @param basis     CeedBasis
   @param[out] Q1d  Variable to store number of quadrature points
 
@@ -705,8 +1410,10 @@ int CeedBasisGetNumNodes1D(CeedBasis basis, CeedInt *P1d) {
   @ref Advanced
 **/
 int CeedBasisGetNumQuadraturePoints1D(CeedBasis basis, CeedInt *Q1d) {
-  if (!basis->tensorbasis) return CeedError(basis->ceed, 1,
-                                      "Cannot supply Q1d for non-tensor basis");
+  if (!basis->tensorbasis && !basis->collapsed)
+    return CeedError(basis->ceed, 1, "Cannot supply Q1d for non-tensor basis");
+  if (basis->sizes1d)
+    return CeedError(basis->ceed, 1, "Cannot supply Q1d for anisotropic basis");
   *Q1d = basis->Q1d;
   return 0;
 }
@@ -752,7 +1459,7 @@ int CeedBasisGetNumQuadraturePoints(CeedBasis basis, CeedInt *Q) {
 
   @ref Advanced
 **/
-int CeedBasisGetQRef(CeedBasis basis, CeedScalar* *qref) {
+int CeedBasisGetQRef(CeedBasis basis, const CeedScalar **qref) {
   *qref = basis->qref1d;
   return 0;
 }
@@ -768,7 +1475,7 @@ int CeedBasisGetQRef(CeedBasis basis, CeedScalar* *qref) {
 
   @ref Advanced
 **/
-int CeedBasisGetQWeights(CeedBasis basis, CeedScalar* *qweight) {
+int CeedBasisGetQWeights(CeedBasis basis, const CeedScalar **qweight) {
   *qweight = basis->qweight1d;
   return 0;
 }
@@ -783,7 +1490,7 @@ int CeedBasisGetQWeights(CeedBasis basis, CeedScalar* *qweight) {
 
   @ref Advanced
 **/
-int CeedBasisGetInterp(CeedBasis basis, CeedScalar* *interp) {
+int CeedBasisGetInterp(CeedBasis basis, const CeedScalar **interp) {
   *interp = basis->interp1d;
   return 0;
 }
@@ -798,11 +1505,62 @@ int CeedBasisGetInterp(CeedBasis basis, CeedScalar* *interp) {
 
   @ref Advanced
 **/
-int CeedBasisGetGrad(CeedBasis basis, CeedScalar* *grad) {
+int CeedBasisGetGrad(CeedBasis basis, const CeedScalar **grad) {
   *grad = basis->grad1d;
   return 0;
 }
 
+/**
+  @brief Get the numbers of nodes and quadrature points in each direction of
+         an anisotropic tensor basis
+
+  The sizes are P1d[0],...,P1d[dim-1] followed by Q1d[0],...,Q1d[dim-1], as
+  given to CeedBasisCreateTensorH1Anisotropic().  The 1D arrays of
+  CeedBasisGetInterp(), CeedBasisGetGrad(), CeedBasisGetQRef() and
+  CeedBasisGetQWeights() then hold those of the directions one after the
+  other.
+
+  @param basis         CeedBasis
+  @param[out] sizes1d  Variable to store the sizes, NULL if the basis is not
+                         anisotropic
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Advanced
+**/
+int CeedBasisGetAnisotropicSizes(CeedBasis basis, CeedInt* *sizes1d) {
+  *sizes1d = basis->sizes1d;
+  return 0;
+}
+
+/**
+  @brief Get the factor tables of a simplex basis in collapsed coordinates
+
+  A basis from CeedBasisCreateSimplexDubiner() with P modes and Q quadrature
+  points in each collapsed coordinate a, b, c has modes A_i(a) B_ij(b) C_ijk(c).
+  Its gradient on the unit simplex is a sum of such products with the factors
+  DA = 2 A', AA = (1+a) A', DB = 2 B', BB = 2 B/(1-b), DBB = (1+b) B',
+  DC = 2 C', CC = 2 C/(1-c):
+    d/dx = DA BB CC,
+    d/dy = AA BB CC + A DB CC,
+    d/dz = AA BB CC + A DBB CC + A B DC,
+  with C = CC = 1 on triangles.  The tables hold the row-major Q × P matrices
+  A, DA and AA, then for each of B, DB, BB and DBB the Q × (P-i) matrices for
+  i=0,...,P-1 and, for tetrahedra, for each of C, DC and CC the Q × (P-i-j)
+  matrices for i+j<P, in lexicographic order.
+
+  @param basis        CeedBasis
+  @param[out] tables  Variable to store the tables, NULL for other bases
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Advanced
+**/
+int CeedBasisGetCollapsedTables(CeedBasis basis, CeedScalar* *tables) {
+  *tables = basis->collapsed;
+  return 0;
+}
+
 /**
   @brief Get backend data of a CeedBasis
 
@@ -865,10 +1623,22 @@ int CeedBasisDestroy(CeedBasis *basis) {
   if ((*basis)->Destroy) {
     ierr = (*basis)->Destroy(*basis); CeedChk(ierr);
   }
-  ierr = CeedFree(&(*basis)->interp1d); CeedChk(ierr);
-  ierr = CeedFree(&(*basis)->grad1d); CeedChk(ierr);
-  ierr = CeedFree(&(*basis)->qref1d); CeedChk(ierr);
-  ierr = CeedFree(&(*basis)->qweight1d); CeedChk(ierr);
+  if ((*basis)->dirtables) {
+    for (CeedInt d=0; d<(*basis)->dim; d++) {
+      ierr = CeedBasisTableRestore(&(*basis)->dirtables[d]); CeedChk(ierr);
+    }
+    ierr = CeedFree(&(*basis)->dirtables); CeedChk(ierr);
+  }
+  if ((*basis)->table) {
+    ierr = CeedBasisTableRestore(&(*basis)->table); CeedChk(ierr);
+  } else {
+    ierr = CeedFree(&(*basis)->interp1d); CeedChk(ierr);
+    ierr = CeedFree(&(*basis)->grad1d); CeedChk(ierr);
+    ierr = CeedFree(&(*basis)->qref1d); CeedChk(ierr);
+    ierr = CeedFree(&(*basis)->qweight1d); CeedChk(ierr);
+  }
+  ierr = CeedFree(&(*basis)->sizes1d); CeedChk(ierr);
+  ierr = CeedFree(&(*basis)->collapsed); CeedChk(ierr);
   ierr = CeedDestroy(&(*basis)->ceed); CeedChk(ierr);
   ierr = CeedFree(basis); CeedChk(ierr);
   return 0;
@@ -16,6 +16,9 @@
 
 #include <ceed-impl.h>
 #include <ceed-backend.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
 
 /// @file
 /// Implementation of public CeedElemRestriction interfaces
@@ -83,6 +86,9 @@ int CeedElemRestrictionCreate(Ceed ceed, CeedInt nelem, CeedInt elemsize,
 /**
   @brief Create an identity CeedElemRestriction
 
+  The L-vector holds the components of the nodes of each element one after
+  the other, see CeedElemRestrictionCreateStrided().
+
   @param ceed       A Ceed object where the CeedElemRestriction will be created
   @param nelem      Number of elements described in the @a indices array
   @param elemsize   Size (number of "nodes") per element
@@ -102,6 +108,54 @@ int CeedElemRestrictionCreateIdentity(Ceed ceed, CeedInt nelem,
                                       CeedInt elemsize,
                                       CeedInt ndof, CeedInt ncomp, CeedElemRestriction *rstr) {
   int ierr;
+  const CeedInt strides[3] = {1, elemsize, elemsize*ncomp};
+  ierr = CeedElemRestrictionCreateStrided(ceed, nelem, elemsize, ndof, ncomp,
+                                          strides, rstr); CeedChk(ierr);
+  return 0;
+}
+
+// Check that the strides of a restriction stay within its L-vector
+static int CeedElemRestrictionCheckStrides(Ceed ceed, CeedInt nelem,
+    CeedInt elemsize, CeedInt ndof, CeedInt ncomp, const CeedInt *strides) {
+  if (strides[0] < 0 || strides[1] < 0 || strides[2] < 0)
+    return CeedError(ceed, 1, "Restriction strides must be nonnegative");
+  if ((elemsize-1)*strides[0] + (ncomp-1)*strides[1]
+      + (nelem-1)*strides[2] >= ndof*ncomp)
+    return CeedError(ceed, 1,
+                     "Restriction strides exceed the L-vector of size %d",
+                     ndof*ncomp);
+  return 0;
+}
+
+/**
+  @brief Create a strided CeedElemRestriction
+
+  Node i of component d of element e is entry
+  i*strides[0] + d*strides[1] + e*strides[2] of the L-vector, whatever the
+  @a lmode it is applied with.  No indices are stored or read, so this suits
+  data that is already element-local, such as quadrature data or
+  discontinuous fields.  An identity restriction has strides
+  {1, elemsize, elemsize*ncomp}.
+
+  @param ceed       A Ceed object where the CeedElemRestriction will be created
+  @param nelem      Number of elements
+  @param elemsize   Size (number of "nodes") per element
+  @param ndof       The total size of the input CeedVector to which the
+                      restriction will be applied, divided by ncomp
+  @param ncomp      Number of field components per interpolation node
+  @param strides    Node, component and element strides in the L-vector
+  @param rstr       Address of the variable where the newly created
+                      CeedElemRestriction will be stored
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Basic
+**/
+int CeedElemRestrictionCreateStrided(Ceed ceed, CeedInt nelem,
+                                     CeedInt elemsize, CeedInt ndof,
+                                     CeedInt ncomp, const CeedInt strides[3],
+                                     CeedElemRestriction *rstr) {
+  int ierr;
 
   if (!ceed->ElemRestrictionCreate) {
     Ceed delegate;
@@ -111,10 +165,12 @@ int CeedElemRestrictionCreateIdentity(Ceed ceed, CeedInt nelem,
       return CeedError(ceed, 1,
                      "Backend does not support ElemRestrictionCreate");
 
-    ierr = CeedElemRestrictionCreateIdentity(delegate, nelem, elemsize,
-                            ndof, ncomp, rstr); CeedChk(ierr);
+    ierr = CeedElemRestrictionCreateStrided(delegate, nelem, elemsize,
+                            ndof, ncomp, strides, rstr); CeedChk(ierr);
     return 0;
   }
+  ierr = CeedElemRestrictionCheckStrides(ceed, nelem, elemsize, ndof, ncomp,
+                                         strides); CeedChk(ierr);
 
   ierr = CeedCalloc(1, rstr); CeedChk(ierr);
   (*rstr)->ceed = ceed;
@@ -126,6 +182,8 @@ int CeedElemRestrictionCreateIdentity(Ceed ceed, CeedInt nelem,
   (*rstr)->ncomp = ncomp;
   (*rstr)->nblk = nelem;
   (*rstr)->blksize = 1;
+  ierr = CeedMalloc(3, &(*rstr)->strides); CeedChk(ierr);
+  memcpy((*rstr)->strides, strides, 3*sizeof(strides[0]));
   ierr = ceed->ElemRestrictionCreate(CEED_MEM_HOST, CEED_OWN_POINTER, NULL, *rstr);
   CeedChk(ierr);
   return 0;
@@ -197,6 +255,14 @@ int CeedElemRestrictionCreateBlocked(Ceed ceed, CeedInt nelem, CeedInt elemsize,
   CeedInt *blkindices;
   CeedInt nblk = (nelem / blksize) + !!(nelem % blksize);
 
+  if (!indices) {
+    const CeedInt strides[3] = {1, elemsize, elemsize*ncomp};
+    ierr = CeedElemRestrictionCreateBlockedStrided(ceed, nelem, elemsize,
+                                                   blksize, ndof, ncomp,
+                                                   strides, rstr);
+    CeedChk(ierr);
+    return 0;
+  }
   if (!ceed->ElemRestrictionCreateBlocked) {
     Ceed delegate;
     ierr = CeedGetDelegate(ceed, &delegate); CeedChk(ierr);
@@ -213,14 +279,9 @@ int CeedElemRestrictionCreateBlocked(Ceed ceed, CeedInt nelem, CeedInt elemsize,
 
   ierr = CeedCalloc(1, rstr); CeedChk(ierr);
 
-  if (indices) {
-    ierr = CeedCalloc(nblk*blksize*elemsize, &blkindices);
-    ierr = CeedPermutePadIndices(indices, blkindices, nblk, nelem, blksize,
-                                 elemsize);
-    CeedChk(ierr);
-  } else {
-    blkindices = NULL;
-  }
+  ierr = CeedCalloc(nblk*blksize*elemsize, &blkindices); CeedChk(ierr);
+  ierr = CeedPermutePadIndices(indices, blkindices, nblk, nelem, blksize,
+                               elemsize); CeedChk(ierr);
 
   (*rstr)->ceed = ceed;
   ceed->refcount++;
@@ -241,6 +302,479 @@ int CeedElemRestrictionCreateBlocked(Ceed ceed, CeedInt nelem, CeedInt elemsize,
   return 0;
 }
 
+/**
+  @brief Create a blocked strided CeedElemRestriction, typically only called
+         by backends
+
+  @param ceed       A Ceed object where the CeedElemRestriction will be created.
+  @param nelem      Number of elements
+  @param elemsize   Size (number of unknowns) per element
+  @param blksize    Number of elements in a block
+  @param ndof       The total size of the input CeedVector to which the
+                      restriction will be applied, divided by ncomp
+  @param ncomp      Number of components stored at each node
+  @param strides    Node, component and element strides in the L-vector, see
+                      CeedElemRestrictionCreateStrided()
+  @param rstr       Address of the variable where the newly created
+                      CeedElemRestriction will be stored
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Advanced
+ **/
+int CeedElemRestrictionCreateBlockedStrided(Ceed ceed, CeedInt nelem,
+    CeedInt elemsize, CeedInt blksize, CeedInt ndof, CeedInt ncomp,
+    const CeedInt strides[3], CeedElemRestriction *rstr) {
+  int ierr;
+  CeedInt nblk = (nelem / blksize) + !!(nelem % blksize);
+
+  if (!ceed->ElemRestrictionCreateBlocked) {
+    Ceed delegate;
+    ierr = CeedGetDelegate(ceed, &delegate); CeedChk(ierr);
+
+    if (!delegate)
+      return CeedError(ceed, 1,
+                     "Backend does not support ElemRestrictionCreateBlocked");
+
+    ierr = CeedElemRestrictionCreateBlockedStrided(delegate, nelem, elemsize,
+                            blksize, ndof, ncomp, strides, rstr);
+    CeedChk(ierr);
+    return 0;
+  }
+  ierr = CeedElemRestrictionCheckStrides(ceed, nelem, elemsize, ndof, ncomp,
+                                         strides); CeedChk(ierr);
+
+  ierr = CeedCalloc(1, rstr); CeedChk(ierr);
+  (*rstr)->ceed = ceed;
+  ceed->refcount++;
+  (*rstr)->refcount = 1;
+  (*rstr)->nelem = nelem;
+  (*rstr)->elemsize = elemsize;
+  (*rstr)->ndof = ndof;
+  (*rstr)->ncomp = ncomp;
+  (*rstr)->nblk = nblk;
+  (*rstr)->blksize = blksize;
+  ierr = CeedMalloc(3, &(*rstr)->strides); CeedChk(ierr);
+  memcpy((*rstr)->strides, strides, 3*sizeof(strides[0]));
+  ierr = ceed->ElemRestrictionCreateBlocked(CEED_MEM_HOST, CEED_OWN_POINTER,
+         NULL, *rstr); CeedChk(ierr);
+  return 0;
+}
+
+// Check the box of a Cartesian restriction and store its description
+static int CeedElemRestrictionCartesianBox(Ceed ceed, CeedInt dim,
+    const CeedInt *nelem, CeedInt P, CeedNodeOrdering order,
+    CeedInt **cartesian, CeedInt *numelem, CeedInt *elemsize, CeedInt *ndof) {
+  int ierr;
+  if (dim < 1 || dim > 3)
+    return CeedError(ceed, 1, "Cartesian restrictions have dimension 1 to 3");
+  if (P < 2)
+    return CeedError(ceed, 1,
+                     "Cartesian restrictions need at least 2 nodes per direction");
+  if (order != CEED_ORDER_LEXICOGRAPHIC && order != CEED_ORDER_REVERSED)
+    return CeedError(ceed, 1, "Unknown node ordering %d", order);
+  ierr = CeedMalloc(6, cartesian); CeedChk(ierr);
+  (*cartesian)[0] = dim;
+  (*cartesian)[1] = P;
+  (*cartesian)[5] = order;
+  *numelem = 1; *elemsize = 1; *ndof = 1;
+  for (CeedInt d=0; d<3; d++) {
+    const CeedInt n = d < dim ? nelem[d] : 1;
+    if (n < 1) {
+      ierr = CeedFree(cartesian); CeedChk(ierr);
+      return CeedError(ceed, 1, "Cartesian restrictions need elements");
+    }
+    (*cartesian)[2+d] = n;
+    if (d < dim) {
+      *numelem *= n;
+      *elemsize *= P;
+      *ndof *= n*(P-1) + 1;
+    }
+  }
+  return 0;
+}
+
+/**
+  @brief Create a CeedElemRestriction for a structured Cartesian mesh
+
+  The elements of a box of @a nelem[0] x ... x @a nelem[dim-1] elements of
+  @a P nodes in each direction are numbered lexicographically, direction 0
+  fastest, and so are the (@a nelem[d]*(P-1)+1) nodes in each direction d of
+  the L-vector.  The nodes of each element follow @a order.  Only the box is
+  stored; the indices are computed as the restriction is applied.
+
+  @param ceed       A Ceed object where the CeedElemRestriction will be created
+  @param dim        Dimension of the box, 1 to 3
+  @param nelem      Number of elements in each direction
+  @param P          Number of nodes in each direction of an element
+  @param order      Ordering of the nodes of each element,
+                      \ref CEED_ORDER_LEXICOGRAPHIC or \ref CEED_ORDER_REVERSED
+  @param ncomp      Number of field components per interpolation node
+  @param rstr       Address of the variable where the newly created
+                      CeedElemRestriction will be stored
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Basic
+**/
+int CeedElemRestrictionCreateCartesian(Ceed ceed, CeedInt dim,
+                                       const CeedInt *nelem, CeedInt P,
+                                       CeedNodeOrdering order, CeedInt ncomp,
+                                       CeedElemRestriction *rstr) {
+  int ierr;
+  CeedInt *cartesian, numelem, elemsize, ndof;
+
+  if (!ceed->ElemRestrictionCreate) {
+    Ceed delegate;
+    ierr = CeedGetDelegate(ceed, &delegate); CeedChk(ierr);
+
+    if (!delegate)
+      return CeedError(ceed, 1,
+                     "Backend does not support ElemRestrictionCreate");
+
+    ierr = CeedElemRestrictionCreateCartesian(delegate, dim, nelem, P, order,
+           ncomp, rstr); CeedChk(ierr);
+    return 0;
+  }
+  ierr = CeedElemRestrictionCartesianBox(ceed, dim, nelem, P, order,
+                                         &cartesian, &numelem, &elemsize,
+                                         &ndof);
+  CeedChk(ierr);
+
+  ierr = CeedCalloc(1, rstr); CeedChk(ierr);
+  (*rstr)->ceed = ceed;
+  ceed->refcount++;
+  (*rstr)->refcount = 1;
+  (*rstr)->nelem = numelem;
+  (*rstr)->elemsize = elemsize;
+  (*rstr)->ndof = ndof;
+  (*rstr)->ncomp = ncomp;
+  (*rstr)->nblk = numelem;
+  (*rstr)->blksize = 1;
+  (*rstr)->cartesian = cartesian;
+  ierr = ceed->ElemRestrictionCreate(CEED_MEM_HOST, CEED_OWN_POINTER, NULL,
+                                     *rstr); CeedChk(ierr);
+  return 0;
+}
+
+/**
+  @brief Create a blocked CeedElemRestriction for a structured Cartesian mesh,
+         typically only called by backends
+
+  @param ceed       A Ceed object where the CeedElemRestriction will be created
+  @param dim        Dimension of the box, 1 to 3
+  @param nelem      Number of elements in each direction
+  @param P          Number of nodes in each direction of an element
+  @param order      Ordering of the nodes of each element
+  @param blksize    Number of elements in a block
+  @param ncomp      Number of field components per interpolation node
+  @param rstr       Address of the variable where the newly created
+                      CeedElemRestriction will be stored
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Advanced
+**/
+int CeedElemRestrictionCreateBlockedCartesian(Ceed ceed, CeedInt dim,
+    const CeedInt *nelem, CeedInt P, CeedNodeOrdering order, CeedInt blksize,
+    CeedInt ncomp, CeedElemRestriction *rstr) {
+  int ierr;
+  CeedInt *cartesian, numelem, elemsize, ndof;
+
+  if (!ceed->ElemRestrictionCreateBlocked) {
+    Ceed delegate;
+    ierr = CeedGetDelegate(ceed, &delegate); CeedChk(ierr);
+
+    if (!delegate)
+      return CeedError(ceed, 1,
+                     "Backend does not support ElemRestrictionCreateBlocked");
+
+    ierr = CeedElemRestrictionCreateBlockedCartesian(delegate, dim, nelem, P,
+           order, blksize, ncomp, rstr); CeedChk(ierr);
+    return 0;
+  }
+  ierr = CeedElemRestrictionCartesianBox(ceed, dim, nelem, P, order,
+                                         &cartesian, &numelem, &elemsize,
+                                         &ndof);
+  CeedChk(ierr);
+
+  ierr = CeedCalloc(1, rstr); CeedChk(ierr);
+  (*rstr)->ceed = ceed;
+  ceed->refcount++;
+  (*rstr)->refcount = 1;
+  (*rstr)->nelem = numelem;
+  (*rstr)->elemsize = elemsize;
+  (*rstr)->ndof = ndof;
+  (*rstr)->ncomp = ncomp;
+  (*rstr)->nblk = (numelem / blksize) + !!(numelem % blksize);
+  (*rstr)->blksize = blksize;
+  (*rstr)->cartesian = cartesian;
+  ierr = ceed->ElemRestrictionCreateBlocked(CEED_MEM_HOST, CEED_OWN_POINTER,
+         NULL, *rstr); CeedChk(ierr);
+  return 0;
+}
+
+// Element with its key in the element order
+typedef struct {
+  uint64_t key;
+  CeedInt elem;
+} CeedElemKey;
+
+static int CeedElemKeyCompare(const void *a, const void *b) {
+  const CeedElemKey *ka = a, *kb = b;
+  if (ka->key != kb->key) return ka->key < kb->key ? -1 : 1;
+  return ka->elem - kb->elem;
+}
+
+// Morton (Z-order) key of a point with coordinates quantized to bits bits in
+//   each of the dim directions
+static uint64_t CeedMortonKey(CeedInt dim, const uint64_t *q, CeedInt bits) {
+  uint64_t key = 0;
+  for (CeedInt b=bits-1; b>=0; b--)
+    for (CeedInt d=0; d<dim; d++)
+      key = (key << 1) | ((q[d] >> b) & 1);
+  return key;
+}
+
+// Elements in Morton order of their centroids
+static int CeedOrderElementsMorton(CeedInt nelem, CeedInt dim,
+                                   const CeedScalar *centroids,
+                                   CeedInt *eperm) {
+  int ierr;
+  // Exact in double precision
+  const CeedInt bits = CeedIntMin(63 / dim, 52);
+  CeedScalar lo[3], hi[3];
+  for (CeedInt d=0; d<dim; d++) {
+    lo[d] = hi[d] = centroids[d];
+    for (CeedInt e=1; e<nelem; e++) {
+      lo[d] = fmin(lo[d], centroids[e*dim+d]);
+      hi[d] = fmax(hi[d], centroids[e*dim+d]);
+    }
+  }
+  CeedElemKey *keys;
+  ierr = CeedMalloc(nelem, &keys); CeedChk(ierr);
+  for (CeedInt e=0; e<nelem; e++) {
+    uint64_t q[3];
+    for (CeedInt d=0; d<dim; d++) {
+      const CeedScalar s = hi[d] > lo[d] ?
+                           (centroids[e*dim+d] - lo[d]) / (hi[d] - lo[d]) : 0;
+      q[d] = (uint64_t)(s * (CeedScalar)((1ull << bits) - 1));
+    }
+    keys[e].key = CeedMortonKey(dim, q, bits);
+    keys[e].elem = e;
+  }
+  qsort(keys, nelem, sizeof(keys[0]), CeedElemKeyCompare);
+  for (CeedInt e=0; e<nelem; e++)
+    eperm[e] = keys[e].elem;
+  ierr = CeedFree(&keys); CeedChk(ierr);
+  return 0;
+}
+
+// Elements in reverse Cuthill-McKee order of the graph of elements sharing a
+//   node: breadth-first from an element of least degree, neighbors by
+//   increasing degree, each connected component in turn. The start of each
+//   component is the next unvisited element in a single sort by degree.
+static int CeedOrderElementsRCM(CeedInt nelem, CeedInt elemsize, CeedInt ndof,
+                                const CeedInt *indices, CeedInt *eperm) {
+  int ierr;
+  CeedInt *noffsets, *nelems, *degree, *mark, *visited;
+  // Elements of each node
+  ierr = CeedCalloc(ndof+1, &noffsets); CeedChk(ierr);
+  ierr = CeedMalloc(nelem*elemsize, &nelems); CeedChk(ierr);
+  for (CeedInt i=0; i<nelem*elemsize; i++)
+    noffsets[indices[i]+1]++;
+  for (CeedInt n=0; n<ndof; n++)
+    noffsets[n+1] += noffsets[n];
+  for (CeedInt i=0; i<nelem*elemsize; i++)
+    nelems[noffsets[indices[i]]++] = i / elemsize;
+  for (CeedInt n=ndof; n>0; n--)
+    noffsets[n] = noffsets[n-1];
+  noffsets[0] = 0;
+
+  // Number of distinct neighbors of each element
+  ierr = CeedCalloc(nelem, &degree); CeedChk(ierr);
+  ierr = CeedMalloc(nelem, &mark); CeedChk(ierr);
+  ierr = CeedCalloc(nelem, &visited); CeedChk(ierr);
+  for (CeedInt e=0; e<nelem; e++)
+    mark[e] = -1;
+  for (CeedInt e=0; e<nelem; e++) {
+    mark[e] = e;
+    for (CeedInt k=0; k<elemsize; k++) {
+      const CeedInt n = indices[e*elemsize+k];
+      for (CeedInt j=noffsets[n]; j<noffsets[n+1]; j++)
+        if (mark[nelems[j]] != e) {
+          mark[nelems[j]] = e;
+          degree[e]++;
+        }
+    }
+  }
+
+  // Elements by increasing degree, then index
+  CeedElemKey *bydegree;
+  ierr = CeedMalloc(nelem, &bydegree); CeedChk(ierr);
+  for (CeedInt e=0; e<nelem; e++) {
+    bydegree[e].key = degree[e];
+    bydegree[e].elem = e;
+  }
+  qsort(bydegree, nelem, sizeof(bydegree[0]), CeedElemKeyCompare);
+
+  // Breadth-first search, eperm is the queue
+  CeedInt head = 0, tail = 0, cursor = 0;
+  while (tail < nelem) {
+    while (visited[bydegree[cursor].elem])
+      cursor++;
+    const CeedInt start = bydegree[cursor].elem;
+    visited[start] = 1;
+    eperm[tail++] = start;
+    while (head < tail) {
+      const CeedInt e = eperm[head++], first = tail;
+      for (CeedInt k=0; k<elemsize; k++) {
+        const CeedInt n = indices[e*elemsize+k];
+        for (CeedInt j=noffsets[n]; j<noffsets[n+1]; j++)
+          if (!visited[nelems[j]]) {
+            visited[nelems[j]] = 1;
+            eperm[tail++] = nelems[j];
+          }
+      }
+      // Insertion sort of the new elements by degree, few per element
+      for (CeedInt i=first+1; i<tail; i++) {
+        const CeedInt f = eperm[i];
+        CeedInt j = i;
+        for (; j>first && degree[eperm[j-1]] > degree[f]; j--)
+          eperm[j] = eperm[j-1];
+        eperm[j] = f;
+      }
+    }
+  }
+  for (CeedInt i=0; i<nelem/2; i++) {
+    const CeedInt f = eperm[i];
+    eperm[i] = eperm[nelem-1-i];
+    eperm[nelem-1-i] = f;
+  }
+
+  ierr = CeedFree(&noffsets); CeedChk(ierr);
+  ierr = CeedFree(&nelems); CeedChk(ierr);
+  ierr = CeedFree(&degree); CeedChk(ierr);
+  ierr = CeedFree(&mark); CeedChk(ierr);
+  ierr = CeedFree(&visited); CeedChk(ierr);
+  ierr = CeedFree(&bydegree); CeedChk(ierr);
+  return 0;
+}
+
+/**
+  @brief Compute an element order and a node numbering with good locality for
+           the indices of a CeedElemRestriction
+
+  Elements are ordered along a Morton (Z-order) curve through their centroids,
+    or in reverse Cuthill-McKee order of the graph of elements sharing a node
+    when no centroids are given. Nodes are then numbered in the order the
+    reordered elements first reference them; nodes that no element references
+    come last, in their original order. The gather and scatter of a restriction
+    created with CeedElemRestrictionCreatePermuted() then read nearby entries
+    of the L-vector for nearby elements, as on a structured mesh.
+
+  @param ceed        A Ceed object for error handling
+  @param nelem       Number of elements described in the @a indices array
+  @param elemsize    Size (number of "nodes") per element
+  @param ndof        Number of nodes, all indices are in [0, @a ndof)
+  @param indices     Array of shape [@a nelem, @a elemsize], as for
+                       CeedElemRestrictionCreate()
+  @param dim         Dimension of the centroids, 1 to 3
+  @param centroids   Array of shape [@a nelem, @a dim] with a point of each
+                       element, or NULL for the reverse Cuthill-McKee order
+  @param[out] eperm  Array of size @a nelem, the original number of each
+                       element in the new order
+  @param[out] dofperm  Array of size @a ndof, the new number of each node
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Advanced
+**/
+int CeedElemRestrictionComputeOrdering(Ceed ceed, CeedInt nelem,
+                                       CeedInt elemsize, CeedInt ndof,
+                                       const CeedInt *indices, CeedInt dim,
+                                       const CeedScalar *centroids,
+                                       CeedInt *eperm, CeedInt *dofperm) {
+  int ierr;
+  for (CeedInt i=0; i<nelem*elemsize; i++)
+    if (indices[i] < 0 || indices[i] >= ndof)
+      return CeedError(ceed, 1, "Index %d of element %d out of range [0, %d)",
+                       indices[i], i / elemsize, ndof);
+
+  if (centroids) {
+    if (dim < 1 || dim > 3)
+      return CeedError(ceed, 1, "Centroids of dimension %d not supported", dim);
+    ierr = CeedOrderElementsMorton(nelem, dim, centroids, eperm); CeedChk(ierr);
+  } else {
+    ierr = CeedOrderElementsRCM(nelem, elemsize, ndof, indices, eperm);
+    CeedChk(ierr);
+  }
+
+  // First touch
+  CeedInt next = 0;
+  for (CeedInt n=0; n<ndof; n++)
+    dofperm[n] = -1;
+  for (CeedInt e=0; e<nelem; e++)
+    for (CeedInt k=0; k<elemsize; k++) {
+      const CeedInt n = indices[eperm[e]*elemsize+k];
+      if (dofperm[n] < 0)
+        dofperm[n] = next++;
+    }
+  for (CeedInt n=0; n<ndof; n++)
+    if (dofperm[n] < 0)
+      dofperm[n] = next++;
+  return 0;
+}
+
+/**
+  @brief Create a CeedElemRestriction with elements and nodes permuted
+
+  Element i of the restriction is element @a eperm[i] of @a indices, and node
+    n of @a indices is node @a dofperm[n] of the L-vector. An L-vector u for
+    @a indices maps to the L-vector u' of the restriction by
+    u'[dofperm[n]] = u[n], in each component. The other restrictions of an
+    operator use the same @a eperm, with a NULL @a dofperm for those of
+    passive data such as the quadrature data.
+
+  @param ceed       A Ceed object where the CeedElemRestriction will be created
+  @param nelem      Number of elements described in the @a indices array
+  @param elemsize   Size (number of "nodes") per element
+  @param ndof       The total size of the L-vector, per component
+  @param ncomp      Number of field components per interpolation node
+  @param indices    Array of shape [@a nelem, @a elemsize], as for
+                      CeedElemRestrictionCreate()
+  @param eperm      Element order, see CeedElemRestrictionComputeOrdering(),
+                      or NULL to keep the elements in order
+  @param dofperm    Node numbering, see CeedElemRestrictionComputeOrdering(),
+                      or NULL to keep the nodes
+  @param[out] rstr  Address of the variable where the newly created
+                      CeedElemRestriction will be stored
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Advanced
+**/
+int CeedElemRestrictionCreatePermuted(Ceed ceed, CeedInt nelem,
+                                      CeedInt elemsize, CeedInt ndof,
+                                      CeedInt ncomp, const CeedInt *indices,
+                                      const CeedInt *eperm,
+                                      const CeedInt *dofperm,
+                                      CeedElemRestriction *rstr) {
+  int ierr;
+  CeedInt *pindices;
+
+  ierr = CeedMalloc(nelem*elemsize, &pindices); CeedChk(ierr);
+  for (CeedInt e=0; e<nelem; e++)
+    for (CeedInt k=0; k<elemsize; k++) {
+      const CeedInt n = indices[(eperm ? eperm[e] : e)*elemsize+k];
+      pindices[e*elemsize+k] = dofperm ? dofperm[n] : n;
+    }
+  ierr = CeedElemRestrictionCreate(ceed, nelem, elemsize, ndof, ncomp,
+                                   CEED_MEM_HOST, CEED_OWN_POINTER, pindices,
+                                   rstr); CeedChk(ierr);
+  return 0;
+}
+
 /**
   @brief Create CeedVectors associated with a CeedElemRestriction
 
@@ -267,9 +801,57 @@ int CeedElemRestrictionCreateVector(CeedElemRestriction rstr, CeedVector *lvec,
   return 0;
 }
 
+/**
+  @brief Allow the backend to replace the indices of a CeedElemRestriction by
+    those of the blocked copy its operators build
+
+  A restriction that owns its indices (CEED_COPY_VALUES or CEED_OWN_POINTER)
+    then frees them once an operator has blocked it, keeping a single copy of
+    the indices. Off by default.
+
+  @param rstr    CeedElemRestriction
+  @param share   Whether the indices may be shared
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Advanced
+**/
+int CeedElemRestrictionSetIndexSharing(CeedElemRestriction rstr,
+                                       bool share) {
+  rstr->shareindices = share;
+  return 0;
+}
+
+// Check the sizes of the input and output vectors of an apply
+static int CeedElemRestrictionCheckVectors(CeedElemRestriction rstr,
+    CeedTransposeMode tmode, CeedVector u, CeedVector v) {
+  CeedInt m,n;
+
+  if (tmode == CEED_NOTRANSPOSE) {
+    m = rstr->nblk * rstr->blksize * rstr->elemsize * rstr->ncomp;
+    n = rstr->ndof * rstr->ncomp;
+  } else {
+    m = rstr->ndof * rstr->ncomp;
+    n = rstr->nblk * rstr->blksize * rstr->elemsize * rstr->ncomp;
+  }
+  if (n != u->length)
+    return CeedError(rstr->ceed, 2,
+                     "Input vector size %d not compatible with element restriction (%d, %d)",
+                     u->length, m, n);
+  if (m != v->length)
+    return CeedError(rstr->ceed, 2,
+                     "Output vector size %d not compatible with element restriction (%d, %d)",
+                     v->length, m, n);
+  return 0;
+}
+
 /**
   @brief Restrict an L-vector to an E-vector or apply transpose
 
+  The transpose adds to @a v, for each node of the L-vector, the sum of the
+    element nodes that reference it, see CeedElemRestrictionApplyOverwrite()
+    to overwrite @a v instead.
+
   @param rstr    CeedElemRestriction
   @param tmode   Apply restriction or transpose
   @param lmode   Ordering of the ncomp components
@@ -284,15 +866,93 @@ int CeedElemRestrictionCreateVector(CeedElemRestriction rstr, CeedVector *lvec,
 int CeedElemRestrictionApply(CeedElemRestriction rstr, CeedTransposeMode tmode,
                              CeedTransposeMode lmode,
                              CeedVector u, CeedVector v, CeedRequest *request) {
+  int ierr;
+
+  ierr = CeedElemRestrictionCheckVectors(rstr, tmode, u, v); CeedChk(ierr);
+  ierr = rstr->Apply(rstr, tmode, lmode, u, v, request); CeedChk(ierr);
+
+  return 0;
+}
+
+/**
+  @brief Restrict an L-vector to an E-vector or apply transpose, the transpose
+    overwriting its output
+
+  Same as CeedElemRestrictionApply(), except that the transpose sets each
+    entry of @a v to the sum of the element nodes that reference it, so @a v
+    needs no prior zeroing. Backends that do not provide this zero @a v and
+    accumulate.
+
+  @param rstr    CeedElemRestriction
+  @param tmode   Apply restriction or transpose
+  @param lmode   Ordering of the ncomp components
+  @param u       Input vector (of size @a ndof when tmode=CEED_NOTRANSPOSE)
+  @param v       Output vector (of size @a nelem * @a elemsize when
+                   tmode=CEED_NOTRANSPOSE)
+  @param request Request or CEED_REQUEST_IMMEDIATE
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Advanced
+**/
+int CeedElemRestrictionApplyOverwrite(CeedElemRestriction rstr,
+                                      CeedTransposeMode tmode,
+                                      CeedTransposeMode lmode, CeedVector u,
+                                      CeedVector v, CeedRequest *request) {
+  int ierr;
+
+  ierr = CeedElemRestrictionCheckVectors(rstr, tmode, u, v); CeedChk(ierr);
+  if (rstr->ApplyOverwrite) {
+    ierr = rstr->ApplyOverwrite(rstr, tmode, lmode, u, v, request);
+    CeedChk(ierr);
+  } else {
+    if (tmode == CEED_TRANSPOSE) {
+      ierr = CeedVectorSetValue(v, 0.0); CeedChk(ierr);
+    }
+    ierr = rstr->Apply(rstr, tmode, lmode, u, v, request); CeedChk(ierr);
+  }
+
+  return 0;
+}
+
+/**
+  @brief Restrict an L-vector to a block of an E-vector or apply transpose
+
+  The transpose adds the contribution of the block to @a v, so applying it for
+    every block is equivalent to CeedElemRestrictionApply().
+
+  @param rstr    CeedElemRestriction
+  @param block   Block number to restrict to/from, i.e. block=0 will handle
+                   elements [0 : blksize] and block=3 will handle elements
+                   [3*blksize : 4*blksize]
+  @param tmode   Apply restriction or transpose
+  @param lmode   Ordering of the ncomp components
+  @param u       Input vector (of size @a ndof when tmode=CEED_NOTRANSPOSE)
+  @param v       Output vector (of size @a blksize * @a elemsize when
+                   tmode=CEED_NOTRANSPOSE)
+  @param request Request or CEED_REQUEST_IMMEDIATE
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Advanced
+**/
+int CeedElemRestrictionApplyBlock(CeedElemRestriction rstr, CeedInt block,
+                                  CeedTransposeMode tmode,
+                                  CeedTransposeMode lmode, CeedVector u,
+                                  CeedVector v, CeedRequest *request) {
   CeedInt m,n;
   int ierr;
 
+  if (!rstr->ApplyBlock)
+    return CeedError(rstr->ceed, 1,
+                     "Backend does not support ElemRestrictionApplyBlock");
+
   if (tmode == CEED_NOTRANSPOSE) {
-    m = rstr->nblk * rstr->blksize * rstr->elemsize * rstr->ncomp;
+    m = rstr->blksize * rstr->elemsize * rstr->ncomp;
     n = rstr->ndof * rstr->ncomp;
   } else {
     m = rstr->ndof * rstr->ncomp;
-    n = rstr->nblk * rstr->blksize * rstr->elemsize * rstr->ncomp;
+    n = rstr->blksize * rstr->elemsize * rstr->ncomp;
   }
   if (n != u->length)
     return CeedError(rstr->ceed, 2,
@@ -302,7 +962,12 @@ int CeedElemRestrictionApply(CeedElemRestriction rstr, CeedTransposeMode tmode,
     return CeedError(rstr->ceed, 2,
                      "Output vector size %d not compatible with element restriction (%d, %d)",
                      v->length, m, n);
-  ierr = rstr->Apply(rstr, tmode, lmode, u, v, request); CeedChk(ierr);
+  if (block < 0 || block >= rstr->nblk)
+    return CeedError(rstr->ceed, 2,
+                     "Invalid block %d, element restriction has %d blocks",
+                     block, rstr->nblk);
+  ierr = rstr->ApplyBlock(rstr, block, tmode, lmode, u, v, request);
+  CeedChk(ierr);
 
   return 0;
 }
@@ -404,6 +1069,62 @@ int CeedElemRestrictionGetNumBlocks(CeedElemRestriction rstr,
   return 0;
 }
 
+/**
+  @brief Get the strides of a strided CeedElemRestriction
+
+  @param rstr             CeedElemRestriction
+  @param[out] strides     Variable to store the node, component and element
+                            strides, NULL if the restriction has indices
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Advanced
+**/
+int CeedElemRestrictionGetStrides(CeedElemRestriction rstr,
+                                  CeedInt* *strides) {
+  *strides = rstr->strides;
+  return 0;
+}
+
+/**
+  @brief Get the box of a Cartesian CeedElemRestriction
+
+  @param rstr             CeedElemRestriction
+  @param[out] cartesian   Variable to store the dimension, the number of nodes
+                            in each direction of an element, the number of
+                            elements in each of the 3 directions (1 beyond
+                            the dimension) and the CeedNodeOrdering of the
+                            element nodes, NULL if the restriction is not
+                            Cartesian
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Advanced
+**/
+int CeedElemRestrictionGetCartesian(CeedElemRestriction rstr,
+                                    CeedInt* *cartesian) {
+  *cartesian = rstr->cartesian;
+  return 0;
+}
+
+/**
+  @brief Get whether the backend may replace the indices of a
+    CeedElemRestriction by those of a blocked copy
+
+  @param rstr             CeedElemRestriction
+  @param[out] share       Variable to store the setting, see
+                            CeedElemRestrictionSetIndexSharing()
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Advanced
+**/
+int CeedElemRestrictionGetIndexSharing(CeedElemRestriction rstr,
+                                       bool *share) {
+  *share = rstr->shareindices;
+  return 0;
+}
+
 /**
   @brief Get the size of blocks in the CeedElemRestriction
 
@@ -452,6 +1173,24 @@ int CeedElemRestrictionSetData(CeedElemRestriction rstr,
   return 0;
 }
 
+/**
+  @brief Take a reference to a CeedElemRestriction, which is then released by
+           one more call to CeedElemRestrictionDestroy()
+
+  Backends use this to share one restriction, such as a blocked copy, between
+    several fields and operators.
+
+  @param rstr             CeedElemRestriction to reference
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Advanced
+**/
+int CeedElemRestrictionReference(CeedElemRestriction rstr) {
+  rstr->refcount++;
+  return 0;
+}
+
 /**
   @brief Destroy a CeedElemRestriction
 
@@ -468,6 +1207,8 @@ int CeedElemRestrictionDestroy(CeedElemRestriction *rstr) {
   if ((*rstr)->Destroy) {
     ierr = (*rstr)->Destroy(*rstr); CeedChk(ierr);
   }
+  ierr = CeedFree(&(*rstr)->strides); CeedChk(ierr);
+  ierr = CeedFree(&(*rstr)->cartesian); CeedChk(ierr);
   ierr = CeedDestroy(&(*rstr)->ceed); CeedChk(ierr);
   ierr = CeedFree(rstr); CeedChk(ierr);
   return 0;
@@ -216,6 +216,80 @@ void fCeedElemRestrictionCreateIdentity(int *ceed, int *nelements,
   }
 }
 
+#define fCeedElemRestrictionCreateStrided \
+    FORTRAN_NAME(ceedelemrestrictioncreatestrided, CEEDELEMRESTRICTIONCREATESTRIDED)
+void fCeedElemRestrictionCreateStrided(int *ceed, int *nelements,
+                                       int *esize, int *ndof, int *ncomp,
+                                       const int *strides,
+                                       int *elemrestriction, int *err) {
+  if (CeedElemRestriction_count == CeedElemRestriction_count_max) {
+    CeedElemRestriction_count_max += CeedElemRestriction_count_max/2 + 1;
+    CeedRealloc(CeedElemRestriction_count_max, &CeedElemRestriction_dict);
+  }
+
+  CeedElemRestriction *elemrestriction_ =
+    &CeedElemRestriction_dict[CeedElemRestriction_count];
+  *err = CeedElemRestrictionCreateStrided(Ceed_dict[*ceed], *nelements, *esize,
+         *ndof, *ncomp, strides, elemrestriction_);
+
+  if (*err == 0) {
+    *elemrestriction = CeedElemRestriction_count++;
+    CeedElemRestriction_n++;
+  }
+}
+
+#define fCeedElemRestrictionCreateCartesian \
+    FORTRAN_NAME(ceedelemrestrictioncreatecartesian, CEEDELEMRESTRICTIONCREATECARTESIAN)
+void fCeedElemRestrictionCreateCartesian(int *ceed, int *dim,
+    const int *nelements, int *P, int *order, int *ncomp,
+    int *elemrestriction, int *err) {
+  if (CeedElemRestriction_count == CeedElemRestriction_count_max) {
+    CeedElemRestriction_count_max += CeedElemRestriction_count_max/2 + 1;
+    CeedRealloc(CeedElemRestriction_count_max, &CeedElemRestriction_dict);
+  }
+
+  CeedElemRestriction *elemrestriction_ =
+    &CeedElemRestriction_dict[CeedElemRestriction_count];
+  *err = CeedElemRestrictionCreateCartesian(Ceed_dict[*ceed], *dim, nelements,
+         *P, (CeedNodeOrdering)*order, *ncomp, elemrestriction_);
+
+  if (*err == 0) {
+    *elemrestriction = CeedElemRestriction_count++;
+    CeedElemRestriction_n++;
+  }
+}
+
+// A dimension of 0 stands for NULL centroids
+#define fCeedElemRestrictionComputeOrdering \
+    FORTRAN_NAME(ceedelemrestrictioncomputeordering, CEEDELEMRESTRICTIONCOMPUTEORDERING)
+void fCeedElemRestrictionComputeOrdering(int *ceed, int *nelements,
+    int *esize, int *ndof, const int *indices, int *dim,
+    const CeedScalar *centroids, int *eperm, int *dofperm, int *err) {
+  *err = CeedElemRestrictionComputeOrdering(Ceed_dict[*ceed], *nelements,
+         *esize, *ndof, indices, *dim, *dim ? centroids : NULL, eperm, dofperm);
+}
+
+#define fCeedElemRestrictionCreatePermuted \
+    FORTRAN_NAME(ceedelemrestrictioncreatepermuted, CEEDELEMRESTRICTIONCREATEPERMUTED)
+void fCeedElemRestrictionCreatePermuted(int *ceed, int *nelements,
+    int *esize, int *ndof, int *ncomp, const int *indices, const int *eperm,
+    const int *dofperm, int *elemrestriction, int *err) {
+  if (CeedElemRestriction_count == CeedElemRestriction_count_max) {
+    CeedElemRestriction_count_max += CeedElemRestriction_count_max/2 + 1;
+    CeedRealloc(CeedElemRestriction_count_max, &CeedElemRestriction_dict);
+  }
+
+  CeedElemRestriction *elemrestriction_ =
+    &CeedElemRestriction_dict[CeedElemRestriction_count];
+  *err = CeedElemRestrictionCreatePermuted(Ceed_dict[*ceed], *nelements,
+         *esize, *ndof, *ncomp, indices, eperm, dofperm, elemrestriction_);
+
+  if (*err == 0) {
+    *elemrestriction = CeedElemRestriction_count++;
+    CeedElemRestriction_n++;
+  }
+}
+
 #define fCeedElemRestrictionCreateBlocked \
     FORTRAN_NAME(ceedelemrestrictioncreateblocked,CEEDELEMRESTRICTIONCREATEBLOCKED)
 void fCeedElemRestrictionCreateBlocked(int *ceed, int *nelements,
@@ -240,6 +314,14 @@ void fCeedElemRestrictionCreateBlocked(int *ceed, int *nelements,
   }
 }
 
+#define fCeedElemRestrictionSetIndexSharing \
+    FORTRAN_NAME(ceedelemrestrictionsetindexsharing, \
+                 CEEDELEMRESTRICTIONSETINDEXSHARING)
+void fCeedElemRestrictionSetIndexSharing(int *elemr, int *share, int *err) {
+  *err = CeedElemRestrictionSetIndexSharing(CeedElemRestriction_dict[*elemr],
+         *share);
+}
+
 static CeedRequest *CeedRequest_dict = NULL;
 static int CeedRequest_count = 0;
 static int CeedRequest_n = 0;
@@ -273,6 +355,68 @@ void fCeedElemRestrictionApply(int *elemr, int *tmode, int *lmode,
   }
 }
 
+#define fCeedElemRestrictionApplyOverwrite \
+    FORTRAN_NAME(ceedelemrestrictionapplyoverwrite, \
+                 CEEDELEMRESTRICTIONAPPLYOVERWRITE)
+void fCeedElemRestrictionApplyOverwrite(int *elemr, int *tmode, int *lmode,
+                                        int *uvec, int *ruvec, int *rqst,
+                                        int *err) {
+  int createRequest = 1;
+  // Check if input is CEED_REQUEST_ORDERED(-2) or CEED_REQUEST_IMMEDIATE(-1)
+  if (*rqst == FORTRAN_REQUEST_IMMEDIATE || *rqst == FORTRAN_REQUEST_ORDERED)
+    createRequest = 0;
+
+  if (createRequest && CeedRequest_count == CeedRequest_count_max) {
+    CeedRequest_count_max += CeedRequest_count_max/2 + 1;
+    CeedRealloc(CeedRequest_count_max, &CeedRequest_dict);
+  }
+
+  CeedRequest *rqst_;
+  if      (*rqst == FORTRAN_REQUEST_IMMEDIATE) rqst_ = CEED_REQUEST_IMMEDIATE;
+  else if (*rqst == FORTRAN_REQUEST_ORDERED  ) rqst_ = CEED_REQUEST_ORDERED;
+  else rqst_ = &CeedRequest_dict[CeedRequest_count];
+
+  *err = CeedElemRestrictionApplyOverwrite(CeedElemRestriction_dict[*elemr],
+         *tmode, *lmode, CeedVector_dict[*uvec], CeedVector_dict[*ruvec],
+         rqst_);
+
+  if (*err == 0 && createRequest) {
+    *rqst = CeedRequest_count++;
+    CeedRequest_n++;
+  }
+}
+
+#define fCeedElemRestrictionApplyBlock \
+    FORTRAN_NAME(ceedelemrestrictionapplyblock,CEEDELEMRESTRICTIONAPPLYBLOCK)
+void fCeedElemRestrictionApplyBlock(int *elemr, int *block, int *tmode,
+                                    int *lmode, int *uvec, int *ruvec,
+                                    int *rqst, int *err) {
+  int createRequest = 1;
+  // Check if input is CEED_REQUEST_ORDERED(-2) or CEED_REQUEST_IMMEDIATE(-1)
+  if (*rqst == FORTRAN_REQUEST_IMMEDIATE || *rqst == FORTRAN_REQUEST_ORDERED)
+    createRequest = 0;
+
+  if (createRequest && CeedRequest_count == CeedRequest_count_max) {
+    CeedRequest_count_max += CeedRequest_count_max/2 + 1;
+    CeedRealloc(CeedRequest_count_max, &CeedRequest_dict);
+  }
+
+  CeedRequest *rqst_;
+  if      (*rqst == FORTRAN_REQUEST_IMMEDIATE) rqst_ = CEED_REQUEST_IMMEDIATE;
+  else if (*rqst == FORTRAN_REQUEST_ORDERED  ) rqst_ = CEED_REQUEST_ORDERED;
+  else rqst_ = &CeedRequest_dict[CeedRequest_count];
+
+  *err = CeedElemRestrictionApplyBlock(CeedElemRestriction_dict[*elemr],
+                                       *block, *tmode, *lmode,
+                                       CeedVector_dict[*uvec],
+                                       CeedVector_dict[*ruvec], rqst_);
+
+  if (*err == 0 && createRequest) {
+    *rqst = CeedRequest_count++;
+    CeedRequest_n++;
+  }
+}
+
 #define fCeedRequestWait FORTRAN_NAME(ceedrequestwait, CEEDREQUESTWAIT)
 void fCeedRequestWait(int *rqst, int *err) {
   // TODO Uncomment this once CeedRequestWait is implemented
@@ -347,6 +491,47 @@ void fCeedBasisCreateTensorH1(int *ceed, int *dim, int *ncomp, int *P1d,
   }
 }
 
+#define fCeedBasisCreateTensorH1LagrangeAnisotropic \
+    FORTRAN_NAME(ceedbasiscreatetensorh1lagrangeanisotropic, \
+                 CEEDBASISCREATETENSORH1LAGRANGEANISOTROPIC)
+void fCeedBasisCreateTensorH1LagrangeAnisotropic(int *ceed, int *dim,
+    int *ncomp, int *P, int *Q, int *quadmode, int *basis, int *err) {
+  if (CeedBasis_count == CeedBasis_count_max) {
+    CeedBasis_count_max += CeedBasis_count_max/2 + 1;
+    CeedRealloc(CeedBasis_count_max, &CeedBasis_dict);
+  }
+
+  *err = CeedBasisCreateTensorH1LagrangeAnisotropic(Ceed_dict[*ceed], *dim,
+         *ncomp, P, Q, *quadmode, &CeedBasis_dict[CeedBasis_count]);
+
+  if (*err == 0) {
+    *basis = CeedBasis_count++;
+    CeedBasis_n++;
+  }
+}
+
+#define fCeedBasisCreateTensorH1Anisotropic \
+    FORTRAN_NAME(ceedbasiscreatetensorh1anisotropic, \
+                 CEEDBASISCREATETENSORH1ANISOTROPIC)
+void fCeedBasisCreateTensorH1Anisotropic(int *ceed, int *dim, int *ncomp,
+    int *P1d, int *Q1d, const CeedScalar *interp1d, const CeedScalar *grad1d,
+    const CeedScalar *qref1d, const CeedScalar *qweight1d, int *basis,
+    int *err) {
+  if (CeedBasis_count == CeedBasis_count_max) {
+    CeedBasis_count_max += CeedBasis_count_max/2 + 1;
+    CeedRealloc(CeedBasis_count_max, &CeedBasis_dict);
+  }
+
+  *err = CeedBasisCreateTensorH1Anisotropic(Ceed_dict[*ceed], *dim, *ncomp,
+         P1d, Q1d, interp1d, grad1d, qref1d, qweight1d,
+         &CeedBasis_dict[CeedBasis_count]);
+
+  if (*err == 0) {
+    *basis = CeedBasis_count++;
+    CeedBasis_n++;
+  }
+}
+
 #define fCeedBasisCreateH1 \
     FORTRAN_NAME(ceedbasiscreateh1, CEEDBASISCREATEH1)
 void fCeedBasisCreateH1(int *ceed, int *topo, int *ncomp, int *ndof,
@@ -367,6 +552,24 @@ void fCeedBasisCreateH1(int *ceed, int *topo, int *ncomp, int *ndof,
   }
 }
 
+#define fCeedBasisCreateSimplexDubiner \
+    FORTRAN_NAME(ceedbasiscreatesimplexdubiner, CEEDBASISCREATESIMPLEXDUBINER)
+void fCeedBasisCreateSimplexDubiner(int *ceed, int *topo, int *ncomp, int *P,
+                                    int *Q, int *basis, int *err) {
+  if (CeedBasis_count == CeedBasis_count_max) {
+    CeedBasis_count_max += CeedBasis_count_max/2 + 1;
+    CeedRealloc(CeedBasis_count_max, &CeedBasis_dict);
+  }
+
+  *err = CeedBasisCreateSimplexDubiner(Ceed_dict[*ceed], *topo, *ncomp, *P, *Q,
+                                       &CeedBasis_dict[CeedBasis_count]);
+
+  if (*err == 0) {
+    *basis = CeedBasis_count++;
+    CeedBasis_n++;
+  }
+}
+
 #define fCeedBasisView FORTRAN_NAME(ceedbasisview, CEEDBASISVIEW)
 void fCeedBasisView(int *basis, int *err) {
   *err = CeedBasisView(CeedBasis_dict[*basis], stdout);
@@ -389,7 +592,18 @@ void fCeedBasisGetCollocatedGrad(int *basis, CeedScalar *colograd1d,
 #define fCeedBasisApply FORTRAN_NAME(ceedbasisapply, CEEDBASISAPPLY)
 void fCeedBasisApply(int *basis, int *nelem, int *tmode, int *emode,
                      int *u, int *v, int *err) {
-  *err = CeedBasisApply(CeedBasis_dict[*basis], *nelem, *tmode, *emode, CeedVector_dict[*u], CeedVector_dict[*v]);
+  *err = CeedBasisApply(CeedBasis_dict[*basis], *nelem, *tmode, *emode,
+                        *u==FORTRAN_NULL?NULL:CeedVector_dict[*u],
+                        CeedVector_dict[*v]);
+}
+
+#define fCeedBasisApplyAtPoints \
+    FORTRAN_NAME(ceedbasisapplyatpoints, CEEDBASISAPPLYATPOINTS)
+void fCeedBasisApplyAtPoints(int *basis, int *nelem, int *npoints, int *tmode,
+                             int *emode, int *x, int *u, int *v, int *err) {
+  *err = CeedBasisApplyAtPoints(CeedBasis_dict[*basis], *nelem, *npoints,
+                                *tmode, *emode, CeedVector_dict[*x],
+                                CeedVector_dict[*u], CeedVector_dict[*v]);
 }
 
 #define fCeedBasisGetNumNodes \
@@ -703,6 +917,72 @@ void fCeedOperatorApply(int *op, int *ustatevec,
   }
 }
 
+#define fCeedOperatorApplyElements \
+    FORTRAN_NAME(ceedoperatorapplyelements, CEEDOPERATORAPPLYELEMENTS)
+void fCeedOperatorApplyElements(int *op, int *nelem, int *elems,
+                                int *ustatevec, int *resvec, int *rqst,
+                                int *err) {
+  CeedVector ustatevec_ = *ustatevec == FORTRAN_NULL
+                          ? NULL : CeedVector_dict[*ustatevec];
+  CeedVector resvec_ = *resvec == FORTRAN_NULL
+                       ? NULL : CeedVector_dict[*resvec];
+
+  int createRequest = 1;
+  // Check if input is CEED_REQUEST_ORDERED(-2) or CEED_REQUEST_IMMEDIATE(-1)
+  if (*rqst == FORTRAN_REQUEST_IMMEDIATE || *rqst == FORTRAN_REQUEST_ORDERED)
+    createRequest = 0;
+
+  if (createRequest && CeedRequest_count == CeedRequest_count_max) {
+    CeedRequest_count_max += CeedRequest_count_max/2 + 1;
+    CeedRealloc(CeedRequest_count_max, &CeedRequest_dict);
+  }
+
+  CeedRequest *rqst_;
+  if      (*rqst == FORTRAN_REQUEST_IMMEDIATE) rqst_ = CEED_REQUEST_IMMEDIATE;
+  else if (*rqst == FORTRAN_REQUEST_ORDERED  ) rqst_ = CEED_REQUEST_ORDERED;
+  else rqst_ = &CeedRequest_dict[CeedRequest_count];
+
+  *err = CeedOperatorApplyElements(CeedOperator_dict[*op], *nelem, elems,
+                                   ustatevec_, resvec_, rqst_);
+  if (*err == 0 && createRequest) {
+    *rqst = CeedRequest_count++;
+    CeedRequest_n++;
+  }
+}
+
+#define fCeedOperatorApplyElementRange \
+    FORTRAN_NAME(ceedoperatorapplyelementrange, CEEDOPERATORAPPLYELEMENTRANGE)
+void fCeedOperatorApplyElementRange(int *op, int *start, int *stop,
+                                    int *ustatevec, int *resvec, int *rqst,
+                                    int *err) {
+  CeedVector ustatevec_ = *ustatevec == FORTRAN_NULL
+                          ? NULL : CeedVector_dict[*ustatevec];
+  CeedVector resvec_ = *resvec == FORTRAN_NULL
+                       ? NULL : CeedVector_dict[*resvec];
+
+  int createRequest = 1;
+  // Check if input is CEED_REQUEST_ORDERED(-2) or CEED_REQUEST_IMMEDIATE(-1)
+  if (*rqst == FORTRAN_REQUEST_IMMEDIATE || *rqst == FORTRAN_REQUEST_ORDERED)
+    createRequest = 0;
+
+  if (createRequest && CeedRequest_count == CeedRequest_count_max) {
+    CeedRequest_count_max += CeedRequest_count_max/2 + 1;
+    CeedRealloc(CeedRequest_count_max, &CeedRequest_dict);
+  }
+
+  CeedRequest *rqst_;
+  if      (*rqst == FORTRAN_REQUEST_IMMEDIATE) rqst_ = CEED_REQUEST_IMMEDIATE;
+  else if (*rqst == FORTRAN_REQUEST_ORDERED  ) rqst_ = CEED_REQUEST_ORDERED;
+  else rqst_ = &CeedRequest_dict[CeedRequest_count];
+
+  *err = CeedOperatorApplyElementRange(CeedOperator_dict[*op], *start, *stop,
+                                       ustatevec_, resvec_, rqst_);
+  if (*err == 0 && createRequest) {
+    *rqst = CeedRequest_count++;
+    CeedRequest_n++;
+  }
+}
+
 #define fCeedOperatorApplyJacobian \
     FORTRAN_NAME(ceedoperatorapplyjacobian, CEEDOPERATORAPPLYJACOBIAN)
 void fCeedOperatorApplyJacobian(int *op, int *qdatavec, int *ustatevec,
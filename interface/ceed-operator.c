@@ -145,6 +145,21 @@ found:
   return 0;
 }
 
+// Check that the fields of an operator are set before it is applied
+static int CeedOperatorCheckReady(CeedOperator op) {
+  Ceed ceed = op->ceed;
+  CeedQFunction qf = op->qf;
+
+  if (op->nfields == 0) return CeedError(ceed, 1, "No operator fields set");
+  if (op->nfields < qf->numinputfields + qf->numoutputfields) return CeedError(
+          ceed, 1, "Not all operator fields set");
+  if (op->numelements == 0) return CeedError(ceed, 1,
+                                     "At least one restriction required");
+  if (op->numqpoints == 0) return CeedError(ceed, 1,
+                                    "At least one non-collocated basis required");
+  return 0;
+}
+
 /**
   @brief Apply CeedOperator to a vector
 
@@ -167,20 +182,94 @@ found:
 int CeedOperatorApply(CeedOperator op, CeedVector in,
                       CeedVector out, CeedRequest *request) {
   int ierr;
-  Ceed ceed = op->ceed;
-  CeedQFunction qf = op->qf;
-
-  if (op->nfields == 0) return CeedError(ceed, 1, "No operator fields set");
-  if (op->nfields < qf->numinputfields + qf->numoutputfields) return CeedError(
-          ceed, 1, "Not all operator fields set");
-  if (op->numelements == 0) return CeedError(ceed, 1,
-                                     "At least one restriction required");
-  if (op->numqpoints == 0) return CeedError(ceed, 1,
-                                    "At least one non-collocated basis required");
+  ierr = CeedOperatorCheckReady(op); CeedChk(ierr);
   ierr = op->Apply(op, in, out, request); CeedChk(ierr);
   return 0;
 }
 
+/**
+  @brief Apply CeedOperator to a vector on a subset of its elements
+
+  This computes the contribution of the listed elements to the action of the
+  operator, using the same restrictions, bases and passive vectors as
+  CeedOperatorApply().  The contribution is added to the output vectors,
+  active and passive, which are not zeroed first, so that for instance the
+  interior elements can be applied while a halo exchange is in progress and
+  the boundary elements once it has completed.  An element listed more than
+  once is applied once.  The listed elements are packed into blocks, so the
+  cost is that of the listed elements only, and lists of nearby elements
+  share more of the vector entries they read and write, see
+  CeedElemRestrictionComputeOrdering().
+
+  @param op        CeedOperator to apply
+  @param nelem     Number of elements in @a elems
+  @param elems     Array of element indices, each in [0, number of elements)
+  @param[in] in    CeedVector containing input state or NULL if there are no
+                     active inputs
+  @param[out] out  CeedVector to add the result to (must be distinct from
+                     @a in) or NULL if there are no active outputs
+  @param request   Address of CeedRequest for non-blocking completion, else
+                     CEED_REQUEST_IMMEDIATE
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Advanced
+**/
+int CeedOperatorApplyElements(CeedOperator op, CeedInt nelem,
+                              const CeedInt *elems, CeedVector in,
+                              CeedVector out, CeedRequest *request) {
+  int ierr;
+  ierr = CeedOperatorCheckReady(op); CeedChk(ierr);
+  if (!op->ApplyElements)
+    return CeedError(op->ceed, 1,
+                     "Backend does not support OperatorApplyElements");
+  for (CeedInt i=0; i<nelem; i++)
+    if (elems[i] < 0 || elems[i] >= op->numelements)
+      return CeedError(op->ceed, 1, "Element %d not in [0, %d)", elems[i],
+                       op->numelements);
+  if (nelem <= 0) return 0;
+  ierr = op->ApplyElements(op, 0, nelem, elems, in, out, request);
+  CeedChk(ierr);
+  return 0;
+}
+
+/**
+  @brief Apply CeedOperator to a vector on a range of its elements
+
+  Same as CeedOperatorApplyElements() for the elements [@a start, @a stop),
+  adding their contribution to the output vectors.
+
+  @param op        CeedOperator to apply
+  @param start     First element of the range
+  @param stop      One past the last element of the range
+  @param[in] in    CeedVector containing input state or NULL if there are no
+                     active inputs
+  @param[out] out  CeedVector to add the result to (must be distinct from
+                     @a in) or NULL if there are no active outputs
+  @param request   Address of CeedRequest for non-blocking completion, else
+                     CEED_REQUEST_IMMEDIATE
+
+  @return An error code: 0 - success, otherwise - failure
+
+  @ref Advanced
+**/
+int CeedOperatorApplyElementRange(CeedOperator op, CeedInt start,
+                                  CeedInt stop, CeedVector in,
+                                  CeedVector out, CeedRequest *request) {
+  int ierr;
+  ierr = CeedOperatorCheckReady(op); CeedChk(ierr);
+  if (!op->ApplyElements)
+    return CeedError(op->ceed, 1,
+                     "Backend does not support OperatorApplyElements");
+  if (start < 0 || stop > op->numelements)
+    return CeedError(op->ceed, 1, "Elements [%d, %d) not in [0, %d)", start,
+                     stop, op->numelements);
+  if (stop <= start) return 0;
+  ierr = op->ApplyElements(op, start, stop - start, NULL, in, out, request);
+  CeedChk(ierr);
+  return 0;
+}
+
 /**
   @brief Get the Ceed associated with a CeedOperator
 
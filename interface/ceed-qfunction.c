@@ -129,7 +129,9 @@ int CeedQFunctionCreateInteriorFromGallery(Ceed ceed, CeedInt vlength, char* spe
   @param ncomp      Number of components per quadrature node
   @param emode      \ref CEED_EVAL_NONE to use values directly,
                       \ref CEED_EVAL_INTERP to use interpolated values,
-                      \ref CEED_EVAL_GRAD to use gradients.
+                      \ref CEED_EVAL_GRAD to use gradients,
+                      \ref CEED_EVAL_INTERP | \ref CEED_EVAL_GRAD to use
+                      interpolated values followed by gradients.
 
   @return An error code: 0 - success, otherwise - failure
 
@@ -158,7 +160,9 @@ static int CeedQFunctionFieldSet(CeedQFunctionField *f,const char *fieldname,
   @param ncomp      Number of components per quadrature node
   @param emode      \ref CEED_EVAL_NONE to use values directly,
                       \ref CEED_EVAL_INTERP to use interpolated values,
-                      \ref CEED_EVAL_GRAD to use gradients.
+                      \ref CEED_EVAL_GRAD to use gradients,
+                      \ref CEED_EVAL_INTERP | \ref CEED_EVAL_GRAD to use
+                      interpolated values followed by gradients.
 
   @return An error code: 0 - success, otherwise - failure
 
@@ -166,6 +170,9 @@ static int CeedQFunctionFieldSet(CeedQFunctionField *f,const char *fieldname,
 **/
 int CeedQFunctionAddInput(CeedQFunction qf, const char *fieldname,
                           CeedInt ncomp, CeedEvalMode emode) {
+  if ((emode & (emode-1)) && emode != (CEED_EVAL_INTERP|CEED_EVAL_GRAD))
+    return CeedError(qf->ceed, 1,
+                     "Only CEED_EVAL_INTERP and CEED_EVAL_GRAD can be combined");
   int ierr = CeedQFunctionFieldSet(&qf->inputfields[qf->numinputfields],
                                    fieldname, ncomp, emode);
   CeedChk(ierr);
@@ -181,7 +188,9 @@ int CeedQFunctionAddInput(CeedQFunction qf, const char *fieldname,
   @param ncomp      Number of components per quadrature node
   @param emode      \ref CEED_EVAL_NONE to use values directly,
                       \ref CEED_EVAL_INTERP to use interpolated values,
-                      \ref CEED_EVAL_GRAD to use gradients.
+                      \ref CEED_EVAL_GRAD to use gradients,
+                      \ref CEED_EVAL_INTERP | \ref CEED_EVAL_GRAD to use
+                      interpolated values followed by gradients.
 
   @return An error code: 0 - success, otherwise - failure
 
@@ -192,6 +201,9 @@ int CeedQFunctionAddOutput(CeedQFunction qf, const char *fieldname,
   if (emode == CEED_EVAL_WEIGHT)
     return CeedError(qf->ceed, 1,
                      "Cannot create qfunction output with CEED_EVAL_WEIGHT");
+  if ((emode & (emode-1)) && emode != (CEED_EVAL_INTERP|CEED_EVAL_GRAD))
+    return CeedError(qf->ceed, 1,
+                     "Only CEED_EVAL_INTERP and CEED_EVAL_GRAD can be combined");
   int ierr = CeedQFunctionFieldSet(&qf->outputfields[qf->numoutputfields],
                                    fieldname, ncomp, emode);
   CeedChk(ierr);
@@ -358,13 +358,17 @@ int CeedInit(const char *resource, Ceed *ceed) {
       {"RestoreArrayRead",       ceedoffsetof(CeedVector, RestoreArrayRead)},
       {"VectorDestroy",          ceedoffsetof(CeedVector, Destroy)},
       {"ElemRestrictionApply",   ceedoffsetof(CeedElemRestriction, Apply)},
+      {"ApplyOverwrite",         ceedoffsetof(CeedElemRestriction, ApplyOverwrite)},
+      {"ApplyBlock",             ceedoffsetof(CeedElemRestriction, ApplyBlock)},
       {"ElemRestrictionDestroy", ceedoffsetof(CeedElemRestriction, Destroy)},
       {"BasisApply",             ceedoffsetof(CeedBasis, Apply)},
+      {"ApplyAtPoints",          ceedoffsetof(CeedBasis, ApplyAtPoints)},
       {"BasisDestroy",           ceedoffsetof(CeedBasis, Destroy)},
       {"QFunctionApply",         ceedoffsetof(CeedQFunction, Apply)},
       {"QFunctionDestroy",       ceedoffsetof(CeedQFunction, Destroy)},
       {"OperatorApply",          ceedoffsetof(CeedOperator, Apply)},
       {"ApplyJacobian",          ceedoffsetof(CeedOperator, ApplyJacobian)},
+      {"ApplyElements",          ceedoffsetof(CeedOperator, ApplyElements)},
       {"OperatorDestroy",        ceedoffsetof(CeedOperator, Destroy)}         };
 
   memcpy((*ceed)->foffsets, foffsets,
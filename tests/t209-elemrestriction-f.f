@@ -0,0 +1,67 @@
+c-----------------------------------------------------------------------
+      program test
+
+      include 'ceedf.h'
+
+      integer ceed,err
+      integer x,y
+      integer r
+      integer i,d,e
+
+      integer ne,esize,ncomp
+      parameter(ne=3)
+      parameter(esize=2)
+      parameter(ncomp=2)
+
+      integer*4 strides(3)
+      real*8 a(ne*esize*ncomp)
+      real*8 yy(ne*esize*ncomp)
+      real*8 v
+      integer*8 yoffset
+
+      character arg*32
+
+      call getarg(1,arg)
+      call ceedinit(trim(arg)//char(0),ceed,err)
+
+      call ceedvectorcreate(ceed,ne*esize*ncomp,x,err)
+
+      do i=1,ne*esize*ncomp
+        a(i)=10+i-1
+      enddo
+
+      call ceedvectorsetarray(x,ceed_mem_host,ceed_use_pointer,a,err)
+
+c     Components interlaced at each node of each element
+      strides(1)=ncomp
+      strides(2)=1
+      strides(3)=esize*ncomp
+      call ceedelemrestrictioncreatestrided(ceed,ne,esize,ne*esize,
+     $  ncomp,strides,r,err)
+
+      call ceedvectorcreate(ceed,ne*esize*ncomp,y,err);
+      call ceedvectorsetvalue(y,0.d0,err);
+      call ceedelemrestrictionapply(r,ceed_notranspose,
+     $  ceed_notranspose,x,y,ceed_request_immediate,err)
+
+      call ceedvectorgetarrayread(y,ceed_mem_host,yy,yoffset,err)
+      do e=0,ne-1
+        do d=0,ncomp-1
+          do i=0,esize-1
+            v=a(i*strides(1)+d*strides(2)+e*strides(3)+1)
+            if (yy(yoffset+(e*ncomp+d)*esize+i+1).ne.v) then
+              write(*,*) 'Error in restricted array ',e,d,i,
+     $          yy(yoffset+(e*ncomp+d)*esize+i+1),' != ',v
+            endif
+          enddo
+        enddo
+      enddo
+      call ceedvectorrestorearrayread(y,yy,yoffset,err)
+
+      call ceedvectordestroy(x,err)
+      call ceedvectordestroy(y,err)
+      call ceedelemrestrictiondestroy(r,err)
+      call ceeddestroy(ceed,err)
+
+      end
+c-----------------------------------------------------------------------
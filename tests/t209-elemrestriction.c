@@ -0,0 +1,76 @@
+/// @file
+/// Test creation, use, and destruction of a strided element restriction
+/// \test Test creation, use, and destruction of a strided element restriction
+#include <ceed.h>
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedVector x, y, z;
+  const CeedInt ne = 3, elemsize = 2, ncomp = 2, blksize = 2,
+                strides[3] = {ncomp, 1, elemsize*ncomp};
+  CeedScalar a[ne*elemsize*ncomp];
+  const CeedScalar *yy;
+  CeedElemRestriction r, rb;
+
+  CeedInit(argv[1], &ceed);
+  CeedVectorCreate(ceed, ne*elemsize*ncomp, &x);
+  for (CeedInt i=0; i<ne*elemsize*ncomp; i++) a[i] = 10 + i;
+  CeedVectorSetArray(x, CEED_MEM_HOST, CEED_USE_POINTER, a);
+
+  // Components interlaced at each node of each element
+  CeedElemRestrictionCreateStrided(ceed, ne, elemsize, ne*elemsize, ncomp,
+                                   strides, &r);
+  CeedVectorCreate(ceed, ne*elemsize*ncomp, &y);
+  CeedVectorSetValue(y, 0); // Allocates array
+  CeedElemRestrictionApply(r, CEED_NOTRANSPOSE, CEED_NOTRANSPOSE, x, y,
+                           CEED_REQUEST_IMMEDIATE);
+  CeedVectorGetArrayRead(y, CEED_MEM_HOST, &yy);
+  for (CeedInt e=0; e<ne; e++)
+    for (CeedInt d=0; d<ncomp; d++)
+      for (CeedInt i=0; i<elemsize; i++) {
+        const CeedScalar v = a[i*strides[0] + d*strides[1] + e*strides[2]];
+        if (yy[(e*ncomp+d)*elemsize+i] != v)
+          printf("Error in restricted array y[%d,%d,%d] = %f != %f\n", e, d, i,
+                 (double)yy[(e*ncomp+d)*elemsize+i], (double)v);
+      }
+  CeedVectorRestoreArrayRead(y, &yy);
+
+  // Transpose
+  CeedVectorCreate(ceed, ne*elemsize*ncomp, &z);
+  CeedVectorSetValue(z, 0);
+  CeedElemRestrictionApply(r, CEED_TRANSPOSE, CEED_NOTRANSPOSE, y, z,
+                           CEED_REQUEST_IMMEDIATE);
+  CeedVectorGetArrayRead(z, CEED_MEM_HOST, &yy);
+  for (CeedInt i=0; i<ne*elemsize*ncomp; i++)
+    if (yy[i] != a[i])
+      printf("Error in transpose z[%d] = %f != %f\n", i, (double)yy[i],
+             (double)a[i]);
+  CeedVectorRestoreArrayRead(z, &yy);
+  CeedVectorDestroy(&y);
+
+  // Blocked, the last block is padded with the last element
+  CeedElemRestrictionCreateBlockedStrided(ceed, ne, elemsize, blksize,
+                                          ne*elemsize, ncomp, strides, &rb);
+  CeedVectorCreate(ceed, blksize*elemsize*ncomp, &y);
+  CeedVectorSetValue(y, 0);
+  CeedElemRestrictionApplyBlock(rb, 1, CEED_NOTRANSPOSE, CEED_NOTRANSPOSE, x,
+                                y, CEED_REQUEST_IMMEDIATE);
+  CeedVectorGetArrayRead(y, CEED_MEM_HOST, &yy);
+  for (CeedInt j=0; j<blksize; j++)
+    for (CeedInt d=0; d<ncomp; d++)
+      for (CeedInt i=0; i<elemsize; i++) {
+        const CeedScalar v = a[i*strides[0] + d*strides[1] + (ne-1)*strides[2]];
+        if (yy[(d*elemsize+i)*blksize+j] != v)
+          printf("Error in block [%d,%d,%d] = %f != %f\n", d, i, j,
+                 (double)yy[(d*elemsize+i)*blksize+j], (double)v);
+      }
+  CeedVectorRestoreArrayRead(y, &yy);
+
+  CeedVectorDestroy(&x);
+  CeedVectorDestroy(&y);
+  CeedVectorDestroy(&z);
+  CeedElemRestrictionDestroy(&r);
+  CeedElemRestrictionDestroy(&rb);
+  CeedDestroy(&ceed);
+  return 0;
+}
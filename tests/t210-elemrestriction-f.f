@@ -0,0 +1,85 @@
+c-----------------------------------------------------------------------
+      program test
+
+      include 'ceedf.h'
+
+      integer ceed,err
+      integer x,y,z
+      integer r,rc
+      integer i,j,ii,jj,e
+
+      integer dimn,p,nx,ny,nelem,esize,ndx,ndy,ndof
+      parameter(dimn=2)
+      parameter(p=3)
+      parameter(nx=3)
+      parameter(ny=2)
+      parameter(nelem=nx*ny)
+      parameter(esize=p*p)
+      parameter(ndx=nx*(p-1)+1)
+      parameter(ndy=ny*(p-1)+1)
+      parameter(ndof=ndx*ndy)
+
+      integer*4 ind(esize*nelem)
+      integer*4 nel(dimn)
+      real*8 a(ndof)
+      real*8 yy(esize*nelem)
+      real*8 zz(esize*nelem)
+      integer*8 yoffset,zoffset
+
+      character arg*32
+
+      call getarg(1,arg)
+      call ceedinit(trim(arg)//char(0),ceed,err)
+
+c     Explicit indices of the same box
+      do j=0,ny-1
+        do i=0,nx-1
+          e=i+nx*j
+          do jj=0,p-1
+            do ii=0,p-1
+              ind(e*esize+ii+p*jj+1)=i*(p-1)+ii+ndx*(j*(p-1)+jj)
+            enddo
+          enddo
+        enddo
+      enddo
+      do i=1,ndof
+        a(i)=10+i-1
+      enddo
+
+      call ceedvectorcreate(ceed,ndof,x,err)
+      call ceedvectorsetarray(x,ceed_mem_host,ceed_use_pointer,a,err)
+      call ceedvectorcreate(ceed,esize*nelem,y,err)
+      call ceedvectorcreate(ceed,esize*nelem,z,err)
+
+      nel(1)=nx
+      nel(2)=ny
+      call ceedelemrestrictioncreate(ceed,nelem,esize,ndof,1,
+     $  ceed_mem_host,ceed_use_pointer,ind,r,err)
+      call ceedelemrestrictioncreatecartesian(ceed,dimn,nel,p,
+     $  ceed_order_lexicographic,1,rc,err)
+
+      call ceedelemrestrictionapply(r,ceed_notranspose,
+     $  ceed_notranspose,x,y,ceed_request_immediate,err)
+      call ceedelemrestrictionapply(rc,ceed_notranspose,
+     $  ceed_notranspose,x,z,ceed_request_immediate,err)
+
+      call ceedvectorgetarrayread(y,ceed_mem_host,yy,yoffset,err)
+      call ceedvectorgetarrayread(z,ceed_mem_host,zz,zoffset,err)
+      do i=1,esize*nelem
+        if (yy(yoffset+i).ne.zz(zoffset+i)) then
+          write(*,*) 'Error in restricted array ',i,
+     $      zz(zoffset+i),' != ',yy(yoffset+i)
+        endif
+      enddo
+      call ceedvectorrestorearrayread(y,yy,yoffset,err)
+      call ceedvectorrestorearrayread(z,zz,zoffset,err)
+
+      call ceedvectordestroy(x,err)
+      call ceedvectordestroy(y,err)
+      call ceedvectordestroy(z,err)
+      call ceedelemrestrictiondestroy(r,err)
+      call ceedelemrestrictiondestroy(rc,err)
+      call ceeddestroy(ceed,err)
+
+      end
+c-----------------------------------------------------------------------
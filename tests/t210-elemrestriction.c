@@ -0,0 +1,121 @@
+/// @file
+/// Test Cartesian element restrictions against their explicit indices
+/// \test Test Cartesian element restrictions against their explicit indices
+#include <ceed.h>
+
+// Compare two vectors entry by entry
+static void compare(const char *what, CeedInt dim, CeedNodeOrdering order,
+                    CeedVector a, CeedVector b) {
+  CeedInt n;
+  const CeedScalar *aa, *bb;
+  CeedVectorGetLength(a, &n);
+  CeedVectorGetArrayRead(a, CEED_MEM_HOST, &aa);
+  CeedVectorGetArrayRead(b, CEED_MEM_HOST, &bb);
+  for (CeedInt i=0; i<n; i++)
+    if (aa[i] != bb[i])
+      printf("dim %d order %d %s [%d] %f != %f\n", dim, order, what, i,
+             (double)aa[i], (double)bb[i]);
+  CeedVectorRestoreArrayRead(a, &aa);
+  CeedVectorRestoreArrayRead(b, &bb);
+}
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  const CeedInt nelem[3] = {3, 2, 2}, P = 3, ncomp = 2, blksize = 4;
+
+  CeedInit(argv[1], &ceed);
+
+  for (CeedInt dim=1; dim<=3; dim++)
+    for (CeedInt order=CEED_ORDER_LEXICOGRAPHIC; order<=CEED_ORDER_REVERSED;
+         order++) {
+      CeedInt ne = 1, elemsize = CeedIntPow(P, dim), ndof = 1, nd[3];
+      for (CeedInt d=0; d<dim; d++) {
+        ne *= nelem[d];
+        nd[d] = nelem[d]*(P-1) + 1;
+        ndof *= nd[d];
+      }
+      CeedInt ind[ne*elemsize];
+      CeedScalar x[ndof*ncomp];
+
+      // Explicit indices of the same box, the element nodes in the given order
+      for (CeedInt e=0; e<ne; e++)
+        for (CeedInt k=0; k<elemsize; k++) {
+          CeedInt i = 0, s = 1, re = e;
+          for (CeedInt d=0; d<dim; d++) {
+            const CeedInt kd = (k/CeedIntPow(P, order == CEED_ORDER_REVERSED ?
+                                             dim-1-d : d))%P;
+            i += ((re%nelem[d])*(P-1) + kd)*s;
+            s *= nd[d];
+            re /= nelem[d];
+          }
+          ind[e*elemsize+k] = i;
+        }
+      for (CeedInt i=0; i<ndof*ncomp; i++)
+        x[i] = 10 + i;
+
+      CeedVector X, Y, Z, U, V;
+      CeedElemRestriction r, rc, rb, rcb;
+      CeedElemRestrictionCreate(ceed, ne, elemsize, ndof, ncomp, CEED_MEM_HOST,
+                                CEED_USE_POINTER, ind, &r);
+      CeedElemRestrictionCreateCartesian(ceed, dim, nelem, P, order, ncomp,
+                                         &rc);
+      CeedElemRestrictionCreateBlocked(ceed, ne, elemsize, blksize, ndof, ncomp,
+                                       CEED_MEM_HOST, CEED_COPY_VALUES, ind,
+                                       &rb);
+      CeedElemRestrictionCreateBlockedCartesian(ceed, dim, nelem, P, order,
+          blksize, ncomp, &rcb);
+      CeedVectorCreate(ceed, ndof*ncomp, &X);
+      CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+      CeedVectorCreate(ceed, ne*elemsize*ncomp, &Y);
+      CeedVectorCreate(ceed, ne*elemsize*ncomp, &Z);
+      CeedVectorCreate(ceed, ndof*ncomp, &U);
+      CeedVectorCreate(ceed, ndof*ncomp, &V);
+
+      for (CeedInt lmode=CEED_NOTRANSPOSE; lmode<=CEED_TRANSPOSE; lmode++) {
+        CeedElemRestrictionApply(r, CEED_NOTRANSPOSE, lmode, X, Y,
+                                 CEED_REQUEST_IMMEDIATE);
+        CeedElemRestrictionApply(rc, CEED_NOTRANSPOSE, lmode, X, Z,
+                                 CEED_REQUEST_IMMEDIATE);
+        compare("restriction", dim, order, Y, Z);
+        CeedVectorSetValue(U, 0);
+        CeedVectorSetValue(V, 0);
+        CeedElemRestrictionApply(r, CEED_TRANSPOSE, lmode, Y, U,
+                                 CEED_REQUEST_IMMEDIATE);
+        CeedElemRestrictionApply(rc, CEED_TRANSPOSE, lmode, Z, V,
+                                 CEED_REQUEST_IMMEDIATE);
+        compare("transpose", dim, order, U, V);
+      }
+      CeedVectorDestroy(&Y);
+      CeedVectorDestroy(&Z);
+
+      // Blocked, with padding elements
+      const CeedInt nblk = (ne / blksize) + !!(ne % blksize);
+      CeedVectorCreate(ceed, nblk*blksize*elemsize*ncomp, &Y);
+      CeedVectorCreate(ceed, nblk*blksize*elemsize*ncomp, &Z);
+      CeedElemRestrictionApply(rb, CEED_NOTRANSPOSE, CEED_NOTRANSPOSE, X, Y,
+                               CEED_REQUEST_IMMEDIATE);
+      CeedElemRestrictionApply(rcb, CEED_NOTRANSPOSE, CEED_NOTRANSPOSE, X, Z,
+                               CEED_REQUEST_IMMEDIATE);
+      compare("blocked restriction", dim, order, Y, Z);
+      CeedVectorSetValue(U, 0);
+      CeedVectorSetValue(V, 0);
+      CeedElemRestrictionApply(rb, CEED_TRANSPOSE, CEED_NOTRANSPOSE, Y, U,
+                               CEED_REQUEST_IMMEDIATE);
+      CeedElemRestrictionApply(rcb, CEED_TRANSPOSE, CEED_NOTRANSPOSE, Z, V,
+                               CEED_REQUEST_IMMEDIATE);
+      compare("blocked transpose", dim, order, U, V);
+
+      CeedVectorDestroy(&X);
+      CeedVectorDestroy(&Y);
+      CeedVectorDestroy(&Z);
+      CeedVectorDestroy(&U);
+      CeedVectorDestroy(&V);
+      CeedElemRestrictionDestroy(&r);
+      CeedElemRestrictionDestroy(&rc);
+      CeedElemRestrictionDestroy(&rb);
+      CeedElemRestrictionDestroy(&rcb);
+    }
+
+  CeedDestroy(&ceed);
+  return 0;
+}
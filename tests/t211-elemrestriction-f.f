@@ -0,0 +1,68 @@
+c-----------------------------------------------------------------------
+      program test
+
+      include 'ceedf.h'
+
+      integer ceed,err
+      integer x,y
+      integer r
+      integer i,k,e,s,n
+
+      integer ne,esize,ndof
+      parameter(ne=5)
+      parameter(esize=14)
+      parameter(ndof=ne+1+ne*(esize-2))
+
+      integer*4 ind(esize*ne)
+      integer*4 perm(ne)
+      real*8 a(ndof)
+      real*8 yy(esize*ne)
+      integer*8 yoffset
+
+      character arg*32
+
+      data perm/3,0,4,2,1/
+
+      call getarg(1,arg)
+      call ceedinit(trim(arg)//char(0),ceed,err)
+
+c     Segments of a line taken out of order, with the vertices numbered
+c     first and the interior nodes of each segment one after the other
+      do e=0,ne-1
+        s=perm(e+1)
+        ind(e*esize+1)=s
+        do k=1,esize-2
+          ind(e*esize+k+1)=ne+1+s*(esize-2)+k-1
+        enddo
+        ind(e*esize+esize)=s+1
+      enddo
+      do i=1,ndof
+        a(i)=10+i-1
+      enddo
+
+      call ceedvectorcreate(ceed,ndof,x,err)
+      call ceedvectorsetarray(x,ceed_mem_host,ceed_use_pointer,a,err)
+      call ceedvectorcreate(ceed,esize*ne,y,err)
+
+      call ceedelemrestrictioncreate(ceed,ne,esize,ndof,1,
+     $  ceed_mem_host,ceed_copy_values,ind,r,err)
+      call ceedelemrestrictionapply(r,ceed_notranspose,
+     $  ceed_notranspose,x,y,ceed_request_immediate,err)
+
+      call ceedvectorgetarrayread(y,ceed_mem_host,yy,yoffset,err)
+      do i=1,esize*ne
+        n=ind(i)
+        if (yy(yoffset+i).ne.a(n+1)) then
+          write(*,*) 'Error in restricted array ',i,
+     $      yy(yoffset+i),' != ',a(n+1)
+        endif
+      enddo
+      call ceedvectorrestorearrayread(y,yy,yoffset,err)
+
+      call ceedvectordestroy(x,err)
+      call ceedvectordestroy(y,err)
+      call ceedelemrestrictiondestroy(r,err)
+      call ceeddestroy(ceed,err)
+
+      end
+c-----------------------------------------------------------------------
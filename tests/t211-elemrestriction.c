@@ -0,0 +1,92 @@
+/// @file
+/// Test element restrictions whose indices are mostly runs of consecutive nodes
+/// \test Test element restrictions whose indices are mostly runs of consecutive nodes
+#include <ceed.h>
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  const CeedInt ne = 5, elemsize = 14, ncomp = 2, blksize = 4,
+                ndof = ne+1 + ne*(elemsize-2), perm[5] = {3, 0, 4, 2, 1};
+  CeedInt ind[ne*elemsize];
+  CeedScalar a[ndof*ncomp], b[ndof*ncomp];
+  const CeedScalar *yy;
+
+  CeedInit(argv[1], &ceed);
+
+  // Segments of a line taken out of order, with the vertices numbered first
+  // and the interior nodes of each segment one after the other
+  for (CeedInt e=0; e<ne; e++) {
+    const CeedInt s = perm[e];
+    ind[e*elemsize] = s;
+    for (CeedInt k=1; k<elemsize-1; k++)
+      ind[e*elemsize+k] = ne+1 + s*(elemsize-2) + k-1;
+    ind[e*elemsize+elemsize-1] = s+1;
+  }
+  for (CeedInt i=0; i<ndof*ncomp; i++)
+    a[i] = 10 + i;
+
+  for (CeedInt blk=1; blk<=blksize; blk+=blksize-1) {
+    const CeedInt nblk = (ne / blk) + !!(ne % blk);
+    CeedVector x, y, z;
+    CeedElemRestriction r;
+    // Copied, so that the backend may store the indices as runs
+    if (blk == 1)
+      CeedElemRestrictionCreate(ceed, ne, elemsize, ndof, ncomp, CEED_MEM_HOST,
+                                CEED_COPY_VALUES, ind, &r);
+    else
+      CeedElemRestrictionCreateBlocked(ceed, ne, elemsize, blk, ndof, ncomp,
+                                       CEED_MEM_HOST, CEED_COPY_VALUES, ind,
+                                       &r);
+    CeedVectorCreate(ceed, ndof*ncomp, &x);
+    CeedVectorSetArray(x, CEED_MEM_HOST, CEED_USE_POINTER, a);
+    CeedVectorCreate(ceed, nblk*blk*elemsize*ncomp, &y);
+    CeedVectorCreate(ceed, ndof*ncomp, &z);
+
+    for (CeedInt lmode=CEED_NOTRANSPOSE; lmode<=CEED_TRANSPOSE; lmode++) {
+      CeedElemRestrictionApply(r, CEED_NOTRANSPOSE, lmode, x, y,
+                               CEED_REQUEST_IMMEDIATE);
+      CeedVectorGetArrayRead(y, CEED_MEM_HOST, &yy);
+      for (CeedInt e=0; e<nblk*blk; e++)
+        for (CeedInt d=0; d<ncomp; d++)
+          for (CeedInt k=0; k<elemsize; k++) {
+            const CeedInt n = ind[CeedIntMin(e,ne-1)*elemsize+k];
+            const CeedScalar v = a[lmode == CEED_NOTRANSPOSE ? n+ndof*d
+                                                             : d+ncomp*n],
+                             yi = yy[((e/blk)*ncomp+d)*elemsize*blk + k*blk
+                                     + e%blk];
+            if (yi != v)
+              printf("blksize %d lmode %d restriction [%d,%d,%d] %f != %f\n",
+                     blk, lmode, e, d, k, (double)yi, (double)v);
+          }
+
+      // The transpose adds the values of the elements sharing each node
+      for (CeedInt i=0; i<ndof*ncomp; i++)
+        b[i] = 0;
+      for (CeedInt e=0; e<ne; e++)
+        for (CeedInt d=0; d<ncomp; d++)
+          for (CeedInt k=0; k<elemsize; k++) {
+            const CeedInt n = ind[e*elemsize+k],
+                          l = lmode == CEED_NOTRANSPOSE ? n+ndof*d : d+ncomp*n;
+            b[l] += yy[((e/blk)*ncomp+d)*elemsize*blk + k*blk + e%blk];
+          }
+      CeedVectorRestoreArrayRead(y, &yy);
+      CeedVectorSetValue(z, 0);
+      CeedElemRestrictionApply(r, CEED_TRANSPOSE, lmode, y, z,
+                               CEED_REQUEST_IMMEDIATE);
+      CeedVectorGetArrayRead(z, CEED_MEM_HOST, &yy);
+      for (CeedInt i=0; i<ndof*ncomp; i++)
+        if (yy[i] != b[i])
+          printf("blksize %d lmode %d transpose [%d] %f != %f\n", blk, lmode,
+                 i, (double)yy[i], (double)b[i]);
+      CeedVectorRestoreArrayRead(z, &yy);
+    }
+
+    CeedVectorDestroy(&x);
+    CeedVectorDestroy(&y);
+    CeedVectorDestroy(&z);
+    CeedElemRestrictionDestroy(&r);
+  }
+
+  CeedDestroy(&ceed);
+  return 0;
+}
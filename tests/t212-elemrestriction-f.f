@@ -0,0 +1,82 @@
+c-----------------------------------------------------------------------
+      program test
+
+      include 'ceedf.h'
+
+      integer ceed,err
+      integer y,z
+      integer r
+      integer i,k,e,n
+
+      integer ne,esize,ndof
+      parameter(ne=7)
+      parameter(esize=3)
+      parameter(ndof=ne*(esize-1)+1)
+
+      integer*4 ind(esize*ne)
+      real*8 a(esize*ne)
+      real*8 b(ndof)
+      real*8 zz(ndof)
+      integer*8 zoffset
+
+      character arg*32
+
+      call getarg(1,arg)
+      call ceedinit(trim(arg)//char(0),ceed,err)
+
+c     Elements of a line, numbered backwards
+      do e=0,ne-1
+        do k=0,esize-1
+          ind(e*esize+k+1)=(ne-1-e)*(esize-1)+k
+        enddo
+      enddo
+      do i=1,esize*ne
+        a(i)=i
+      enddo
+      do i=1,ndof
+        b(i)=0
+      enddo
+      do i=1,esize*ne
+        n=ind(i)
+        b(n+1)=b(n+1)+a(i)
+      enddo
+
+      call ceedvectorcreate(ceed,esize*ne,y,err)
+      call ceedvectorsetarray(y,ceed_mem_host,ceed_use_pointer,a,err)
+      call ceedvectorcreate(ceed,ndof,z,err)
+
+      call ceedelemrestrictioncreate(ceed,ne,esize,ndof,1,
+     $  ceed_mem_host,ceed_use_pointer,ind,r,err)
+
+c     The previous content of the output is added to, then discarded
+      call ceedvectorsetvalue(z,42.d0,err)
+      call ceedelemrestrictionapply(r,ceed_transpose,
+     $  ceed_notranspose,y,z,ceed_request_immediate,err)
+
+      call ceedvectorgetarrayread(z,ceed_mem_host,zz,zoffset,err)
+      do i=1,ndof
+        if (zz(zoffset+i).ne.b(i)+42) then
+          write(*,*) 'Error in transpose ',i,zz(zoffset+i),' != ',
+     $      b(i)+42
+        endif
+      enddo
+      call ceedvectorrestorearrayread(z,zz,zoffset,err)
+
+      call ceedelemrestrictionapplyoverwrite(r,ceed_transpose,
+     $  ceed_notranspose,y,z,ceed_request_immediate,err)
+
+      call ceedvectorgetarrayread(z,ceed_mem_host,zz,zoffset,err)
+      do i=1,ndof
+        if (zz(zoffset+i).ne.b(i)) then
+          write(*,*) 'Error in overwrite ',i,zz(zoffset+i),' != ',b(i)
+        endif
+      enddo
+      call ceedvectorrestorearrayread(z,zz,zoffset,err)
+
+      call ceedvectordestroy(y,err)
+      call ceedvectordestroy(z,err)
+      call ceedelemrestrictiondestroy(r,err)
+      call ceeddestroy(ceed,err)
+
+      end
+c-----------------------------------------------------------------------
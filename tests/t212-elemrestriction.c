@@ -0,0 +1,116 @@
+/// @file
+/// Test that the transpose of element restrictions adds to or overwrites its output
+/// \test Test that the transpose of element restrictions adds to or overwrites its output
+#include <ceed.h>
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  const CeedInt ne = 7, elemsize = 3, ncomp = 2, blksize = 3,
+                ndof = ne*(elemsize-1) + 1;
+  CeedInt ind[ne*elemsize];
+  CeedScalar y[ne*elemsize*ncomp], b[ndof*ncomp];
+  const CeedScalar *zz;
+
+  CeedInit(argv[1], &ceed);
+
+  // Elements of a line, numbered backwards
+  for (CeedInt e=0; e<ne; e++)
+    for (CeedInt k=0; k<elemsize; k++)
+      ind[e*elemsize+k] = (ne-1-e)*(elemsize-1) + k;
+  for (CeedInt i=0; i<ne*elemsize*ncomp; i++)
+    y[i] = i + 1;
+
+  for (CeedInt blk=1; blk<=blksize; blk+=blksize-1) {
+    const CeedInt nblk = (ne / blk) + !!(ne % blk);
+    CeedVector Y, Z;
+    CeedElemRestriction r;
+    if (blk == 1)
+      CeedElemRestrictionCreate(ceed, ne, elemsize, ndof, ncomp, CEED_MEM_HOST,
+                                CEED_USE_POINTER, ind, &r);
+    else
+      CeedElemRestrictionCreateBlocked(ceed, ne, elemsize, blk, ndof, ncomp,
+                                       CEED_MEM_HOST, CEED_COPY_VALUES, ind,
+                                       &r);
+    CeedVectorCreate(ceed, nblk*blk*elemsize*ncomp, &Y);
+    CeedVectorSetValue(Y, 0);
+    CeedVectorCreate(ceed, ndof*ncomp, &Z);
+
+    for (CeedInt lmode=CEED_NOTRANSPOSE; lmode<=CEED_TRANSPOSE; lmode++) {
+      // E-vector values, padding elements excluded
+      CeedScalar *yy;
+      CeedVectorGetArray(Y, CEED_MEM_HOST, &yy);
+      for (CeedInt e=0; e<ne; e++)
+        for (CeedInt d=0; d<ncomp; d++)
+          for (CeedInt k=0; k<elemsize; k++)
+            yy[((e/blk)*ncomp+d)*elemsize*blk + k*blk + e%blk]
+              = y[(e*ncomp+d)*elemsize+k];
+      CeedVectorRestoreArray(Y, &yy);
+      for (CeedInt i=0; i<ndof*ncomp; i++)
+        b[i] = 0;
+      for (CeedInt e=0; e<ne; e++)
+        for (CeedInt d=0; d<ncomp; d++)
+          for (CeedInt k=0; k<elemsize; k++) {
+            const CeedInt n = ind[e*elemsize+k];
+            b[lmode == CEED_NOTRANSPOSE ? n+ndof*d : d+ncomp*n]
+              += y[(e*ncomp+d)*elemsize+k];
+          }
+
+      // The previous content of the output is added to, then discarded
+      CeedVectorSetValue(Z, 42);
+      CeedElemRestrictionApply(r, CEED_TRANSPOSE, lmode, Y, Z,
+                               CEED_REQUEST_IMMEDIATE);
+      CeedVectorGetArrayRead(Z, CEED_MEM_HOST, &zz);
+      for (CeedInt i=0; i<ndof*ncomp; i++)
+        if (zz[i] != b[i] + 42)
+          printf("blksize %d lmode %d transpose [%d] %f != %f\n", blk, lmode,
+                 i, (double)zz[i], (double)b[i] + 42);
+      CeedVectorRestoreArrayRead(Z, &zz);
+      CeedElemRestrictionApplyOverwrite(r, CEED_TRANSPOSE, lmode, Y, Z,
+                                        CEED_REQUEST_IMMEDIATE);
+      CeedVectorGetArrayRead(Z, CEED_MEM_HOST, &zz);
+      for (CeedInt i=0; i<ndof*ncomp; i++)
+        if (zz[i] != b[i])
+          printf("blksize %d lmode %d overwrite [%d] %f != %f\n", blk, lmode,
+                 i, (double)zz[i], (double)b[i]);
+      CeedVectorRestoreArrayRead(Z, &zz);
+    }
+
+    CeedVectorDestroy(&Y);
+    CeedVectorDestroy(&Z);
+    CeedElemRestrictionDestroy(&r);
+  }
+
+  // Strided restriction
+  {
+    CeedVector Y, Z;
+    CeedElemRestriction r;
+    CeedElemRestrictionCreateIdentity(ceed, ne, elemsize, ne*elemsize, ncomp,
+                                      &r);
+    CeedVectorCreate(ceed, ne*elemsize*ncomp, &Y);
+    CeedVectorSetArray(Y, CEED_MEM_HOST, CEED_USE_POINTER, y);
+    CeedVectorCreate(ceed, ne*elemsize*ncomp, &Z);
+    CeedVectorSetValue(Z, 42);
+    CeedElemRestrictionApply(r, CEED_TRANSPOSE, CEED_NOTRANSPOSE, Y, Z,
+                             CEED_REQUEST_IMMEDIATE);
+    CeedVectorGetArrayRead(Z, CEED_MEM_HOST, &zz);
+    for (CeedInt i=0; i<ne*elemsize*ncomp; i++)
+      if (zz[i] != y[i] + 42)
+        printf("strided transpose [%d] %f != %f\n", i, (double)zz[i],
+               (double)y[i] + 42);
+    CeedVectorRestoreArrayRead(Z, &zz);
+    CeedElemRestrictionApplyOverwrite(r, CEED_TRANSPOSE, CEED_NOTRANSPOSE, Y, Z,
+                                      CEED_REQUEST_IMMEDIATE);
+    CeedVectorGetArrayRead(Z, CEED_MEM_HOST, &zz);
+    for (CeedInt i=0; i<ne*elemsize*ncomp; i++)
+      if (zz[i] != y[i])
+        printf("strided overwrite [%d] %f != %f\n", i, (double)zz[i],
+               (double)y[i]);
+    CeedVectorRestoreArrayRead(Z, &zz);
+    CeedVectorDestroy(&Y);
+    CeedVectorDestroy(&Z);
+    CeedElemRestrictionDestroy(&r);
+  }
+
+  CeedDestroy(&ceed);
+  return 0;
+}
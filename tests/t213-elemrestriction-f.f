@@ -0,0 +1,121 @@
+c-----------------------------------------------------------------------
+      program test
+
+      include 'ceedf.h'
+
+      integer ceed,err
+      integer x,y,z,w
+      integer r
+      integer i,k,d,e,n,m,l,lm
+
+      integer ne,esize,ndof,ncomp,blksize,nblk,bsize
+      parameter(ne=11)
+      parameter(esize=4)
+      parameter(ndof=ne*(esize-1)+1)
+      parameter(ncomp=3)
+      parameter(blksize=8)
+      parameter(nblk=(ne+blksize-1)/blksize)
+      parameter(bsize=blksize*esize*ncomp)
+
+      integer*4 ind(esize*ne)
+      real*8 xx(ndof*ncomp)
+      real*8 yy(nblk*bsize)
+      real*8 b(ndof*ncomp)
+      real*8 zz(nblk*bsize)
+      integer*8 zoffset
+
+      character arg*32
+
+      call getarg(1,arg)
+      call ceedinit(trim(arg)//char(0),ceed,err)
+
+c     Elements of a line with scattered node numbers
+      do e=0,ne-1
+        do k=0,esize-1
+          ind(e*esize+k+1)=mod((e*(esize-1)+k)*7,ndof)
+        enddo
+      enddo
+      do i=1,ndof*ncomp
+        xx(i)=10+i
+      enddo
+      do i=1,nblk*bsize
+        yy(i)=i
+      enddo
+
+      call ceedvectorcreate(ceed,ndof*ncomp,x,err)
+      call ceedvectorsetarray(x,ceed_mem_host,ceed_use_pointer,xx,err)
+      call ceedvectorcreate(ceed,nblk*bsize,y,err)
+      call ceedvectorcreate(ceed,ndof*ncomp,z,err)
+
+      call ceedelemrestrictioncreateblocked(ceed,ne,esize,blksize,ndof,
+     $  ncomp,ceed_mem_host,ceed_copy_values,ind,r,err)
+
+      do lm=ceed_notranspose,ceed_transpose
+c       Gather
+        call ceedelemrestrictionapply(r,ceed_notranspose,lm,x,y,
+     $    ceed_request_immediate,err)
+        call ceedvectorgetarrayread(y,ceed_mem_host,zz,zoffset,err)
+        do e=0,ne-1
+          do d=0,ncomp-1
+            do k=0,esize-1
+              n=ind(e*esize+k+1)
+              if (lm.eq.ceed_notranspose) then
+                m=n+ndof*d
+              else
+                m=d+ncomp*n
+              endif
+              l=(e/blksize)*bsize+(d*esize+k)*blksize+mod(e,blksize)
+              if (zz(zoffset+l+1).ne.xx(m+1)) then
+                write(*,*) 'Error in gather ',lm,e,d,k,
+     $            zz(zoffset+l+1),' != ',xx(m+1)
+              endif
+            enddo
+          enddo
+        enddo
+        call ceedvectorrestorearrayread(y,zz,zoffset,err)
+
+c       Scatter-add block by block
+        do i=1,ndof*ncomp
+          b(i)=0
+        enddo
+        do e=0,ne-1
+          do d=0,ncomp-1
+            do k=0,esize-1
+              n=ind(e*esize+k+1)
+              if (lm.eq.ceed_notranspose) then
+                m=n+ndof*d
+              else
+                m=d+ncomp*n
+              endif
+              l=(e/blksize)*bsize+(d*esize+k)*blksize+mod(e,blksize)
+              b(m+1)=b(m+1)+yy(l+1)
+            enddo
+          enddo
+        enddo
+        call ceedvectorsetvalue(z,0.d0,err)
+        do i=0,nblk-1
+          call ceedvectorcreate(ceed,bsize,w,err)
+          call ceedvectorsetarray(w,ceed_mem_host,ceed_use_pointer,
+     $      yy(i*bsize+1),err)
+          call ceedelemrestrictionapplyblock(r,i,ceed_transpose,lm,w,z,
+     $      ceed_request_immediate,err)
+          call ceedvectordestroy(w,err)
+        enddo
+        call ceedvectorgetarrayread(z,ceed_mem_host,zz,zoffset,err)
+        do i=1,ndof*ncomp
+          if (zz(zoffset+i).ne.b(i)) then
+            write(*,*) 'Error in transpose ',lm,i,zz(zoffset+i),' != ',
+     $        b(i)
+          endif
+        enddo
+        call ceedvectorrestorearrayread(z,zz,zoffset,err)
+      enddo
+
+      call ceedvectordestroy(x,err)
+      call ceedvectordestroy(y,err)
+      call ceedvectordestroy(z,err)
+      call ceedelemrestrictiondestroy(r,err)
+      call ceeddestroy(ceed,err)
+
+      end
+c-----------------------------------------------------------------------
@@ -0,0 +1,107 @@
+/// @file
+/// Test element restrictions with 1 or 3 components and blocks of 1, 4 or 8
+/// \test Test element restrictions with 1 or 3 components and blocks of 1, 4 or 8
+#include <ceed.h>
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  const CeedInt ne = 11, elemsize = 4, ndof = ne*(elemsize-1) + 1;
+  CeedInt ind[ne*elemsize];
+  CeedScalar x[ndof*3], y[ne*elemsize*3], b[ndof*3];
+
+  CeedInit(argv[1], &ceed);
+
+  for (CeedInt i=0; i<ndof*3; i++)
+    x[i] = 10 + i;
+  for (CeedInt i=0; i<ne*elemsize*3; i++)
+    y[i] = i + 1;
+
+  for (CeedInt mesh=0; mesh<2; mesh++) {
+    // Elements of a line with scattered node numbers, then indices that repeat
+    //   nodes within a block
+    for (CeedInt e=0; e<ne; e++)
+      for (CeedInt k=0; k<elemsize; k++)
+        ind[e*elemsize+k] = mesh == 0 ? ((e*(elemsize-1)+k)*7) % ndof
+                            : (e*13 + k*5 + e*k) % 9;
+
+    for (CeedInt ncomp=1; ncomp<=3; ncomp+=2)
+      for (CeedInt blk=1; blk<=8; blk*=blk==1 ? 4 : 2) {
+        const CeedInt nblk = (ne / blk) + !!(ne % blk),
+                      bsize = blk*elemsize*ncomp;
+        CeedScalar yb[nblk*bsize];
+        const CeedScalar *zz;
+        CeedVector X, Y, Z;
+        CeedElemRestriction r;
+        if (blk == 1)
+          CeedElemRestrictionCreate(ceed, ne, elemsize, ndof, ncomp,
+                                    CEED_MEM_HOST, CEED_USE_POINTER, ind, &r);
+        else
+          CeedElemRestrictionCreateBlocked(ceed, ne, elemsize, blk, ndof,
+                                           ncomp, CEED_MEM_HOST,
+                                           CEED_COPY_VALUES, ind, &r);
+        CeedVectorCreate(ceed, ndof*ncomp, &X);
+        CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+        CeedVectorCreate(ceed, nblk*bsize, &Y);
+        CeedVectorCreate(ceed, ndof*ncomp, &Z);
+
+        for (CeedInt lmode=CEED_NOTRANSPOSE; lmode<=CEED_TRANSPOSE; lmode++) {
+          // Gather, padding elements repeat the last element
+          CeedElemRestrictionApply(r, CEED_NOTRANSPOSE, lmode, X, Y,
+                                   CEED_REQUEST_IMMEDIATE);
+          CeedVectorGetArrayRead(Y, CEED_MEM_HOST, &zz);
+          for (CeedInt e=0; e<nblk*blk; e++)
+            for (CeedInt d=0; d<ncomp; d++)
+              for (CeedInt k=0; k<elemsize; k++) {
+                const CeedInt n = ind[CeedIntMin(e, ne-1)*elemsize+k];
+                const CeedScalar xi = x[lmode == CEED_NOTRANSPOSE ? n+ndof*d
+                                                : d+ncomp*n],
+                                 yi = zz[(e/blk)*bsize + (d*elemsize+k)*blk
+                                         + e%blk];
+                if (yi != xi)
+                  printf("mesh %d ncomp %d blksize %d lmode %d element %d "
+                         "[%d,%d] %f != %f\n", mesh, ncomp, blk, lmode, e, d,
+                         k, (double)yi, (double)xi);
+              }
+          CeedVectorRestoreArrayRead(Y, &zz);
+
+          // Scatter-add block by block, padding elements are ignored
+          for (CeedInt i=0; i<nblk*bsize; i++)
+            yb[i] = y[i % (ne*elemsize*ncomp)];
+          for (CeedInt i=0; i<ndof*ncomp; i++)
+            b[i] = 0;
+          for (CeedInt e=0; e<ne; e++)
+            for (CeedInt d=0; d<ncomp; d++)
+              for (CeedInt k=0; k<elemsize; k++) {
+                const CeedInt n = ind[e*elemsize+k];
+                b[lmode == CEED_NOTRANSPOSE ? n+ndof*d : d+ncomp*n]
+                  += yb[(e/blk)*bsize + (d*elemsize+k)*blk + e%blk];
+              }
+          CeedVectorSetValue(Z, 0);
+          for (CeedInt blkidx=0; blkidx<nblk; blkidx++) {
+            CeedVector B;
+            CeedVectorCreate(ceed, bsize, &B);
+            CeedVectorSetArray(B, CEED_MEM_HOST, CEED_USE_POINTER,
+                               yb + blkidx*bsize);
+            CeedElemRestrictionApplyBlock(r, blkidx, CEED_TRANSPOSE, lmode, B,
+                                          Z, CEED_REQUEST_IMMEDIATE);
+            CeedVectorDestroy(&B);
+          }
+          CeedVectorGetArrayRead(Z, CEED_MEM_HOST, &zz);
+          for (CeedInt i=0; i<ndof*ncomp; i++)
+            if (zz[i] != b[i])
+              printf("mesh %d ncomp %d blksize %d lmode %d transpose [%d] "
+                     "%f != %f\n", mesh, ncomp, blk, lmode, i, (double)zz[i],
+                     (double)b[i]);
+          CeedVectorRestoreArrayRead(Z, &zz);
+        }
+
+        CeedVectorDestroy(&X);
+        CeedVectorDestroy(&Y);
+        CeedVectorDestroy(&Z);
+        CeedElemRestrictionDestroy(&r);
+      }
+  }
+
+  CeedDestroy(&ceed);
+  return 0;
+}
@@ -0,0 +1,104 @@
+c-----------------------------------------------------------------------
+      program test
+
+      include 'ceedf.h'
+
+      integer ceed,err
+      integer x,y
+      integer r
+      integer i,j,k,l,e,s,n,m,d
+
+      integer nx,ny,p,nelem,esize,mx,ndof
+      parameter(nx=12)
+      parameter(ny=10)
+      parameter(p=3)
+      parameter(nelem=nx*ny)
+      parameter(esize=p*p)
+      parameter(mx=nx*(p-1)+1)
+      parameter(ndof=mx*(ny*(p-1)+1))
+
+      integer*4 ind(esize*nelem)
+      integer*4 sind(esize*nelem)
+      integer*4 eperm(nelem)
+      integer*4 dofperm(ndof)
+      integer*4 seen(ndof)
+      real*8 cent(2*nelem)
+      real*8 a(ndof)
+      real*8 yy(esize*nelem)
+      integer*8 yoffset
+
+      character arg*32
+
+      call getarg(1,arg)
+      call ceedinit(trim(arg)//char(0),ceed,err)
+
+c     Quadrilaterals of a grid, numbered row by row, then scrambled
+      do j=0,ny-1
+        do i=0,nx-1
+          do l=0,p-1
+            do k=0,p-1
+              ind((j*nx+i)*esize+l*p+k+1)=(j*(p-1)+l)*mx+i*(p-1)+k
+            enddo
+          enddo
+        enddo
+      enddo
+      do e=0,nelem-1
+        s=mod(e*37,nelem)
+        do k=1,esize
+          sind(s*esize+k)=mod(ind(e*esize+k)*101,ndof)
+        enddo
+        cent(2*s+1)=mod(e,nx)+0.5d0
+        cent(2*s+2)=e/nx+0.5d0
+      enddo
+
+c     Reverse Cuthill-McKee order, then Morton order of the centroids
+      do d=0,2,2
+        call ceedelemrestrictioncomputeordering(ceed,nelem,esize,ndof,
+     $    sind,d,cent,eperm,dofperm,err)
+
+        do n=1,ndof
+          seen(n)=0
+        enddo
+        do n=1,ndof
+          m=dofperm(n)
+          if (m.lt.0 .or. m.ge.ndof) then
+            write(*,*) 'Error in dofperm ',d,n,m
+          else if (seen(m+1).ne.0) then
+            write(*,*) 'Error in dofperm ',d,n,m
+          else
+            seen(m+1)=1
+          endif
+        enddo
+
+c       The permuted restriction on the permuted L-vector
+        do n=1,ndof
+          a(dofperm(n)+1)=n-1
+        enddo
+        call ceedvectorcreate(ceed,ndof,x,err)
+        call ceedvectorsetarray(x,ceed_mem_host,ceed_use_pointer,a,err)
+        call ceedvectorcreate(ceed,nelem*esize,y,err)
+        call ceedelemrestrictioncreatepermuted(ceed,nelem,esize,ndof,1,
+     $    sind,eperm,dofperm,r,err)
+        call ceedelemrestrictionapply(r,ceed_notranspose,
+     $    ceed_notranspose,x,y,ceed_request_immediate,err)
+        call ceedvectorgetarrayread(y,ceed_mem_host,yy,yoffset,err)
+        do e=0,nelem-1
+          do k=1,esize
+            n=sind(eperm(e+1)*esize+k)
+            if (yy(yoffset+e*esize+k).ne.n) then
+              write(*,*) 'Error in restriction ',d,e,k,
+     $          yy(yoffset+e*esize+k),' != ',n
+            endif
+          enddo
+        enddo
+        call ceedvectorrestorearrayread(y,yy,yoffset,err)
+
+        call ceedvectordestroy(x,err)
+        call ceedvectordestroy(y,err)
+        call ceedelemrestrictiondestroy(r,err)
+      enddo
+
+      call ceeddestroy(ceed,err)
+
+      end
+c-----------------------------------------------------------------------
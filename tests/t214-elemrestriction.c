@@ -0,0 +1,102 @@
+/// @file
+/// Test element and node reordering of element restrictions
+/// \test Test element and node reordering of element restrictions
+#include <ceed.h>
+
+// Average over the elements of the spread of their node numbers
+static CeedScalar span(CeedInt nelem, CeedInt elemsize, const CeedInt *ind) {
+  CeedScalar sum = 0;
+  for (CeedInt e=0; e<nelem; e++) {
+    CeedInt lo = ind[e*elemsize], hi = lo;
+    for (CeedInt k=1; k<elemsize; k++) {
+      lo = CeedIntMin(lo, ind[e*elemsize+k]);
+      hi = ind[e*elemsize+k] > hi ? ind[e*elemsize+k] : hi;
+    }
+    sum += hi - lo;
+  }
+  return sum / nelem;
+}
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  const CeedInt nx = 12, ny = 10, P = 3, nelem = nx*ny, elemsize = P*P,
+                mx = nx*(P-1) + 1, ndof = mx*(ny*(P-1) + 1);
+  CeedInt ind[nelem*elemsize], sind[nelem*elemsize], pind[nelem*elemsize],
+          eperm[nelem], dofperm[ndof], seen[ndof];
+  CeedScalar centroids[nelem*2], u[ndof], up[ndof];
+
+  CeedInit(argv[1], &ceed);
+
+  // Quadrilaterals of a grid, numbered row by row, then scrambled
+  for (CeedInt j=0; j<ny; j++)
+    for (CeedInt i=0; i<nx; i++)
+      for (CeedInt l=0; l<P; l++)
+        for (CeedInt k=0; k<P; k++)
+          ind[(j*nx+i)*elemsize + l*P+k] = (j*(P-1)+l)*mx + i*(P-1)+k;
+  for (CeedInt e=0; e<nelem; e++) {
+    const CeedInt s = (e*37) % nelem;
+    for (CeedInt k=0; k<elemsize; k++)
+      sind[s*elemsize+k] = (ind[e*elemsize+k]*101) % ndof;
+    centroids[2*s+0] = e%nx + 0.5;
+    centroids[2*s+1] = e/nx + 0.5;
+  }
+  const CeedScalar grid = span(nelem, elemsize, ind);
+  for (CeedInt n=0; n<ndof; n++)
+    u[n] = n;
+
+  for (CeedInt morton=0; morton<2; morton++) {
+    CeedElemRestriction r;
+    CeedVector U, E;
+    const CeedScalar *ee;
+
+    CeedElemRestrictionComputeOrdering(ceed, nelem, elemsize, ndof, sind, 2,
+                                       morton ? centroids : NULL, eperm,
+                                       dofperm);
+
+    // Permutations
+    for (CeedInt n=0; n<ndof; n++)
+      seen[n] = 0;
+    for (CeedInt e=0; e<nelem; e++)
+      if (eperm[e] < 0 || eperm[e] >= nelem || seen[eperm[e]]++)
+        printf("morton %d eperm[%d] = %d\n", morton, e, eperm[e]);
+    for (CeedInt n=0; n<ndof; n++)
+      seen[n] = 0;
+    for (CeedInt n=0; n<ndof; n++)
+      if (dofperm[n] < 0 || dofperm[n] >= ndof || seen[dofperm[n]]++)
+        printf("morton %d dofperm[%d] = %d\n", morton, n, dofperm[n]);
+
+    // Locality close to that of the grid
+    for (CeedInt e=0; e<nelem; e++)
+      for (CeedInt k=0; k<elemsize; k++)
+        pind[e*elemsize+k] = dofperm[sind[eperm[e]*elemsize+k]];
+    const CeedScalar s = span(nelem, elemsize, pind);
+    if (s > 2*grid)
+      printf("morton %d node spread %f, %f on the grid\n", morton, s, grid);
+
+    // The permuted restriction on the permuted L-vector
+    for (CeedInt n=0; n<ndof; n++)
+      up[dofperm[n]] = u[n];
+    CeedElemRestrictionCreatePermuted(ceed, nelem, elemsize, ndof, 1, sind,
+                                      eperm, dofperm, &r);
+    CeedVectorCreate(ceed, ndof, &U);
+    CeedVectorSetArray(U, CEED_MEM_HOST, CEED_USE_POINTER, up);
+    CeedVectorCreate(ceed, nelem*elemsize, &E);
+    CeedElemRestrictionApply(r, CEED_NOTRANSPOSE, CEED_NOTRANSPOSE, U, E,
+                             CEED_REQUEST_IMMEDIATE);
+    CeedVectorGetArrayRead(E, CEED_MEM_HOST, &ee);
+    for (CeedInt e=0; e<nelem; e++)
+      for (CeedInt k=0; k<elemsize; k++)
+        if (ee[e*elemsize+k] != u[sind[eperm[e]*elemsize+k]])
+          printf("morton %d element %d [%d] %f != %f\n", morton, e, k,
+                 (double)ee[e*elemsize+k],
+                 (double)u[sind[eperm[e]*elemsize+k]]);
+    CeedVectorRestoreArrayRead(E, &ee);
+
+    CeedVectorDestroy(&U);
+    CeedVectorDestroy(&E);
+    CeedElemRestrictionDestroy(&r);
+  }
+
+  CeedDestroy(&ceed);
+  return 0;
+}
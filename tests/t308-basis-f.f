@@ -0,0 +1,86 @@
+c-----------------------------------------------------------------------
+      program test
+
+      include 'ceedf.h'
+
+      integer ceed,err
+      integer u,v,ue,ve
+      integer b
+      integer dimn,ncomp,p,q,nelem,pdim,qdim
+      parameter(dimn=2)
+      parameter(ncomp=2)
+      parameter(p=3)
+      parameter(q=4)
+      parameter(nelem=3)
+      parameter(pdim=p**dimn)
+      parameter(qdim=q**dimn)
+      integer i,e,m,emode,vsize
+
+      real*8 uu(nelem*ncomp*pdim)
+      real*8 uue(ncomp*pdim)
+      real*8 vv(nelem*ncomp*qdim*dimn)
+      real*8 vve(ncomp*qdim*dimn)
+      integer*8 voffset,veoffset
+
+      character arg*32
+
+      call getarg(1,arg)
+      call ceedinit(trim(arg)//char(0),ceed,err)
+
+c     u has shape [ncomp, P^dim, nelem]
+      do i=0,ncomp*pdim-1
+        do e=0,nelem-1
+          uu(i*nelem+e+1)=sin(i+0.7d0*e)
+        enddo
+      enddo
+
+      call ceedvectorcreate(ceed,nelem*ncomp*pdim,u,err)
+      call ceedvectorsetarray(u,ceed_mem_host,ceed_use_pointer,uu,err)
+      call ceedvectorcreate(ceed,nelem*ncomp*qdim*dimn,v,err)
+      call ceedvectorcreate(ceed,ncomp*pdim,ue,err)
+      call ceedvectorsetarray(ue,ceed_mem_host,ceed_use_pointer,uue,err)
+      call ceedvectorcreate(ceed,ncomp*qdim*dimn,ve,err)
+
+      call ceedbasiscreatetensorh1lagrange(ceed,dimn,ncomp,p,q,
+     $  ceed_gauss,b,err)
+
+      do m=0,1
+        if (m.eq.0) then
+          emode=ceed_eval_interp
+          vsize=ncomp*qdim
+        else
+          emode=ceed_eval_grad
+          vsize=ncomp*qdim*dimn
+        endif
+
+        call ceedbasisapply(b,nelem,ceed_notranspose,emode,u,v,err)
+
+c       Compare each element with a single element apply
+        call ceedvectorgetarrayread(v,ceed_mem_host,vv,voffset,err)
+        do e=0,nelem-1
+          do i=0,ncomp*pdim-1
+            uue(i+1)=uu(i*nelem+e+1)
+          enddo
+          call ceedbasisapply(b,1,ceed_notranspose,emode,ue,ve,err)
+          call ceedvectorgetarrayread(ve,ceed_mem_host,vve,veoffset,err)
+          do i=0,vsize-1
+            if (abs(vv(i*nelem+e+1+voffset)-vve(i+1+veoffset))
+     $        > 1.0d-14) then
+              write(*,*) 'element ',e,' [',i,'] ',
+     $          vv(i*nelem+e+1+voffset),' != ',vve(i+1+veoffset)
+            endif
+          enddo
+          call ceedvectorrestorearrayread(ve,vve,veoffset,err)
+        enddo
+        call ceedvectorrestorearrayread(v,vv,voffset,err)
+      enddo
+
+      call ceedvectordestroy(u,err)
+      call ceedvectordestroy(v,err)
+      call ceedvectordestroy(ue,err)
+      call ceedvectordestroy(ve,err)
+      call ceedbasisdestroy(b,err)
+      call ceeddestroy(ceed,err)
+
+      end
+c-----------------------------------------------------------------------
@@ -0,0 +1,61 @@
+/// @file
+/// Test interpolation and gradient of multiple elements in a single apply
+/// \test Test interpolation and gradient of multiple elements in a single apply
+#include <ceed.h>
+#include <math.h>
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedInt dim = 2, ncomp = 2, P = 3, Q = 4, nelem = 3;
+  CeedInt Pdim = CeedIntPow(P, dim), Qdim = CeedIntPow(Q, dim);
+  CeedVector U, V, Ue, Ve;
+  CeedBasis b;
+  CeedScalar u[nelem*ncomp*Pdim], ue[ncomp*Pdim];
+  const CeedScalar *v, *ve;
+
+  CeedInit(argv[1], &ceed);
+
+  // u has shape [ncomp, P^dim, nelem]
+  for (CeedInt i=0; i<ncomp*Pdim; i++)
+    for (CeedInt e=0; e<nelem; e++)
+      u[i*nelem + e] = sin(i + 0.7*e);
+
+  CeedVectorCreate(ceed, nelem*ncomp*Pdim, &U);
+  CeedVectorSetArray(U, CEED_MEM_HOST, CEED_USE_POINTER, u);
+  CeedVectorCreate(ceed, nelem*ncomp*Qdim*dim, &V);
+  CeedVectorCreate(ceed, ncomp*Pdim, &Ue);
+  CeedVectorSetArray(Ue, CEED_MEM_HOST, CEED_USE_POINTER, ue);
+  CeedVectorCreate(ceed, ncomp*Qdim*dim, &Ve);
+
+  CeedBasisCreateTensorH1Lagrange(ceed, dim, ncomp, P, Q, CEED_GAUSS, &b);
+
+  for (CeedInt m=0; m<2; m++) {
+    CeedEvalMode emode = m ? CEED_EVAL_GRAD : CEED_EVAL_INTERP;
+    CeedInt vsize = ncomp*Qdim*(m ? dim : 1);
+
+    CeedBasisApply(b, nelem, CEED_NOTRANSPOSE, emode, U, V);
+
+    // Compare each element with a single element apply
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, &v);
+    for (CeedInt e=0; e<nelem; e++) {
+      for (CeedInt i=0; i<ncomp*Pdim; i++)
+        ue[i] = u[i*nelem + e];
+      CeedBasisApply(b, 1, CEED_NOTRANSPOSE, emode, Ue, Ve);
+      CeedVectorGetArrayRead(Ve, CEED_MEM_HOST, &ve);
+      for (CeedInt i=0; i<vsize; i++)
+        if (fabs(v[i*nelem + e] - ve[i]) > 1e-14)
+          printf("%s element %d [%d] %f != %f\n", m ? "grad" : "interp", e, i,
+                 v[i*nelem + e], ve[i]);
+      CeedVectorRestoreArrayRead(Ve, &ve);
+    }
+    CeedVectorRestoreArrayRead(V, &v);
+  }
+
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedVectorDestroy(&Ue);
+  CeedVectorDestroy(&Ve);
+  CeedBasisDestroy(&b);
+  CeedDestroy(&ceed);
+  return 0;
+}
@@ -0,0 +1,84 @@
+c-----------------------------------------------------------------------
+      program test
+
+      include 'ceedf.h'
+
+      integer ceed,err
+      integer u,v,w,x
+      integer b
+      integer p,q,nelem,maxdof,maxqpt
+      parameter(p=4)
+      parameter(q=5)
+      parameter(nelem=2)
+      parameter(maxdof=20)
+      parameter(maxqpt=125)
+      integer i,t,dimn,topo,ndof,nqpt
+
+      real*8 uu(nelem*maxdof)
+      real*8 vv(nelem*maxqpt)
+      real*8 ww(nelem*maxqpt)
+      real*8 xx(nelem*maxdof)
+      integer*8 voffset,woffset,xoffset
+
+      character arg*32
+
+      call getarg(1,arg)
+      call ceedinit(trim(arg)//char(0),ceed,err)
+
+c     The modes are orthonormal, so B^T W B is the identity
+      do t=0,1
+        dimn=t+2
+        if (t.eq.0) then
+          topo=ceed_triangle
+          ndof=p*(p+1)/2
+        else
+          topo=ceed_tet
+          ndof=p*(p+1)*(p+2)/6
+        endif
+        nqpt=q**dimn
+
+        call ceedbasiscreatesimplexdubiner(ceed,topo,1,p,q,b,err)
+
+        do i=1,nelem*ndof
+          uu(i)=sin(1.0d0*i)
+        enddo
+        call ceedvectorcreate(ceed,nelem*ndof,u,err)
+        call ceedvectorsetarray(u,ceed_mem_host,ceed_use_pointer,uu,err)
+        call ceedvectorcreate(ceed,nelem*ndof,x,err)
+        call ceedvectorcreate(ceed,nelem*nqpt,v,err)
+        call ceedvectorcreate(ceed,nelem*nqpt,w,err)
+
+        call ceedbasisapply(b,nelem,ceed_notranspose,ceed_eval_weight,
+     $    ceed_null,w,err)
+        call ceedbasisapply(b,nelem,ceed_notranspose,ceed_eval_interp,
+     $    u,v,err)
+        call ceedvectorgetarray(v,ceed_mem_host,vv,voffset,err)
+        call ceedvectorgetarrayread(w,ceed_mem_host,ww,woffset,err)
+        do i=1,nelem*nqpt
+          vv(i+voffset)=vv(i+voffset)*ww(i+woffset)
+        enddo
+        call ceedvectorrestorearrayread(w,ww,woffset,err)
+        call ceedvectorrestorearray(v,vv,voffset,err)
+        call ceedbasisapply(b,nelem,ceed_transpose,ceed_eval_interp,
+     $    v,x,err)
+
+        call ceedvectorgetarrayread(x,ceed_mem_host,xx,xoffset,err)
+        do i=1,nelem*ndof
+          if (abs(xx(i+xoffset)-uu(i)) > 1.0d-12) then
+            write(*,*) 'dim ',dimn,' [',i,'] ',xx(i+xoffset),
+     $        ' != ',uu(i)
+          endif
+        enddo
+        call ceedvectorrestorearrayread(x,xx,xoffset,err)
+
+        call ceedvectordestroy(u,err)
+        call ceedvectordestroy(v,err)
+        call ceedvectordestroy(w,err)
+        call ceedvectordestroy(x,err)
+        call ceedbasisdestroy(b,err)
+      enddo
+
+      call ceeddestroy(ceed,err)
+
+      end
+c-----------------------------------------------------------------------
@@ -0,0 +1,98 @@
+/// @file
+/// Test Dubiner simplex bases applied in collapsed coordinates
+/// \test Test Dubiner simplex bases applied in collapsed coordinates
+#include <ceed.h>
+#include <ceed-backend.h>
+#include <math.h>
+
+// Cubic test function and its gradient on the unit simplex
+static CeedScalar feval(CeedInt dim, const CeedScalar *x, CeedScalar *df) {
+  const CeedScalar z = dim == 3 ? x[2] : 0;
+  df[0] = 2 + x[1] + 3*x[0]*x[0];
+  df[1] = -1 + x[0] + 2*z;
+  df[2] = 2*x[1] - 1;
+  return 1 + 2*x[0] - x[1] + x[0]*x[1] + x[0]*x[0]*x[0] + 2*x[1]*z - z;
+}
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  const CeedElemTopology topos[2] = {CEED_TRIANGLE, CEED_TET};
+  const CeedInt nelem = 2;
+
+  CeedInit(argv[1], &ceed);
+
+  for (CeedInt t=0; t<2; t++) {
+    CeedInt dim = t+2, P = 4, Q = 5, ndof, nqpt;
+    CeedBasis b, bdense;
+    CeedVector U, V, W, X;
+    CeedScalar *v;
+    const CeedScalar *qref, *interp, *grad, *qweight, *w, *x;
+
+    CeedBasisCreateSimplexDubiner(ceed, topos[t], 1, P, Q, &b);
+    CeedBasisGetNumNodes(b, &ndof);
+    CeedBasisGetNumQuadraturePoints(b, &nqpt);
+    CeedBasisGetQRef(b, &qref);
+    CeedBasisGetQWeights(b, &qweight);
+    CeedBasisGetInterp(b, &interp);
+    CeedBasisGetGrad(b, &grad);
+    CeedBasisCreateH1(ceed, topos[t], 1, ndof, nqpt, interp, grad, qref,
+                      qweight, &bdense);
+
+    CeedVectorCreate(ceed, nelem*ndof, &U);
+    CeedVectorCreate(ceed, nelem*ndof, &X);
+    CeedVectorCreate(ceed, nelem*dim*nqpt, &V);
+    CeedVectorCreate(ceed, nelem*nqpt, &W);
+    CeedBasisApply(b, nelem, CEED_NOTRANSPOSE, CEED_EVAL_WEIGHT, NULL, W);
+
+    // Project the test function, the modes are orthonormal
+    CeedVectorGetArray(V, CEED_MEM_HOST, &v);
+    CeedVectorGetArrayRead(W, CEED_MEM_HOST, &w);
+    for (CeedInt q=0; q<nqpt; q++)
+      for (CeedInt e=0; e<nelem; e++) {
+        CeedScalar xq[3], df[3];
+        for (CeedInt d=0; d<dim; d++)
+          xq[d] = qref[d*nqpt+q];
+        v[q*nelem+e] = (e+1)*feval(dim, xq, df)*w[q*nelem+e];
+      }
+    CeedVectorRestoreArray(V, &v);
+    CeedBasisApply(b, nelem, CEED_TRANSPOSE, CEED_EVAL_INTERP, V, U);
+
+    // Gradient of the projection
+    CeedBasisApply(b, nelem, CEED_NOTRANSPOSE, CEED_EVAL_GRAD, U, V);
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, (const CeedScalar **)&v);
+    for (CeedInt q=0; q<nqpt; q++)
+      for (CeedInt e=0; e<nelem; e++) {
+        CeedScalar xq[3], df[3];
+        for (CeedInt d=0; d<dim; d++)
+          xq[d] = qref[d*nqpt+q];
+        feval(dim, xq, df);
+        for (CeedInt d=0; d<dim; d++)
+          if (fabs(v[(d*nqpt+q)*nelem+e] - (e+1)*df[d]) > 1e-10)
+            printf("dim %d grad %d [%d] %f != %f\n", dim, d, q,
+                   v[(d*nqpt+q)*nelem+e], (e+1)*df[d]);
+      }
+    CeedVectorRestoreArrayRead(V, (const CeedScalar **)&v);
+
+    // Transpose gradient against the dense basis
+    CeedBasisApply(b, nelem, CEED_TRANSPOSE, CEED_EVAL_GRAD, V, U);
+    CeedBasisApply(bdense, nelem, CEED_TRANSPOSE, CEED_EVAL_GRAD, V, X);
+    CeedVectorGetArrayRead(U, CEED_MEM_HOST, (const CeedScalar **)&v);
+    CeedVectorGetArrayRead(X, CEED_MEM_HOST, &x);
+    for (CeedInt i=0; i<nelem*ndof; i++)
+      if (fabs(v[i] - x[i]) > 1e-10)
+        printf("dim %d grad^T [%d] %f != %f\n", dim, i, v[i], x[i]);
+    CeedVectorRestoreArrayRead(U, (const CeedScalar **)&v);
+    CeedVectorRestoreArrayRead(X, &x);
+
+    CeedVectorRestoreArrayRead(W, &w);
+    CeedVectorDestroy(&U);
+    CeedVectorDestroy(&X);
+    CeedVectorDestroy(&V);
+    CeedVectorDestroy(&W);
+    CeedBasisDestroy(&b);
+    CeedBasisDestroy(&bdense);
+  }
+
+  CeedDestroy(&ceed);
+  return 0;
+}
@@ -0,0 +1,76 @@
+c-----------------------------------------------------------------------
+      program test
+
+      include 'ceedf.h'
+
+      integer ceed,err
+      integer u,v,vi,vg
+      integer b
+      integer i
+      integer dimn,p,q,nelem
+      parameter(dimn=2)
+      parameter(p=4)
+      parameter(q=5)
+      parameter(nelem=3)
+      integer psize,qsize
+      parameter(psize=nelem*p**dimn)
+      parameter(qsize=nelem*q**dimn)
+
+      real*8 uu(psize)
+      real*8 vv(qsize*(dimn+1))
+      real*8 vvi(qsize)
+      real*8 vvg(qsize*dimn)
+      integer*8 offset,ioffset,goffset
+
+      character arg*32
+
+      call getarg(1,arg)
+      call ceedinit(trim(arg)//char(0),ceed,err)
+
+      do i=1,psize
+        uu(i)=sin(1.d0*i)
+      enddo
+
+      call ceedvectorcreate(ceed,psize,u,err)
+      call ceedvectorsetarray(u,ceed_mem_host,ceed_use_pointer,uu,err)
+      call ceedvectorcreate(ceed,qsize*(dimn+1),v,err)
+      call ceedvectorcreate(ceed,qsize,vi,err)
+      call ceedvectorcreate(ceed,qsize*dimn,vg,err)
+
+      call ceedbasiscreatetensorh1lagrange(ceed,dimn,1,p,q,
+     $  ceed_gauss,b,err)
+
+c     Values followed by gradients
+      call ceedbasisapply(b,nelem,ceed_notranspose,
+     $  ceed_eval_interp+ceed_eval_grad,u,v,err)
+      call ceedbasisapply(b,nelem,ceed_notranspose,ceed_eval_interp,
+     $  u,vi,err)
+      call ceedbasisapply(b,nelem,ceed_notranspose,ceed_eval_grad,
+     $  u,vg,err)
+
+      call ceedvectorgetarrayread(v,ceed_mem_host,vv,offset,err)
+      call ceedvectorgetarrayread(vi,ceed_mem_host,vvi,ioffset,err)
+      call ceedvectorgetarrayread(vg,ceed_mem_host,vvg,goffset,err)
+      do i=1,qsize
+        if(dabs(vv(i+offset)-vvi(i+ioffset)) > 1.0D-12) then
+          write(*,*) 'interp ',i,vv(i+offset),' != ',vvi(i+ioffset)
+        endif
+      enddo
+      do i=1,qsize*dimn
+        if(dabs(vv(qsize+i+offset)-vvg(i+goffset)) > 1.0D-12) then
+          write(*,*) 'grad ',i,vv(qsize+i+offset),' != ',
+     $      vvg(i+goffset)
+        endif
+      enddo
+      call ceedvectorrestorearrayread(v,vv,offset,err)
+      call ceedvectorrestorearrayread(vi,vvi,ioffset,err)
+      call ceedvectorrestorearrayread(vg,vvg,goffset,err)
+
+      call ceedvectordestroy(u,err)
+      call ceedvectordestroy(v,err)
+      call ceedvectordestroy(vi,err)
+      call ceedvectordestroy(vg,err)
+      call ceedbasisdestroy(b,err)
+      call ceeddestroy(ceed,err)
+      end
+c-----------------------------------------------------------------------
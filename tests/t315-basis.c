@@ -0,0 +1,107 @@
+/// @file
+/// Test fused interpolation and gradient with tensor and non-tensor H1 bases
+/// \test Test fused interpolation and gradient with tensor and non-tensor H1 bases
+#include <ceed.h>
+#include <ceed-backend.h>
+#include <math.h>
+#include "t310-basis.h"
+
+// Checks that CEED_EVAL_INTERP|CEED_EVAL_GRAD matches the separate modes, in
+// both directions
+static int checkfused(Ceed ceed, CeedBasis b, CeedInt nelem) {
+  CeedVector U, G, V, W;
+  CeedInt dim, ncomp, P, Q;
+  const CeedScalar *v, *w;
+  int nerr = 0;
+
+  CeedBasisGetDimension(b, &dim);
+  CeedBasisGetNumComponents(b, &ncomp);
+  CeedBasisGetNumNodes(b, &P);
+  CeedBasisGetNumQuadraturePoints(b, &Q);
+  const CeedInt psize = nelem*ncomp*P, qsize = nelem*ncomp*Q;
+  CeedScalar u[qsize*(1+dim)];
+
+  CeedVectorCreate(ceed, qsize*(1+dim), &U);
+  CeedVectorCreate(ceed, qsize*dim, &G);
+  CeedVectorCreate(ceed, qsize*(1+dim), &V);
+  CeedVectorCreate(ceed, qsize*(1+dim), &W);
+
+  // Nodes to quadrature points
+  for (CeedInt i=0; i<psize; i++)
+    u[i] = sin(i + 1.);
+  CeedVectorSetArray(U, CEED_MEM_HOST, CEED_COPY_VALUES, u);
+  CeedBasisApply(b, nelem, CEED_NOTRANSPOSE, CEED_EVAL_INTERP|CEED_EVAL_GRAD,
+                 U, V);
+  CeedBasisApply(b, nelem, CEED_NOTRANSPOSE, CEED_EVAL_INTERP, U, W);
+  CeedVectorGetArrayRead(V, CEED_MEM_HOST, &v);
+  CeedVectorGetArrayRead(W, CEED_MEM_HOST, &w);
+  for (CeedInt i=0; i<qsize; i++)
+    if (fabs(v[i] - w[i]) > 1e-12)
+      printf("interp [%d] %f != %f\n", i, v[i], w[i]), nerr++;
+  CeedVectorRestoreArrayRead(W, &w);
+  CeedBasisApply(b, nelem, CEED_NOTRANSPOSE, CEED_EVAL_GRAD, U, W);
+  CeedVectorGetArrayRead(W, CEED_MEM_HOST, &w);
+  for (CeedInt i=0; i<dim*qsize; i++)
+    if (fabs(v[qsize+i] - w[i]) > 1e-12)
+      printf("grad [%d] %f != %f\n", i, v[qsize+i], w[i]), nerr++;
+  CeedVectorRestoreArrayRead(W, &w);
+  CeedVectorRestoreArrayRead(V, &v);
+
+  // Quadrature points to nodes, the sum of the separate transposes
+  for (CeedInt i=0; i<qsize*(1+dim); i++)
+    u[i] = cos(i + 1.);
+  CeedVectorSetArray(U, CEED_MEM_HOST, CEED_COPY_VALUES, u);
+  CeedBasisApply(b, nelem, CEED_TRANSPOSE, CEED_EVAL_INTERP|CEED_EVAL_GRAD,
+                 U, V);
+  CeedVectorGetArrayRead(V, CEED_MEM_HOST, &v);
+  CeedScalar sum[psize];
+  CeedBasisApply(b, nelem, CEED_TRANSPOSE, CEED_EVAL_INTERP, U, W);
+  CeedVectorGetArrayRead(W, CEED_MEM_HOST, &w);
+  for (CeedInt i=0; i<psize; i++)
+    sum[i] = w[i];
+  CeedVectorRestoreArrayRead(W, &w);
+  CeedVectorSetArray(G, CEED_MEM_HOST, CEED_COPY_VALUES, u + qsize);
+  CeedBasisApply(b, nelem, CEED_TRANSPOSE, CEED_EVAL_GRAD, G, W);
+  CeedVectorGetArrayRead(W, CEED_MEM_HOST, &w);
+  for (CeedInt i=0; i<psize; i++)
+    if (fabs(v[i] - sum[i] - w[i]) > 1e-12)
+      printf("transpose [%d] %f != %f\n", i, v[i], sum[i] + w[i]), nerr++;
+  CeedVectorRestoreArrayRead(W, &w);
+  CeedVectorRestoreArrayRead(V, &v);
+
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&G);
+  CeedVectorDestroy(&V);
+  CeedVectorDestroy(&W);
+  return nerr;
+}
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedBasis b;
+  const CeedInt P = 6, Q = 4, dim = 2;
+  CeedScalar qref[dim*Q], qweight[Q];
+  CeedScalar interp[P*Q], grad[dim*P*Q];
+
+  CeedInit(argv[1], &ceed);
+
+  // Tensor bases, with and without symmetric 1D matrices
+  for (CeedInt d=1; d<=3; d++) {
+    CeedBasisCreateTensorH1Lagrange(ceed, d, 2, 4, 5, CEED_GAUSS, &b);
+    checkfused(ceed, b, 3);
+    CeedBasisDestroy(&b);
+    CeedBasisCreateTensorH1Lagrange(ceed, d, 1, 3, 5, CEED_GAUSS_LOBATTO, &b);
+    checkfused(ceed, b, 8);
+    CeedBasisDestroy(&b);
+  }
+
+  // Non-tensor basis
+  buildmats(qref, qweight, interp, grad);
+  CeedBasisCreateH1(ceed, CEED_TRIANGLE, 2, P, Q, interp, grad, qref, qweight,
+                    &b);
+  checkfused(ceed, b, 5);
+  CeedBasisDestroy(&b);
+
+  CeedDestroy(&ceed);
+  return 0;
+}
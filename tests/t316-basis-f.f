@@ -0,0 +1,43 @@
+c-----------------------------------------------------------------------
+      program test
+
+      include 'ceedf.h'
+
+      integer ceed,ceed2,err
+      integer b1,b2
+      integer i
+      integer p,q
+      parameter(p=4)
+      parameter(q=6)
+
+      real*8 colograd1(q*q)
+      real*8 colograd2(q*q)
+
+      character arg*32
+
+      call getarg(1,arg)
+      call ceedinit(trim(arg)//char(0),ceed,err)
+      call ceedinit(trim(arg)//char(0),ceed2,err)
+
+c     Same 1D tables computed in two contexts
+      call ceedbasiscreatetensorh1lagrange(ceed,1,1,p,q,ceed_gauss,
+     $  b1,err)
+      call ceedbasiscreatetensorh1lagrange(ceed2,3,2,p,q,ceed_gauss,
+     $  b2,err)
+
+      call ceedbasisgetcollocatedgrad(b1,colograd1,err)
+      call ceedbasisdestroy(b1,err)
+      call ceedbasisgetcollocatedgrad(b2,colograd2,err)
+
+      do i=1,q*q
+        if (colograd1(i).ne.colograd2(i)) then
+          write(*,*) 'Collocated grad ',i,colograd1(i),' != ',
+     $      colograd2(i)
+        endif
+      enddo
+
+      call ceedbasisdestroy(b2,err)
+      call ceeddestroy(ceed,err)
+      call ceeddestroy(ceed2,err)
+      end
+c-----------------------------------------------------------------------
@@ -0,0 +1,62 @@
+/// @file
+/// Test sharing of the 1D tables of tensor product Lagrange bases
+/// \test Test sharing of the 1D tables of tensor product Lagrange bases
+#include <ceed.h>
+#include <ceed-backend.h>
+#include <math.h>
+
+int main(int argc, char **argv) {
+  Ceed ceed, ceed2;
+  CeedBasis b1, b2, b3, b4;
+  CeedVector U, V;
+  const CeedInt P = 4, Q = 6;
+  const CeedScalar *interp1, *interp2, *interp3, *interp4;
+  CeedScalar colograd1[Q*Q], colograd2[Q*Q];
+  const CeedScalar *v;
+
+  CeedInit(argv[1], &ceed);
+  CeedInit(argv[1], &ceed2);
+
+  // Same 1D tables in one context, different ones for another qmode or
+  // another context
+  CeedBasisCreateTensorH1Lagrange(ceed, 1, 1, P, Q, CEED_GAUSS, &b1);
+  CeedBasisCreateTensorH1Lagrange(ceed, 3, 2, P, Q, CEED_GAUSS, &b2);
+  CeedBasisCreateTensorH1Lagrange(ceed, 1, 1, P, Q, CEED_GAUSS_LOBATTO, &b3);
+  CeedBasisCreateTensorH1Lagrange(ceed2, 1, 1, P, Q, CEED_GAUSS, &b4);
+  CeedBasisGetInterp(b1, &interp1);
+  CeedBasisGetInterp(b2, &interp2);
+  CeedBasisGetInterp(b3, &interp3);
+  CeedBasisGetInterp(b4, &interp4);
+  if (interp1 != interp2)
+    printf("Bases with the same tables do not share them\n");
+  if (interp1 == interp3)
+    printf("Bases with different quadratures share their tables\n");
+  if (interp1 == interp4)
+    printf("Bases from different contexts share their tables\n");
+  CeedBasisGetCollocatedGrad(b1, colograd1);
+  CeedBasisGetCollocatedGrad(b4, colograd2);
+  for (CeedInt i=0; i<Q*Q; i++)
+    if (colograd1[i] != colograd2[i])
+      printf("[%d] Collocated grad %f != %f\n", i, colograd1[i], colograd2[i]);
+
+  // The tables outlive the first basis using them
+  CeedBasisDestroy(&b1);
+  CeedVectorCreate(ceed, 2*P*P*P, &U);
+  CeedVectorCreate(ceed, 2*Q*Q*Q, &V);
+  CeedVectorSetValue(U, 1.0);
+  CeedBasisApply(b2, 1, CEED_NOTRANSPOSE, CEED_EVAL_INTERP, U, V);
+  CeedVectorGetArrayRead(V, CEED_MEM_HOST, &v);
+  for (CeedInt i=0; i<2*Q*Q*Q; i++)
+    if (fabs(v[i] - 1.) > 1e-14)
+      printf("[%d] %f != 1\n", i, v[i]);
+  CeedVectorRestoreArrayRead(V, &v);
+
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedBasisDestroy(&b2);
+  CeedBasisDestroy(&b3);
+  CeedBasisDestroy(&b4);
+  CeedDestroy(&ceed);
+  CeedDestroy(&ceed2);
+  return 0;
+}
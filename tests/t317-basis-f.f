@@ -0,0 +1,95 @@
+c-----------------------------------------------------------------------
+      real*8 function fx(x)
+      real*8 x
+      fx=1+x+x**3
+      end
+c-----------------------------------------------------------------------
+      real*8 function dfx(x)
+      real*8 x
+      dfx=1+3*x**2
+      end
+c-----------------------------------------------------------------------
+      program test
+
+      include 'ceedf.h'
+
+      integer ceed,err
+      integer x,u,v
+      integer b
+      integer i,j,e,p
+      integer dimn,pp,q,nelem,npts
+      parameter(dimn=2)
+      parameter(pp=4)
+      parameter(q=5)
+      parameter(nelem=3)
+      parameter(npts=6)
+      integer psize,qsize,xsize
+      parameter(psize=nelem*pp**dimn)
+      parameter(qsize=nelem*npts)
+      parameter(xsize=nelem*npts*dimn)
+
+      real*8 nodes(pp),weights(pp)
+      real*8 xx(xsize)
+      real*8 uu(psize)
+      real*8 vv(qsize*(dimn+1))
+      real*8 x1,x2,f(3)
+      real*8 fx,dfx
+      integer*8 offset
+
+      character arg*32
+
+      call getarg(1,arg)
+      call ceedinit(trim(arg)//char(0),ceed,err)
+
+c     Nodal values of a cubic and pseudo-random points
+      call ceedlobattoquadrature(pp,nodes,weights,err)
+      do e=0,nelem-1
+        do j=0,pp-1
+          do i=0,pp-1
+            uu((i+pp*j)*nelem+e+1)=fx(nodes(i+1))*fx(nodes(j+1))
+          enddo
+        enddo
+      enddo
+      do i=1,xsize
+        xx(i)=sin(3.d0*i)
+      enddo
+
+      call ceedvectorcreate(ceed,xsize,x,err)
+      call ceedvectorsetarray(x,ceed_mem_host,ceed_use_pointer,xx,err)
+      call ceedvectorcreate(ceed,psize,u,err)
+      call ceedvectorsetarray(u,ceed_mem_host,ceed_use_pointer,uu,err)
+      call ceedvectorcreate(ceed,qsize*(dimn+1),v,err)
+
+      call ceedbasiscreatetensorh1lagrange(ceed,dimn,1,pp,q,
+     $  ceed_gauss,b,err)
+
+c     Values followed by the gradient
+      call ceedbasisapplyatpoints(b,nelem,npts,ceed_notranspose,
+     $  ceed_eval_interp+ceed_eval_grad,x,u,v,err)
+
+      call ceedvectorgetarrayread(v,ceed_mem_host,vv,offset,err)
+      do e=0,nelem-1
+        do p=0,npts-1
+          x1=xx(p*nelem+e+1)
+          x2=xx((npts+p)*nelem+e+1)
+          f(1)=fx(x1)*fx(x2)
+          f(2)=dfx(x1)*fx(x2)
+          f(3)=fx(x1)*dfx(x2)
+          do i=0,dimn
+            if(dabs(vv((i*npts+p)*nelem+e+1+offset)-f(i+1))
+     $        > 1.0D-11) then
+              write(*,*) 'output ',i,e,p,
+     $          vv((i*npts+p)*nelem+e+1+offset),' != ',f(i+1)
+            endif
+          enddo
+        enddo
+      enddo
+      call ceedvectorrestorearrayread(v,vv,offset,err)
+
+      call ceedvectordestroy(x,err)
+      call ceedvectordestroy(u,err)
+      call ceedvectordestroy(v,err)
+      call ceedbasisdestroy(b,err)
+      call ceeddestroy(ceed,err)
+      end
+c-----------------------------------------------------------------------
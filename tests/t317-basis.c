@@ -0,0 +1,117 @@
+/// @file
+/// Test evaluation of tensor H1 bases at arbitrary points
+/// \test Test evaluation of tensor H1 bases at arbitrary points
+#include <ceed.h>
+#include <math.h>
+
+// A polynomial of degree 3 in each coordinate, and its derivatives
+static CeedScalar eval(CeedInt dim, CeedInt comp, const CeedScalar *x,
+                       CeedInt deriv) {
+  CeedScalar f = 1;
+  for (CeedInt d=0; d<dim; d++) {
+    const CeedScalar xd = x[d];
+    f *= deriv == d ? 1 + 3*(comp+d+1)*xd*xd
+         : 1 + comp + xd + (comp+d+1)*xd*xd*xd;
+  }
+  return f;
+}
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  const CeedInt P = 4, Q = 5, ncomp = 2, nelem = 3, npoints = 7;
+
+  CeedInit(argv[1], &ceed);
+
+  CeedScalar nodes[P];
+  CeedLobattoQuadrature(P, nodes, NULL);
+  for (CeedInt dim=1; dim<=3; dim++) {
+    CeedBasis b;
+    CeedVector X, U, V, W;
+    const CeedInt ndof = CeedIntPow(P, dim), psize = nelem*ncomp*ndof,
+                  qsize = nelem*ncomp*npoints, xsize = nelem*dim*npoints;
+    CeedScalar x[xsize], u[psize], w[qsize*(1+dim)];
+    const CeedScalar *v;
+
+    // Nodal values of the polynomial and pseudo-random points
+    for (CeedInt e=0; e<nelem; e++)
+      for (CeedInt comp=0; comp<ncomp; comp++)
+        for (CeedInt i=0; i<ndof; i++) {
+          CeedScalar xi[dim];
+          for (CeedInt d=0, k=i; d<dim; d++, k/=P)
+            xi[d] = nodes[k%P];
+          u[(comp*ndof+i)*nelem+e] = eval(dim, comp, xi, -1);
+        }
+    for (CeedInt i=0; i<xsize; i++)
+      x[i] = sin(3.*i + dim);
+
+    CeedBasisCreateTensorH1Lagrange(ceed, dim, ncomp, P, Q, CEED_GAUSS, &b);
+    CeedVectorCreate(ceed, xsize, &X);
+    CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+    CeedVectorCreate(ceed, psize, &U);
+    CeedVectorSetArray(U, CEED_MEM_HOST, CEED_USE_POINTER, u);
+    CeedVectorCreate(ceed, qsize*(1+dim), &V);
+    CeedVectorCreate(ceed, psize, &W);
+
+    // Values followed by the gradient, exact for the polynomial
+    CeedBasisApplyAtPoints(b, nelem, npoints, CEED_NOTRANSPOSE,
+                           CEED_EVAL_INTERP|CEED_EVAL_GRAD, X, U, V);
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, &v);
+    for (CeedInt e=0; e<nelem; e++)
+      for (CeedInt p=0; p<npoints; p++) {
+        CeedScalar xp[dim];
+        for (CeedInt d=0; d<dim; d++)
+          xp[d] = x[(d*npoints+p)*nelem+e];
+        for (CeedInt o=0; o<=dim; o++)
+          for (CeedInt comp=0; comp<ncomp; comp++) {
+            const CeedScalar f = eval(dim, comp, xp, o-1),
+                             vi = v[((o*ncomp+comp)*npoints+p)*nelem+e];
+            if (fabs(vi - f) > 1e-11)
+              printf("dim %d output %d [%d,%d,%d] %f != %f\n", dim, o, e, comp,
+                     p, vi, f);
+          }
+      }
+    CeedVectorRestoreArrayRead(V, &v);
+
+    // The gradient alone
+    CeedVector G;
+    const CeedScalar *g;
+    CeedVectorCreate(ceed, qsize*dim, &G);
+    CeedBasisApplyAtPoints(b, nelem, npoints, CEED_NOTRANSPOSE, CEED_EVAL_GRAD,
+                           X, U, G);
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, &v);
+    CeedVectorGetArrayRead(G, CEED_MEM_HOST, &g);
+    for (CeedInt i=0; i<qsize*dim; i++)
+      if (fabs(g[i] - v[qsize+i]) > 1e-14)
+        printf("dim %d grad [%d] %f != %f\n", dim, i, g[i], v[qsize+i]);
+    CeedVectorRestoreArrayRead(G, &g);
+    CeedVectorRestoreArrayRead(V, &v);
+    CeedVectorDestroy(&G);
+
+    // The transpose is the adjoint, <v, Bu> = <B^T v, u>
+    CeedScalar vBu = 0, Btvu = 0;
+    for (CeedInt i=0; i<qsize*(1+dim); i++)
+      w[i] = cos(i + 1.);
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, &v);
+    for (CeedInt i=0; i<qsize*(1+dim); i++)
+      vBu += w[i]*v[i];
+    CeedVectorRestoreArrayRead(V, &v);
+    CeedVectorSetArray(V, CEED_MEM_HOST, CEED_COPY_VALUES, w);
+    CeedBasisApplyAtPoints(b, nelem, npoints, CEED_TRANSPOSE,
+                           CEED_EVAL_INTERP|CEED_EVAL_GRAD, X, V, W);
+    CeedVectorGetArrayRead(W, CEED_MEM_HOST, &v);
+    for (CeedInt i=0; i<psize; i++)
+      Btvu += v[i]*u[i];
+    CeedVectorRestoreArrayRead(W, &v);
+    if (fabs(vBu - Btvu) > 1e-10*fabs(vBu))
+      printf("dim %d transpose %f != %f\n", dim, Btvu, vBu);
+
+    CeedVectorDestroy(&X);
+    CeedVectorDestroy(&U);
+    CeedVectorDestroy(&V);
+    CeedVectorDestroy(&W);
+    CeedBasisDestroy(&b);
+  }
+
+  CeedDestroy(&ceed);
+  return 0;
+}
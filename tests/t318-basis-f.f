@@ -0,0 +1,100 @@
+c-----------------------------------------------------------------------
+      real*8 function fx(x)
+      real*8 x
+      fx=1+x+x**3
+      end
+c-----------------------------------------------------------------------
+      real*8 function fy(x)
+      real*8 x
+      fy=2-x
+      end
+c-----------------------------------------------------------------------
+      program test
+
+      include 'ceedf.h'
+
+      integer ceed,err
+      integer u,v,w
+      integer b
+      integer i,j,e
+      integer dimn,nelem
+      parameter(dimn=2)
+      parameter(nelem=2)
+      integer p(dimn),q(dimn)
+      integer psize,qsize
+      parameter(psize=nelem*4*2)
+      parameter(qsize=nelem*5*3)
+
+      real*8 nodesx(4),nodesy(2)
+      real*8 qrefx(5),qrefy(3),qweight(5)
+      real*8 uu(psize)
+      real*8 vv(qsize)
+      real*8 f,summ
+      real*8 fx,fy
+      integer*8 offset
+
+      character arg*32
+
+      data p/4,2/
+      data q/5,3/
+
+      call getarg(1,arg)
+      call ceedinit(trim(arg)//char(0),ceed,err)
+
+c     Nodal values of a cubic in x and a line in y
+      call ceedlobattoquadrature(p(1),nodesx,qweight,err)
+      call ceedlobattoquadrature(p(2),nodesy,qweight,err)
+      call ceedgaussquadrature(q(1),qrefx,qweight,err)
+      call ceedgaussquadrature(q(2),qrefy,qweight,err)
+      do e=0,nelem-1
+        do j=0,p(2)-1
+          do i=0,p(1)-1
+            uu((i+p(1)*j)*nelem+e+1)=fx(nodesx(i+1))*fy(nodesy(j+1))
+          enddo
+        enddo
+      enddo
+
+      call ceedvectorcreate(ceed,psize,u,err)
+      call ceedvectorsetarray(u,ceed_mem_host,ceed_use_pointer,uu,err)
+      call ceedvectorcreate(ceed,qsize,v,err)
+      call ceedvectorcreate(ceed,qsize,w,err)
+
+      call ceedbasiscreatetensorh1lagrangeanisotropic(ceed,dimn,1,p,q,
+     $  ceed_gauss,b,err)
+
+      call ceedbasisapply(b,nelem,ceed_notranspose,ceed_eval_interp,
+     $  u,v,err)
+      call ceedbasisapply(b,nelem,ceed_notranspose,ceed_eval_weight,
+     $  ceed_null,w,err)
+
+      call ceedvectorgetarrayread(v,ceed_mem_host,vv,offset,err)
+      do e=0,nelem-1
+        do j=0,q(2)-1
+          do i=0,q(1)-1
+            f=fx(qrefx(i+1))*fy(qrefy(j+1))
+            if(dabs(vv((i+q(1)*j)*nelem+e+1+offset)-f) > 1.0D-13) then
+              write(*,*) 'interp ',e,i,j,
+     $          vv((i+q(1)*j)*nelem+e+1+offset),' != ',f
+            endif
+          enddo
+        enddo
+      enddo
+      call ceedvectorrestorearrayread(v,vv,offset,err)
+
+      call ceedvectorgetarrayread(w,ceed_mem_host,vv,offset,err)
+      summ=0
+      do i=1,qsize
+        summ=summ+vv(i+offset)
+      enddo
+      if(dabs(summ-4*nelem) > 1.0D-13) then
+        write(*,*) 'volume ',summ,' != ',4*nelem
+      endif
+      call ceedvectorrestorearrayread(w,vv,offset,err)
+
+      call ceedvectordestroy(u,err)
+      call ceedvectordestroy(v,err)
+      call ceedvectordestroy(w,err)
+      call ceedbasisdestroy(b,err)
+      call ceeddestroy(ceed,err)
+      end
+c-----------------------------------------------------------------------
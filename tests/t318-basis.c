@@ -0,0 +1,135 @@
+/// @file
+/// Test anisotropic tensor H1 bases
+/// \test Test anisotropic tensor H1 bases
+#include <ceed.h>
+#include <math.h>
+
+// A polynomial of degree P[d]-1 in coordinate d, and its derivatives
+static CeedScalar eval(CeedInt dim, const CeedInt *P, CeedInt comp,
+                       const CeedScalar *x, CeedInt deriv) {
+  CeedScalar f = comp+1;
+  for (CeedInt d=0; d<dim; d++) {
+    CeedScalar fd = 0;
+    for (CeedInt i=0; i<P[d]; i++)
+      fd += deriv == d ? (i ? i*pow(x[d], i-1)/(i+d+1) : 0)
+            : pow(x[d], i)/(i+d+1);
+    f *= fd;
+  }
+  return f;
+}
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  const CeedInt P[3] = {5, 2, 3}, Q[3] = {6, 3, 4}, ncomp = 2, nelem = 3;
+
+  CeedInit(argv[1], &ceed);
+
+  for (CeedInt dim=2; dim<=3; dim++) {
+    CeedBasis b;
+    CeedVector U, V, W, X;
+    CeedInt ndof = 1, nqpt = 1;
+    for (CeedInt d=0; d<dim; d++) {
+      ndof *= P[d];
+      nqpt *= Q[d];
+    }
+    const CeedInt psize = nelem*ncomp*ndof, qsize = nelem*ncomp*nqpt;
+    CeedScalar u[psize], w[qsize*(1+dim)], nodes[dim][5], qref[dim][6],
+               qweight[6];
+    const CeedScalar *v;
+
+    // Nodal values of the polynomial
+    for (CeedInt d=0; d<dim; d++) {
+      CeedLobattoQuadrature(P[d], nodes[d], NULL);
+      CeedGaussQuadrature(Q[d], qref[d], qweight);
+    }
+    for (CeedInt e=0; e<nelem; e++)
+      for (CeedInt comp=0; comp<ncomp; comp++)
+        for (CeedInt i=0; i<ndof; i++) {
+          CeedScalar xi[dim];
+          for (CeedInt d=0, k=i; d<dim; k/=P[d], d++)
+            xi[d] = nodes[d][k%P[d]];
+          u[(comp*ndof+i)*nelem+e] = eval(dim, P, comp, xi, -1);
+        }
+
+    CeedBasisCreateTensorH1LagrangeAnisotropic(ceed, dim, ncomp, P, Q,
+        CEED_GAUSS, &b);
+    CeedVectorCreate(ceed, psize, &U);
+    CeedVectorSetArray(U, CEED_MEM_HOST, CEED_USE_POINTER, u);
+    CeedVectorCreate(ceed, qsize*(1+dim), &V);
+    CeedVectorCreate(ceed, psize, &W);
+    CeedVectorCreate(ceed, nelem*nqpt, &X);
+
+    // Values followed by the gradient, exact for the polynomial
+    CeedBasisApply(b, nelem, CEED_NOTRANSPOSE, CEED_EVAL_INTERP|CEED_EVAL_GRAD,
+                   U, V);
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, &v);
+    for (CeedInt e=0; e<nelem; e++)
+      for (CeedInt q=0; q<nqpt; q++) {
+        CeedScalar xq[dim];
+        for (CeedInt d=0, k=q; d<dim; k/=Q[d], d++)
+          xq[d] = qref[d][k%Q[d]];
+        for (CeedInt o=0; o<=dim; o++)
+          for (CeedInt comp=0; comp<ncomp; comp++) {
+            const CeedScalar f = eval(dim, P, comp, xq, o-1),
+                             vi = v[((o*ncomp+comp)*nqpt+q)*nelem+e];
+            if (fabs(vi - f) > 1e-13)
+              printf("dim %d output %d [%d,%d,%d] %f != %f\n", dim, o, e, comp,
+                     q, vi, f);
+          }
+      }
+    CeedVectorRestoreArrayRead(V, &v);
+
+    // The gradient alone
+    CeedVector G;
+    const CeedScalar *g;
+    CeedVectorCreate(ceed, qsize*dim, &G);
+    CeedBasisApply(b, nelem, CEED_NOTRANSPOSE, CEED_EVAL_GRAD, U, G);
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, &v);
+    CeedVectorGetArrayRead(G, CEED_MEM_HOST, &g);
+    for (CeedInt i=0; i<qsize*dim; i++)
+      if (fabs(g[i] - v[qsize+i]) > 1e-14)
+        printf("dim %d grad [%d] %f != %f\n", dim, i, g[i], v[qsize+i]);
+    CeedVectorRestoreArrayRead(G, &g);
+    CeedVectorRestoreArrayRead(V, &v);
+    CeedVectorDestroy(&G);
+
+    // The weights integrate 1 over [-1, 1]^dim
+    CeedBasisApply(b, nelem, CEED_NOTRANSPOSE, CEED_EVAL_WEIGHT, NULL, X);
+    CeedVectorGetArrayRead(X, CEED_MEM_HOST, &v);
+    for (CeedInt e=0; e<nelem; e++) {
+      CeedScalar sum = 0;
+      for (CeedInt q=0; q<nqpt; q++)
+        sum += v[q*nelem+e];
+      if (fabs(sum - CeedIntPow(2, dim)) > 1e-13)
+        printf("dim %d volume %f != %d\n", dim, sum, CeedIntPow(2, dim));
+    }
+    CeedVectorRestoreArrayRead(X, &v);
+
+    // The transpose is the adjoint, <v, Bu> = <B^T v, u>
+    CeedScalar vBu = 0, Btvu = 0;
+    for (CeedInt i=0; i<qsize*(1+dim); i++)
+      w[i] = cos(i + 1.);
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, &v);
+    for (CeedInt i=0; i<qsize*(1+dim); i++)
+      vBu += w[i]*v[i];
+    CeedVectorRestoreArrayRead(V, &v);
+    CeedVectorSetArray(V, CEED_MEM_HOST, CEED_COPY_VALUES, w);
+    CeedBasisApply(b, nelem, CEED_TRANSPOSE, CEED_EVAL_INTERP|CEED_EVAL_GRAD,
+                   V, W);
+    CeedVectorGetArrayRead(W, CEED_MEM_HOST, &v);
+    for (CeedInt i=0; i<psize; i++)
+      Btvu += v[i]*u[i];
+    CeedVectorRestoreArrayRead(W, &v);
+    if (fabs(vBu - Btvu) > 1e-10*fabs(vBu))
+      printf("dim %d transpose %f != %f\n", dim, Btvu, vBu);
+
+    CeedVectorDestroy(&U);
+    CeedVectorDestroy(&V);
+    CeedVectorDestroy(&W);
+    CeedVectorDestroy(&X);
+    CeedBasisDestroy(&b);
+  }
+
+  CeedDestroy(&ceed);
+  return 0;
+}
@@ -0,0 +1,83 @@
+c-----------------------------------------------------------------------
+      real*8 function fx(x)
+      real*8 x
+      fx=2+x+x**3
+      end
+c-----------------------------------------------------------------------
+      program test
+
+      include 'ceedf.h'
+
+      integer ceed,err
+      integer u,v
+      integer b
+      integer i,j,k,e
+      integer dimn,p,q,nelem
+      parameter(dimn=3)
+      parameter(p=16)
+      parameter(q=16)
+      parameter(nelem=9)
+      integer psize,qsize
+      parameter(psize=nelem*p*p*p)
+      parameter(qsize=nelem*q*q*q)
+
+      real*8 nodes(p),qref(q),qweight(q)
+      real*8 uu(psize)
+      real*8 vv(qsize)
+      real*8 f
+      real*8 fx
+      integer*8 offset
+
+      character arg*32
+
+      call getarg(1,arg)
+      call ceedinit(trim(arg)//char(0),ceed,err)
+
+c     Nodal values of a cubic in each direction, on enough elements that
+c     the contractions are tiled
+      call ceedlobattoquadrature(p,nodes,qweight,err)
+      call ceedgaussquadrature(q,qref,qweight,err)
+      do e=0,nelem-1
+        do k=0,p-1
+          do j=0,p-1
+            do i=0,p-1
+              uu(((k*p+j)*p+i)*nelem+e+1)=(e+1)*fx(nodes(i+1))*
+     $          fx(nodes(j+1))*fx(nodes(k+1))
+            enddo
+          enddo
+        enddo
+      enddo
+
+      call ceedvectorcreate(ceed,psize,u,err)
+      call ceedvectorsetarray(u,ceed_mem_host,ceed_use_pointer,uu,err)
+      call ceedvectorcreate(ceed,qsize,v,err)
+
+      call ceedbasiscreatetensorh1lagrange(ceed,dimn,1,p,q,ceed_gauss,
+     $  b,err)
+
+      call ceedbasisapply(b,nelem,ceed_notranspose,ceed_eval_interp,
+     $  u,v,err)
+
+      call ceedvectorgetarrayread(v,ceed_mem_host,vv,offset,err)
+      do e=0,nelem-1
+        do k=0,q-1
+          do j=0,q-1
+            do i=0,q-1
+              f=(e+1)*fx(qref(i+1))*fx(qref(j+1))*fx(qref(k+1))
+              if(dabs(vv(((k*q+j)*q+i)*nelem+e+1+offset)-f) > 1.0D-10)
+     $          then
+                write(*,*) 'interp ',e,i,j,k,
+     $            vv(((k*q+j)*q+i)*nelem+e+1+offset),' != ',f
+              endif
+            enddo
+          enddo
+        enddo
+      enddo
+      call ceedvectorrestorearrayread(v,vv,offset,err)
+
+      call ceedvectordestroy(u,err)
+      call ceedvectordestroy(v,err)
+      call ceedbasisdestroy(b,err)
+      call ceeddestroy(ceed,err)
+      end
+c-----------------------------------------------------------------------
@@ -0,0 +1,115 @@
+/// @file
+/// Test tensor H1 bases of high order on enough elements to tile contractions
+/// \test Test tensor H1 bases of high order on enough elements to tile
+///       contractions
+#include <ceed.h>
+#include <math.h>
+#include <stdlib.h>
+
+// A polynomial of low degree in each coordinate, and its derivatives
+static CeedScalar eval(CeedInt dim, const CeedScalar *x, CeedInt deriv) {
+  CeedScalar f = 1;
+  for (CeedInt d=0; d<dim; d++)
+    f *= deriv == d ? 1 + 3*(d+1)*x[d]*x[d] : 2 + x[d] + (d+1)*x[d]*x[d]*x[d];
+  return f;
+}
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  // With 9 elements, the intermediates of a 3D basis with P1d = 16 exceed the
+  // 256 KiB above which contractions are applied slab by slab.  Q1d = P1d
+  // goes through the collocated derivative, Q1d < P1d shares the first
+  // contractions of values and gradients.
+  const CeedInt dim = 3, P1d = 16, Q1ds[2] = {16, 15}, nelem = 9;
+
+  CeedInit(argv[1], &ceed);
+
+  for (CeedInt c=0; c<2; c++) {
+    const CeedInt Q1d = Q1ds[c], ndof = CeedIntPow(P1d, dim),
+                  nqpt = CeedIntPow(Q1d, dim), psize = nelem*ndof,
+                  qsize = nelem*nqpt;
+    CeedBasis b;
+    CeedVector U, V, W;
+    CeedScalar nodes[P1d], qref[Q1d], qweight[Q1d];
+    CeedScalar *u = malloc(psize*sizeof(u[0])),
+                *w = malloc(qsize*(1+dim)*sizeof(w[0]));
+    const CeedScalar *v;
+
+    // Nodal values of the polynomial
+    CeedLobattoQuadrature(P1d, nodes, NULL);
+    CeedGaussQuadrature(Q1d, qref, qweight);
+    for (CeedInt e=0; e<nelem; e++)
+      for (CeedInt i=0; i<ndof; i++) {
+        CeedScalar xi[dim];
+        for (CeedInt d=0, k=i; d<dim; k/=P1d, d++)
+          xi[d] = nodes[k%P1d];
+        u[i*nelem+e] = (e+1)*eval(dim, xi, -1);
+      }
+
+    CeedBasisCreateTensorH1Lagrange(ceed, dim, 1, P1d, Q1d, CEED_GAUSS, &b);
+    CeedVectorCreate(ceed, psize, &U);
+    CeedVectorSetArray(U, CEED_MEM_HOST, CEED_USE_POINTER, u);
+    CeedVectorCreate(ceed, qsize*(1+dim), &V);
+    CeedVectorCreate(ceed, psize, &W);
+
+    // Values followed by the gradient, exact for the polynomial
+    CeedBasisApply(b, nelem, CEED_NOTRANSPOSE, CEED_EVAL_INTERP|CEED_EVAL_GRAD,
+                   U, V);
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, &v);
+    for (CeedInt e=0; e<nelem; e++)
+      for (CeedInt q=0; q<nqpt; q++) {
+        CeedScalar xq[dim];
+        for (CeedInt d=0, k=q; d<dim; k/=Q1d, d++)
+          xq[d] = qref[k%Q1d];
+        for (CeedInt o=0; o<=dim; o++) {
+          const CeedScalar f = (e+1)*eval(dim, xq, o-1),
+                           vi = v[(o*nqpt+q)*nelem+e];
+          if (fabs(vi - f) > 1e-10*(1 + fabs(f)))
+            printf("Q1d %d output %d [%d,%d] %f != %f\n", Q1d, o, e, q, vi, f);
+        }
+      }
+    CeedVectorRestoreArrayRead(V, &v);
+
+    // The values alone
+    CeedVector I;
+    const CeedScalar *x;
+    CeedVectorCreate(ceed, qsize, &I);
+    CeedBasisApply(b, nelem, CEED_NOTRANSPOSE, CEED_EVAL_INTERP, U, I);
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, &v);
+    CeedVectorGetArrayRead(I, CEED_MEM_HOST, &x);
+    for (CeedInt i=0; i<qsize; i++)
+      if (fabs(x[i] - v[i]) > 1e-13*(1 + fabs(v[i])))
+        printf("Q1d %d interp [%d] %f != %f\n", Q1d, i, x[i], v[i]);
+    CeedVectorRestoreArrayRead(I, &x);
+    CeedVectorRestoreArrayRead(V, &v);
+    CeedVectorDestroy(&I);
+
+    // The transpose is the adjoint, <v, Bu> = <B^T v, u>
+    CeedScalar vBu = 0, Btvu = 0;
+    for (CeedInt i=0; i<qsize*(1+dim); i++)
+      w[i] = cos(i + 1.);
+    CeedVectorGetArrayRead(V, CEED_MEM_HOST, &v);
+    for (CeedInt i=0; i<qsize*(1+dim); i++)
+      vBu += w[i]*v[i];
+    CeedVectorRestoreArrayRead(V, &v);
+    CeedVectorSetArray(V, CEED_MEM_HOST, CEED_COPY_VALUES, w);
+    CeedBasisApply(b, nelem, CEED_TRANSPOSE, CEED_EVAL_INTERP|CEED_EVAL_GRAD,
+                   V, W);
+    CeedVectorGetArrayRead(W, CEED_MEM_HOST, &v);
+    for (CeedInt i=0; i<psize; i++)
+      Btvu += v[i]*u[i];
+    CeedVectorRestoreArrayRead(W, &v);
+    if (fabs(vBu - Btvu) > 1e-10*fabs(vBu))
+      printf("Q1d %d transpose %f != %f\n", Q1d, Btvu, vBu);
+
+    CeedVectorDestroy(&U);
+    CeedVectorDestroy(&V);
+    CeedVectorDestroy(&W);
+    CeedBasisDestroy(&b);
+    free(u);
+    free(w);
+  }
+
+  CeedDestroy(&ceed);
+  return 0;
+}
@@ -0,0 +1,208 @@
+c-----------------------------------------------------------------------
+      subroutine setup(ctx,q,u1,u2,u3,u4,u5,u6,u7,
+     $  u8,u9,u10,u11,u12,u13,u14,u15,u16,v1,v2,v3,v4,v5,v6,v7,v8,
+     $  v9,v10,v11,v12,v13,v14,v15,v16,ierr)
+      real*8 ctx
+      real*8 u1(1)
+      real*8 u2(1)
+      real*8 v1(1)
+      integer q,ierr
+
+      do i=1,q
+        v1(i)=u1(i)*u2(i)
+      enddo
+
+      ierr=0
+      end
+c-----------------------------------------------------------------------
+      subroutine mass(ctx,q,u1,u2,u3,u4,u5,u6,u7,
+     $  u8,u9,u10,u11,u12,u13,u14,u15,u16,v1,v2,v3,v4,v5,v6,v7,v8,
+     $  v9,v10,v11,v12,v13,v14,v15,v16,ierr)
+      real*8 ctx
+      real*8 u1(1)
+      real*8 u2(1)
+      real*8 u3(1)
+      real*8 v1(1)
+      real*8 v2(1)
+      integer q,ierr
+
+      do i=1,q
+        v1(i)=u1(i)*(u2(i)+2*u3(i))
+        v2(i)=u1(i)*u3(i)
+      enddo
+
+      ierr=0
+      end
+c-----------------------------------------------------------------------
+      program test
+
+      include 'ceedf.h'
+
+      integer ceed,err,i,j
+      integer erestrictx,erestrictu,erestrictxi,erestrictui
+      integer bx,bu
+      integer qf_setup,qf_mass
+      integer op_setup,op_mass
+      integer qdata,x,u,v,w,z
+      integer nelem,p,q
+      parameter(nelem=15)
+      parameter(p=5)
+      parameter(q=8)
+      integer nx,nu
+      parameter(nx=nelem+1)
+      parameter(nu=nelem*(p-1)+1)
+      integer indx(nelem*2)
+      integer indu(nelem*p)
+      real*8 arrx(nx)
+      real*8 nodes(p),weights(p)
+      integer*8 voffset
+
+      real*8 hu(nu),hv(nu),hw(nu),hz(nu)
+      real*8 total1,total2
+      integer*8 woffset,zoffset
+
+      character arg*32
+
+      external setup,mass
+
+      call getarg(1,arg)
+      call ceedinit(trim(arg)//char(0),ceed,err)
+
+      do i=0,nx-1
+        arrx(i+1)=i/(nx-1.d0)
+      enddo
+      do i=0,nelem-1
+        indx(2*i+1)=i
+        indx(2*i+2)=i+1
+      enddo
+
+      call ceedelemrestrictioncreate(ceed,nelem,2,nx,1,
+     $  ceed_mem_host,ceed_use_pointer,indx,erestrictx,err)
+      call ceedelemrestrictioncreateidentity(ceed,nelem,2,2*nelem,1,
+     $  erestrictxi,err)
+
+      do i=0,nelem-1
+        do j=0,p-1
+          indu(p*i+j+1)=i*(p-1)+j
+        enddo
+      enddo
+
+      call ceedelemrestrictioncreate(ceed,nelem,p,nu,1,
+     $  ceed_mem_host,ceed_use_pointer,indu,erestrictu,err)
+      call ceedelemrestrictioncreateidentity(ceed,nelem,q,q*nelem,1,
+     $  erestrictui,err)
+
+      call ceedbasiscreatetensorh1lagrange(ceed,1,1,2,q,ceed_gauss,
+     $  bx,err)
+      call ceedbasiscreatetensorh1lagrange(ceed,1,1,p,q,ceed_gauss,
+     $  bu,err)
+
+      call ceedqfunctioncreateinterior(ceed,1,setup,
+c     __FILE__ should not be more than the 72 characters, -ffree-line-length-none ?
+     $__FILE__ 
+     $     //':setup'//char(0),qf_setup,err)
+c     $  't30-operator-f.f:setup',qf_setup,err)
+      call ceedqfunctionaddinput(qf_setup,'_weight',1,
+     $  ceed_eval_weight,err)
+      call ceedqfunctionaddinput(qf_setup,'x',1,ceed_eval_grad,err)
+      call ceedqfunctionaddoutput(qf_setup,'rho',1,
+     $  ceed_eval_none,err)
+
+      call ceedqfunctioncreateinterior(ceed,1,mass,
+     $__FILE__ 
+     $     //':mass'//char(0),qf_mass,err)
+c     $  't30-operator-f.f:mass',qf_mass,err)
+      call ceedqfunctionaddinput(qf_mass,'rho',1,ceed_eval_none,err)
+      call ceedqfunctionaddinput(qf_mass,'u',1,ceed_eval_interp,err)
+      call ceedqfunctionaddinput(qf_mass,'w',1,ceed_eval_interp,err)
+      call ceedqfunctionaddoutput(qf_mass,'v',1,ceed_eval_interp,err)
+      call ceedqfunctionaddoutput(qf_mass,'z',1,ceed_eval_interp,err)
+
+      call ceedoperatorcreate(ceed,qf_setup,ceed_null,ceed_null,
+     $  op_setup,err)
+      call ceedoperatorcreate(ceed,qf_mass,ceed_null,ceed_null,
+     $  op_mass,err)
+
+      call ceedvectorcreate(ceed,nx,x,err)
+      call ceedvectorsetarray(x,ceed_mem_host,ceed_use_pointer,arrx,err)
+      call ceedvectorcreate(ceed,nelem*q,qdata,err)
+
+c     W holds the coordinates of the nodes
+      call ceedlobattoquadrature(p,nodes,weights,err)
+      call ceedvectorcreate(ceed,nu,w,err)
+      call ceedvectorgetarray(w,ceed_mem_host,hw,woffset,err)
+      do i=0,nelem-1
+        do j=0,p-1
+          hw(woffset+i*(p-1)+j+1)=(i+(nodes(j+1)+1)/2)/nelem
+        enddo
+      enddo
+      call ceedvectorrestorearray(w,hw,woffset,err)
+      call ceedvectorcreate(ceed,nu,z,err)
+
+      call ceedoperatorsetfield(op_setup,'_weight',erestrictxi,
+     $  ceed_notranspose,bx,ceed_vector_none,err)
+      call ceedoperatorsetfield(op_setup,'x',erestrictx,
+     $  ceed_notranspose,bx,ceed_vector_active,err)
+      call ceedoperatorsetfield(op_setup,'rho',erestrictui,
+     $  ceed_notranspose,ceed_basis_collocated,
+     $  ceed_vector_active,err)
+      call ceedoperatorsetfield(op_mass,'rho',erestrictui,
+     $  ceed_notranspose,ceed_basis_collocated,
+     $  qdata,err)
+      call ceedoperatorsetfield(op_mass,'u',erestrictu,
+     $  ceed_transpose,bu,ceed_vector_active,err)
+      call ceedoperatorsetfield(op_mass,'w',erestrictu,
+     $  ceed_transpose,bu,w,err)
+      call ceedoperatorsetfield(op_mass,'v',erestrictu,
+     $  ceed_transpose,bu,ceed_vector_active,err)
+      call ceedoperatorsetfield(op_mass,'z',erestrictu,
+     $  ceed_transpose,bu,z,err)
+
+      call ceedoperatorapply(op_setup,x,qdata,
+     $  ceed_request_immediate,err)
+
+      call ceedvectorcreate(ceed,nu,u,err)
+      call ceedvectorgetarray(u,ceed_mem_host,hu,voffset,err)
+      do i=1,nu
+        hu(voffset+i)=1.
+      enddo
+      call ceedvectorrestorearray(u,hu,voffset,err)
+      call ceedvectorcreate(ceed,nu,v,err)
+      call ceedoperatorapply(op_mass,u,v,ceed_request_immediate,err)
+
+c     v integrates 1+2x and z integrates x
+      call ceedvectorgetarrayread(v,ceed_mem_host,hv,voffset,err)
+      call ceedvectorgetarrayread(z,ceed_mem_host,hz,zoffset,err)
+      total1=0.
+      total2=0.
+      do i=1,nu
+        total1=total1+hv(voffset+i)
+        total2=total2+hz(zoffset+i)
+      enddo
+      if (abs(total1-2.)>1.0d-10) then
+        write(*,*) 'Computed Integral: ',total1,' != True Integral: 2.0'
+      endif
+      if (abs(total2-.5)>1.0d-10) then
+        write(*,*) 'Computed Integral: ',total2,' != True Integral: 0.5'
+      endif
+      call ceedvectorrestorearrayread(v,hv,voffset,err)
+      call ceedvectorrestorearrayread(z,hz,zoffset,err)
+
+      call ceedvectordestroy(x,err)
+      call ceedvectordestroy(u,err)
+      call ceedvectordestroy(v,err)
+      call ceedvectordestroy(w,err)
+      call ceedvectordestroy(z,err)
+      call ceedoperatordestroy(op_mass,err)
+      call ceedoperatordestroy(op_setup,err)
+      call ceedqfunctiondestroy(qf_mass,err)
+      call ceedqfunctiondestroy(qf_setup,err)
+      call ceedbasisdestroy(bu,err)
+      call ceedbasisdestroy(bx,err)
+      call ceedelemrestrictiondestroy(erestrictu,err)
+      call ceedelemrestrictiondestroy(erestrictx,err)
+      call ceedelemrestrictiondestroy(erestrictui,err)
+      call ceedelemrestrictiondestroy(erestrictxi,err)
+      call ceeddestroy(ceed,err)
+      end
+c-----------------------------------------------------------------------
@@ -0,0 +1,164 @@
+/// @file
+/// Test mass matrix operator with several fields sharing a basis
+/// \test Test mass matrix operator with several fields sharing a basis
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+
+static int setup(void *ctx, CeedInt Q, const CeedScalar *const *in,
+                 CeedScalar *const *out);
+static int mass(void *ctx, CeedInt Q, const CeedScalar *const *in,
+                CeedScalar *const *out);
+
+static int setup(void *ctx, CeedInt Q, const CeedScalar *const *in,
+                 CeedScalar *const *out) {
+  const CeedScalar *weight = in[0], *dxdX = in[1];
+  CeedScalar *rho = out[0];
+  for (CeedInt i=0; i<Q; i++) {
+    rho[i] = weight[i] * dxdX[i];
+  }
+  return 0;
+}
+
+static int mass(void *ctx, CeedInt Q, const CeedScalar *const *in,
+                CeedScalar *const *out) {
+  const CeedScalar *rho = in[0], *u = in[1], *w = in[2];
+  CeedScalar *v = out[0], *z = out[1];
+  for (CeedInt i=0; i<Q; i++) {
+    v[i] = rho[i] * (u[i] + 2*w[i]);
+    z[i] = rho[i] * w[i];
+  }
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedElemRestriction Erestrictx, Erestrictu, Erestrictxi, Erestrictui;
+  CeedBasis bx, bu;
+  CeedQFunction qf_setup, qf_mass;
+  CeedOperator op_setup, op_mass;
+  CeedVector qdata, X, U, V, W, Z;
+  CeedScalar *hu, *hw;
+  const CeedScalar *hv, *hz;
+  CeedInt nelem = 15, P = 5, Q = 8;
+  CeedInt Nx = nelem+1, Nu = nelem*(P-1)+1;
+  CeedInt indx[nelem*2], indu[nelem*P];
+  CeedScalar x[Nx], nodes[P];
+  CeedScalar sum1, sum2;
+
+  CeedInit(argv[1], &ceed);
+  for (CeedInt i=0; i<Nx; i++) x[i] = (CeedScalar) i / (Nx - 1);
+  for (CeedInt i=0; i<nelem; i++) {
+    indx[2*i+0] = i;
+    indx[2*i+1] = i+1;
+  }
+  // Restrictions
+  CeedElemRestrictionCreate(ceed, nelem, 2, Nx, 1, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indx, &Erestrictx);
+  CeedElemRestrictionCreateIdentity(ceed, nelem, 2, nelem*2, 1, &Erestrictxi);
+
+  for (CeedInt i=0; i<nelem; i++) {
+    for (CeedInt j=0; j<P; j++) {
+      indu[P*i+j] = i*(P-1) + j;
+    }
+  }
+  CeedElemRestrictionCreate(ceed, nelem, P, Nu, 1, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indu, &Erestrictu);
+  CeedElemRestrictionCreateIdentity(ceed, nelem, Q, Q*nelem, 1, &Erestrictui);
+
+  // Bases
+  CeedBasisCreateTensorH1Lagrange(ceed, 1, 1, 2, Q, CEED_GAUSS, &bx);
+  CeedBasisCreateTensorH1Lagrange(ceed, 1, 1, P, Q, CEED_GAUSS, &bu);
+
+  // QFunctions
+  CeedQFunctionCreateInterior(ceed, 1, setup, __FILE__ ":setup", &qf_setup);
+  CeedQFunctionAddInput(qf_setup, "_weight", 1, CEED_EVAL_WEIGHT);
+  CeedQFunctionAddInput(qf_setup, "x", 1, CEED_EVAL_GRAD);
+  CeedQFunctionAddOutput(qf_setup, "rho", 1, CEED_EVAL_NONE);
+
+  CeedQFunctionCreateInterior(ceed, 1, mass, __FILE__ ":mass", &qf_mass);
+  CeedQFunctionAddInput(qf_mass, "rho", 1, CEED_EVAL_NONE);
+  CeedQFunctionAddInput(qf_mass, "u", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddInput(qf_mass, "w", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddOutput(qf_mass, "v", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddOutput(qf_mass, "z", 1, CEED_EVAL_INTERP);
+
+  // Operators
+  CeedOperatorCreate(ceed, qf_setup, NULL, NULL, &op_setup);
+
+  CeedOperatorCreate(ceed, qf_mass, NULL, NULL, &op_mass);
+
+  CeedVectorCreate(ceed, Nx, &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+  CeedVectorCreate(ceed, nelem*Q, &qdata);
+
+  // W holds the coordinates of the nodes
+  CeedLobattoQuadrature(P, nodes, NULL);
+  CeedVectorCreate(ceed, Nu, &W);
+  CeedVectorGetArray(W, CEED_MEM_HOST, &hw);
+  for (CeedInt i=0; i<nelem; i++)
+    for (CeedInt j=0; j<P; j++)
+      hw[i*(P-1)+j] = (i + (nodes[j] + 1)/2) / nelem;
+  CeedVectorRestoreArray(W, &hw);
+  CeedVectorCreate(ceed, Nu, &Z);
+
+  CeedOperatorSetField(op_setup, "_weight", Erestrictxi, CEED_NOTRANSPOSE,
+                       bx, CEED_VECTOR_NONE);
+  CeedOperatorSetField(op_setup, "x", Erestrictx, CEED_NOTRANSPOSE,
+                       bx, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_setup, "rho", Erestrictui, CEED_NOTRANSPOSE,
+                       CEED_BASIS_COLLOCATED, CEED_VECTOR_ACTIVE);
+
+  CeedOperatorSetField(op_mass, "rho", Erestrictui, CEED_NOTRANSPOSE,
+                       CEED_BASIS_COLLOCATED, qdata);
+  CeedOperatorSetField(op_mass, "u", Erestrictu, CEED_TRANSPOSE,
+                       bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_mass, "w", Erestrictu, CEED_TRANSPOSE,
+                       bu, W);
+  CeedOperatorSetField(op_mass, "v", Erestrictu, CEED_TRANSPOSE,
+                       bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_mass, "z", Erestrictu, CEED_TRANSPOSE,
+                       bu, Z);
+
+  CeedOperatorApply(op_setup, X, qdata, CEED_REQUEST_IMMEDIATE);
+
+  CeedVectorCreate(ceed, Nu, &U);
+  CeedVectorGetArray(U, CEED_MEM_HOST, &hu);
+  for (int i = 0; i < Nu; i++)
+    hu[i] = 1.0;
+  CeedVectorRestoreArray(U, &hu);
+  CeedVectorCreate(ceed, Nu, &V);
+  CeedOperatorApply(op_mass, U, V, CEED_REQUEST_IMMEDIATE);
+
+  // Check output, v integrates 1 + 2x and z integrates x
+  CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+  CeedVectorGetArrayRead(Z, CEED_MEM_HOST, &hz);
+  sum1 = 0.; sum2 = 0.;
+  for (CeedInt i=0; i<Nu; i++) {
+    sum1 += hv[i];
+    sum2 += hz[i];
+  }
+  if (fabs(sum1-2.)>1e-10) printf("Computed Integral: %f != True Integral: 2.0\n", sum1);
+  if (fabs(sum2-.5)>1e-10) printf("Computed Integral: %f != True Integral: 0.5\n", sum2);
+  CeedVectorRestoreArrayRead(V, &hv);
+  CeedVectorRestoreArrayRead(Z, &hz);
+
+  CeedQFunctionDestroy(&qf_setup);
+  CeedQFunctionDestroy(&qf_mass);
+  CeedOperatorDestroy(&op_setup);
+  CeedOperatorDestroy(&op_mass);
+  CeedElemRestrictionDestroy(&Erestrictu);
+  CeedElemRestrictionDestroy(&Erestrictx);
+  CeedElemRestrictionDestroy(&Erestrictui);
+  CeedElemRestrictionDestroy(&Erestrictxi);
+  CeedBasisDestroy(&bu);
+  CeedBasisDestroy(&bx);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedVectorDestroy(&W);
+  CeedVectorDestroy(&Z);
+  CeedVectorDestroy(&qdata);
+  CeedDestroy(&ceed);
+  return 0;
+}
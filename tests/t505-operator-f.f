@@ -0,0 +1,216 @@
+c-----------------------------------------------------------------------
+      subroutine setup(ctx,q,u1,u2,u3,u4,u5,u6,u7,
+     $  u8,u9,u10,u11,u12,u13,u14,u15,u16,v1,v2,v3,v4,v5,v6,v7,v8,
+     $  v9,v10,v11,v12,v13,v14,v15,v16,ierr)
+      real*8 ctx
+      real*8 u1(1)
+      real*8 u2(1)
+      real*8 v1(1)
+      integer q,ierr
+
+      do i=1,q
+        v1(i)=u1(i)*u2(i)
+      enddo
+
+      ierr=0
+      end
+c-----------------------------------------------------------------------
+      subroutine mass(ctx,q,u1,u2,u3,u4,u5,u6,u7,
+     $  u8,u9,u10,u11,u12,u13,u14,u15,u16,v1,v2,v3,v4,v5,v6,v7,v8,
+     $  v9,v10,v11,v12,v13,v14,v15,v16,ierr)
+      real*8 ctx
+      real*8 u1(1)
+      real*8 u2(1)
+      real*8 v1(1)
+      integer q,ierr
+
+      do i=1,q
+        v1(i)=u2(i)*u1(i)
+      enddo
+
+      ierr=0
+      end
+c-----------------------------------------------------------------------
+      program test
+
+      include 'ceedf.h'
+
+      integer ceed,err,i,j
+      integer erestrictx,erestrictu,erestrictxi,erestrictui
+      integer bx,bu
+      integer qf_setup,qf_mass
+      integer op_setup,op_mass
+      integer qdata,qfull,x,u,v,w
+      integer nelem,p,q
+      parameter(nelem=15)
+      parameter(p=5)
+      parameter(q=8)
+      integer nx,nu
+      parameter(nx=nelem+1)
+      parameter(nu=nelem*(p-1)+1)
+      integer indx(nelem*2)
+      integer indu(nelem*p)
+      integer bnd(3)
+      integer rest(9)
+      real*8 arrx(nx)
+      real*8 arru(nu)
+      integer*8 qoffset,voffset,woffset
+
+      real*8 hq(nelem*q)
+      real*8 hf(nelem*q)
+      real*8 hv(nu)
+      real*8 hw(nu)
+
+      character arg*32
+
+      external setup,mass
+
+      call getarg(1,arg)
+      call ceedinit(trim(arg)//char(0),ceed,err)
+
+      do i=0,nx-1
+        arrx(i+1)=i/(nx-1.d0)
+      enddo
+      do i=0,nelem-1
+        indx(2*i+1)=i
+        indx(2*i+2)=i+1
+      enddo
+
+      call ceedelemrestrictioncreate(ceed,nelem,2,nx,1,
+     $  ceed_mem_host,ceed_use_pointer,indx,erestrictx,err)
+      call ceedelemrestrictioncreateidentity(ceed,nelem,2,2*nelem,1,
+     $  erestrictxi,err)
+
+      do i=0,nelem-1
+        do j=0,p-1
+          indu(p*i+j+1)=i*(p-1)+j
+        enddo
+      enddo
+
+      call ceedelemrestrictioncreate(ceed,nelem,p,nu,1,
+     $  ceed_mem_host,ceed_use_pointer,indu,erestrictu,err)
+      call ceedelemrestrictioncreateidentity(ceed,nelem,q,q*nelem,1,
+     $  erestrictui,err)
+
+      call ceedbasiscreatetensorh1lagrange(ceed,1,1,2,q,ceed_gauss,
+     $  bx,err)
+      call ceedbasiscreatetensorh1lagrange(ceed,1,1,p,q,ceed_gauss,
+     $  bu,err)
+
+      call ceedqfunctioncreateinterior(ceed,1,setup,
+c     __FILE__ should not be more than the 72 characters, -ffree-line-length-none ?
+     $__FILE__ 
+     $     //':setup'//char(0),qf_setup,err)
+c     $  't30-operator-f.f:setup',qf_setup,err)
+      call ceedqfunctionaddinput(qf_setup,'_weight',1,
+     $  ceed_eval_weight,err)
+      call ceedqfunctionaddinput(qf_setup,'x',1,ceed_eval_grad,err)
+      call ceedqfunctionaddoutput(qf_setup,'rho',1,
+     $  ceed_eval_none,err)
+
+      call ceedqfunctioncreateinterior(ceed,1,mass,
+     $__FILE__ 
+     $     //':mass'//char(0),qf_mass,err)
+c     $  't30-operator-f.f:mass',qf_mass,err)
+      call ceedqfunctionaddinput(qf_mass,'rho',1,ceed_eval_none,err)
+      call ceedqfunctionaddinput(qf_mass,'u',1,ceed_eval_interp,err)
+      call ceedqfunctionaddoutput(qf_mass,'v',1,ceed_eval_interp,err)
+
+      call ceedoperatorcreate(ceed,qf_setup,ceed_null,ceed_null,
+     $  op_setup,err)
+      call ceedoperatorcreate(ceed,qf_mass,ceed_null,ceed_null,
+     $  op_mass,err)
+
+      call ceedvectorcreate(ceed,nx,x,err)
+      call ceedvectorsetarray(x,ceed_mem_host,ceed_use_pointer,arrx,err)
+      call ceedvectorcreate(ceed,nelem*q,qdata,err)
+
+      call ceedoperatorsetfield(op_setup,'_weight',erestrictxi,
+     $  ceed_notranspose,bx,ceed_vector_none,err)
+      call ceedoperatorsetfield(op_setup,'x',erestrictx,
+     $  ceed_notranspose,bx,ceed_vector_active,err)
+      call ceedoperatorsetfield(op_setup,'rho',erestrictui,
+     $  ceed_notranspose,ceed_basis_collocated,
+     $  ceed_vector_active,err)
+      call ceedoperatorsetfield(op_mass,'rho',erestrictui,
+     $  ceed_notranspose,ceed_basis_collocated,
+     $  qdata,err)
+      call ceedoperatorsetfield(op_mass,'u',erestrictu,
+     $  ceed_notranspose,bu,ceed_vector_active,err)
+      call ceedoperatorsetfield(op_mass,'v',erestrictu,
+     $  ceed_notranspose,bu,ceed_vector_active,err)
+
+c     Quadrature data of elements [0, 6), then of the others in reverse
+      call ceedvectorsetvalue(qdata,0.d0,err)
+      call ceedoperatorapplyelementrange(op_setup,0,6,x,qdata,
+     $  ceed_request_immediate,err)
+      do i=1,9
+        rest(i)=nelem-i
+      enddo
+      call ceedoperatorapplyelements(op_setup,9,rest,x,qdata,
+     $  ceed_request_immediate,err)
+      call ceedvectorcreate(ceed,nelem*q,qfull,err)
+      call ceedoperatorapply(op_setup,x,qfull,
+     $  ceed_request_immediate,err)
+      call ceedvectorgetarrayread(qdata,ceed_mem_host,hq,qoffset,err)
+      call ceedvectorgetarrayread(qfull,ceed_mem_host,hf,voffset,err)
+      do i=1,nelem*q
+        if (abs(hq(qoffset+i)-hf(voffset+i))>1.0d-14) then
+          write(*,*) 'qdata computed by subsets: ',hq(qoffset+i),
+     $      ' != ',hf(voffset+i)
+        endif
+      enddo
+      call ceedvectorrestorearrayread(qdata,hq,qoffset,err)
+      call ceedvectorrestorearrayread(qfull,hf,voffset,err)
+
+      do i=0,nu-1
+        arru(i+1)=1+mod(i,7)
+      enddo
+      call ceedvectorcreate(ceed,nu,u,err)
+      call ceedvectorsetarray(u,ceed_mem_host,ceed_use_pointer,arru,err)
+      call ceedvectorcreate(ceed,nu,v,err)
+      call ceedvectorcreate(ceed,nu,w,err)
+      call ceedoperatorapply(op_mass,u,v,ceed_request_immediate,err)
+
+c     Boundary elements, then interior elements, adding to w
+      bnd(1)=nelem-1
+      bnd(2)=0
+      bnd(3)=7
+      call ceedvectorsetvalue(w,0.d0,err)
+      call ceedoperatorapplyelements(op_mass,3,bnd,u,w,
+     $  ceed_request_immediate,err)
+      call ceedoperatorapplyelementrange(op_mass,1,7,u,w,
+     $  ceed_request_immediate,err)
+      call ceedoperatorapplyelementrange(op_mass,8,nelem-1,u,w,
+     $  ceed_request_immediate,err)
+
+      call ceedvectorgetarrayread(v,ceed_mem_host,hv,voffset,err)
+      call ceedvectorgetarrayread(w,ceed_mem_host,hw,woffset,err)
+      do i=1,nu
+        if (abs(hw(woffset+i)-hv(voffset+i))>1.0d-12) then
+          write(*,*) 'Computed by subsets: ',hw(woffset+i),' != ',
+     $      hv(voffset+i)
+        endif
+      enddo
+      call ceedvectorrestorearrayread(v,hv,voffset,err)
+      call ceedvectorrestorearrayread(w,hw,woffset,err)
+
+      call ceedvectordestroy(x,err)
+      call ceedvectordestroy(u,err)
+      call ceedvectordestroy(v,err)
+      call ceedvectordestroy(w,err)
+      call ceedvectordestroy(qdata,err)
+      call ceedvectordestroy(qfull,err)
+      call ceedoperatordestroy(op_mass,err)
+      call ceedoperatordestroy(op_setup,err)
+      call ceedqfunctiondestroy(qf_mass,err)
+      call ceedqfunctiondestroy(qf_setup,err)
+      call ceedbasisdestroy(bu,err)
+      call ceedbasisdestroy(bx,err)
+      call ceedelemrestrictiondestroy(erestrictu,err)
+      call ceedelemrestrictiondestroy(erestrictx,err)
+      call ceedelemrestrictiondestroy(erestrictui,err)
+      call ceedelemrestrictiondestroy(erestrictxi,err)
+      call ceeddestroy(ceed,err)
+      end
+c-----------------------------------------------------------------------
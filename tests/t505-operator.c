@@ -0,0 +1,166 @@
+/// @file
+/// Test mass matrix operator applied to subsets of its elements
+/// \test Test mass matrix operator applied to subsets of its elements
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+
+static int setup(void *ctx, CeedInt Q, const CeedScalar *const *in,
+                 CeedScalar *const *out);
+static int mass(void *ctx, CeedInt Q, const CeedScalar *const *in,
+                CeedScalar *const *out);
+
+static int setup(void *ctx, CeedInt Q, const CeedScalar *const *in,
+                 CeedScalar *const *out) {
+  const CeedScalar *weight = in[0], *dxdX = in[1];
+  CeedScalar *rho = out[0];
+  for (CeedInt i=0; i<Q; i++) {
+    rho[i] = weight[i] * dxdX[i];
+  }
+  return 0;
+}
+
+static int mass(void *ctx, CeedInt Q, const CeedScalar *const *in,
+                CeedScalar *const *out) {
+  const CeedScalar *rho = in[0], *u = in[1];
+  CeedScalar *v = out[0];
+  for (CeedInt i=0; i<Q; i++) {
+    v[i] = rho[i] * u[i];
+  }
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+  CeedElemRestriction Erestrictx, Erestrictu, Erestrictxi, Erestrictui;
+  CeedBasis bx, bu;
+  CeedQFunction qf_setup, qf_mass;
+  CeedOperator op_setup, op_mass;
+  CeedVector qdata, qfull, X, U, V, W;
+  const CeedScalar *hq, *hv, *hw;
+  CeedInt nelem = 15, P = 5, Q = 8;
+  CeedInt Nx = nelem+1, Nu = nelem*(P-1)+1;
+  CeedInt indx[nelem*2], indu[nelem*P];
+  CeedInt boundary[3] = {14, 0, 7}, rest[9];
+  CeedScalar x[Nx], u[Nu];
+
+  CeedInit(argv[1], &ceed);
+  for (CeedInt i=0; i<Nx; i++) x[i] = (CeedScalar) i / (Nx - 1);
+  for (CeedInt i=0; i<nelem; i++) {
+    indx[2*i+0] = i;
+    indx[2*i+1] = i+1;
+  }
+  // Restrictions
+  CeedElemRestrictionCreate(ceed, nelem, 2, Nx, 1, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indx, &Erestrictx);
+  CeedElemRestrictionCreateIdentity(ceed, nelem, 2, nelem*2, 1, &Erestrictxi);
+
+  for (CeedInt i=0; i<nelem; i++) {
+    for (CeedInt j=0; j<P; j++) {
+      indu[P*i+j] = i*(P-1) + j;
+    }
+  }
+  CeedElemRestrictionCreate(ceed, nelem, P, Nu, 1, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indu, &Erestrictu);
+  CeedElemRestrictionCreateIdentity(ceed, nelem, Q, Q*nelem, 1, &Erestrictui);
+
+  // Bases
+  CeedBasisCreateTensorH1Lagrange(ceed, 1, 1, 2, Q, CEED_GAUSS, &bx);
+  CeedBasisCreateTensorH1Lagrange(ceed, 1, 1, P, Q, CEED_GAUSS, &bu);
+
+  // QFunctions
+  CeedQFunctionCreateInterior(ceed, 1, setup, __FILE__ ":setup", &qf_setup);
+  CeedQFunctionAddInput(qf_setup, "_weight", 1, CEED_EVAL_WEIGHT);
+  CeedQFunctionAddInput(qf_setup, "x", 1, CEED_EVAL_GRAD);
+  CeedQFunctionAddOutput(qf_setup, "rho", 1, CEED_EVAL_NONE);
+
+  CeedQFunctionCreateInterior(ceed, 1, mass, __FILE__ ":mass", &qf_mass);
+  CeedQFunctionAddInput(qf_mass, "rho", 1, CEED_EVAL_NONE);
+  CeedQFunctionAddInput(qf_mass, "u", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddOutput(qf_mass, "v", 1, CEED_EVAL_INTERP);
+
+  // Operators
+  CeedOperatorCreate(ceed, qf_setup, NULL, NULL, &op_setup);
+
+  CeedOperatorCreate(ceed, qf_mass, NULL, NULL, &op_mass);
+
+  CeedVectorCreate(ceed, Nx, &X);
+  CeedVectorSetArray(X, CEED_MEM_HOST, CEED_USE_POINTER, x);
+  CeedVectorCreate(ceed, nelem*Q, &qdata);
+
+  CeedOperatorSetField(op_setup, "_weight", Erestrictxi, CEED_NOTRANSPOSE,
+                       bx, CEED_VECTOR_NONE);
+  CeedOperatorSetField(op_setup, "x", Erestrictx, CEED_NOTRANSPOSE,
+                       bx, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_setup, "rho", Erestrictui, CEED_NOTRANSPOSE,
+                       CEED_BASIS_COLLOCATED, CEED_VECTOR_ACTIVE);
+
+  CeedOperatorSetField(op_mass, "rho", Erestrictui, CEED_NOTRANSPOSE,
+                       CEED_BASIS_COLLOCATED, qdata);
+  CeedOperatorSetField(op_mass, "u", Erestrictu, CEED_NOTRANSPOSE,
+                       bu, CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_mass, "v", Erestrictu, CEED_NOTRANSPOSE,
+                       bu, CEED_VECTOR_ACTIVE);
+
+  // Quadrature data of elements [0, 6), then of the others in reverse order
+  CeedVectorSetValue(qdata, 0.0);
+  CeedOperatorApplyElementRange(op_setup, 0, 6, X, qdata,
+                                CEED_REQUEST_IMMEDIATE);
+  for (CeedInt i=0; i<9; i++)
+    rest[i] = nelem-1 - i;
+  CeedOperatorApplyElements(op_setup, 9, rest, X, qdata,
+                            CEED_REQUEST_IMMEDIATE);
+  CeedVectorCreate(ceed, nelem*Q, &qfull);
+  CeedOperatorApply(op_setup, X, qfull, CEED_REQUEST_IMMEDIATE);
+  CeedVectorGetArrayRead(qdata, CEED_MEM_HOST, &hq);
+  CeedVectorGetArrayRead(qfull, CEED_MEM_HOST, &hv);
+  for (CeedInt i=0; i<nelem*Q; i++)
+    if (fabs(hq[i]-hv[i]) > 1e-14)
+      printf("[%d] qdata computed by subsets: %f != %f\n", i, hq[i], hv[i]);
+  CeedVectorRestoreArrayRead(qdata, &hq);
+  CeedVectorRestoreArrayRead(qfull, &hv);
+
+  for (CeedInt i=0; i<Nu; i++)
+    u[i] = 1 + i%7;
+  CeedVectorCreate(ceed, Nu, &U);
+  CeedVectorSetArray(U, CEED_MEM_HOST, CEED_USE_POINTER, u);
+  CeedVectorCreate(ceed, Nu, &V);
+  CeedVectorCreate(ceed, Nu, &W);
+  CeedOperatorApply(op_mass, U, V, CEED_REQUEST_IMMEDIATE);
+
+  // Boundary elements, then interior elements, adding to W
+  CeedVectorSetValue(W, 0.0);
+  CeedOperatorApplyElements(op_mass, 3, boundary, U, W,
+                            CEED_REQUEST_IMMEDIATE);
+  CeedOperatorApplyElementRange(op_mass, 1, 7, U, W, CEED_REQUEST_IMMEDIATE);
+  CeedOperatorApplyElementRange(op_mass, 8, nelem-1, U, W,
+                                CEED_REQUEST_IMMEDIATE);
+
+  // Check output
+  CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+  CeedVectorGetArrayRead(W, CEED_MEM_HOST, &hw);
+  for (CeedInt i=0; i<Nu; i++)
+    if (fabs(hw[i]-hv[i]) > 1e-12)
+      printf("[%d] Computed by subsets: %f != %f\n", i, hw[i], hv[i]);
+  CeedVectorRestoreArrayRead(V, &hv);
+  CeedVectorRestoreArrayRead(W, &hw);
+
+  CeedQFunctionDestroy(&qf_setup);
+  CeedQFunctionDestroy(&qf_mass);
+  CeedOperatorDestroy(&op_setup);
+  CeedOperatorDestroy(&op_mass);
+  CeedElemRestrictionDestroy(&Erestrictu);
+  CeedElemRestrictionDestroy(&Erestrictx);
+  CeedElemRestrictionDestroy(&Erestrictui);
+  CeedElemRestrictionDestroy(&Erestrictxi);
+  CeedBasisDestroy(&bu);
+  CeedBasisDestroy(&bx);
+  CeedVectorDestroy(&X);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedVectorDestroy(&W);
+  CeedVectorDestroy(&qdata);
+  CeedVectorDestroy(&qfull);
+  CeedDestroy(&ceed);
+  return 0;
+}
@@ -0,0 +1,179 @@
+c-----------------------------------------------------------------------
+c     Values followed by the 3 gradient components
+      subroutine fused(ctx,q,u1,u2,u3,u4,u5,u6,u7,
+     $  u8,u9,u10,u11,u12,u13,u14,u15,u16,v1,v2,v3,v4,v5,v6,v7,v8,
+     $  v9,v10,v11,v12,v13,v14,v15,v16,ierr)
+      real*8 ctx
+      real*8 u1(1)
+      real*8 v1(1)
+      integer q,ierr,d
+
+      do i=1,q
+        v1(i)=u1(i)+u1(q+i)-2*u1(3*q+i)
+        do d=0,2
+          v1((1+d)*q+i)=(d+1)*u1((1+d)*q+i)+0.5d0*u1(i)
+        enddo
+      enddo
+
+      ierr=0
+      end
+c-----------------------------------------------------------------------
+      subroutine separate(ctx,q,u1,u2,u3,u4,u5,u6,u7,
+     $  u8,u9,u10,u11,u12,u13,u14,u15,u16,v1,v2,v3,v4,v5,v6,v7,v8,
+     $  v9,v10,v11,v12,v13,v14,v15,v16,ierr)
+      real*8 ctx
+      real*8 u1(1)
+      real*8 u2(1)
+      real*8 v1(1)
+      real*8 v2(1)
+      integer q,ierr,d
+
+      do i=1,q
+        v1(i)=u1(i)+u2(i)-2*u2(2*q+i)
+        do d=0,2
+          v2(d*q+i)=(d+1)*u2(d*q+i)+0.5d0*u1(i)
+        enddo
+      enddo
+
+      ierr=0
+      end
+c-----------------------------------------------------------------------
+c     Applies both operators on a 3 x 2 x 1 hexahedral mesh of order p-1
+c     with q quadrature points in each direction and compares the results
+      subroutine check(ceed,p,q)
+      include 'ceedf.h'
+
+      integer ceed,p,q,err,i,j,k,e,ex,ey,ez
+      integer erestrictu,bu
+      integer qf_fused,qf_separate
+      integer op_fused,op_separate
+      integer u,v,w
+      integer nelem,maxp
+      parameter(nelem=6)
+      parameter(maxp=15)
+      integer n0,n1,n2,ndofs,elemsize
+      integer indu(nelem*maxp**3)
+      real*8 arru(((3*(maxp-1)+1)*(2*(maxp-1)+1)*maxp))
+      integer*8 voffset,woffset
+
+      real*8 hv(((3*(maxp-1)+1)*(2*(maxp-1)+1)*maxp))
+      real*8 hw(((3*(maxp-1)+1)*(2*(maxp-1)+1)*maxp))
+
+      external fused,separate
+
+      n0=3*(p-1)+1
+      n1=2*(p-1)+1
+      n2=p
+      ndofs=n0*n1*n2
+      elemsize=p*p*p
+
+      do e=0,nelem-1
+        ex=mod(e,3)
+        ey=mod(e/3,2)
+        ez=e/6
+        do k=0,p-1
+          do j=0,p-1
+            do i=0,p-1
+              indu(e*elemsize+(k*p+j)*p+i+1)=((ez*(p-1)+k)*n1+
+     $          ey*(p-1)+j)*n0+ex*(p-1)+i
+            enddo
+          enddo
+        enddo
+      enddo
+
+      call ceedelemrestrictioncreate(ceed,nelem,elemsize,ndofs,1,
+     $  ceed_mem_host,ceed_use_pointer,indu,erestrictu,err)
+      call ceedbasiscreatetensorh1lagrange(ceed,3,1,p,q,ceed_gauss,
+     $  bu,err)
+
+      call ceedqfunctioncreateinterior(ceed,1,fused,
+     $__FILE__
+     $     //':fused'//char(0),qf_fused,err)
+      call ceedqfunctionaddinput(qf_fused,'u',1,
+     $  ceed_eval_interp+ceed_eval_grad,err)
+      call ceedqfunctionaddoutput(qf_fused,'v',1,
+     $  ceed_eval_interp+ceed_eval_grad,err)
+
+      call ceedqfunctioncreateinterior(ceed,1,separate,
+     $__FILE__
+     $     //':separate'//char(0),qf_separate,err)
+      call ceedqfunctionaddinput(qf_separate,'u',1,ceed_eval_interp,
+     $  err)
+      call ceedqfunctionaddinput(qf_separate,'du',1,ceed_eval_grad,
+     $  err)
+      call ceedqfunctionaddoutput(qf_separate,'v',1,ceed_eval_interp,
+     $  err)
+      call ceedqfunctionaddoutput(qf_separate,'dv',1,ceed_eval_grad,
+     $  err)
+
+      call ceedoperatorcreate(ceed,qf_fused,ceed_null,ceed_null,
+     $  op_fused,err)
+      call ceedoperatorsetfield(op_fused,'u',erestrictu,
+     $  ceed_notranspose,bu,ceed_vector_active,err)
+      call ceedoperatorsetfield(op_fused,'v',erestrictu,
+     $  ceed_notranspose,bu,ceed_vector_active,err)
+
+      call ceedoperatorcreate(ceed,qf_separate,ceed_null,ceed_null,
+     $  op_separate,err)
+      call ceedoperatorsetfield(op_separate,'u',erestrictu,
+     $  ceed_notranspose,bu,ceed_vector_active,err)
+      call ceedoperatorsetfield(op_separate,'du',erestrictu,
+     $  ceed_notranspose,bu,ceed_vector_active,err)
+      call ceedoperatorsetfield(op_separate,'v',erestrictu,
+     $  ceed_notranspose,bu,ceed_vector_active,err)
+      call ceedoperatorsetfield(op_separate,'dv',erestrictu,
+     $  ceed_notranspose,bu,ceed_vector_active,err)
+
+      do i=0,ndofs-1
+        arru(i+1)=sin(i+1.d0)
+      enddo
+      call ceedvectorcreate(ceed,ndofs,u,err)
+      call ceedvectorsetarray(u,ceed_mem_host,ceed_use_pointer,arru,err)
+      call ceedvectorcreate(ceed,ndofs,v,err)
+      call ceedvectorcreate(ceed,ndofs,w,err)
+      call ceedoperatorapply(op_fused,u,v,ceed_request_immediate,err)
+      call ceedoperatorapply(op_separate,u,w,ceed_request_immediate,
+     $  err)
+
+      call ceedvectorgetarrayread(v,ceed_mem_host,hv,voffset,err)
+      call ceedvectorgetarrayread(w,ceed_mem_host,hw,woffset,err)
+      do i=1,ndofs
+        if (abs(hv(voffset+i)-hw(woffset+i))>
+     $    1.0d-10*max(1.d0,abs(hw(woffset+i)))) then
+          write(*,*) 'p=',p,' q=',q,' Fused ',hv(voffset+i),
+     $      ' != separate ',hw(woffset+i)
+        endif
+      enddo
+      call ceedvectorrestorearrayread(v,hv,voffset,err)
+      call ceedvectorrestorearrayread(w,hw,woffset,err)
+
+      call ceedvectordestroy(u,err)
+      call ceedvectordestroy(v,err)
+      call ceedvectordestroy(w,err)
+      call ceedoperatordestroy(op_fused,err)
+      call ceedoperatordestroy(op_separate,err)
+      call ceedqfunctiondestroy(qf_fused,err)
+      call ceedqfunctiondestroy(qf_separate,err)
+      call ceedbasisdestroy(bu,err)
+      call ceedelemrestrictiondestroy(erestrictu,err)
+      end
+c-----------------------------------------------------------------------
+      program test
+
+      include 'ceedf.h'
+
+      integer ceed,err
+
+      character arg*32
+
+      call getarg(1,arg)
+      call ceedinit(trim(arg)//char(0),ceed,err)
+
+c     Collocated derivative, q < p, and slab by slab contractions
+      call check(ceed,3,4)
+      call check(ceed,4,3)
+      call check(ceed,15,17)
+
+      call ceeddestroy(ceed,err)
+      end
+c-----------------------------------------------------------------------
@@ -0,0 +1,134 @@
+/// @file
+/// Test operator with a fused CEED_EVAL_INTERP|CEED_EVAL_GRAD field against separate fields
+/// \test Test operator with a fused CEED_EVAL_INTERP|CEED_EVAL_GRAD field against separate fields
+#include <ceed.h>
+#include <stdlib.h>
+#include <math.h>
+
+static int fused(void *ctx, CeedInt Q, const CeedScalar *const *in,
+                 CeedScalar *const *out);
+static int separate(void *ctx, CeedInt Q, const CeedScalar *const *in,
+                    CeedScalar *const *out);
+
+// Values followed by the 3 gradient components
+static int fused(void *ctx, CeedInt Q, const CeedScalar *const *in,
+                 CeedScalar *const *out) {
+  const CeedScalar *u = in[0];
+  CeedScalar *v = out[0];
+  for (CeedInt i=0; i<Q; i++) {
+    v[i] = u[i] + u[Q+i] - 2*u[3*Q+i];
+    for (CeedInt d=0; d<3; d++)
+      v[(1+d)*Q+i] = (d+1)*u[(1+d)*Q+i] + 0.5*u[i];
+  }
+  return 0;
+}
+
+static int separate(void *ctx, CeedInt Q, const CeedScalar *const *in,
+                    CeedScalar *const *out) {
+  const CeedScalar *u = in[0], *du = in[1];
+  CeedScalar *v = out[0], *dv = out[1];
+  for (CeedInt i=0; i<Q; i++) {
+    v[i] = u[i] + du[i] - 2*du[2*Q+i];
+    for (CeedInt d=0; d<3; d++)
+      dv[d*Q+i] = (d+1)*du[d*Q+i] + 0.5*u[i];
+  }
+  return 0;
+}
+
+// Applies both operators on a 3 x 2 x 1 hexahedral mesh of order P-1 with
+// Q quadrature points in each direction and compares the results
+static void check(Ceed ceed, CeedInt P, CeedInt Q) {
+  const CeedInt ne[3] = {3, 2, 1}, nelem = ne[0]*ne[1]*ne[2],
+                nn[3] = {ne[0]*(P-1)+1, ne[1]*(P-1)+1, ne[2]*(P-1)+1},
+                ndofs = nn[0]*nn[1]*nn[2], elemsize = P*P*P;
+  CeedInt *indu = malloc(nelem*elemsize*sizeof(indu[0]));
+  CeedScalar *u = malloc(ndofs*sizeof(u[0]));
+  CeedElemRestriction Erestrictu;
+  CeedBasis bu;
+  CeedQFunction qf_fused, qf_separate;
+  CeedOperator op_fused, op_separate;
+  CeedVector U, V, W;
+  const CeedScalar *hv, *hw;
+
+  for (CeedInt e=0; e<nelem; e++) {
+    const CeedInt ex = e%ne[0], ey = (e/ne[0])%ne[1], ez = e/(ne[0]*ne[1]);
+    for (CeedInt k=0; k<P; k++)
+      for (CeedInt j=0; j<P; j++)
+        for (CeedInt i=0; i<P; i++)
+          indu[e*elemsize + (k*P+j)*P+i] = ((ez*(P-1)+k)*nn[1] +
+                                            ey*(P-1)+j)*nn[0] + ex*(P-1)+i;
+  }
+  CeedElemRestrictionCreate(ceed, nelem, elemsize, ndofs, 1, CEED_MEM_HOST,
+                            CEED_USE_POINTER, indu, &Erestrictu);
+  CeedBasisCreateTensorH1Lagrange(ceed, 3, 1, P, Q, CEED_GAUSS, &bu);
+
+  CeedQFunctionCreateInterior(ceed, 1, fused, __FILE__ ":fused", &qf_fused);
+  CeedQFunctionAddInput(qf_fused, "u", 1, CEED_EVAL_INTERP|CEED_EVAL_GRAD);
+  CeedQFunctionAddOutput(qf_fused, "v", 1, CEED_EVAL_INTERP|CEED_EVAL_GRAD);
+
+  CeedQFunctionCreateInterior(ceed, 1, separate, __FILE__ ":separate",
+                              &qf_separate);
+  CeedQFunctionAddInput(qf_separate, "u", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddInput(qf_separate, "du", 1, CEED_EVAL_GRAD);
+  CeedQFunctionAddOutput(qf_separate, "v", 1, CEED_EVAL_INTERP);
+  CeedQFunctionAddOutput(qf_separate, "dv", 1, CEED_EVAL_GRAD);
+
+  CeedOperatorCreate(ceed, qf_fused, NULL, NULL, &op_fused);
+  CeedOperatorSetField(op_fused, "u", Erestrictu, CEED_NOTRANSPOSE, bu,
+                       CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_fused, "v", Erestrictu, CEED_NOTRANSPOSE, bu,
+                       CEED_VECTOR_ACTIVE);
+
+  CeedOperatorCreate(ceed, qf_separate, NULL, NULL, &op_separate);
+  CeedOperatorSetField(op_separate, "u", Erestrictu, CEED_NOTRANSPOSE, bu,
+                       CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_separate, "du", Erestrictu, CEED_NOTRANSPOSE, bu,
+                       CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_separate, "v", Erestrictu, CEED_NOTRANSPOSE, bu,
+                       CEED_VECTOR_ACTIVE);
+  CeedOperatorSetField(op_separate, "dv", Erestrictu, CEED_NOTRANSPOSE, bu,
+                       CEED_VECTOR_ACTIVE);
+
+  for (CeedInt i=0; i<ndofs; i++)
+    u[i] = sin(i + 1.);
+  CeedVectorCreate(ceed, ndofs, &U);
+  CeedVectorSetArray(U, CEED_MEM_HOST, CEED_USE_POINTER, u);
+  CeedVectorCreate(ceed, ndofs, &V);
+  CeedVectorCreate(ceed, ndofs, &W);
+  CeedOperatorApply(op_fused, U, V, CEED_REQUEST_IMMEDIATE);
+  CeedOperatorApply(op_separate, U, W, CEED_REQUEST_IMMEDIATE);
+
+  // Check output
+  CeedVectorGetArrayRead(V, CEED_MEM_HOST, &hv);
+  CeedVectorGetArrayRead(W, CEED_MEM_HOST, &hw);
+  for (CeedInt i=0; i<ndofs; i++)
+    if (fabs(hv[i]-hw[i]) > 1e-10*fmax(1., fabs(hw[i])))
+      printf("P=%d Q=%d [%d] Fused %f != separate %f\n", P, Q, i, hv[i],
+             hw[i]);
+  CeedVectorRestoreArrayRead(V, &hv);
+  CeedVectorRestoreArrayRead(W, &hw);
+
+  CeedQFunctionDestroy(&qf_fused);
+  CeedQFunctionDestroy(&qf_separate);
+  CeedOperatorDestroy(&op_fused);
+  CeedOperatorDestroy(&op_separate);
+  CeedElemRestrictionDestroy(&Erestrictu);
+  CeedBasisDestroy(&bu);
+  CeedVectorDestroy(&U);
+  CeedVectorDestroy(&V);
+  CeedVectorDestroy(&W);
+  free(indu);
+  free(u);
+}
+
+int main(int argc, char **argv) {
+  Ceed ceed;
+
+  CeedInit(argv[1], &ceed);
+  // Collocated derivative, Q < P, and slab by slab contractions
+  check(ceed, 3, 4);
+  check(ceed, 4, 3);
+  check(ceed, 15, 17);
+  CeedDestroy(&ceed);
+  return 0;
+}